@@ -21,6 +21,8 @@
 #include <rtm/Typename.h>
 #include "ComponentObserverSkel.h"
 #include "ComponentObserverConsumer.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 namespace RTC
@@ -58,6 +60,7 @@ namespace RTC
         unsetConfigurationListeners();
         unsetHeartbeat();
       }
+      stopSender();
 
       {
         std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -86,6 +89,8 @@ namespace RTC
     m_profile = profile;
     coil::Properties prop;
     NVUtil::copyToProperties(prop, profile.properties);
+    setNotification(prop);
+    startSender();
     setHeartbeat(prop);
     setDataPortInterval(prop);
     setListeners(prop);
@@ -109,12 +114,14 @@ namespace RTC
           {
             return false;
           }
+        std::lock_guard<std::mutex> guard(mutex);
         m_observer.releaseObject();
         m_observer.setObject(profile.service);
       }
     m_profile= profile;
     coil::Properties prop;
     NVUtil::copyToProperties(prop, profile.properties);
+    setNotification(prop);
     setHeartbeat(prop);
     setListeners(prop);
     return true;
@@ -152,6 +159,156 @@ namespace RTC
   //============================================================
   // protected functions
 
+  /*!
+   * @if jp
+   * @brief リモートオブジェクトコール
+   * @else
+   * @brief Calling remote object
+   * @endif
+   */
+  void ComponentObserverConsumer::updateStatus(OpenRTM::StatusKind statuskind,
+                                               const char* msg)
+  {
+    std::lock_guard<std::mutex> guard(m_queueMutex);
+    // the target of a notification is the part after "<event>:"
+    const char* target(std::strchr(msg, ':'));
+    for (auto it = m_queue.rbegin(); it != m_queue.rend(); ++it)
+      {
+        if (it->kind != statuskind) { continue; }
+        std::string::size_type pos(it->msg.find(':'));
+        std::string qtarget(pos == std::string::npos ?
+                            "" : it->msg.substr(pos));
+        if (qtarget != (target == nullptr ? "" : target)) { continue; }
+
+        // repeated heartbeats and events are collapsed, and the
+        // state of an RTC in an EC flapping within a batch is sent
+        // only as the latest one
+        if (it->msg == msg) { return; }
+        if (statuskind == OpenRTM::RTC_STATUS)
+          {
+            it->msg = msg;
+            return;
+          }
+        break;
+      }
+    if (m_queue.size() >= m_queueLength)
+      {
+        m_queue.pop_front();
+      }
+    m_queue.push_back({statuskind, msg});
+    m_queueCond.notify_one();
+  }
+
+  /*!
+   * @if jp
+   * @brief 通知の送信設定を行う
+   * @else
+   * @brief Setting notification sending
+   * @endif
+   */
+  void ComponentObserverConsumer::setNotification(coil::Properties& prop)
+  {
+    std::lock_guard<std::mutex> guard(m_queueMutex);
+    std::chrono::nanoseconds window;
+    if (coil::stringTo(window, prop["notification.batch_window"].c_str()))
+      {
+        m_batchWindow = window;
+      }
+    size_t length;
+    if (coil::stringTo(length, prop["notification.queue_length"].c_str())
+        && length > 0)
+      {
+        m_queueLength = length;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信スレッドを開始する
+   * @else
+   * @brief Starting the sender thread
+   * @endif
+   */
+  void ComponentObserverConsumer::startSender()
+  {
+    if (m_sender.joinable()) { return; }
+    m_stopSender = false;
+    m_sender = std::thread([this]{ runSender(); });
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信スレッドを停止する
+   * @else
+   * @brief Stopping the sender thread
+   * @endif
+   */
+  void ComponentObserverConsumer::stopSender()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_queueMutex);
+      m_stopSender = true;
+      m_queueCond.notify_all();
+    }
+    if (m_sender.joinable())
+      {
+        m_sender.join();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信スレッドの処理
+   * @else
+   * @brief Body of the sender thread
+   * @endif
+   */
+  void ComponentObserverConsumer::runSender()
+  {
+    std::unique_lock<std::mutex> guard(m_queueMutex);
+    while (!m_stopSender)
+      {
+        if (m_queue.empty())
+          {
+            m_queueCond.wait(guard);
+            continue;
+          }
+        if (m_batchWindow > std::chrono::nanoseconds::zero())
+          {
+            // notifications within the window are coalesced in the queue
+            m_queueCond.wait_for(guard, m_batchWindow,
+                                 [this]{ return m_stopSender; });
+            if (m_stopSender) { break; }
+          }
+        std::deque<Notification> batch;
+        batch.swap(m_queue);
+        guard.unlock();
+
+        bool failed(false);
+        {
+          std::lock_guard<std::mutex> obsguard(mutex);
+          try
+            {
+              for (auto & notification : batch)
+                {
+                  m_observer->update_status(notification.kind,
+                                            notification.msg.c_str());
+                }
+            }
+          catch (...)
+            {
+              failed = true;
+            }
+        }
+        if (failed)
+          {
+            m_rtobj->removeSdoServiceConsumerStartThread(m_profile.id);
+            return;
+          }
+        guard.lock();
+      }
+  }
+
   /*!
    * @if jp
    * @brief RTObjectへのリスナ接続処理
@@ -274,6 +431,12 @@ namespace RTC
             interval = std::chrono::seconds(1);
           }
         m_heartbeat = true;
+        if (coil::toBool(prop["heartbeat.aggregate"], "YES", "NO", false))
+          {
+            m_hbaggregated = true;
+            HeartbeatAggregator::instance().join(*this, interval);
+            return;
+          }
         m_hbtaskid = Manager::instance().addTask([this]{
           if (m_heartbeat) { updateStatus(OpenRTM::HEARTBEAT, ""); }
         }, interval);
@@ -314,11 +477,129 @@ namespace RTC
   {
     if(m_heartbeat)
       {
-        Manager::instance().removeTask(m_hbtaskid);
+        if (m_hbaggregated)
+          {
+            HeartbeatAggregator::instance().leave(*this);
+            m_hbaggregated = false;
+          }
+        else
+          {
+            Manager::instance().removeTask(m_hbtaskid);
+          }
         m_heartbeat = false;
       }
   }
 
+  //============================================================
+  // HeartbeatAggregator
+
+  /*!
+   * @if jp
+   * @brief インスタンスを取得する
+   * @else
+   * @brief Getting the instance
+   * @endif
+   */
+  HeartbeatAggregator& HeartbeatAggregator::instance()
+  {
+    static HeartbeatAggregator aggregator;
+    return aggregator;
+  }
+
+  /*!
+   * @if jp
+   * @brief コンシューマのハートビートを集約対象に加える
+   * @else
+   * @brief Adding the heartbeat of a consumer to the aggregation
+   * @endif
+   */
+  void HeartbeatAggregator::join(ComponentObserverConsumer& consumer,
+                                 std::chrono::nanoseconds interval)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto & group : m_groups)
+      {
+        if (group.second.interval != interval) { continue; }
+        try
+          {
+            if (consumer.m_observer._ptr()->
+                _is_equivalent(group.second.observer.in()))
+              {
+                group.second.members.emplace_back(&consumer);
+                return;
+              }
+          }
+        catch (...)
+          {
+          }
+      }
+
+    unsigned long id(m_nextId++);
+    Group& group(m_groups[id]);
+    group.observer =
+      OpenRTM::ComponentObserver::_duplicate(consumer.m_observer._ptr());
+    group.interval = interval;
+    group.members.emplace_back(&consumer);
+    // the task refers to the group by id since it may outlive the group
+    group.task = Manager::instance().addTask([this, id]{ beat(id); },
+                                             interval);
+  }
+
+  /*!
+   * @if jp
+   * @brief コンシューマのハートビートを集約対象から外す
+   * @else
+   * @brief Removing the heartbeat of a consumer from the aggregation
+   * @endif
+   */
+  void HeartbeatAggregator::leave(ComponentObserverConsumer& consumer)
+  {
+    Manager::TaskId task;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      auto it = m_groups.begin();
+      for (; it != m_groups.end(); ++it)
+        {
+          std::vector<ComponentObserverConsumer*>& members(it->second.members);
+          auto member = std::find(members.begin(), members.end(), &consumer);
+          if (member != members.end())
+            {
+              members.erase(member);
+              break;
+            }
+        }
+      if (it == m_groups.end() || !it->second.members.empty()) { return; }
+      task = it->second.task;
+      m_groups.erase(it);
+    }
+    // removeTask() waits for a running beat(), which locks m_mutex
+    Manager::removeTask(task);
+  }
+
+  /*!
+   * @if jp
+   * @brief 集約されたハートビートを送信する
+   * @else
+   * @brief Sending an aggregated heartbeat
+   * @endif
+   */
+  void HeartbeatAggregator::beat(unsigned long id)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_groups.find(id);
+    if (it == m_groups.end() || it->second.members.empty()) { return; }
+
+    std::string names;
+    for (auto & member : it->second.members)
+      {
+        if (!names.empty()) { names += ","; }
+        names += member->m_rtobj->getInstanceName();
+      }
+    // sent by the sender thread of the first member
+    it->second.members.front()->updateStatus(OpenRTM::HEARTBEAT,
+                                             names.c_str());
+  }
+
 
   //============================================================
   // Component status
@@ -28,10 +28,17 @@
 #include <rtm/idl/SDOPackageStub.h>
 #include <ComponentObserverStub.h>
 
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <string>
+#include <thread>
 #include <utility>
 
 namespace RTC
 {
+  class HeartbeatAggregator;
+
 
   /*!
    * @if jp
@@ -41,6 +48,7 @@ namespace RTC
   class ComponentObserverConsumer
     : public SdoServiceConsumerBase
   {
+    friend class HeartbeatAggregator;
   public:
     /*!
      * @if jp
@@ -101,22 +109,58 @@ namespace RTC
     /*!
      * @if jp
      * @brief リモートオブジェクトコール
+     *
+     * 通知をキューに追加し、送信スレッドから非同期に送信する。ブロック
+     * しないため、ECスレッドのリスナから呼び出すことができる。同じ通知
+     * がキュー内にある場合、新しい通知はそれにまとめられる。
+     *
      * @else
      * @brief Calling remote object
+     *
+     * The notification is queued and sent asynchronously by the
+     * sender thread. Since it does not block, it can be called from
+     * listeners on the EC thread. A notification is coalesced with the
+     * same notification waiting in the queue.
+     *
      * @endif
      */
-    inline void updateStatus(OpenRTM::StatusKind statuskind, const char* msg)
-    {
-      std::lock_guard<std::mutex> guard(mutex);
-      try
-        {
-          m_observer->update_status(statuskind, msg);
-        }
-      catch (...)
-        {
-          m_rtobj->removeSdoServiceConsumerStartThread(m_profile.id);
-        }
-    }
+    void updateStatus(OpenRTM::StatusKind statuskind, const char* msg);
+
+    /*!
+     * @if jp
+     * @brief 通知の送信設定を行う
+     * @else
+     * @brief Setting notification sending
+     * @endif
+     */
+    void setNotification(coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 送信スレッドを開始する
+     * @else
+     * @brief Starting the sender thread
+     * @endif
+     */
+    void startSender();
+
+    /*!
+     * @if jp
+     * @brief 送信スレッドを停止する
+     * @else
+     * @brief Stopping the sender thread
+     * @endif
+     */
+    void stopSender();
+
+    /*!
+     * @if jp
+     * @brief 送信スレッドの処理
+     * @else
+     * @brief Body of the sender thread
+     * @endif
+     */
+    void runSender();
 
     /*!
      * @if jp
@@ -578,15 +622,101 @@ namespace RTC
 
     // Heartbeat
     bool m_heartbeat{false};
+    bool m_hbaggregated{false};
     Manager::TaskId m_hbtaskid;
 
     std::mutex mutex;
 
+    // Notification queue
+    struct Notification
+    {
+      OpenRTM::StatusKind kind;
+      std::string msg;
+    };
+    std::deque<Notification> m_queue;
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCond;
+    std::thread m_sender;
+    bool m_stopSender{false};
+    std::chrono::nanoseconds m_batchWindow{0};
+    size_t m_queueLength{256};
+
     std::vector<DataPortAction*> m_recievedactions;
     std::vector<DataPortAction*> m_sendactions;
 
   };
 
+  /*!
+   * @if jp
+   *
+   * @class HeartbeatAggregator
+   * @brief プロセス内のハートビートの集約
+   *
+   * heartbeat.aggregate が YES の ComponentObserverConsumer のハートビー
+   * トを、同じオブザーバと周期ごとにひとつの Manager タイマーにまとめ
+   * る。各周期でオブザーバに対して一回だけ update_status(HEARTBEAT) を
+   * 送信し、hint には生存しているコンポーネントのインスタンス名をカン
+   * マ区切りで列挙する。
+   *
+   * @else
+   *
+   * @class HeartbeatAggregator
+   * @brief Aggregation of heartbeats in a process
+   *
+   * This class gathers the heartbeats of ComponentObserverConsumers
+   * with heartbeat.aggregate=YES into a Manager timer for each
+   * observer and interval. update_status(HEARTBEAT) is sent only once
+   * per interval to an observer, and its hint lists the instance names
+   * of the live components separated by commas.
+   *
+   * @endif
+   */
+  class HeartbeatAggregator
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief インスタンスを取得する
+     * @else
+     * @brief Getting the instance
+     * @endif
+     */
+    static HeartbeatAggregator& instance();
+
+    /*!
+     * @if jp
+     * @brief コンシューマのハートビートを集約対象に加える
+     * @else
+     * @brief Adding the heartbeat of a consumer to the aggregation
+     * @endif
+     */
+    void join(ComponentObserverConsumer& consumer,
+              std::chrono::nanoseconds interval);
+
+    /*!
+     * @if jp
+     * @brief コンシューマのハートビートを集約対象から外す
+     * @else
+     * @brief Removing the heartbeat of a consumer from the aggregation
+     * @endif
+     */
+    void leave(ComponentObserverConsumer& consumer);
+
+  private:
+    struct Group
+    {
+      OpenRTM::ComponentObserver_var observer;
+      std::chrono::nanoseconds interval;
+      std::vector<ComponentObserverConsumer*> members;
+      Manager::TaskId task;
+    };
+    void beat(unsigned long id);
+
+    std::map<unsigned long, Group> m_groups;
+    unsigned long m_nextId{0};
+    std::mutex m_mutex;
+  };
+
 } // namespace RTC
 
 extern "C"
@@ -0,0 +1,55 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  CompressionCodec.cpp
+ * @brief CompressionCodec module
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "CompressionCodec.h"
+#ifdef RTM_HAVE_LZ4
+#include "Lz4Codec.h"
+#endif
+#ifdef RTM_HAVE_ZSTD
+#include "ZstdCodec.h"
+#endif
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void CompressionCodecInit(RTC::Manager* /*manager*/)
+  {
+    RTC::ByteDataCodecFactory& factory(RTC::ByteDataCodecFactory::instance());
+#ifdef RTM_HAVE_LZ4
+    factory.addFactory("lz4",
+                       ::coil::Creator< ::RTC::ByteDataCodec,
+                                        ::RTC::Lz4Codec>,
+                       ::coil::Destructor< ::RTC::ByteDataCodec,
+                                           ::RTC::Lz4Codec>);
+#endif
+#ifdef RTM_HAVE_ZSTD
+    factory.addFactory("zstd",
+                       ::coil::Creator< ::RTC::ByteDataCodec,
+                                        ::RTC::ZstdCodec>,
+                       ::coil::Destructor< ::RTC::ByteDataCodec,
+                                           ::RTC::ZstdCodec>);
+#endif
+    (void)factory;
+  }
+}
@@ -0,0 +1,47 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  CompressionCodec.h
+ * @brief CompressionCodec module
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_COMPRESSIONCODEC_H
+#define RTC_COMPRESSIONCODEC_H
+
+#include <rtm/Manager.h>
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * ビルド時に見つかった圧縮ライブラリのコーデックを "lz4"、"zstd" と
+   * して ByteDataCodecFactory に登録する初期化関数。コネクタの
+   * marshaling_type に "cdr+lz4" のように指定して使用する。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * This function registers the codecs of the compression libraries
+   * found at build time as "lz4" and "zstd" to ByteDataCodecFactory.
+   * They are used by specifying the marshaling_type of a connector such
+   * as "cdr+lz4".
+   *
+   * @endif
+   */
+  DLL_EXPORT void CompressionCodecInit(RTC::Manager* manager);
+}
+
+#endif // RTC_COMPRESSIONCODEC_H
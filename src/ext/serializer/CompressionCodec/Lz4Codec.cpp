@@ -0,0 +1,111 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  Lz4Codec.cpp
+ * @brief Lz4Codec class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "Lz4Codec.h"
+
+#include <coil/stringutil.h>
+
+#include <climits>
+#include <lz4.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  Lz4Codec::Lz4Codec()
+    : m_acceleration(1)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  Lz4Codec::~Lz4Codec() = default;
+
+  /*!
+   * @if jp
+   * @brief 初期化
+   * @else
+   * @brief Initialization
+   * @endif
+   */
+  void Lz4Codec::init(const coil::Properties& prop)
+  {
+    if (!coil::stringTo(m_acceleration,
+                        prop.getProperty("acceleration", "1").c_str()) ||
+        m_acceleration < 1)
+      {
+        m_acceleration = 1;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 圧縮する
+   * @else
+   * @brief Compress data
+   * @endif
+   */
+  bool Lz4Codec::encode(const unsigned char* data, size_t length,
+                        std::vector<unsigned char>& out)
+  {
+    if (length > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) { return false; }
+    int bound(LZ4_compressBound(static_cast<int>(length)));
+    out.resize(static_cast<size_t>(bound));
+    int size(LZ4_compress_fast(reinterpret_cast<const char*>(data),
+                               reinterpret_cast<char*>(out.data()),
+                               static_cast<int>(length), bound,
+                               m_acceleration));
+    if (size <= 0) { return false; }
+    out.resize(static_cast<size_t>(size));
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 伸長する
+   * @else
+   * @brief Decompress data
+   * @endif
+   */
+  bool Lz4Codec::decode(const unsigned char* data, size_t length,
+                        size_t original_length,
+                        std::vector<unsigned char>& out)
+  {
+    if (length > static_cast<size_t>(INT_MAX) ||
+        original_length > static_cast<size_t>(INT_MAX))
+      {
+        return false;
+      }
+    out.resize(original_length);
+    int size(LZ4_decompress_safe(reinterpret_cast<const char*>(data),
+                                 reinterpret_cast<char*>(out.data()),
+                                 static_cast<int>(length),
+                                 static_cast<int>(original_length)));
+    return size >= 0 && static_cast<size_t>(size) == original_length;
+  }
+} // namespace RTC
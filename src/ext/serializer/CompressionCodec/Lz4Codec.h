@@ -0,0 +1,68 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  Lz4Codec.h
+ * @brief Lz4Codec class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_LZ4CODEC_H
+#define RTC_LZ4CODEC_H
+
+#include <rtm/ByteDataCodec.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class Lz4Codec
+   * @brief LZ4 による圧縮コーデック
+   *
+   * "lz4" として登録され、"cdr+lz4" のように使用する。圧縮率よりも速
+   * 度を優先する場合に適している。
+   *
+   * 設定:
+   * - compression.lz4.acceleration: 大きいほど高速で圧縮率が低い
+   *   (デフォルト: 1)
+   *
+   * @else
+   * @class Lz4Codec
+   * @brief Compression codec with LZ4
+   *
+   * This is registered as "lz4" and used as "cdr+lz4". It is suitable
+   * when speed is more important than the compression ratio.
+   *
+   * Configuration:
+   * - compression.lz4.acceleration: Larger is faster with lower
+   *   compression ratio (default: 1)
+   *
+   * @endif
+   */
+  class Lz4Codec : public ByteDataCodec
+  {
+  public:
+    Lz4Codec();
+    ~Lz4Codec() override;
+    void init(const coil::Properties& prop) override;
+    bool encode(const unsigned char* data, size_t length,
+                std::vector<unsigned char>& out) override;
+    bool decode(const unsigned char* data, size_t length,
+                size_t original_length,
+                std::vector<unsigned char>& out) override;
+
+  private:
+    int m_acceleration;
+  };
+} // namespace RTC
+
+#endif // RTC_LZ4CODEC_H
@@ -0,0 +1,109 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  ZstdCodec.cpp
+ * @brief ZstdCodec class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "ZstdCodec.h"
+
+#include <coil/stringutil.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  ZstdCodec::ZstdCodec()
+    : m_cctx(ZSTD_createCCtx()), m_dctx(ZSTD_createDCtx()), m_level(3)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  ZstdCodec::~ZstdCodec()
+  {
+    ZSTD_freeCCtx(m_cctx);
+    ZSTD_freeDCtx(m_dctx);
+  }
+
+  /*!
+   * @if jp
+   * @brief 初期化
+   * @else
+   * @brief Initialization
+   * @endif
+   */
+  void ZstdCodec::init(const coil::Properties& prop)
+  {
+    if (!coil::stringTo(m_level, prop.getProperty("level", "3").c_str()) ||
+        m_level > ZSTD_maxCLevel())
+      {
+        m_level = 3;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 圧縮する
+   * @else
+   * @brief Compress data
+   * @endif
+   */
+  bool ZstdCodec::encode(const unsigned char* data, size_t length,
+                         std::vector<unsigned char>& out)
+  {
+    if (m_cctx == nullptr) { return false; }
+    out.resize(ZSTD_compressBound(length));
+    size_t size(ZSTD_compressCCtx(m_cctx, out.data(), out.size(),
+                                  data, length, m_level));
+    if (ZSTD_isError(size) != 0) { return false; }
+    out.resize(size);
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 伸長する
+   * @else
+   * @brief Decompress data
+   * @endif
+   */
+  bool ZstdCodec::decode(const unsigned char* data, size_t length,
+                         size_t original_length,
+                         std::vector<unsigned char>& out)
+  {
+    if (m_dctx == nullptr) { return false; }
+    // the frame header must agree with the length before allocating
+    unsigned long long content(ZSTD_getFrameContentSize(data, length));
+    if (content == ZSTD_CONTENTSIZE_ERROR ||
+        (content != ZSTD_CONTENTSIZE_UNKNOWN && content != original_length))
+      {
+        return false;
+      }
+    out.resize(original_length);
+    size_t size(ZSTD_decompressDCtx(m_dctx, out.data(), out.size(),
+                                    data, length));
+    return ZSTD_isError(size) == 0 && size == original_length;
+  }
+} // namespace RTC
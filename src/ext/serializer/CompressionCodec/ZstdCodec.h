@@ -0,0 +1,73 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  ZstdCodec.h
+ * @brief ZstdCodec class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_ZSTDCODEC_H
+#define RTC_ZSTDCODEC_H
+
+#include <rtm/ByteDataCodec.h>
+
+#include <zstd.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class ZstdCodec
+   * @brief Zstandard による圧縮コーデック
+   *
+   * "zstd" として登録され、"cdr+zstd" のように使用する。LZ4 より低速
+   * だが圧縮率が高く、帯域の狭い通信路に適している。圧縮・伸長のコン
+   * テキストはデータ毎に再利用する。
+   *
+   * 設定:
+   * - compression.zstd.level: 圧縮レベル (デフォルト: 3)
+   *
+   * @else
+   * @class ZstdCodec
+   * @brief Compression codec with Zstandard
+   *
+   * This is registered as "zstd" and used as "cdr+zstd". It is slower
+   * than LZ4 but has higher compression ratio, and is suitable for
+   * narrow links. The compression and decompression contexts are
+   * reused for each data.
+   *
+   * Configuration:
+   * - compression.zstd.level: Compression level (default: 3)
+   *
+   * @endif
+   */
+  class ZstdCodec : public ByteDataCodec
+  {
+  public:
+    ZstdCodec();
+    ~ZstdCodec() override;
+    void init(const coil::Properties& prop) override;
+    bool encode(const unsigned char* data, size_t length,
+                std::vector<unsigned char>& out) override;
+    bool decode(const unsigned char* data, size_t length,
+                size_t original_length,
+                std::vector<unsigned char>& out) override;
+
+  private:
+    ZSTD_CCtx* m_cctx;
+    ZSTD_DCtx* m_dctx;
+    int m_level;
+  };
+} // namespace RTC
+
+#endif // RTC_ZSTDCODEC_H
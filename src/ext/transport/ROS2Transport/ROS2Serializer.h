@@ -25,6 +25,11 @@
 #include <rmw_fastrtps_cpp/TypeSupport.hpp>
 #include <fastcdr/FastBuffer.h>
 #include <fastcdr/Cdr.h>
+#include <fastcdr/exceptions/Exception.h>
+#include <fastcdr/exceptions/NotEnoughMemoryException.h>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #if (STD_MSGS_VERSION_MAJOR >= 2)
 #include <std_msgs/msg/detail/float32__rosidl_typesupport_fastrtps_cpp.hpp>
@@ -93,6 +98,11 @@ namespace RTC
    *
    * @brief ROS2シリアライザ基底クラス
    *
+   * FastCDR は再利用するバッファに直接シリアライズし、バッファは
+   * getSharedBuffer() でコネクタの ByteData とコピーせずに共有される。
+   * バッファの大きさは前回のデータ長から決め、足りない場合は倍にして
+   * シリアライズし直す。受信側では referData() で受信バッファを参照し、
+   * コピーせずにデシリアライズする。
    *
    * @since 2.0.0
    *
@@ -100,8 +110,14 @@ namespace RTC
    *
    * @class ROS2SerializerBase
    *
-   * @brief 
+   * @brief Base class of ROS2 serializers
    *
+   * FastCDR serializes directly into a reused buffer, which is shared
+   * with the ByteData of the connector by getSharedBuffer() without
+   * copying. The buffer is sized from the previous data length and
+   * doubled to serialize again if it is not enough. On the receiving
+   * side, referData() refers to the received buffer and the data are
+   * deserialized without copying.
    *
    * @since 2.0.0
    *
@@ -122,9 +138,7 @@ namespace RTC
      *
      * @endif
      */
-    ROS2SerializerBase(){
-      m_message.reserve(2147483647);
-    }
+    ROS2SerializerBase() = default;
 
     /*!
      * @if jp
@@ -160,11 +174,44 @@ namespace RTC
      */
     void writeData(const unsigned char* buffer, unsigned long length) override
     {
-      m_message.reserve(length);
-      m_message.length = length;
-      m_message.max_size = length;
-      m_message.data = new eprosima::fastrtps::rtps::octet[length];
-      memcpy(m_message.data, buffer, length);
+      m_current.reset();
+      size_t capacity(length);
+      std::shared_ptr<unsigned char> buffer_(acquire(capacity));
+      memcpy(buffer_.get(), buffer, length);
+      m_current = buffer_;
+      m_data = buffer_.get();
+      m_length = length;
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 外部のバッファをコピーせずに参照する
+     * 
+     * 受信したバッファを参照し、デシリアライズ時にそのまま読み出す。
+     * 
+     * @param buffer 参照するバッファ
+     * @param length データの長さ
+     * 
+     *
+     * @else
+     *
+     * @brief Refer to an external buffer without copying
+     * 
+     * The received buffer is referred to and read in place when
+     * deserializing.
+     * 
+     * @param buffer Buffer to refer to
+     * @param length Data length
+     * 
+     *
+     * @endif
+     */
+    void referData(const unsigned char* buffer, unsigned long length) override
+    {
+      m_current.reset();
+      m_data = buffer;
+      m_length = length;
     }
 
     /*!
@@ -188,7 +235,8 @@ namespace RTC
      */
     void readData(unsigned char* buffer, unsigned long length) const override
     {
-      memcpy(buffer, m_message.data, length);
+      if (m_data == nullptr || length > m_length) { return; }
+      memcpy(buffer, m_data, length);
     }
     /*!
      * @if jp
@@ -209,7 +257,28 @@ namespace RTC
      */
     unsigned long getDataLength() const override
     {
-      return m_message.length;
+      return m_length;
+    }
+    /*!
+     * @if jp
+     *
+     * @brief シリアライズ済みのバッファを取得
+     * 
+     * @return バッファ。外部のバッファを参照している場合は空
+     * 
+     *
+     * @else
+     *
+     * @brief Get the serialized buffer
+     * 
+     * @return Buffer, or empty if referring to an external buffer
+     * 
+     *
+     * @endif
+     */
+    std::shared_ptr<unsigned char> getSharedBuffer() const override
+    {
+      return m_current;
     }
     /*!
      * @if jp
@@ -275,19 +344,8 @@ namespace RTC
     template <class MessageType>
     bool stdmsg_serialize(const MessageType& msg)
     {
-      
-      eprosima::fastcdr::FastBuffer fastbuffer((char*) m_message.data, m_message.max_size);
-      eprosima::fastcdr::Cdr ser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
-                eprosima::fastcdr::DDS_CDR);
-      m_message.encapsulation = ser.endianness() == eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
-      ser.serialize_encapsulation();
-
-      std_msgs::msg::typesupport_fastrtps_cpp::cdr_serialize(msg, ser);
-
-      m_message.length = (uint32_t)ser.get_serialized_data_length();
-
-      
-      return true;
+      return serializeCdr([&msg](eprosima::fastcdr::Cdr& ser)
+        { return std_msgs::msg::typesupport_fastrtps_cpp::cdr_serialize(msg, ser); });
     }
     /*!
      * @if jp
@@ -308,21 +366,9 @@ namespace RTC
      */
     template <class MessageType>
     bool stdmsg_deserialize(MessageType& msg)
-    { 
-
-
-      eprosima::fastcdr::FastBuffer fastbuffer((char*)m_message.data, m_message.length);
-      eprosima::fastcdr::Cdr deser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
-                eprosima::fastcdr::DDS_CDR); // Object that deserializes the data.
-      
-      deser.read_encapsulation();
-      
-      m_message.encapsulation = deser.endianness() == eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
-
-      std_msgs::msg::typesupport_fastrtps_cpp::cdr_deserialize(deser, msg);
-
-
-      return true;
+    {
+      return deserializeCdr([&msg](eprosima::fastcdr::Cdr& deser)
+        { return std_msgs::msg::typesupport_fastrtps_cpp::cdr_deserialize(deser, msg); });
     }
 
     /*!
@@ -345,19 +391,8 @@ namespace RTC
     template <class MessageType>
     bool geometrymsg_serialize(const MessageType& msg)
     {
-      
-      eprosima::fastcdr::FastBuffer fastbuffer((char*) m_message.data, m_message.max_size);
-      eprosima::fastcdr::Cdr ser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
-                eprosima::fastcdr::DDS_CDR);
-      m_message.encapsulation = ser.endianness() == eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
-      ser.serialize_encapsulation();
-
-      geometry_msgs::msg::typesupport_fastrtps_cpp::cdr_serialize(msg, ser);
-
-      m_message.length = (uint32_t)ser.get_serialized_data_length();
-
-      
-      return true;
+      return serializeCdr([&msg](eprosima::fastcdr::Cdr& ser)
+        { return geometry_msgs::msg::typesupport_fastrtps_cpp::cdr_serialize(msg, ser); });
     }
     
     /*!
@@ -379,21 +414,9 @@ namespace RTC
      */
     template <class MessageType>
     bool geometrymsg_deserialize(MessageType& msg)
-    { 
-
-
-      eprosima::fastcdr::FastBuffer fastbuffer((char*)m_message.data, m_message.length);
-      eprosima::fastcdr::Cdr deser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
-                eprosima::fastcdr::DDS_CDR); // Object that deserializes the data.
-      
-      deser.read_encapsulation();
-      
-      m_message.encapsulation = deser.endianness() == eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
-
-      geometry_msgs::msg::typesupport_fastrtps_cpp::cdr_deserialize(deser, msg);
-
-
-      return true;
+    {
+      return deserializeCdr([&msg](eprosima::fastcdr::Cdr& deser)
+        { return geometry_msgs::msg::typesupport_fastrtps_cpp::cdr_deserialize(deser, msg); });
     }
 
     /*!
@@ -416,19 +439,8 @@ namespace RTC
     template <class MessageType>
     bool sensormsg_serialize(const MessageType& msg)
     {
-      
-      eprosima::fastcdr::FastBuffer fastbuffer((char*) m_message.data, m_message.max_size);
-      eprosima::fastcdr::Cdr ser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
-                eprosima::fastcdr::DDS_CDR);
-      m_message.encapsulation = ser.endianness() == eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
-      ser.serialize_encapsulation();
-
-      sensor_msgs::msg::typesupport_fastrtps_cpp::cdr_serialize(msg, ser);
-
-      m_message.length = (uint32_t)ser.get_serialized_data_length();
-
-      
-      return true;
+      return serializeCdr([&msg](eprosima::fastcdr::Cdr& ser)
+        { return sensor_msgs::msg::typesupport_fastrtps_cpp::cdr_serialize(msg, ser); });
     }
     
     /*!
@@ -450,25 +462,150 @@ namespace RTC
      */
     template <class MessageType>
     bool sensormsg_deserialize(MessageType& msg)
-    { 
+    {
+      return deserializeCdr([&msg](eprosima::fastcdr::Cdr& deser)
+        { return sensor_msgs::msg::typesupport_fastrtps_cpp::cdr_deserialize(deser, msg); });
+    }
 
+  private:
+    /*!
+     * @if jp
+     *
+     * @brief capacity 以上の大きさの再利用可能なバッファを取得する
+     *
+     * 他から参照されていないバッファを再利用し、なければ新たに確保す
+     * る。capacity には取得したバッファの大きさが入る。
+     *
+     * @else
+     *
+     * @brief Get a reusable buffer of capacity or larger
+     *
+     * A buffer not referred to by others is reused, otherwise a new
+     * one is allocated. capacity is set to the size of the buffer.
+     *
+     * @endif
+     */
+    std::shared_ptr<unsigned char> acquire(size_t& capacity)
+    {
+      Buffer* victim(nullptr);
+      for (auto & buffer : m_buffers)
+      {
+        // only this serializer refers to it
+        if (buffer.first.use_count() != 1) { continue; }
+        if (buffer.second >= capacity)
+        {
+          capacity = buffer.second;
+          return buffer.first;
+        }
+        victim = &buffer;
+      }
 
-      eprosima::fastcdr::FastBuffer fastbuffer((char*)m_message.data, m_message.length);
-      eprosima::fastcdr::Cdr deser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
-                eprosima::fastcdr::DDS_CDR); // Object that deserializes the data.
-      
-      deser.read_encapsulation();
-      
-      m_message.encapsulation = deser.endianness() == eprosima::fastcdr::Cdr::BIG_ENDIANNESS ? CDR_BE : CDR_LE;
+      std::shared_ptr<unsigned char> buffer(new unsigned char[capacity],
+                                            std::default_delete<unsigned char[]>());
+      if (victim == nullptr)
+      {
+        if (m_buffers.size() < max_buffers)
+        {
+          m_buffers.emplace_back();
+          victim = &m_buffers.back();
+        }
+        else
+        {
+          victim = &m_buffers[m_next];
+          m_next = (m_next + 1) % max_buffers;
+        }
+      }
+      victim->first = buffer;
+      victim->second = capacity;
+      return buffer;
+    }
 
-      sensor_msgs::msg::typesupport_fastrtps_cpp::cdr_deserialize(deser, msg);
+    /*!
+     * @if jp
+     *
+     * @brief FastCDR でバッファに直接シリアライズする
+     *
+     * @else
+     *
+     * @brief Serialize directly into a buffer with FastCDR
+     *
+     * @endif
+     */
+    template <class Function>
+    bool serializeCdr(Function func)
+    {
+      m_current.reset();
+      m_data = nullptr;
+      m_length = 0;
 
+      size_t capacity(m_lastLength + m_lastLength / 4 + 64);
+      for (;;)
+      {
+        std::shared_ptr<unsigned char> buffer(acquire(capacity));
+        eprosima::fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(buffer.get()), capacity);
+        eprosima::fastcdr::Cdr ser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
+                  eprosima::fastcdr::DDS_CDR);
+        try
+        {
+          ser.serialize_encapsulation();
+          if (!func(ser)) { return false; }
+        }
+        catch (eprosima::fastcdr::exception::NotEnoughMemoryException&)
+        {
+          if (capacity > max_payload / 2) { return false; }
+          capacity *= 2;
+          continue;
+        }
+
+        m_current = buffer;
+        m_data = buffer.get();
+        m_length = static_cast<unsigned long>(ser.get_serialized_data_length());
+        m_lastLength = m_length;
+        return true;
+      }
+    }
 
-      return true;
+    /*!
+     * @if jp
+     *
+     * @brief FastCDR でバッファからそのままデシリアライズする
+     *
+     * @else
+     *
+     * @brief Deserialize in place from the buffer with FastCDR
+     *
+     * @endif
+     */
+    template <class Function>
+    bool deserializeCdr(Function func)
+    {
+      if (m_data == nullptr) { return false; }
+
+      // FastCDR only reads the buffer when deserializing
+      eprosima::fastcdr::FastBuffer fastbuffer(
+        reinterpret_cast<char*>(const_cast<unsigned char*>(m_data)), m_length);
+      eprosima::fastcdr::Cdr deser(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN,
+                eprosima::fastcdr::DDS_CDR); // Object that deserializes the data.
+      try
+      {
+        deser.read_encapsulation();
+        return func(deser);
+      }
+      catch (eprosima::fastcdr::exception::Exception&)
+      {
+        return false;
+      }
     }
 
-  protected:
-    eprosima::fastrtps::rtps::SerializedPayload_t m_message;
+    using Buffer = std::pair<std::shared_ptr<unsigned char>, size_t>;
+    static const size_t max_buffers = 4;
+    static const size_t max_payload = 2147483647;
+    std::vector<Buffer> m_buffers;
+    size_t m_next{0};
+    std::shared_ptr<unsigned char> m_current;
+    const unsigned char* m_data{nullptr};
+    unsigned long m_length{0};
+    unsigned long m_lastLength{0};
   };
 
   template <class DataType>
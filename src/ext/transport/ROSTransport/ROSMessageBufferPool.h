@@ -0,0 +1,194 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  ROSMessageBufferPool.h
+ * @brief ROS message buffer pool class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *
+ *     All rights reserved.
+ *
+ *
+ */
+
+#ifndef RTC_ROSMESSAGEBUFFERPOOL_H
+#define RTC_ROSMESSAGEBUFFERPOOL_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   *
+   * @class ROSMessageBufferPool
+   *
+   * @brief シリアライズ済みROSメッセージのバッファプール
+   *
+   * allocate() は参照カウント付きのバッファを返す。バッファは参照がす
+   * べてなくなった時、すなわちシリアライザが次のデータに移り、全ての
+   * SubscriberLink の送信が完了した時にプールに戻り、次のデータで再利
+   * 用される。プールに保持するバッファは max_free 個までとする。
+   *
+   * バッファはプール自身への参照を持つため、プールはシリアライザより
+   * 後まで、最後のバッファが戻るまで存続する。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   *
+   * @class ROSMessageBufferPool
+   *
+   * @brief Buffer pool of serialized ROS messages
+   *
+   * allocate() returns a reference counted buffer. The buffer returns
+   * to the pool when all references are gone, that is, when the
+   * serializer has moved to the next data and all SubscriberLinks have
+   * finished sending it, and is reused for later data. Up to max_free
+   * buffers are kept in the pool.
+   *
+   * Since the buffers refer to the pool, the pool outlives the
+   * serializer until the last buffer returns.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class ROSMessageBufferPool
+    : public std::enable_shared_from_this<ROSMessageBufferPool>
+  {
+  public:
+    /*!
+     * @if jp
+     *
+     * @brief コンストラクタ
+     *
+     * @param max_free プールに保持するバッファの最大数
+     *
+     * @else
+     *
+     * @brief Constructor
+     *
+     * @param max_free Maximum number of buffers kept in the pool
+     *
+     * @endif
+     */
+    explicit ROSMessageBufferPool(size_t max_free = 4)
+      : m_maxFree(max_free)
+    {
+    }
+    /*!
+     * @if jp
+     *
+     * @brief デストラクタ
+     *
+     * @else
+     *
+     * @brief Destructor
+     *
+     * @endif
+     */
+    ~ROSMessageBufferPool()
+    {
+      for (auto & buffer : m_free)
+      {
+        delete[] buffer.second;
+      }
+    }
+    ROSMessageBufferPool(const ROSMessageBufferPool&) = delete;
+    ROSMessageBufferPool& operator=(const ROSMessageBufferPool&) = delete;
+
+    /*!
+     * @if jp
+     *
+     * @brief バッファを取得する
+     *
+     * size 以上、かつ大きすぎない容量のバッファがプールにあればそれを
+     * 返し、なければ新たに確保する。std::shared_ptr で管理されたプール
+     * から呼び出さなければならない。
+     *
+     * @param size 必要なサイズ
+     * @return バッファ
+     *
+     * @else
+     *
+     * @brief Get a buffer
+     *
+     * A pooled buffer is returned if its capacity is size or more and
+     * not too large, otherwise a new one is allocated. This must be
+     * called on a pool managed by std::shared_ptr.
+     *
+     * @param size Required size
+     * @return Buffer
+     *
+     * @endif
+     */
+    std::shared_ptr<unsigned char> allocate(size_t size)
+    {
+      unsigned char* buffer(nullptr);
+      size_t capacity(0);
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto it = m_free.lower_bound(size);
+        if (it != m_free.end() && it->first <= size * 2 + alignment)
+        {
+          capacity = it->first;
+          buffer = it->second;
+          m_free.erase(it);
+        }
+      }
+      if (buffer == nullptr)
+      {
+        capacity = (size + alignment - 1) / alignment * alignment;
+        if (capacity == 0) { capacity = alignment; }
+        buffer = new unsigned char[capacity];
+      }
+
+      std::shared_ptr<ROSMessageBufferPool> pool(shared_from_this());
+      return std::shared_ptr<unsigned char>(buffer,
+        [pool, capacity](unsigned char* p) { pool->release(p, capacity); });
+    }
+
+  private:
+    /*!
+     * @if jp
+     *
+     * @brief 参照がなくなったバッファをプールに戻す
+     *
+     * @else
+     *
+     * @brief Return a buffer with no more references to the pool
+     *
+     * @endif
+     */
+    void release(unsigned char* buffer, size_t capacity)
+    {
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (m_free.size() < m_maxFree)
+        {
+          m_free.emplace(capacity, buffer);
+          return;
+        }
+      }
+      delete[] buffer;
+    }
+
+    static const size_t alignment = 64;
+    std::mutex m_mutex;
+    std::multimap<size_t, unsigned char*> m_free;
+    size_t m_maxFree;
+  };
+}
+
+
+#endif // RTC_ROSMESSAGEBUFFERPOOL_H
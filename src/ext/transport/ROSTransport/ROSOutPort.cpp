@@ -202,8 +202,20 @@ namespace RTC
       {
         size_t length = (size_t)data.getDataLength();
         m_message_data_sent += static_cast<uint64_t>(length);
-        boost::shared_array<uint8_t> buffer(new uint8_t[length]);
-        memcpy(buffer.get(), data.getBuffer(), length);
+        // The buffer serialized by ROSSerializerBase is shared with all
+        // links without copying and returns to its pool after all of
+        // them have been written.
+        std::shared_ptr<unsigned char> shared(data.getSharedBuffer());
+        boost::shared_array<uint8_t> buffer;
+        if (shared)
+        {
+          buffer = boost::shared_array<uint8_t>(shared.get(), [shared](uint8_t*) {});
+        }
+        else
+        {
+          buffer.reset(new uint8_t[length]);
+          memcpy(buffer.get(), data.getBuffer(), length);
+        }
 
         RTC_VERBOSE(("Data size:%d", length));
         
@@ -226,7 +226,7 @@ namespace RTC
       std_msgs::String msg;
       msg.data = data.data;
       
-      ROSSerializerBase<RTC::TimedString>::m_message = ros::serialization::serializeMessage<std_msgs::String>(msg);
+      ROSSerializerBase<RTC::TimedString>::serializeMessage(msg);
 
       return true;
     }
@@ -353,7 +353,7 @@ namespace RTC
       msg.point.y = data.data.y;
       msg.point.z = data.data.z;
       
-      ROSSerializerBase<RTC::TimedPoint3D>::m_message = ros::serialization::serializeMessage<geometry_msgs::PointStamped>(msg);
+      ROSSerializerBase<RTC::TimedPoint3D>::serializeMessage(msg);
 
       return true;
     }
@@ -488,7 +488,7 @@ namespace RTC
       msg.quaternion.z = data.data.z;
       msg.quaternion.w = data.data.w;
       
-      ROSSerializerBase<RTC::TimedQuaternion>::m_message = ros::serialization::serializeMessage<geometry_msgs::QuaternionStamped>(msg);
+      ROSSerializerBase<RTC::TimedQuaternion>::serializeMessage(msg);
 
       return true;
     }
@@ -624,7 +624,7 @@ namespace RTC
       msg.vector.z = data.data.z;
 
       
-      ROSSerializerBase<RTC::TimedVector3D>::m_message = ros::serialization::serializeMessage<geometry_msgs::Vector3Stamped>(msg);
+      ROSSerializerBase<RTC::TimedVector3D>::serializeMessage(msg);
 
       return true;
     }
@@ -784,7 +784,7 @@ namespace RTC
       }
       */
       
-      ROSSerializerBase<RTC::CameraImage>::m_message = ros::serialization::serializeMessage<sensor_msgs::Image>(m_msg);
+      ROSSerializerBase<RTC::CameraImage>::serializeMessage(m_msg);
 
       return true;
     }
@@ -24,6 +24,7 @@
 #include <rtm/Manager.h>
 #include <ros/serialization.h>
 #include "ROSMessageInfo.h"
+#include "ROSMessageBufferPool.h"
 
 
 namespace RTC
@@ -35,6 +36,10 @@ namespace RTC
    *
    * @brief ROSシリアライザ基底クラス
    *
+   * シリアライズ結果は ROSMessageBufferPool から取得したバッファに直接
+   * 書き込まれ、getSharedBuffer() で共有される。ROSOutPort はこのバッ
+   * ファをコピーせずに各 SubscriberLink に渡し、全ての送信が完了すると
+   * バッファはプールに戻って再利用される。
    *
    * @since 2.0.0
    *
@@ -42,7 +47,13 @@ namespace RTC
    *
    * @class ROSSerializerBase
    *
-   * @brief 
+   * @brief Base class of ROS serializers
+   *
+   * The serialized data are written directly into a buffer taken from
+   * ROSMessageBufferPool and shared by getSharedBuffer(). ROSOutPort
+   * passes the buffer to the SubscriberLinks without copying, and the
+   * buffer returns to the pool to be reused when all of them have been
+   * sent.
    *
    *
    * @since 2.0.0
@@ -64,7 +75,10 @@ namespace RTC
      *
      * @endif
      */
-    ROSSerializerBase() = default;
+    ROSSerializerBase()
+      : m_pool(std::make_shared<ROSMessageBufferPool>())
+    {
+    }
     /*!
      * @if jp
      *
@@ -99,11 +113,11 @@ namespace RTC
      */
     void writeData(const unsigned char* buffer, unsigned long length) override
     {
-      boost::shared_array<uint8_t> buffer_(new uint8_t[length]);
+      std::shared_ptr<unsigned char> buffer_(m_pool->allocate(length));
 
       memcpy(buffer_.get(), buffer, length);
 
-      m_message = ros::SerializedMessage(buffer_, length);
+      setMessage(buffer_, length);
       m_message.message_start = buffer_.get()+4;
 
     }
@@ -152,6 +166,27 @@ namespace RTC
     {
       return static_cast<unsigned long>(m_message.num_bytes);
     }
+    /*!
+     * @if jp
+     *
+     * @brief シリアライズ済みのバッファを取得
+     * 
+     * @return バッファ
+     * 
+     *
+     * @else
+     *
+     * @brief Get the serialized buffer
+     * 
+     * @return Buffer
+     * 
+     *
+     * @endif
+     */
+    std::shared_ptr<unsigned char> getSharedBuffer() const override
+    {
+      return m_buffer;
+    }
     /*!
      * @if jp
      *
@@ -198,7 +233,54 @@ namespace RTC
     }
 
   protected:
+    /*!
+     * @if jp
+     *
+     * @brief メッセージをプールのバッファに直接シリアライズする
+     *
+     * ros::serialization::serializeMessage() と同じ形式 (長さ 4 バイ
+     * トとメッセージ) で書き込む。
+     * 
+     * @param msg ROSメッセージ
+     *
+     * @else
+     *
+     * @brief Serialize a message directly into a buffer of the pool
+     *
+     * The format is the same as ros::serialization::serializeMessage(),
+     * a 4-byte length followed by the message.
+     * 
+     * @param msg ROS message
+     *
+     * @endif
+     */
+    template <class MessageType>
+    void serializeMessage(const MessageType& msg)
+    {
+      uint32_t len = ros::serialization::serializationLength(msg);
+      size_t num_bytes = static_cast<size_t>(len) + 4;
+      std::shared_ptr<unsigned char> buffer(m_pool->allocate(num_bytes));
+
+      ros::serialization::OStream s(buffer.get(), static_cast<uint32_t>(num_bytes));
+      ros::serialization::serialize(s, len);
+      setMessage(buffer, num_bytes);
+      m_message.message_start = s.getData();
+      ros::serialization::serialize(s, msg);
+    }
+
     ros::SerializedMessage m_message;
+
+  private:
+    void setMessage(const std::shared_ptr<unsigned char>& buffer, size_t length)
+    {
+      m_buffer = buffer;
+      m_message = ros::SerializedMessage(
+        boost::shared_array<uint8_t>(buffer.get(), [buffer](uint8_t*) {}),
+        length);
+    }
+
+    std::shared_ptr<ROSMessageBufferPool> m_pool;
+    std::shared_ptr<unsigned char> m_buffer;
   };
 
 
@@ -275,7 +357,7 @@ namespace RTC
       MessageType msg;
       msg.data = static_cast<convertedType>(data.data);
       
-      ROSSerializerBase<DataType>::m_message = ros::serialization::serializeMessage<MessageType>(msg);
+      ROSSerializerBase<DataType>::serializeMessage(msg);
 
       return true;
     }
@@ -385,7 +467,7 @@ namespace RTC
       }
       
       
-      ROSSerializerBase<DataType>::m_message = ros::serialization::serializeMessage<MessageType>(msg);
+      ROSSerializerBase<DataType>::serializeMessage(msg);
 
       return true;
     }
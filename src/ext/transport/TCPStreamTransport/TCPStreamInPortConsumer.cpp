@@ -0,0 +1,361 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamInPortConsumer.cpp
+ * @brief TCPStreamInPortConsumer class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "TCPStreamInPortConsumer.h"
+
+#include <rtm/NVUtil.h>
+#include <coil/stringutil.h>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace RTC
+{
+  using Clock = std::chrono::steady_clock;
+
+  /*!
+   * @if jp
+   * @brief 期限までソケットが書き込み可能になるのを待つ
+   * @else
+   * @brief Wait until the socket becomes writable by the deadline
+   * @endif
+   */
+  static bool waitWritable(int fd, Clock::time_point deadline)
+  {
+    for (;;)
+      {
+        auto remaining(std::chrono::duration_cast<std::chrono::milliseconds>(
+                         deadline - Clock::now()));
+        if (remaining <= std::chrono::milliseconds::zero()) { return false; }
+        pollfd pfd{};
+        pfd.fd = fd;
+        pfd.events = POLLOUT;
+        // rounded up not to spin for the last millisecond
+        int ret(::poll(&pfd, 1, static_cast<int>(remaining.count()) + 1));
+        if (ret > 0) { return true; }
+        if (ret < 0 && errno != EINTR) { return false; }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  TCPStreamInPortConsumer::TCPStreamInPortConsumer()
+    : rtclog("TCPStreamInPortConsumer")
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  TCPStreamInPortConsumer::~TCPStreamInPortConsumer()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    close();
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void TCPStreamInPortConsumer::init(coil::Properties& prop)
+  {
+    RTC_TRACE(("init()"));
+    unsigned int timeout(1000);
+    if (!coil::stringTo(timeout,
+                        prop.getProperty("tcp_stream.send_timeout", "1000").c_str()))
+      {
+        RTC_WARN(("Invalid tcp_stream.send_timeout: %s",
+                  prop["tcp_stream.send_timeout"].c_str()));
+        timeout = 1000;
+      }
+    m_sendTimeout = std::chrono::milliseconds(timeout);
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続先へのデータ送信
+   *
+   * 長さのヘッダとデータを一つの sendmsg() で送信する。
+   *
+   * @else
+   * @brief Send data to the destination port
+   *
+   * The length header and the data are sent by one sendmsg().
+   *
+   * @endif
+   */
+  DataPortStatus TCPStreamInPortConsumer::put(ByteData& data)
+  {
+    RTC_PARANOID(("put()"));
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_fd < 0) { return DataPortStatus::CONNECTION_LOST; }
+
+    uint32_t header(htonl(static_cast<uint32_t>(data.getDataLength())));
+    iovec iov[2];
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = data.getBuffer();
+    iov[1].iov_len = data.getDataLength();
+    return send(iov, iov[1].iov_len > 0 ? 2 : 1);
+  }
+
+  /*!
+   * @if jp
+   * @brief InterfaceProfile情報を公開する
+   * @else
+   * @brief Publish InterfaceProfile information
+   * @endif
+   */
+  void TCPStreamInPortConsumer::
+  publishInterfaceProfile(SDOPackage::NVList& /*properties*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief データ送信通知への登録
+   * @else
+   * @brief Subscribe to the data sending notification
+   * @endif
+   */
+  bool TCPStreamInPortConsumer::
+  subscribeInterface(const SDOPackage::NVList& properties)
+  {
+    RTC_TRACE(("subscribeInterface()"));
+    RTC_DEBUG_STR((NVUtil::toString(properties)));
+
+    CORBA::Long index(NVUtil::find_index(properties,
+                                         "dataport.tcp_stream.inport_addr"));
+    if (index < 0)
+      {
+        RTC_ERROR(("dataport.tcp_stream.inport_addr not found."));
+        return false;
+      }
+    const char* endpoint(nullptr);
+    if (!(properties[index].value >>= endpoint))
+      {
+        RTC_ERROR(("dataport.tcp_stream.inport_addr is not a string."));
+        return false;
+      }
+    // a provider without the token does not expect it
+    std::string token;
+    index = NVUtil::find_index(properties, "dataport.tcp_stream.token");
+    const char* value(nullptr);
+    if (index >= 0 && (properties[index].value >>= value))
+      {
+        token = value;
+      }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    close();
+    return connect(endpoint, token);
+  }
+
+  /*!
+   * @if jp
+   * @brief データ送信通知からの登録解除
+   * @else
+   * @brief Unsubscribe the data send notification
+   * @endif
+   */
+  void TCPStreamInPortConsumer::
+  unsubscribeInterface(const SDOPackage::NVList& /*properties*/)
+  {
+    RTC_TRACE(("unsubscribeInterface()"));
+    std::lock_guard<std::mutex> guard(m_mutex);
+    close();
+  }
+
+  //----------------------------------------------------------------------
+  // private functions
+
+  /*!
+   * @if jp
+   * @brief 期限までにデータを全て送信する
+   *
+   * 部分的に書き込まれた場合は残りを送信する。
+   *
+   * @else
+   * @brief Send all the data by the deadline
+   *
+   * The rest is sent when the data are partially written.
+   *
+   * @endif
+   */
+  DataPortStatus TCPStreamInPortConsumer::send(iovec* iov, size_t count)
+  {
+    Clock::time_point deadline(Clock::now() + m_sendTimeout);
+    bool partial(false);
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+    while (msg.msg_iovlen > 0)
+      {
+        ssize_t ret(::sendmsg(m_fd, &msg, MSG_NOSIGNAL));
+        if (ret < 0)
+          {
+            if (errno == EINTR) { continue; }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+              {
+                if (waitWritable(m_fd, deadline)) { continue; }
+                if (!partial)
+                  {
+                    RTC_WARN(("tcp_stream send timed out."));
+                    return DataPortStatus::SEND_TIMEOUT;
+                  }
+                // the rest of the frame cannot be sent later
+                RTC_ERROR(("tcp_stream send timed out in a frame."));
+                close();
+                return DataPortStatus::SEND_TIMEOUT;
+              }
+            RTC_ERROR(("sendmsg() failed: %s", std::strerror(errno)));
+            close();
+            return DataPortStatus::CONNECTION_LOST;
+          }
+        partial = true;
+        // skip the written part
+        size_t written(static_cast<size_t>(ret));
+        while (msg.msg_iovlen > 0 && written >= msg.msg_iov->iov_len)
+          {
+            written -= msg.msg_iov->iov_len;
+            ++msg.msg_iov;
+            --msg.msg_iovlen;
+          }
+        if (msg.msg_iovlen > 0)
+          {
+            msg.msg_iov->iov_base =
+              static_cast<char*>(msg.msg_iov->iov_base) + written;
+            msg.msg_iov->iov_len -= written;
+          }
+      }
+    return DataPortStatus::PORT_OK;
+  }
+
+  /*!
+   * @if jp
+   * @brief "host:port" 形式のアドレスに接続し、トークンを送信する
+   * @else
+   * @brief Connect to the address in the form of "host:port" and send
+   *        the token
+   * @endif
+   */
+  bool TCPStreamInPortConsumer::connect(const std::string& endpoint,
+                                        const std::string& token)
+  {
+    std::string::size_type pos(endpoint.rfind(':'));
+    if (pos == std::string::npos)
+      {
+        RTC_ERROR(("Invalid tcp_stream address: %s", endpoint.c_str()));
+        return false;
+      }
+    std::string host(endpoint.substr(0, pos));
+    std::string port(endpoint.substr(pos + 1));
+
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* res(nullptr);
+    int err(::getaddrinfo(host.c_str(), port.c_str(), &hints, &res));
+    if (err != 0)
+      {
+        RTC_ERROR(("getaddrinfo(%s) failed: %s",
+                   endpoint.c_str(), ::gai_strerror(err)));
+        return false;
+      }
+
+    Clock::time_point deadline(Clock::now() + m_sendTimeout);
+    for (addrinfo* ai(res); ai != nullptr; ai = ai->ai_next)
+      {
+        int fd(::socket(ai->ai_family,
+                        ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                        ai->ai_protocol));
+        if (fd < 0) { continue; }
+        int ret(::connect(fd, ai->ai_addr, ai->ai_addrlen));
+        if (ret != 0 && errno == EINPROGRESS && waitWritable(fd, deadline))
+          {
+            int error(0);
+            socklen_t len(sizeof(error));
+            ret = ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len) == 0
+              && error == 0 ? 0 : -1;
+          }
+        if (ret == 0)
+          {
+            int on(1);
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            m_fd = fd;
+            break;
+          }
+        ::close(fd);
+      }
+    ::freeaddrinfo(res);
+
+    if (m_fd < 0)
+      {
+        RTC_ERROR(("Failed to connect to %s", endpoint.c_str()));
+        return false;
+      }
+    if (!token.empty())
+      {
+        iovec iov;
+        iov.iov_base = const_cast<char*>(token.data());
+        iov.iov_len = token.size();
+        if (send(&iov, 1) != DataPortStatus::PORT_OK)
+          {
+            RTC_ERROR(("Failed to send the token to %s", endpoint.c_str()));
+            close();
+            return false;
+          }
+      }
+    RTC_DEBUG(("Connected to %s", endpoint.c_str()));
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続を閉じる
+   * @else
+   * @brief Close the connection
+   * @endif
+   */
+  void TCPStreamInPortConsumer::close()
+  {
+    if (m_fd < 0) { return; }
+    ::close(m_fd);
+    m_fd = -1;
+  }
+} // namespace RTC
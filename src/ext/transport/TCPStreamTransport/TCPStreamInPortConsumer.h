@@ -0,0 +1,190 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamInPortConsumer.h
+ * @brief TCPStreamInPortConsumer class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_TCPSTREAMINPORTCONSUMER_H
+#define RTC_TCPSTREAMINPORTCONSUMER_H
+
+#include <rtm/InPortConsumer.h>
+#include <rtm/SystemLogger.h>
+
+#include <sys/uio.h>
+
+#include <chrono>
+#include <mutex>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class TCPStreamInPortConsumer
+   * @brief TCPStreamInPortConsumer クラス
+   *
+   * TCPStreamInPortProvider が公開するアドレス
+   * "dataport.tcp_stream.inport_addr" に TCP で接続し、データを長さ
+   * (4バイト、ネットワークバイトオーダ) を先頭に付けたフレームとして
+   * 送信する InPort コンシューマ。ヘッダとデータは一回の sendmsg() で
+   * コピーせずに送信される。受信側の結果は返されないため、put() は送
+   * 信に失敗した場合を除き PORT_OK を返す。接続後、プロバイダが公開す
+   * るトークン "dataport.tcp_stream.token" を最初に送信する。
+   *
+   * ソケットはノンブロッキングで、接続とフレームの送信は
+   * tcp_stream.send_timeout [ms] (デフォルト 1000) で打ち切られる。
+   * フレームを全く送信できなかった場合は SEND_TIMEOUT を返して接続を
+   * 維持し、途中まで送信した場合はストリームが壊れるため接続を閉じる。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class TCPStreamInPortConsumer
+   * @brief TCPStreamInPortConsumer class
+   *
+   * The InPort consumer which connects to the address
+   * "dataport.tcp_stream.inport_addr" published by
+   * TCPStreamInPortProvider, and sends data as frames prefixed with the
+   * length (4 bytes in network byte order). The header and the data
+   * are sent without copy by one sendmsg(). Since no result is
+   * returned by the receiver, put() returns PORT_OK unless sending
+   * fails. After connecting, the token "dataport.tcp_stream.token"
+   * published by the provider is sent first.
+   *
+   * The socket is non-blocking, and connecting and sending a frame
+   * are given up after tcp_stream.send_timeout [ms] (default 1000). If
+   * nothing of a frame was sent, SEND_TIMEOUT is returned and the
+   * connection is kept. If a frame was partially sent, the connection
+   * is closed since the stream is broken.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class TCPStreamInPortConsumer
+    : public InPortConsumer
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    TCPStreamInPortConsumer();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~TCPStreamInPortConsumer() override;
+
+    /*!
+     * @if jp
+     * @brief 設定初期化
+     * @param prop 設定情報
+     * @else
+     * @brief Initializing configuration
+     * @param prop Configuration information
+     * @endif
+     */
+    void init(coil::Properties& prop) override;
+
+    /*!
+     * @if jp
+     * @brief 接続先へのデータ送信
+     *
+     * @param data 送信するデータ
+     * @return リターンコード
+     *         PORT_OK         正常終了
+     *         SEND_TIMEOUT    送信がタイムアウトした
+     *         CONNECTION_LOST 接続されていない、または送信に失敗した
+     *
+     * @else
+     * @brief Send data to the destination port
+     *
+     * @param data The data that will be sent
+     * @return Return code
+     *         PORT_OK         Normal return
+     *         SEND_TIMEOUT    Sending timed out
+     *         CONNECTION_LOST Not connected or failed to send
+     *
+     * @endif
+     */
+    DataPortStatus put(ByteData& data) override;
+
+    /*!
+     * @if jp
+     * @brief InterfaceProfile情報を公開する
+     *
+     * このコンシューマが公開する情報はない。
+     *
+     * @param properties InterfaceProfile情報を受け取るプロパティ
+     * @else
+     * @brief Publish InterfaceProfile information
+     *
+     * This consumer publishes no information.
+     *
+     * @param properties Properties to get InterfaceProfile information
+     * @endif
+     */
+    void publishInterfaceProfile(SDOPackage::NVList& properties) override;
+
+    /*!
+     * @if jp
+     * @brief データ送信通知への登録
+     *
+     * プロバイダのアドレスに接続する。
+     *
+     * @param properties 登録情報
+     * @return 登録処理結果(登録成功:true、登録失敗:false)
+     * @else
+     * @brief Subscribe to the data sending notification
+     *
+     * This operation connects to the address of the provider.
+     *
+     * @param properties Information for subscription
+     * @return Subscription result (Successful:true, Failed:false)
+     * @endif
+     */
+    bool subscribeInterface(const SDOPackage::NVList& properties) override;
+
+    /*!
+     * @if jp
+     * @brief データ送信通知からの登録解除
+     * @param properties 登録解除情報
+     * @else
+     * @brief Unsubscribe the data send notification
+     * @param properties Information for unsubscription
+     * @endif
+     */
+    void unsubscribeInterface(const SDOPackage::NVList& properties) override;
+
+  private:
+    bool connect(const std::string& endpoint, const std::string& token);
+    DataPortStatus send(iovec* iov, size_t count);
+    void close();
+
+    mutable Logger rtclog;
+    std::mutex m_mutex;
+    int m_fd{-1};
+    std::chrono::milliseconds m_sendTimeout{1000};
+  };  // class TCPStreamInPortConsumer
+} // namespace RTC
+
+#endif  // RTC_TCPSTREAMINPORTCONSUMER_H
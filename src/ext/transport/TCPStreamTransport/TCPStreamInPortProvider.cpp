@@ -0,0 +1,573 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamInPortProvider.cpp
+ * @brief TCPStreamInPortProvider class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "TCPStreamInPortProvider.h"
+#include "TCPStreamReactor.h"
+
+#include <rtm/CORBA_SeqUtil.h>
+#include <rtm/NVUtil.h>
+#include <rtm/InPortConnector.h>
+#include <coil/Routing.h>
+#include <coil/stringutil.h>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  TCPStreamInPortProvider::TCPStreamInPortProvider()
+    : m_recvBuf(64 * 1024)
+  {
+    // PortProfile setting
+    setInterfaceType("tcp_stream");
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  TCPStreamInPortProvider::~TCPStreamInPortProvider()
+  {
+    // no connection is accepted after this
+    if (m_listenFd >= 0)
+      {
+        TCPStreamReactor::instance().removeHandler(m_listenFd);
+        ::close(m_listenFd);
+      }
+    int fd(-1);
+    {
+      std::lock_guard<std::mutex> guard(m_streamMutex);
+      m_closing = true;
+      std::swap(fd, m_candidateFd);
+    }
+    if (fd >= 0)
+      {
+        TCPStreamReactor::instance().removeHandler(fd);
+        ::close(fd);
+      }
+    closeStream();
+
+    if (m_writer.joinable())
+      {
+        {
+          std::lock_guard<std::mutex> guard(m_writeMutex);
+          m_writerStop = true;
+        }
+        m_writeCond.notify_one();
+        m_writer.join();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void TCPStreamInPortProvider::init(coil::Properties& prop)
+  {
+    if (m_listenFd >= 0) { return; }
+
+    if (!coil::stringTo(m_maxFrameSize,
+                        prop.getProperty("tcp_stream.max_frame_size",
+                                         "67108864").c_str()))
+      {
+        RTC_WARN(("Invalid tcp_stream.max_frame_size: %s",
+                  prop["tcp_stream.max_frame_size"].c_str()));
+        m_maxFrameSize = 67108864;
+      }
+
+    std::string host(prop.getProperty("tcp_stream.host"));
+    if (host.empty() && !coil::default_ipaddr(host)) { host = "127.0.0.1"; }
+
+    std::string port(prop.getProperty("tcp_stream.port", "0"));
+    if (!openListener(host, port))
+      {
+        RTC_ERROR(("Failed to open the listening socket: %s", std::strerror(errno)));
+        return;
+      }
+    m_writer = std::thread([this] { runWriter(); });
+  }
+
+  /*!
+   * @if jp
+   * @brief バッファをセットする
+   * @else
+   * @brief Setting outside buffer's pointer
+   * @endif
+   */
+  void TCPStreamInPortProvider::setBuffer(BufferBase<ByteData>* buffer)
+  {
+    m_buffer = buffer;
+  }
+
+  /*!
+   * @if jp
+   * @brief リスナを設定する
+   * @else
+   * @brief Set the listener
+   * @endif
+   */
+  void TCPStreamInPortProvider::setListener(ConnectorInfo& info,
+                                            ConnectorListenersBase* listeners)
+  {
+    std::lock_guard<std::mutex> guard(m_connectorMutex);
+    m_profile = info;
+    m_listeners = listeners;
+  }
+
+  /*!
+   * @if jp
+   * @brief Connectorを設定する
+   * @else
+   * @brief set Connector
+   * @endif
+   */
+  void TCPStreamInPortProvider::setConnector(InPortConnector* connector)
+  {
+    std::lock_guard<std::mutex> guard(m_connectorMutex);
+    m_connector = connector;
+  }
+
+  //----------------------------------------------------------------------
+  // private functions
+
+  /*!
+   * @if jp
+   * @brief 待ち受けソケットを開き、アドレスを公開する
+   * @else
+   * @brief Open the listening socket and publish its address
+   * @endif
+   */
+  bool TCPStreamInPortProvider::openListener(const std::string& host,
+                                             const std::string& port)
+  {
+    int fd(::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+    if (fd < 0) { return false; }
+
+    int on(1);
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    // listen only on the published address
+    sockaddr_in addr{};
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result(nullptr);
+    if (::getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 ||
+        result == nullptr)
+      {
+        ::close(fd);
+        errno = EINVAL;
+        return false;
+      }
+    std::memcpy(&addr, result->ai_addr, sizeof(addr));
+    ::freeaddrinfo(result);
+    addr.sin_port = htons(static_cast<uint16_t>(std::atoi(port.c_str())));
+    socklen_t len(sizeof(addr));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), len) != 0 ||
+        ::listen(fd, 1) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0)
+      {
+        ::close(fd);
+        return false;
+      }
+
+    // set before the handlers may run
+    std::random_device random;
+    char token[33];
+    std::snprintf(token, sizeof(token), "%08x%08x%08x%08x",
+                  random(), random(), random(), random());
+    m_token = token;
+    m_listenFd = fd;
+    if (!TCPStreamReactor::instance().registerHandler(fd, [this] { onAccept(); }))
+      {
+        m_listenFd = -1;
+        ::close(fd);
+        return false;
+      }
+
+    std::string endpoint(host + ":" + std::to_string(ntohs(addr.sin_port)));
+    RTC_DEBUG(("tcp_stream endpoint: %s", endpoint.c_str()));
+    CORBA_SeqUtil::push_back(m_properties,
+                             NVUtil::newNV("dataport.tcp_stream.inport_addr",
+                                           endpoint.c_str()));
+    CORBA_SeqUtil::push_back(m_properties,
+                             NVUtil::newNV("dataport.tcp_stream.token",
+                                           m_token.c_str()));
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続を受け付ける
+   *
+   * 受け付けた接続はトークンを受信するまで受信には用いられない。トー
+   * クン待ちの接続は一つだけであり、新しい接続を受け付けた場合は古い
+   * ものを閉じる。
+   *
+   * @else
+   * @brief Accept a connection
+   *
+   * An accepted connection is not used for reception until the token
+   * is received. Only one connection waits for the token, and the old
+   * one is closed when a new one is accepted.
+   *
+   * @endif
+   */
+  void TCPStreamInPortProvider::onAccept()
+  {
+    int fd(::accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC));
+    if (fd < 0) { return; }
+
+    std::lock_guard<std::mutex> guard(m_streamMutex);
+    if (m_candidateFd >= 0)
+      {
+        TCPStreamReactor::instance().removeHandler(m_candidateFd);
+        ::close(m_candidateFd);
+        m_candidateFd = -1;
+      }
+    if (!TCPStreamReactor::instance().registerHandler(fd, [this, fd] { onHandshake(fd); }))
+      {
+        RTC_ERROR(("Failed to register the accepted socket."));
+        ::close(fd);
+        return;
+      }
+    m_candidateFd = fd;
+    m_tokenRead.clear();
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続のトークンを確認する
+   *
+   * トークンが一致した場合、受信中の接続を閉じてこの接続から受信する。
+   *
+   * @else
+   * @brief Check the token of a connection
+   *
+   * If the token matches, the receiving connection is closed and the
+   * data are received from this connection.
+   *
+   * @endif
+   */
+  void TCPStreamInPortProvider::onHandshake(int fd)
+  {
+    std::lock_guard<std::mutex> guard(m_streamMutex);
+    if (m_closing || fd != m_candidateFd) { return; }
+
+    char buf[64];
+    ssize_t ret(::recv(fd, buf, m_token.size() - m_tokenRead.size(), 0));
+    if (ret < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+      {
+        return;
+      }
+    if (ret > 0)
+      {
+        m_tokenRead.append(buf, static_cast<size_t>(ret));
+        if (m_tokenRead.size() < m_token.size()) { return; }
+      }
+    // compared in constant time
+    unsigned char diff(ret > 0 ? 0 : 1);
+    for (size_t i(0); i < m_token.size() && i < m_tokenRead.size(); ++i)
+      {
+        diff |= static_cast<unsigned char>(m_token[i] ^ m_tokenRead[i]);
+      }
+    TCPStreamReactor::instance().removeHandler(fd);
+    m_candidateFd = -1;
+    m_tokenRead.clear();
+    if (diff != 0)
+      {
+        RTC_WARN(("tcp_stream connection without the valid token closed."));
+        ::close(fd);
+        return;
+      }
+
+    closeStream();
+    int on(1);
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    if (!TCPStreamReactor::instance().registerHandler(fd, [this] { onReadable(); }))
+      {
+        RTC_ERROR(("Failed to register the accepted socket."));
+        ::close(fd);
+        return;
+      }
+    m_streamFd = fd;
+    RTC_DEBUG(("tcp_stream connection accepted."));
+  }
+
+  /*!
+   * @if jp
+   * @brief ソケットから読み込み、完成したフレームを受信する
+   *
+   * 小さいフレームは受信バッファにまとめて読み込み、受信バッファより
+   * 大きいフレームの本体は ByteData に直接読み込む。
+   *
+   * @else
+   * @brief Read the socket and receive the completed frames
+   *
+   * Small frames are read together into the receive buffer, and the
+   * body of a frame larger than the receive buffer is read directly
+   * into ByteData.
+   *
+   * @endif
+   */
+  void TCPStreamInPortProvider::onReadable()
+  {
+    // the completed frame waiting for the writer
+    if (m_stalled && !deliver()) { return; }
+    for (;;)
+      {
+        // consume the buffered bytes
+        while (m_recvBegin < m_recvEnd)
+          {
+            if (m_headerLength < sizeof(m_header))
+              {
+                size_t n(std::min(sizeof(m_header) - m_headerLength,
+                                  m_recvEnd - m_recvBegin));
+                std::memcpy(m_header + m_headerLength, &m_recvBuf[m_recvBegin], n);
+                m_headerLength += n;
+                m_recvBegin += n;
+                if (m_headerLength < sizeof(m_header)) { continue; }
+                uint32_t length;
+                std::memcpy(&length, m_header, sizeof(length));
+                m_bodyLength = ntohl(length);
+                m_bodyRead = 0;
+                if (m_bodyLength > m_maxFrameSize)
+                  {
+                    // the stream cannot be resynchronized
+                    RTC_ERROR(("tcp_stream frame too large: %lu bytes",
+                               static_cast<unsigned long>(m_bodyLength)));
+                    closeStream();
+                    return;
+                  }
+                m_frames[m_fill].setDataLength(m_bodyLength);
+              }
+            size_t n(std::min(m_bodyLength - m_bodyRead, m_recvEnd - m_recvBegin));
+            if (n > 0)
+              {
+                std::memcpy(m_frames[m_fill].getBuffer() + m_bodyRead,
+                            &m_recvBuf[m_recvBegin], n);
+                m_bodyRead += n;
+                m_recvBegin += n;
+              }
+            if (m_bodyRead == m_bodyLength && !deliver()) { return; }
+          }
+        m_recvBegin = m_recvEnd = 0;
+
+        ssize_t ret;
+        if (m_headerLength == sizeof(m_header) &&
+            m_bodyLength - m_bodyRead >= m_recvBuf.size())
+          {
+            ret = ::recv(m_streamFd, m_frames[m_fill].getBuffer() + m_bodyRead,
+                         m_bodyLength - m_bodyRead, 0);
+            if (ret > 0)
+              {
+                m_bodyRead += static_cast<size_t>(ret);
+                if (m_bodyRead == m_bodyLength && !deliver()) { return; }
+                continue;
+              }
+          }
+        else
+          {
+            ret = ::recv(m_streamFd, m_recvBuf.data(), m_recvBuf.size(), 0);
+            if (ret > 0)
+              {
+                m_recvEnd = static_cast<size_t>(ret);
+                continue;
+              }
+          }
+
+        if (ret < 0 && errno == EINTR) { continue; }
+        if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) { return; }
+        // closed by the peer or error
+        RTC_DEBUG(("tcp_stream connection closed."));
+        closeStream();
+        return;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信中の接続を閉じる
+   * @else
+   * @brief Close the receiving connection
+   * @endif
+   */
+  void TCPStreamInPortProvider::closeStream()
+  {
+    int fd(m_streamFd.exchange(-1));
+    if (fd < 0) { return; }
+    // waits for onReadable() unless called from it
+    TCPStreamReactor::instance().removeHandler(fd);
+    ::close(fd);
+    m_recvBegin = m_recvEnd = 0;
+    m_headerLength = 0;
+    // the frame waiting for the writer is dropped
+    std::lock_guard<std::mutex> guard(m_writeMutex);
+    m_stalled = false;
+  }
+
+  /*!
+   * @if jp
+   * @brief 揃ったフレームを書き込みスレッドに渡す
+   *
+   * 書き込みスレッドが前のフレームを書き込み中の場合は、ソケットの読
+   * み込みを停止して false を返す。書き込みが終わるとリアクタからハン
+   * ドラが再度呼び出され、このフレームを渡し直す。
+   *
+   * @else
+   * @brief Hand the completed frame to the writer thread
+   *
+   * If the writer is still writing the previous frame, reading the
+   * socket is paused and false is returned. The handler is called
+   * again from the reactor when the writer finishes, and hands this
+   * frame again.
+   *
+   * @endif
+   */
+  bool TCPStreamInPortProvider::deliver()
+  {
+    std::lock_guard<std::mutex> guard(m_writeMutex);
+    if (m_hasPending)
+      {
+        m_stalled = true;
+        TCPStreamReactor::instance().pause(m_streamFd);
+        return false;
+      }
+    m_stalled = false;
+    m_pending = m_fill;
+    m_fill ^= 1;
+    m_hasPending = true;
+    m_headerLength = 0;
+    m_writeCond.notify_one();
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 書き込みスレッド
+   * @else
+   * @brief Writer thread
+   * @endif
+   */
+  void TCPStreamInPortProvider::runWriter()
+  {
+    std::unique_lock<std::mutex> guard(m_writeMutex);
+    for (;;)
+      {
+        m_writeCond.wait(guard, [this] { return m_hasPending || m_writerStop; });
+        if (m_writerStop) { return; }
+        guard.unlock();
+        received(m_frames[m_pending]);
+        guard.lock();
+        m_hasPending = false;
+        if (m_stalled)
+          {
+            TCPStreamReactor::instance().resume(m_streamFd);
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信したフレームをバッファに書き込む
+   * @else
+   * @brief Write the received frame into the buffer
+   * @endif
+   */
+  void TCPStreamInPortProvider::received(ByteData& data)
+  {
+    RTC_PARANOID(("received data size: %d",
+                  static_cast<int>(data.getDataLength())));
+    std::lock_guard<std::mutex> guard(m_connectorMutex);
+    if (m_listeners == nullptr)
+      {
+        RTC_DEBUG(("the frame received before the connection is dropped."));
+        return;
+      }
+    if (m_connector == nullptr)
+      {
+        onReceiverError(data);
+        return;
+      }
+    data.isLittleEndian(m_connector->isLittleEndian());
+    onReceived(data);
+    convertReturn(m_connector->write(data), data);
+  }
+
+  /*!
+   * @if jp
+   * @brief バッファへの書き込み結果をリスナに通知する
+   * @else
+   * @brief Notify the result of writing to the buffer to the listeners
+   * @endif
+   */
+  void TCPStreamInPortProvider::convertReturn(BufferStatus status,
+                                              ByteData& data)
+  {
+    switch (status)
+      {
+      case BufferStatus::OK:
+        onBufferWrite(data);
+        break;
+
+      case BufferStatus::FULL:
+        onBufferFull(data);
+        onReceiverFull(data);
+        break;
+
+      case BufferStatus::TIMEOUT:
+        onBufferWriteTimeout(data);
+        onReceiverTimeout(data);
+        break;
+
+      case BufferStatus::BUFFER_ERROR:          /* FALLTHROUGH */
+      case BufferStatus::PRECONDITION_NOT_MET:
+        onReceiverError(data);
+        break;
+
+      case BufferStatus::EMPTY:                 /* FALLTHROUGH */
+      case BufferStatus::NOT_SUPPORTED:         /* FALLTHROUGH */
+      default:
+        break;
+      }
+  }
+} // namespace RTC
@@ -0,0 +1,265 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamInPortProvider.h
+ * @brief TCPStreamInPortProvider class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_TCPSTREAMINPORTPROVIDER_H
+#define RTC_TCPSTREAMINPORTPROVIDER_H
+
+#include <rtm/BufferBase.h>
+#include <rtm/InPortProvider.h>
+#include <rtm/ConnectorListener.h>
+#include <rtm/ConnectorBase.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class TCPStreamInPortProvider
+   * @brief TCPStreamInPortProvider クラス
+   *
+   * TCP ストリームでデータを受信する InPort プロバイダ。init() で待ち
+   * 受けソケットを開き、そのアドレスを
+   * "dataport.tcp_stream.inport_addr" として ConnectorProfile で公開
+   * する。CORBA はこのアドレスの交換にのみ使われ、データは長さ (4バイ
+   * ト、ネットワークバイトオーダ) を先頭に付けたフレームとして受信す
+   * る。ソケットの受信処理は TCPStreamReactor のスレッドで行われる。
+   *
+   * 待ち受けアドレスと共に乱数のトークン "dataport.tcp_stream.token"
+   * を公開し、接続後に最初にこのトークンを送信したコンシューマの接続
+   * のみを受信に用いる。トークンが一致しない接続は閉じられ、受信中の
+   * 接続には影響しない。
+   *
+   * 受信したフレームはプロバイダ毎の書き込みスレッドがコネクタに書き
+   * 込むため、バッファへの書き込みがブロックしてもリアクタスレッドは
+   * 止まらない。書き込みスレッドが前のフレームを書き込み中に次のフレー
+   * ムが揃った場合は、書き込みが終わるまでソケットの読み込みを停止し、
+   * TCP のフロー制御で送信側を待たせる。
+   *
+   * init() に渡されるプロパティ (コネクタプロファイルの
+   * dataport.provider.*)
+   * - tcp_stream.host: 待ち受けて公開するホスト名またはアドレス。省略
+   *   した場合はループバック以外の最初の IPv4 アドレス。
+   * - tcp_stream.port: 待ち受けポート番号。0 または省略した場合は自動。
+   * - tcp_stream.max_frame_size: 受信するフレームの最大長 [byte] (デフォ
+   *   ルト 67108864)。これより長いフレームを受信した場合は接続を閉じる。
+   *
+   * データの送信側に受信結果は返されないため、バッファフルなどはこの
+   * プロバイダのリスナにのみ通知される。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class TCPStreamInPortProvider
+   * @brief TCPStreamInPortProvider class
+   *
+   * The InPort provider which receives data from a TCP stream. init()
+   * opens a listening socket and its address is published in
+   * ConnectorProfile as "dataport.tcp_stream.inport_addr". CORBA is
+   * only used to exchange this address, and the data are received as
+   * frames prefixed with the length (4 bytes in network byte
+   * order). Sockets are read on the thread of TCPStreamReactor.
+   *
+   * A random token "dataport.tcp_stream.token" is published with the
+   * listening address, and only a connection whose consumer sends the
+   * token first is used for reception. A connection with a wrong token
+   * is closed without affecting the receiving connection.
+   *
+   * Received frames are written to the connector by a writer thread of
+   * each provider, so the reactor thread is not stalled by a blocking
+   * buffer write. When the next frame is completed while the writer is
+   * still writing the previous one, reading the socket is paused until
+   * the writer finishes, and the sender waits by TCP flow control.
+   *
+   * Properties given to init() (dataport.provider.* of the connector
+   * profile)
+   * - tcp_stream.host: Host name or address to listen on and to be
+   *   published. The first non-loopback IPv4 address if omitted.
+   * - tcp_stream.port: Listening port number. Chosen automatically if
+   *   0 or omitted.
+   * - tcp_stream.max_frame_size: Maximum length of a received frame in
+   *   bytes (default 67108864). The connection is closed when a longer
+   *   frame is received.
+   *
+   * Since no result is returned to the sender, buffer full and so on
+   * are only notified to the listeners of this provider.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class TCPStreamInPortProvider
+    : public InPortProvider
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    TCPStreamInPortProvider();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~TCPStreamInPortProvider() override;
+
+    /*!
+     * @if jp
+     * @brief 設定初期化
+     *
+     * 待ち受けソケットを開き、アドレスを公開するプロパティに追加する。
+     *
+     * @param prop 設定情報
+     * @else
+     * @brief Initializing configuration
+     *
+     * This operation opens the listening socket and adds its address
+     * to the properties to be published.
+     *
+     * @param prop Configuration information
+     * @endif
+     */
+    void init(coil::Properties& prop) override;
+
+    /*!
+     * @if jp
+     * @brief バッファをセットする
+     * @param buffer OutPortProviderがデータを取り出すバッファへのポインタ
+     * @else
+     * @brief Setting outside buffer's pointer
+     * @param buffer A pointer to a data buffer to be used by OutPortProvider
+     * @endif
+     */
+    void setBuffer(BufferBase<ByteData>* buffer) override;
+
+    /*!
+     * @if jp
+     * @brief リスナを設定する
+     * @param info 接続情報
+     * @param listeners リスナオブジェクト
+     * @else
+     * @brief Set the listener
+     * @param info Connector information
+     * @param listeners Listener objects
+     * @endif
+     */
+    void setListener(ConnectorInfo& info,
+                     ConnectorListenersBase* listeners) override;
+
+    /*!
+     * @if jp
+     * @brief Connectorを設定する
+     * @param connector InPortConnector
+     * @else
+     * @brief set Connector
+     * @param connector InPortConnector
+     * @endif
+     */
+    void setConnector(InPortConnector* connector) override;
+
+  private:
+    bool openListener(const std::string& host, const std::string& port);
+    void onAccept();
+    void onHandshake(int fd);
+    void onReadable();
+    void closeStream();
+    bool deliver();
+    void runWriter();
+    void received(ByteData& data);
+    void convertReturn(BufferStatus status, ByteData& data);
+
+    inline void onBufferWrite(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_WRITE, m_profile, data);
+    }
+    inline void onBufferFull(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_FULL, m_profile, data);
+    }
+    inline void onBufferWriteTimeout(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_WRITE_TIMEOUT, m_profile, data);
+    }
+    inline void onReceived(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVED, m_profile, data);
+    }
+    inline void onReceiverFull(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_FULL, m_profile, data);
+    }
+    inline void onReceiverTimeout(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_TIMEOUT, m_profile, data);
+    }
+    inline void onReceiverError(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_ERROR, m_profile, data);
+    }
+
+    CdrBufferBase* m_buffer{nullptr};
+    // m_listeners, m_profile and m_connector are set while receiving
+    std::mutex m_connectorMutex;
+    ConnectorListenersBase* m_listeners{nullptr};
+    ConnectorInfo m_profile;
+    InPortConnector* m_connector{nullptr};
+
+    int m_listenFd{-1};
+    std::string m_token;
+    // the connection waiting for the token, and the receiving one
+    std::mutex m_streamMutex;
+    bool m_closing{false};
+    int m_candidateFd{-1};
+    std::string m_tokenRead;
+    std::atomic<int> m_streamFd{-1};
+    size_t m_maxFrameSize{67108864};
+    // receive buffer and the state of the current frame
+    std::vector<unsigned char> m_recvBuf;
+    size_t m_recvBegin{0};
+    size_t m_recvEnd{0};
+    unsigned char m_header[4]{};
+    size_t m_headerLength{0};
+    size_t m_bodyLength{0};
+    size_t m_bodyRead{0};
+    // the frame being read and the frame being written by the writer
+    ByteData m_frames[2];
+    size_t m_fill{0};
+    size_t m_pending{0};
+
+    std::thread m_writer;
+    std::mutex m_writeMutex;
+    std::condition_variable m_writeCond;
+    bool m_hasPending{false};
+    bool m_stalled{false};
+    bool m_writerStop{false};
+  };  // class TCPStreamInPortProvider
+} // namespace RTC
+
+#endif  // RTC_TCPSTREAMINPORTPROVIDER_H
@@ -0,0 +1,218 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamReactor.cpp
+ * @brief Reactor thread of the TCP stream transport
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "TCPStreamReactor.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief インスタンスを取得する
+   * @else
+   * @brief Get the instance
+   * @endif
+   */
+  TCPStreamReactor& TCPStreamReactor::instance()
+  {
+    static TCPStreamReactor reactor;
+    return reactor;
+  }
+
+  TCPStreamReactor::TCPStreamReactor()
+    : m_epoll(::epoll_create1(EPOLL_CLOEXEC)),
+      m_wakeup(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+  {
+    if (m_epoll >= 0 && m_wakeup >= 0)
+      {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = m_wakeup;
+        ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &ev);
+      }
+  }
+
+  TCPStreamReactor::~TCPStreamReactor()
+  {
+    stop();
+    if (m_wakeup >= 0) { ::close(m_wakeup); }
+    if (m_epoll >= 0) { ::close(m_epoll); }
+  }
+
+  /*!
+   * @if jp
+   * @brief ソケットのハンドラを登録する
+   * @else
+   * @brief Register the handler of a socket
+   * @endif
+   */
+  bool TCPStreamReactor::registerHandler(int fd, Handler handler)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_epoll < 0 || m_wakeup < 0) { return false; }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &ev) != 0) { return false; }
+    m_handlers[fd] = std::make_shared<Handler>(std::move(handler));
+
+    if (!m_running)
+      {
+        if (m_thread.joinable()) { m_thread.join(); }
+        m_running = true;
+        m_thread = std::thread([this] { run(); });
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief ソケットのハンドラを削除する
+   * @else
+   * @brief Remove the handler of a socket
+   * @endif
+   */
+  void TCPStreamReactor::removeHandler(int fd)
+  {
+    std::unique_lock<std::mutex> guard(m_mutex);
+    if (m_handlers.erase(fd) == 0) { return; }
+    ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    if (std::this_thread::get_id() == m_thread.get_id()) { return; }
+    m_cond.wait(guard, [this, fd] { return m_dispatching != fd; });
+  }
+
+  /*!
+   * @if jp
+   * @brief ソケットの監視を一時停止する
+   * @else
+   * @brief Pause watching a socket
+   * @endif
+   */
+  void TCPStreamReactor::pause(int fd)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_handlers.count(fd) == 0) { return; }
+    epoll_event ev{};
+    ev.events = 0;
+    ev.data.fd = fd;
+    ::epoll_ctl(m_epoll, EPOLL_CTL_MOD, fd, &ev);
+  }
+
+  /*!
+   * @if jp
+   * @brief ソケットの監視を再開する
+   * @else
+   * @brief Resume watching a socket
+   * @endif
+   */
+  void TCPStreamReactor::resume(int fd)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_handlers.count(fd) == 0) { return; }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    ::epoll_ctl(m_epoll, EPOLL_CTL_MOD, fd, &ev);
+    m_resumed.push_back(fd);
+    uint64_t one(1);
+    ssize_t ret(::write(m_wakeup, &one, sizeof(one)));
+    (void)ret;
+  }
+
+  /*!
+   * @if jp
+   * @brief リアクタスレッドを停止する
+   * @else
+   * @brief Stop the reactor thread
+   * @endif
+   */
+  void TCPStreamReactor::stop()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (!m_running) { return; }
+      m_running = false;
+      uint64_t one(1);
+      ssize_t ret(::write(m_wakeup, &one, sizeof(one)));
+      (void)ret;
+    }
+    if (m_thread.joinable() &&
+        std::this_thread::get_id() != m_thread.get_id())
+      {
+        m_thread.join();
+      }
+  }
+
+  void TCPStreamReactor::run()
+  {
+    epoll_event events[64];
+    for (;;)
+      {
+        int num(::epoll_wait(m_epoll, events, 64, -1));
+        if (num < 0)
+          {
+            if (errno == EINTR) { continue; }
+            return;
+          }
+        for (int i(0); i < num; ++i)
+          {
+            int fd(events[i].data.fd);
+            if (fd != m_wakeup)
+              {
+                dispatch(fd);
+                continue;
+              }
+            std::vector<int> resumed;
+            {
+              std::lock_guard<std::mutex> guard(m_mutex);
+              uint64_t count(0);
+              ssize_t ret(::read(m_wakeup, &count, sizeof(count)));
+              (void)ret;
+              if (!m_running) { return; }
+              resumed.swap(m_resumed);
+            }
+            for (auto resumed_fd : resumed) { dispatch(resumed_fd); }
+          }
+      }
+  }
+
+  void TCPStreamReactor::dispatch(int fd)
+  {
+    std::shared_ptr<Handler> handler;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      auto it = m_handlers.find(fd);
+      if (it == m_handlers.end()) { return; }
+      handler = it->second;
+      m_dispatching = fd;
+    }
+    (*handler)();
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_dispatching = -1;
+    }
+    m_cond.notify_all();
+  }
+} // namespace RTC
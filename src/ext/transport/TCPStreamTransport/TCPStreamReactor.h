@@ -0,0 +1,202 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamReactor.h
+ * @brief Reactor thread of the TCP stream transport
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_TCPSTREAMREACTOR_H
+#define RTC_TCPSTREAMREACTOR_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   *
+   * @class TCPStreamReactor
+   * @brief TCP ストリームトランスポートのリアクタ
+   *
+   * プロセス内の全ての TCP ストリームプロバイダのソケットを一つの
+   * epoll で監視し、読み込み可能になったソケットのハンドラを単一のス
+   * レッドから呼び出す。ハンドラはリアクタスレッドで実行されるため、
+   * ブロックしてはならない。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   *
+   * @class TCPStreamReactor
+   * @brief Reactor of the TCP stream transport
+   *
+   * This class watches the sockets of all the TCP stream providers in
+   * the process with one epoll instance, and calls the handler of a
+   * readable socket from a single thread. Handlers run on the reactor
+   * thread and must not block.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class TCPStreamReactor
+  {
+  public:
+    using Handler = std::function<void(void)>;
+
+    /*!
+     * @if jp
+     * @brief インスタンスを取得する
+     * @else
+     * @brief Get the instance
+     * @endif
+     */
+    static TCPStreamReactor& instance();
+
+    /*!
+     * @if jp
+     *
+     * @brief ソケットのハンドラを登録する
+     *
+     * リアクタスレッドが動作していない場合は開始する。
+     *
+     * @param fd 監視するソケット
+     * @param handler 読み込み可能になったときに呼び出されるハンドラ
+     * @return 成功した場合 true
+     *
+     * @else
+     *
+     * @brief Register the handler of a socket
+     *
+     * The reactor thread is started if it is not running.
+     *
+     * @param fd Socket to be watched
+     * @param handler Handler called when the socket becomes readable
+     * @return true if succeeded
+     *
+     * @endif
+     */
+    bool registerHandler(int fd, Handler handler);
+
+    /*!
+     * @if jp
+     *
+     * @brief ソケットのハンドラを削除する
+     *
+     * リアクタスレッド以外から呼び出された場合、そのソケットのハンドラ
+     * が実行中であれば終了を待つ。この関数から戻った後、ハンドラが呼び
+     * 出されることはない。
+     *
+     * @param fd 監視を終了するソケット
+     *
+     * @else
+     *
+     * @brief Remove the handler of a socket
+     *
+     * If called from other than the reactor thread, this function
+     * waits for the running handler of the socket. The handler is
+     * never called after this function returns.
+     *
+     * @param fd Socket not to be watched
+     *
+     * @endif
+     */
+    void removeHandler(int fd);
+
+    /*!
+     * @if jp
+     *
+     * @brief ソケットの監視を一時停止する
+     *
+     * resume() が呼ばれるまで、ソケットが読み込み可能になってもハンド
+     * ラは呼び出されない。
+     *
+     * @param fd 監視を一時停止するソケット
+     *
+     * @else
+     *
+     * @brief Pause watching a socket
+     *
+     * The handler is not called even if the socket becomes readable
+     * until resume() is called.
+     *
+     * @param fd Socket to be paused
+     *
+     * @endif
+     */
+    void pause(int fd);
+
+    /*!
+     * @if jp
+     *
+     * @brief ソケットの監視を再開する
+     *
+     * ソケットが読み込み可能でなくても、ハンドラはリアクタスレッドから
+     * 一度呼び出される。ハンドラが一時停止中に読み込み済みのデータを処
+     * 理するために用いる。
+     *
+     * @param fd 監視を再開するソケット
+     *
+     * @else
+     *
+     * @brief Resume watching a socket
+     *
+     * The handler is called once from the reactor thread even if the
+     * socket is not readable, so that it can process the data read
+     * before it was paused.
+     *
+     * @param fd Socket to be resumed
+     *
+     * @endif
+     */
+    void resume(int fd);
+
+    /*!
+     * @if jp
+     * @brief リアクタスレッドを停止する
+     * @else
+     * @brief Stop the reactor thread
+     * @endif
+     */
+    void stop();
+
+  private:
+    TCPStreamReactor();
+    ~TCPStreamReactor();
+    TCPStreamReactor(const TCPStreamReactor&) = delete;
+    TCPStreamReactor& operator=(const TCPStreamReactor&) = delete;
+
+    void run();
+    void dispatch(int fd);
+
+    int m_epoll{-1};
+    int m_wakeup{-1};
+    bool m_running{false};
+    int m_dispatching{-1};
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::unordered_map<int, std::shared_ptr<Handler>> m_handlers;
+    // resumed sockets whose handlers are called on the next wakeup
+    std::vector<int> m_resumed;
+  };
+} // namespace RTC
+
+#endif  // RTC_TCPSTREAMREACTOR_H
@@ -0,0 +1,80 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamTransport.cpp
+ * @brief TCPStreamTransport class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "TCPStreamTransport.h"
+#include "TCPStreamInPortProvider.h"
+#include "TCPStreamInPortConsumer.h"
+#include "TCPStreamReactor.h"
+
+namespace TCPStreamRTM
+{
+  ManagerActionListener::ManagerActionListener()
+  {
+  }
+  ManagerActionListener::~ManagerActionListener()
+  {
+  }
+  void ManagerActionListener::preShutdown()
+  {
+  }
+  void ManagerActionListener::postShutdown()
+  {
+    RTC::TCPStreamReactor::instance().stop();
+  }
+  void ManagerActionListener::postReinit()
+  {
+  }
+  void ManagerActionListener::preReinit()
+  {
+  }
+}
+
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void TCPStreamTransportInit(RTC::Manager* manager)
+  {
+    {
+      RTC::InPortProviderFactory& factory(RTC::InPortProviderFactory::instance());
+      factory.addFactory("tcp_stream",
+                         ::coil::Creator< ::RTC::InPortProvider,
+                                          ::RTC::TCPStreamInPortProvider>,
+                         ::coil::Destructor< ::RTC::InPortProvider,
+                                             ::RTC::TCPStreamInPortProvider>);
+    }
+
+    {
+      RTC::InPortConsumerFactory& factory(RTC::InPortConsumerFactory::instance());
+      factory.addFactory("tcp_stream",
+                         ::coil::Creator< ::RTC::InPortConsumer,
+                                          ::RTC::TCPStreamInPortConsumer>,
+                         ::coil::Destructor< ::RTC::InPortConsumer,
+                                             ::RTC::TCPStreamInPortConsumer>);
+    }
+
+    TCPStreamRTM::ManagerActionListener *listener = new TCPStreamRTM::ManagerActionListener();
+    manager->addManagerActionListener(listener);
+  }
+}
@@ -0,0 +1,59 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  TCPStreamTransport.h
+ * @brief TCPStreamTransport class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_TCPSTREAMTRANSPORT_H
+#define RTC_TCPSTREAMTRANSPORT_H
+
+#include <rtm/Manager.h>
+
+namespace TCPStreamRTM
+{
+  class ManagerActionListener : public RTM::ManagerActionListener
+  {
+  public:
+      ManagerActionListener();
+      ~ManagerActionListener() override;
+      void preShutdown() override;
+      void postShutdown() override;
+      void postReinit() override;
+      void preReinit() override;
+  };
+}
+
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * TCPStreamInPortProvider、TCPStreamInPortConsumer のファクトリを
+   * "tcp_stream" として登録する初期化関数。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * This function registers the factories of TCPStreamInPortProvider
+   * and TCPStreamInPortConsumer as "tcp_stream".
+   *
+   * @endif
+   */
+  DLL_EXPORT void TCPStreamTransportInit(RTC::Manager* manager);
+}
+
+#endif // RTC_TCPSTREAMTRANSPORT_H
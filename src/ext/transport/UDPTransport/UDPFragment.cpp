@@ -0,0 +1,661 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPFragment.cpp
+ * @brief Fragmentation and reassembly of UDP samples
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "UDPFragment.h"
+
+#include <arpa/inet.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <random>
+
+namespace RTC
+{
+  const size_t UDPFragmentHeader::size;
+  const unsigned char UDPFragmentHeader::version;
+  const uint8_t UDPFragmentHeader::parity;
+
+  static const unsigned char udp_fragment_magic[2] = {'R', 'U'};
+  // IPv4 header + UDP header
+  static const size_t udp_ip_header_size = 28;
+
+  /*!
+   * @if jp
+   * @brief ヘッダをバッファに書き込む
+   * @else
+   * @brief Write the header into a buffer
+   * @endif
+   */
+  void UDPFragmentHeader::write(unsigned char* buf) const
+  {
+    uint16_t u16;
+    uint32_t u32;
+    buf[0] = udp_fragment_magic[0];
+    buf[1] = udp_fragment_magic[1];
+    buf[2] = version;
+    buf[3] = flags;
+    u32 = htonl(senderId); std::memcpy(buf + 4, &u32, 4);
+    u32 = htonl(sequence); std::memcpy(buf + 8, &u32, 4);
+    u16 = htons(index);    std::memcpy(buf + 12, &u16, 2);
+    u16 = htons(count);    std::memcpy(buf + 14, &u16, 2);
+    u32 = htonl(length);   std::memcpy(buf + 16, &u32, 4);
+    u32 = htonl(offset);   std::memcpy(buf + 20, &u32, 4);
+  }
+
+  /*!
+   * @if jp
+   * @brief バッファからヘッダを読み込む
+   * @else
+   * @brief Read the header from a buffer
+   * @endif
+   */
+  bool UDPFragmentHeader::read(const unsigned char* buf, size_t len)
+  {
+    if (len < size ||
+        buf[0] != udp_fragment_magic[0] || buf[1] != udp_fragment_magic[1] ||
+        buf[2] != version)
+      {
+        return false;
+      }
+    uint16_t u16;
+    uint32_t u32;
+    flags = buf[3];
+    std::memcpy(&u32, buf + 4, 4);  senderId = ntohl(u32);
+    std::memcpy(&u32, buf + 8, 4);  sequence = ntohl(u32);
+    std::memcpy(&u16, buf + 12, 2); index = ntohs(u16);
+    std::memcpy(&u16, buf + 14, 2); count = ntohs(u16);
+    std::memcpy(&u32, buf + 16, 4); length = ntohl(u32);
+    std::memcpy(&u32, buf + 20, 4); offset = ntohl(u32);
+    if (count == 0 || index >= count) { return false; }
+    // a parity covers "offset" fragments from "index"
+    return (flags & parity) == 0 || (offset != 0 && index % offset == 0);
+  }
+
+  //============================================================
+  // UDPFragmentSender
+  //============================================================
+  UDPFragmentSender::UDPFragmentSender()
+    : m_senderId(std::random_device()()),
+      m_payloadSize(1500 - udp_ip_header_size - UDPFragmentHeader::size)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief MTU を設定する
+   * @else
+   * @brief Set the MTU
+   * @endif
+   */
+  void UDPFragmentSender::setMTU(size_t mtu)
+  {
+    // IPv4 minimum MTU, and the maximum size of a UDP datagram
+    if (mtu < 576) { mtu = 576; }
+    if (mtu > 65535) { mtu = 65535; }
+    m_payloadSize = mtu - udp_ip_header_size - UDPFragmentHeader::size;
+  }
+
+  /*!
+   * @if jp
+   * @brief FEC のグループサイズを設定する
+   * @else
+   * @brief Set the group size of FEC
+   * @endif
+   */
+  void UDPFragmentSender::setFECGroup(size_t group)
+  {
+    m_fecGroup = std::min<size_t>(group, 0xffff);
+  }
+
+  /*!
+   * @if jp
+   * @brief サンプルを送信する
+   * @else
+   * @brief Send a sample
+   * @endif
+   */
+  bool UDPFragmentSender::send(int fd, const sockaddr* addr, socklen_t addrlen,
+                               const unsigned char* data, size_t length)
+  {
+    size_t count(length == 0 ? 1 : (length + m_payloadSize - 1) / m_payloadSize);
+    if (count > 0xffff || length > 0xffffffffUL) { return false; }
+    size_t groups(m_fecGroup == 0 ? 0 : (count + m_fecGroup - 1) / m_fecGroup);
+    size_t total(count + groups);
+
+    m_headers.resize(total * UDPFragmentHeader::size);
+    m_parity.assign(groups * m_payloadSize, 0);
+    m_iov.resize(total * 2);
+    m_msgs.resize(total);
+
+    UDPFragmentHeader header;
+    header.senderId = m_senderId;
+    header.sequence = ++m_sequence;
+    header.count = static_cast<uint16_t>(count);
+    header.length = static_cast<uint32_t>(length);
+
+    size_t msg(0);
+    auto add = [&](const unsigned char* payload, size_t size)
+      {
+        unsigned char* hbuf(&m_headers[msg * UDPFragmentHeader::size]);
+        header.write(hbuf);
+        m_iov[msg * 2].iov_base = hbuf;
+        m_iov[msg * 2].iov_len = UDPFragmentHeader::size;
+        m_iov[msg * 2 + 1].iov_base = const_cast<unsigned char*>(payload);
+        m_iov[msg * 2 + 1].iov_len = size;
+
+        msghdr& mh(m_msgs[msg].msg_hdr);
+        mh = msghdr();
+        mh.msg_name = const_cast<sockaddr*>(addr);
+        mh.msg_namelen = addrlen;
+        mh.msg_iov = &m_iov[msg * 2];
+        mh.msg_iovlen = 2;
+        ++msg;
+      };
+
+    for (size_t i(0); i < count; ++i)
+      {
+        size_t offset(i * m_payloadSize);
+        size_t size(std::min(m_payloadSize, length - offset));
+        header.flags = 0;
+        header.index = static_cast<uint16_t>(i);
+        header.offset = static_cast<uint32_t>(offset);
+        add(data + offset, size);
+
+        if (groups == 0) { continue; }
+        // the parity follows the last fragment of each group
+        size_t group(i / m_fecGroup);
+        unsigned char* parity(&m_parity[group * m_payloadSize]);
+        for (size_t j(0); j < size; ++j) { parity[j] ^= data[offset + j]; }
+        if ((i + 1) % m_fecGroup == 0 || i + 1 == count)
+          {
+            header.flags = UDPFragmentHeader::parity;
+            header.index = static_cast<uint16_t>(group * m_fecGroup);
+            header.offset = static_cast<uint32_t>(m_fecGroup);
+            add(parity, m_payloadSize);
+          }
+      }
+
+    size_t sent(0);
+    while (sent < total)
+      {
+        int ret(::sendmmsg(fd, &m_msgs[sent],
+                           static_cast<unsigned int>(total - sent), 0));
+        if (ret < 0)
+          {
+            if (errno == EINTR) { continue; }
+            return false;
+          }
+        sent += static_cast<size_t>(ret);
+      }
+    return true;
+  }
+
+  //============================================================
+  // UDPReassembler
+  //============================================================
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  UDPReassembler::UDPReassembler(size_t max_samples,
+                                 std::chrono::milliseconds timeout,
+                                 size_t max_sample_size,
+                                 size_t max_senders,
+                                 std::chrono::milliseconds sender_timeout)
+    : m_maxSamples(max_samples == 0 ? 1 : max_samples), m_timeout(timeout),
+      m_maxSampleSize(max_sample_size),
+      m_maxSenders(max_senders == 0 ? 1 : max_senders),
+      m_senderTimeout(sender_timeout)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief データグラムを追加する
+   * @else
+   * @brief Add a datagram
+   * @endif
+   */
+  const std::vector<unsigned char>*
+  UDPReassembler::push(const unsigned char* datagram, size_t length)
+  {
+    UDPFragmentHeader header;
+    if (!header.read(datagram, length))
+      {
+        ++m_stats.invalid;
+        return nullptr;
+      }
+    const unsigned char* payload(datagram + UDPFragmentHeader::size);
+    size_t size(length - UDPFragmentHeader::size);
+    bool is_parity((header.flags & UDPFragmentHeader::parity) != 0);
+    if (!is_parity &&
+        static_cast<size_t>(header.offset) + size > header.length)
+      {
+        ++m_stats.invalid;
+        return nullptr;
+      }
+    ++m_stats.fragments;
+
+    Clock::time_point now(Clock::now());
+    Stream* found(findStream(header.senderId, now));
+    if (found == nullptr)
+      {
+        ++m_stats.rejected;
+        return nullptr;
+      }
+    Stream& stream(*found);
+    stream.active = now;
+    if (stream.started &&
+        static_cast<int32_t>(header.sequence - stream.delivered) <= 0)
+      {
+        // the parity follows the data, so it is late rather than duplicated
+        if (!is_parity) { ++m_stats.duplicated; }
+        return nullptr;
+      }
+
+    Sample* sample(findSample(stream, header, size));
+    if (sample == nullptr) { return nullptr; }
+
+    if (is_parity)
+      {
+        if (!addParity(*sample, header, payload, size)) { return nullptr; }
+        recover(*sample, header.index / sample->fecGroup);
+      }
+    else
+      {
+        if (sample->received[header.index]) { return nullptr; }
+        sample->received[header.index] = true;
+        --sample->remaining;
+        if (size > 0)
+          {
+            std::memcpy(&sample->data[header.offset], payload, size);
+          }
+        if (sample->fecGroup != 0)
+          {
+            recover(*sample, header.index / sample->fecGroup);
+          }
+      }
+    if (sample->remaining > 0) { return nullptr; }
+
+    // completed
+    if (stream.started)
+      {
+        m_stats.lost += header.sequence - stream.delivered - 1;
+      }
+    stream.started = true;
+    stream.delivered = header.sequence;
+    ++m_stats.received;
+    sample->used = false;
+    // the data are handed to the caller and the rest is released
+    m_delivered.swap(sample->data);
+    release(*sample);
+    for (auto& s : stream.samples)
+      {
+        if (s.used &&
+            static_cast<int32_t>(s.sequence - header.sequence) < 0)
+          {
+            discard(s);
+          }
+      }
+    return &m_delivered;
+  }
+
+  /*!
+   * @if jp
+   * @brief タイムアウトしたサンプルと送信者を破棄する
+   * @else
+   * @brief Discard the timed out samples and senders
+   * @endif
+   */
+  void UDPReassembler::expire()
+  {
+    Clock::time_point now(Clock::now());
+    for (auto it(m_streams.begin()); it != m_streams.end();)
+      {
+        bool idle(now - it->second.active > m_senderTimeout);
+        for (auto& sample : it->second.samples)
+          {
+            if (sample.used && (idle || now - sample.begin > m_timeout))
+              {
+                discard(sample);
+              }
+          }
+        if (idle)
+          {
+            it = m_streams.erase(it);
+          }
+        else
+          {
+            ++it;
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信者の受信状態を取得する
+   *
+   * 新しい送信者の場合は受信状態を追加する。送信者数が上限に達してい
+   * る場合は、最も長く受信のない送信者が再構成のタイムアウトを超えて
+   * 受信していなければそれを破棄し、そうでなければ nullptr を返す。
+   *
+   * @else
+   * @brief Get the reception state of a sender
+   *
+   * The state is added for a new sender. If the number of senders
+   * reaches the limit, the least recently active sender is removed if
+   * it has received nothing for longer than the reassembly timeout,
+   * and otherwise nullptr is returned.
+   *
+   * @endif
+   */
+  UDPReassembler::Stream*
+  UDPReassembler::findStream(uint32_t sender, Clock::time_point now)
+  {
+    auto it(m_streams.find(sender));
+    if (it != m_streams.end()) { return &it->second; }
+
+    if (m_streams.size() >= m_maxSenders)
+      {
+        auto idle(m_streams.begin());
+        for (auto s(m_streams.begin()); s != m_streams.end(); ++s)
+          {
+            if (s->second.active < idle->second.active) { idle = s; }
+          }
+        if (now - idle->second.active <= m_timeout) { return nullptr; }
+        for (auto& sample : idle->second.samples)
+          {
+            if (sample.used) { discard(sample); }
+          }
+        m_streams.erase(idle);
+      }
+    Stream& stream(m_streams[sender]);
+    stream.active = now;
+    return &stream;
+  }
+
+  /*!
+   * @if jp
+   * @brief フラグメントが属する受信中のサンプルを取得する
+   *
+   * 新しいサンプルの場合は空いているバッファを割り当て、空きがなけれ
+   * ば最も古いサンプルを破棄する。
+   *
+   * @else
+   * @brief Get the sample in reception which the fragment belongs to
+   *
+   * A free buffer is assigned to a new sample, and the oldest sample
+   * is discarded if no buffer is free.
+   *
+   * @endif
+   */
+  UDPReassembler::Sample*
+  UDPReassembler::findSample(Stream& stream, const UDPFragmentHeader& header,
+                             size_t size)
+  {
+    Clock::time_point now(Clock::now());
+    Sample* free(nullptr);
+    Sample* oldest(nullptr);
+    for (auto& sample : stream.samples)
+      {
+        if (sample.used && now - sample.begin > m_timeout)
+          {
+            discard(sample);
+          }
+        if (!sample.used)
+          {
+            if (free == nullptr) { free = &sample; }
+            continue;
+          }
+        if (sample.sequence == header.sequence)
+          {
+            if (sample.received.size() != header.count ||
+                sample.data.size() != header.length ||
+                !isConsistent(sample.payloadSize, header, size))
+              {
+                ++m_stats.invalid;
+                return nullptr;
+              }
+            return &sample;
+          }
+        if (oldest == nullptr ||
+            static_cast<int32_t>(sample.sequence - oldest->sequence) < 0)
+          {
+            oldest = &sample;
+          }
+      }
+
+    // the length is checked before allocating the buffer
+    size_t payload(0);
+    if (header.length > m_maxSampleSize ||
+        !getPayloadSize(header, size, payload))
+      {
+        ++m_stats.invalid;
+        return nullptr;
+      }
+
+    if (free == nullptr)
+      {
+        if (stream.samples.size() < m_maxSamples)
+          {
+            stream.samples.reserve(m_maxSamples);
+            stream.samples.emplace_back();
+            free = &stream.samples.back();
+          }
+        else
+          {
+            discard(*oldest);
+            free = oldest;
+          }
+      }
+    free->used = true;
+    free->sequence = header.sequence;
+    free->begin = now;
+    free->remaining = header.count;
+    free->payloadSize = payload;
+    free->received.assign(header.count, false);
+    // the buffer of the sample returned last is no longer referred to
+    if (free->data.capacity() == 0) { free->data.swap(m_delivered); }
+    free->data.resize(header.length);
+    free->fecGroup = 0;
+    free->paritySize = 0;
+    return free;
+  }
+
+  /*!
+   * @if jp
+   * @brief サンプルの最初のフラグメントからフラグメントのデータ長を求める
+   *
+   * サンプルの長さがフラグメント数とデータ長に矛盾しないことを確認す
+   * る。フラグメントが一つの場合のデータ長は 0 とする。
+   *
+   * @else
+   * @brief Get the payload size of fragments from the first fragment of
+   *        a sample
+   *
+   * It is checked that the length of the sample is consistent with the
+   * number and the payload size of the fragments. The payload size is
+   * 0 if the sample has only one fragment.
+   *
+   * @endif
+   */
+  bool UDPReassembler::getPayloadSize(const UDPFragmentHeader& header,
+                                      size_t size, size_t& payload)
+  {
+    size_t count(header.count);
+    size_t length(header.length);
+    payload = 0;
+    if (count == 1) { return isConsistent(payload, header, size); }
+
+    if ((header.flags & UDPFragmentHeader::parity) != 0 ||
+        header.index + 1u < count)
+      {
+        payload = size;
+      }
+    else
+      {
+        // the last data fragment is at index * payload
+        if (header.offset % header.index != 0) { return false; }
+        payload = header.offset / header.index;
+      }
+    return payload > 0 &&
+      (count - 1) * payload < length && length <= count * payload &&
+      isConsistent(payload, header, size);
+  }
+
+  /*!
+   * @if jp
+   * @brief フラグメントがサンプルのフラグメントの配置に一致するか確認する
+   * @else
+   * @brief Check if a fragment matches the layout of the fragments of a
+   *        sample
+   * @endif
+   */
+  bool UDPReassembler::isConsistent(size_t payload,
+                                    const UDPFragmentHeader& header,
+                                    size_t size)
+  {
+    bool is_parity((header.flags & UDPFragmentHeader::parity) != 0);
+    if (header.count == 1)
+      {
+        // a parity has the payload size of the sender
+        return is_parity ? size >= header.length :
+          header.offset == 0 && size == header.length;
+      }
+    if (is_parity) { return size == payload; }
+    size_t offset(static_cast<size_t>(header.index) * payload);
+    return header.offset == offset &&
+      size == std::min(payload, static_cast<size_t>(header.length) - offset);
+  }
+
+  /*!
+   * @if jp
+   * @brief パリティフラグメントを保存する
+   * @else
+   * @brief Store a parity fragment
+   * @endif
+   */
+  bool UDPReassembler::addParity(Sample& sample, const UDPFragmentHeader& header,
+                                 const unsigned char* payload, size_t length)
+  {
+    size_t count(sample.received.size());
+    if (sample.fecGroup == 0)
+      {
+        // the parity has the size of the data fragments but the last,
+        // or covers the whole sample if it has only one fragment
+        if (length == 0 || (sample.payloadSize != 0 ?
+                            length != sample.payloadSize :
+                            length < sample.data.size()))
+          {
+            ++m_stats.invalid;
+            return false;
+          }
+        sample.fecGroup = header.offset;
+        sample.paritySize = length;
+        size_t groups((count + sample.fecGroup - 1) / sample.fecGroup);
+        sample.parityReceived.assign(groups, false);
+        sample.parity.resize(groups * length);
+      }
+    else if (sample.fecGroup != header.offset || sample.paritySize != length)
+      {
+        ++m_stats.invalid;
+        return false;
+      }
+
+    size_t group(header.index / sample.fecGroup);
+    if (sample.parityReceived[group]) { return false; }
+    std::memcpy(&sample.parity[group * length], payload, length);
+    sample.parityReceived[group] = true;
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief グループ内で一つだけ欠けたフラグメントをパリティから回復する
+   * @else
+   * @brief Recover the only missing fragment of a group from the parity
+   * @endif
+   */
+  void UDPReassembler::recover(Sample& sample, size_t group)
+  {
+    if (!sample.parityReceived[group]) { return; }
+
+    size_t count(sample.received.size());
+    size_t first(group * sample.fecGroup);
+    size_t last(std::min(first + sample.fecGroup, count));
+    size_t missing(count);
+    for (size_t i(first); i < last; ++i)
+      {
+        if (sample.received[i]) { continue; }
+        if (missing != count) { return; }  // two or more are missing
+        missing = i;
+      }
+    if (missing == count) { return; }
+
+    size_t psize(sample.paritySize);
+    size_t length(sample.data.size());
+    m_scratch.assign(sample.parity.begin() + group * psize,
+                     sample.parity.begin() + (group + 1) * psize);
+    for (size_t i(first); i < last; ++i)
+      {
+        if (i == missing) { continue; }
+        size_t offset(i * psize);
+        size_t size(std::min(psize, length - offset));
+        for (size_t j(0); j < size; ++j) { m_scratch[j] ^= sample.data[offset + j]; }
+      }
+    size_t offset(missing * psize);
+    size_t size(std::min(psize, length - offset));
+    if (size > 0) { std::memcpy(&sample.data[offset], m_scratch.data(), size); }
+    sample.received[missing] = true;
+    --sample.remaining;
+    ++m_stats.recovered;
+  }
+
+  /*!
+   * @if jp
+   * @brief 未完成のサンプルを破棄する
+   * @else
+   * @brief Discard an incomplete sample
+   * @endif
+   */
+  void UDPReassembler::discard(Sample& sample)
+  {
+    sample.used = false;
+    ++m_stats.discarded;
+    release(sample);
+  }
+
+  /*!
+   * @if jp
+   * @brief サンプルのバッファを解放する
+   * @else
+   * @brief Release the buffers of a sample
+   * @endif
+   */
+  void UDPReassembler::release(Sample& sample)
+  {
+    std::vector<unsigned char>().swap(sample.data);
+    std::vector<bool>().swap(sample.received);
+    std::vector<bool>().swap(sample.parityReceived);
+    std::vector<unsigned char>().swap(sample.parity);
+  }
+} // namespace RTC
@@ -0,0 +1,417 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPFragment.h
+ * @brief Fragmentation and reassembly of UDP samples
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_UDPFRAGMENT_H
+#define RTC_UDPFRAGMENT_H
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief フラグメントのヘッダ
+   *
+   * 全てのデータグラムの先頭に付けられる 24 バイトのヘッダ。全ての値
+   * はネットワークバイトオーダで格納される。
+   *
+   * | bytes | 内容                                     |
+   * |-------|------------------------------------------|
+   * | 2     | マジック "RU"                            |
+   * | 1     | バージョン                               |
+   * | 1     | フラグ                                   |
+   * | 4     | 送信者ID                                 |
+   * | 4     | サンプルのシーケンス番号                 |
+   * | 2     | フラグメント番号                         |
+   * | 2     | フラグメント数                           |
+   * | 4     | サンプルの長さ                           |
+   * | 4     | サンプル内のフラグメントのオフセット     |
+   *
+   * フラグに parity が立っているフラグメントは FEC のパリティであり、
+   * フラグメント番号はパリティが対象とするグループの最初のデータフラ
+   * グメントの番号、オフセットはグループのフラグメント数を表す。
+   *
+   * @else
+   * @brief Header of a fragment
+   *
+   * The 24 bytes header put at the beginning of every datagram. All
+   * the values are stored in network byte order.
+   *
+   * | bytes | contents                                 |
+   * |-------|------------------------------------------|
+   * | 2     | magic "RU"                               |
+   * | 1     | version                                  |
+   * | 1     | flags                                    |
+   * | 4     | sender ID                                |
+   * | 4     | sequence number of the sample            |
+   * | 2     | fragment index                           |
+   * | 2     | number of fragments                      |
+   * | 4     | length of the sample                     |
+   * | 4     | offset of the fragment in the sample     |
+   *
+   * A fragment with the parity flag is the FEC parity. Its fragment
+   * index is the index of the first data fragment of the group
+   * covered by the parity, and its offset is the number of fragments
+   * of a group.
+   *
+   * @endif
+   */
+  struct UDPFragmentHeader
+  {
+    static const size_t size = 24;
+    static const unsigned char version = 1;
+    static const uint8_t parity = 0x01;
+
+    uint8_t flags{0};
+    uint32_t senderId{0};
+    uint32_t sequence{0};
+    uint16_t index{0};
+    uint16_t count{0};
+    uint32_t length{0};
+    uint32_t offset{0};
+
+    void write(unsigned char* buf) const;
+    bool read(const unsigned char* buf, size_t length);
+  };
+
+  /*!
+   * @if jp
+   * @class UDPFragmentSender
+   * @brief サンプルをフラグメントに分割して送信する
+   *
+   * MTU に収まるようにサンプルを分割し、ヘッダとデータの iovec で構
+   * 成したメッセージを sendmmsg() でまとめて送信する。データはコピー
+   * されない。送信者ID は生成時に乱数で決められ、シーケンス番号はサン
+   * プル毎に増加する。
+   *
+   * FEC を有効にした場合は、連続する N 個のデータフラグメント毎にそれ
+   * らの XOR をパリティフラグメントとして送信する。受信側は各グルー
+   * プで一つまでの損失を回復できる。
+   *
+   * @else
+   * @class UDPFragmentSender
+   * @brief Send a sample divided into fragments
+   *
+   * A sample is divided so that every datagram fits in the MTU, and
+   * the messages made of the iovecs of the header and the data are
+   * sent together by sendmmsg(). The data are not copied. The sender
+   * ID is chosen randomly on construction, and the sequence number is
+   * incremented for each sample.
+   *
+   * If FEC is enabled, the XOR of every N consecutive data fragments
+   * is sent as a parity fragment. The receiver can recover one lost
+   * fragment in each group.
+   *
+   * @endif
+   */
+  class UDPFragmentSender
+  {
+  public:
+    UDPFragmentSender();
+
+    /*!
+     * @if jp
+     * @brief MTU を設定する
+     *
+     * IPv4 と UDP のヘッダ (28 バイト) とフラグメントのヘッダを除いた
+     * 残りがフラグメントのデータ長になる。
+     *
+     * @param mtu MTU (バイト)
+     * @else
+     * @brief Set the MTU
+     *
+     * The payload of a fragment is the rest of the MTU excluding the
+     * IPv4 and UDP headers (28 bytes) and the fragment header.
+     *
+     * @param mtu MTU in bytes
+     * @endif
+     */
+    void setMTU(size_t mtu);
+
+    /*!
+     * @if jp
+     * @brief FEC のグループサイズを設定する
+     * @param group パリティ一つあたりのデータフラグメント数。0 の場合
+     *              FEC を使用しない。
+     * @else
+     * @brief Set the group size of FEC
+     * @param group Number of data fragments per parity. FEC is not
+     *              used if 0.
+     * @endif
+     */
+    void setFECGroup(size_t group);
+
+    /*!
+     * @if jp
+     * @brief 一つのフラグメントのデータ長を取得する
+     * @else
+     * @brief Get the payload size of a fragment
+     * @endif
+     */
+    size_t getPayloadSize() const { return m_payloadSize; }
+
+    /*!
+     * @if jp
+     * @brief サンプルを送信する
+     *
+     * @param fd ソケット
+     * @param addr 送信先アドレス
+     * @param addrlen 送信先アドレスの長さ
+     * @param data サンプルのデータ
+     * @param length サンプルの長さ
+     * @return 全てのフラグメントを送信した場合 true
+     *
+     * @else
+     * @brief Send a sample
+     *
+     * @param fd Socket
+     * @param addr Destination address
+     * @param addrlen Length of the destination address
+     * @param data Data of the sample
+     * @param length Length of the sample
+     * @return true if all the fragments were sent
+     *
+     * @endif
+     */
+    bool send(int fd, const sockaddr* addr, socklen_t addrlen,
+              const unsigned char* data, size_t length);
+
+  private:
+    uint32_t m_senderId;
+    uint32_t m_sequence{0};
+    size_t m_payloadSize;
+    size_t m_fecGroup{0};
+    // reused between samples to avoid allocation
+    std::vector<unsigned char> m_headers;
+    std::vector<unsigned char> m_parity;
+    std::vector<iovec> m_iov;
+    std::vector<mmsghdr> m_msgs;
+  };
+
+  /*!
+   * @if jp
+   * @class UDPReassembler
+   * @brief フラグメントからサンプルを再構成する
+   *
+   * 送信者毎に最大 max_samples 個の受信中のサンプルを保持し、順不同
+   * に届くフラグメントから再構成する。完成したサンプルは直ちに返され、
+   * それより古い未完成のサンプルは破棄される。受信開始からタイムアウ
+   * ト時間が経過しても完成しないサンプルも破棄される。パリティフラグ
+   * メントを受信した場合は、グループ内で一つだけ欠けたフラグメントを
+   * 回復する。
+   *
+   * シーケンス番号の欠落は損失として数えられる。サンプルの長さが
+   * max_sample_size を超える場合や、フラグメント数とフラグメントのデー
+   * タ長に矛盾する場合は、バッファを確保する前に不正なデータグラムと
+   * して捨てられる。再構成用のバッファはサンプルの完成または破棄の時
+   * 点で解放され、最後に返したサンプルのバッファだけが次のサンプルに
+   * 再利用される。
+   *
+   * 送信者は最大 max_senders 人まで保持する。sender_timeout の間フラ
+   * グメントが届かない送信者は破棄される。送信者数が上限に達している
+   * 場合、新しい送信者は最も長く受信のない送信者が再構成のタイムアウ
+   * トを超えて受信していなければそれと置き換えられ、そうでなければそ
+   * のフラグメントは捨てられる。
+   *
+   * @else
+   * @class UDPReassembler
+   * @brief Reassemble samples from fragments
+   *
+   * Up to max_samples samples in reception are kept for each sender,
+   * and reassembled from fragments arriving in any order. A completed
+   * sample is returned at once, and older incomplete samples are
+   * discarded. Samples which are not completed within the timeout
+   * from the first fragment are also discarded. When parity fragments
+   * are received, a single missing fragment in a group is recovered.
+   *
+   * Gaps of the sequence numbers are counted as lost. If the length of
+   * a sample exceeds max_sample_size or is inconsistent with the number
+   * and the payload size of the fragments, the datagram is dropped as
+   * invalid before a buffer is allocated. The buffers for reassembly
+   * are released when a sample is completed or discarded, and only the
+   * buffer of the last returned sample is reused for the next sample.
+   *
+   * Up to max_senders senders are kept. A sender from which no
+   * fragment arrives for sender_timeout is removed. When the number of
+   * senders reaches the limit, a new sender replaces the least
+   * recently active one if that one has received nothing for longer
+   * than the reassembly timeout, and otherwise its fragments are
+   * dropped.
+   *
+   * @endif
+   */
+  class UDPReassembler
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /*!
+     * @if jp
+     * @brief 受信統計
+     * @else
+     * @brief Reception statistics
+     * @endif
+     */
+    struct Statistics
+    {
+      //! delivered samples
+      unsigned long long received{0};
+      //! gaps of the sequence numbers of the delivered samples
+      unsigned long long lost{0};
+      //! data fragments of samples already delivered or discarded
+      unsigned long long duplicated{0};
+      //! received fragments including parities
+      unsigned long long fragments{0};
+      //! malformed datagrams
+      unsigned long long invalid{0};
+      //! incomplete samples discarded by timeout or by a newer sample
+      unsigned long long discarded{0};
+      //! fragments recovered by FEC
+      unsigned long long recovered{0};
+      //! fragments of new senders dropped because of max_senders
+      unsigned long long rejected{0};
+    };
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @param max_samples 送信者毎に同時に再構成するサンプル数
+     * @param timeout サンプルの再構成のタイムアウト
+     * @param max_sample_size サンプルの最大長
+     * @param max_senders 同時に保持する送信者数
+     * @param sender_timeout 受信のない送信者を破棄するまでの時間
+     * @else
+     * @brief Constructor
+     * @param max_samples Number of samples reassembled at the same
+     *                    time for each sender
+     * @param timeout Timeout of the reassembly of a sample
+     * @param max_sample_size Maximum length of a sample
+     * @param max_senders Number of senders kept at the same time
+     * @param sender_timeout Time until a sender with no reception is
+     *                       removed
+     * @endif
+     */
+    explicit UDPReassembler(size_t max_samples = 4,
+                            std::chrono::milliseconds timeout
+                            = std::chrono::milliseconds(100),
+                            size_t max_sample_size = 16777216,
+                            size_t max_senders = 16,
+                            std::chrono::milliseconds sender_timeout
+                            = std::chrono::milliseconds(10000));
+
+    /*!
+     * @if jp
+     * @brief データグラムを追加する
+     *
+     * @param datagram 受信したデータグラム
+     * @param length データグラムの長さ
+     * @return サンプルが完成した場合そのデータ、それ以外は nullptr。
+     *         データは次に push() を呼ぶまで有効。
+     *
+     * @else
+     * @brief Add a datagram
+     *
+     * @param datagram Received datagram
+     * @param length Length of the datagram
+     * @return The data of the sample if completed, otherwise
+     *         nullptr. The data are valid until the next call of
+     *         push().
+     *
+     * @endif
+     */
+    const std::vector<unsigned char>* push(const unsigned char* datagram,
+                                           size_t length);
+
+    /*!
+     * @if jp
+     * @brief タイムアウトしたサンプルと送信者を破棄する
+     * @else
+     * @brief Discard the timed out samples and senders
+     * @endif
+     */
+    void expire();
+
+    /*!
+     * @if jp
+     * @brief 受信統計を取得する
+     * @else
+     * @brief Get the reception statistics
+     * @endif
+     */
+    const Statistics& getStatistics() const { return m_stats; }
+
+  private:
+    struct Sample
+    {
+      bool used{false};
+      uint32_t sequence{0};
+      Clock::time_point begin;
+      size_t remaining{0};
+      // payload size of every data fragment but the last, 0 if single
+      size_t payloadSize{0};
+      std::vector<bool> received;
+      std::vector<unsigned char> data;
+      // FEC
+      size_t fecGroup{0};
+      size_t paritySize{0};
+      std::vector<bool> parityReceived;
+      std::vector<unsigned char> parity;
+    };
+    struct Stream
+    {
+      bool started{false};
+      uint32_t delivered{0};
+      // the last valid fragment
+      Clock::time_point active;
+      std::vector<Sample> samples;
+    };
+
+    Stream* findStream(uint32_t sender, Clock::time_point now);
+    Sample* findSample(Stream& stream, const UDPFragmentHeader& header,
+                       size_t size);
+    static bool getPayloadSize(const UDPFragmentHeader& header, size_t size,
+                               size_t& payload);
+    static bool isConsistent(size_t payload, const UDPFragmentHeader& header,
+                             size_t size);
+    bool addParity(Sample& sample, const UDPFragmentHeader& header,
+                   const unsigned char* payload, size_t length);
+    void recover(Sample& sample, size_t group);
+    void discard(Sample& sample);
+    static void release(Sample& sample);
+
+    size_t m_maxSamples;
+    std::chrono::milliseconds m_timeout;
+    size_t m_maxSampleSize;
+    size_t m_maxSenders;
+    std::chrono::milliseconds m_senderTimeout;
+    std::unordered_map<uint32_t, Stream> m_streams;
+    // the sample returned last, reused for the next sample
+    std::vector<unsigned char> m_delivered;
+    std::vector<unsigned char> m_scratch;
+    Statistics m_stats;
+  };
+} // namespace RTC
+
+#endif  // RTC_UDPFRAGMENT_H
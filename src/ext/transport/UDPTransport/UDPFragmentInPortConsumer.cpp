@@ -0,0 +1,228 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPFragmentInPortConsumer.cpp
+ * @brief UDPFragmentInPortConsumer class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "UDPFragmentInPortConsumer.h"
+
+#include <rtm/NVUtil.h>
+#include <coil/stringutil.h>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  UDPFragmentInPortConsumer::UDPFragmentInPortConsumer()
+    : rtclog("UDPFragmentInPortConsumer")
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  UDPFragmentInPortConsumer::~UDPFragmentInPortConsumer()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    close();
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void UDPFragmentInPortConsumer::init(coil::Properties& prop)
+  {
+    RTC_TRACE(("init()"));
+    size_t mtu(1500);
+    if (!coil::stringTo(mtu, prop.getProperty("udp_fragment.mtu", "1500").c_str()))
+      {
+        RTC_WARN(("Invalid udp_fragment.mtu: %s",
+                  prop["udp_fragment.mtu"].c_str()));
+        mtu = 1500;
+      }
+    size_t fec(0);
+    if (!coil::stringTo(fec, prop.getProperty("udp_fragment.fec", "0").c_str()))
+      {
+        RTC_WARN(("Invalid udp_fragment.fec: %s",
+                  prop["udp_fragment.fec"].c_str()));
+        fec = 0;
+      }
+    if (!coil::stringTo(m_sendBuffer, prop.getProperty("udp_fragment.send_buffer", "0").c_str()))
+      {
+        RTC_WARN(("Invalid udp_fragment.send_buffer: %s",
+                  prop["udp_fragment.send_buffer"].c_str()));
+        m_sendBuffer = 0;
+      }
+    m_sender.setMTU(mtu);
+    m_sender.setFECGroup(fec);
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続先へのデータ送信
+   * @else
+   * @brief Send data to the destination port
+   * @endif
+   */
+  DataPortStatus UDPFragmentInPortConsumer::put(ByteData& data)
+  {
+    RTC_PARANOID(("put()"));
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_fd < 0) { return DataPortStatus::CONNECTION_LOST; }
+
+    if (!m_sender.send(m_fd, reinterpret_cast<const sockaddr*>(&m_addr),
+                       sizeof(m_addr), data.getBuffer(), data.getDataLength()))
+      {
+        RTC_WARN(("sendmmsg() failed: %s", std::strerror(errno)));
+        return DataPortStatus::PORT_ERROR;
+      }
+    return DataPortStatus::PORT_OK;
+  }
+
+  /*!
+   * @if jp
+   * @brief InterfaceProfile情報を公開する
+   * @else
+   * @brief Publish InterfaceProfile information
+   * @endif
+   */
+  void UDPFragmentInPortConsumer::
+  publishInterfaceProfile(SDOPackage::NVList& /*properties*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief データ送信通知への登録
+   * @else
+   * @brief Subscribe to the data sending notification
+   * @endif
+   */
+  bool UDPFragmentInPortConsumer::
+  subscribeInterface(const SDOPackage::NVList& properties)
+  {
+    RTC_TRACE(("subscribeInterface()"));
+    RTC_DEBUG_STR((NVUtil::toString(properties)));
+
+    CORBA::Long index(NVUtil::find_index(properties,
+                                         "dataport.udp_fragment.address"));
+    if (index < 0)
+      {
+        RTC_ERROR(("dataport.udp_fragment.address not found."));
+        return false;
+      }
+    const char* value(nullptr);
+    if (!(properties[index].value >>= value))
+      {
+        RTC_ERROR(("dataport.udp_fragment.address is not a string."));
+        return false;
+      }
+    std::string endpoint(value);
+    std::string::size_type pos(endpoint.rfind(':'));
+    if (pos == std::string::npos)
+      {
+        RTC_ERROR(("Invalid udp_fragment address: %s", endpoint.c_str()));
+        return false;
+      }
+
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* res(nullptr);
+    int err(::getaddrinfo(endpoint.substr(0, pos).c_str(),
+                          endpoint.substr(pos + 1).c_str(), &hints, &res));
+    if (err != 0)
+      {
+        RTC_ERROR(("getaddrinfo(%s) failed: %s",
+                   endpoint.c_str(), ::gai_strerror(err)));
+        return false;
+      }
+    sockaddr_in addr;
+    std::memcpy(&addr, res->ai_addr, sizeof(addr));
+    ::freeaddrinfo(res);
+
+    int fd(::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0));
+    if (fd < 0)
+      {
+        RTC_ERROR(("socket() failed: %s", std::strerror(errno)));
+        return false;
+      }
+    if (m_sendBuffer > 0)
+      {
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF,
+                     &m_sendBuffer, sizeof(m_sendBuffer));
+      }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    close();
+    m_fd = fd;
+    m_addr = addr;
+    RTC_DEBUG(("udp_fragment destination: %s", endpoint.c_str()));
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief データ送信通知からの登録解除
+   * @else
+   * @brief Unsubscribe the data send notification
+   * @endif
+   */
+  void UDPFragmentInPortConsumer::
+  unsubscribeInterface(const SDOPackage::NVList& /*properties*/)
+  {
+    RTC_TRACE(("unsubscribeInterface()"));
+    std::lock_guard<std::mutex> guard(m_mutex);
+    close();
+  }
+
+  //----------------------------------------------------------------------
+  // private functions
+
+  /*!
+   * @if jp
+   * @brief ソケットを閉じる
+   * @else
+   * @brief Close the socket
+   * @endif
+   */
+  void UDPFragmentInPortConsumer::close()
+  {
+    if (m_fd < 0) { return; }
+    ::close(m_fd);
+    m_fd = -1;
+  }
+} // namespace RTC
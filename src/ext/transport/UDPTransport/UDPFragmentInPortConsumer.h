@@ -0,0 +1,174 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPFragmentInPortConsumer.h
+ * @brief UDPFragmentInPortConsumer class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_UDPFRAGMENTINPORTCONSUMER_H
+#define RTC_UDPFRAGMENTINPORTCONSUMER_H
+
+#include <rtm/InPortConsumer.h>
+#include <rtm/SystemLogger.h>
+
+#include "UDPFragment.h"
+
+#include <netinet/in.h>
+
+#include <mutex>
+#include <string>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class UDPFragmentInPortConsumer
+   * @brief UDPFragmentInPortConsumer クラス
+   *
+   * UDPFragmentInPortProvider が公開するアドレス
+   * "dataport.udp_fragment.address" に、サンプルを UDPFragmentSender
+   * でフラグメントに分割して送信する InPort コンシューマ。
+   *
+   * init() に渡されるプロパティ (コネクタプロファイルの
+   * dataport.consumer.*)
+   * - udp_fragment.mtu: MTU (デフォルト 1500)
+   * - udp_fragment.fec: FEC のパリティ一つあたりのフラグメント数。0
+   *   (デフォルト) の場合は FEC を使用しない。
+   * - udp_fragment.send_buffer: ソケットの送信バッファサイズ
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class UDPFragmentInPortConsumer
+   * @brief UDPFragmentInPortConsumer class
+   *
+   * The InPort consumer which sends samples divided into fragments by
+   * UDPFragmentSender to the address "dataport.udp_fragment.address"
+   * published by UDPFragmentInPortProvider.
+   *
+   * Properties given to init() (dataport.consumer.* of the connector
+   * profile)
+   * - udp_fragment.mtu: MTU (default 1500)
+   * - udp_fragment.fec: Number of fragments per FEC parity. FEC is
+   *   not used if 0 (default).
+   * - udp_fragment.send_buffer: Send buffer size of the socket
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class UDPFragmentInPortConsumer
+    : public InPortConsumer
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    UDPFragmentInPortConsumer();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~UDPFragmentInPortConsumer() override;
+
+    /*!
+     * @if jp
+     * @brief 設定初期化
+     * @param prop 設定情報
+     * @else
+     * @brief Initializing configuration
+     * @param prop Configuration information
+     * @endif
+     */
+    void init(coil::Properties& prop) override;
+
+    /*!
+     * @if jp
+     * @brief 接続先へのデータ送信
+     *
+     * @param data 送信するデータ
+     * @return リターンコード
+     *         PORT_OK         正常終了
+     *         PORT_ERROR      送信に失敗した
+     *         CONNECTION_LOST 接続されていない
+     *
+     * @else
+     * @brief Send data to the destination port
+     *
+     * @param data The data that will be sent
+     * @return Return code
+     *         PORT_OK         Normal return
+     *         PORT_ERROR      Failed to send
+     *         CONNECTION_LOST Not connected
+     *
+     * @endif
+     */
+    DataPortStatus put(ByteData& data) override;
+
+    /*!
+     * @if jp
+     * @brief InterfaceProfile情報を公開する
+     * @param properties InterfaceProfile情報を受け取るプロパティ
+     * @else
+     * @brief Publish InterfaceProfile information
+     * @param properties Properties to get InterfaceProfile information
+     * @endif
+     */
+    void publishInterfaceProfile(SDOPackage::NVList& properties) override;
+
+    /*!
+     * @if jp
+     * @brief データ送信通知への登録
+     * @param properties 登録情報
+     * @return 登録処理結果(登録成功:true、登録失敗:false)
+     * @else
+     * @brief Subscribe to the data sending notification
+     * @param properties Information for subscription
+     * @return Subscription result (Successful:true, Failed:false)
+     * @endif
+     */
+    bool subscribeInterface(const SDOPackage::NVList& properties) override;
+
+    /*!
+     * @if jp
+     * @brief データ送信通知からの登録解除
+     * @param properties 登録解除情報
+     * @else
+     * @brief Unsubscribe the data send notification
+     * @param properties Information for unsubscription
+     * @endif
+     */
+    void unsubscribeInterface(const SDOPackage::NVList& properties) override;
+
+  private:
+    void close();
+
+    mutable Logger rtclog;
+    std::mutex m_mutex;
+    int m_fd{-1};
+    int m_sendBuffer{0};
+    sockaddr_in m_addr{};
+    UDPFragmentSender m_sender;
+  };  // class UDPFragmentInPortConsumer
+} // namespace RTC
+
+#endif  // RTC_UDPFRAGMENTINPORTCONSUMER_H
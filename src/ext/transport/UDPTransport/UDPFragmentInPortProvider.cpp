@@ -0,0 +1,121 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPFragmentInPortProvider.cpp
+ * @brief UDPFragmentInPortProvider class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "UDPFragmentInPortProvider.h"
+
+#include <rtm/CORBA_SeqUtil.h>
+#include <rtm/NVUtil.h>
+#include <coil/Routing.h>
+#include <coil/stringutil.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  UDPFragmentInPortProvider::UDPFragmentInPortProvider()
+  {
+    // PortProfile setting
+    setInterfaceType("udp_fragment");
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  UDPFragmentInPortProvider::~UDPFragmentInPortProvider() = default;
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void UDPFragmentInPortProvider::init(coil::Properties& prop)
+  {
+    if (isReceiving()) { return; }
+
+    std::string host(prop.getProperty("udp_fragment.host"));
+    if (host.empty() && !coil::default_ipaddr(host)) { host = "127.0.0.1"; }
+    unsigned short port(0);
+    if (!coil::stringTo(port, prop.getProperty("udp_fragment.port", "0").c_str()))
+      {
+        RTC_ERROR(("Invalid udp_fragment.port: %s",
+                   prop["udp_fragment.port"].c_str()));
+        return;
+      }
+    int rcvbuf(4194304);
+    if (!coil::stringTo(rcvbuf, prop.getProperty("udp_fragment.receive_buffer", "4194304").c_str()))
+      {
+        RTC_WARN(("Invalid udp_fragment.receive_buffer: %s",
+                  prop["udp_fragment.receive_buffer"].c_str()));
+        rcvbuf = 4194304;
+      }
+
+    int fd(::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0));
+    if (fd < 0)
+      {
+        RTC_ERROR(("socket() failed: %s", std::strerror(errno)));
+        return;
+      }
+    if (rcvbuf > 0)
+      {
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+      }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    socklen_t len(sizeof(addr));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), len) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) != 0)
+      {
+        RTC_ERROR(("Failed to bind the receiving socket: %s",
+                   std::strerror(errno)));
+        ::close(fd);
+        return;
+      }
+    if (!startReceiving(fd, prop, "udp_fragment"))
+      {
+        RTC_ERROR(("Failed to start receiving: %s", std::strerror(errno)));
+        return;
+      }
+
+    std::string endpoint(host + ":" + std::to_string(ntohs(addr.sin_port)));
+    RTC_DEBUG(("udp_fragment endpoint: %s", endpoint.c_str()));
+    CORBA_SeqUtil::push_back(m_properties,
+                             NVUtil::newNV("dataport.udp_fragment.address",
+                                           endpoint.c_str()));
+  }
+} // namespace RTC
@@ -0,0 +1,123 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPFragmentInPortProvider.h
+ * @brief UDPFragmentInPortProvider class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_UDPFRAGMENTINPORTPROVIDER_H
+#define RTC_UDPFRAGMENTINPORTPROVIDER_H
+
+#include "UDPInPortProviderBase.h"
+
+#include <string>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class UDPFragmentInPortProvider
+   * @brief UDPFragmentInPortProvider クラス
+   *
+   * UDP ユニキャストでフラグメントに分割されたサンプルを受信する
+   * InPort プロバイダ。init() で UDP ソケットを開き、そのアドレスを
+   * "dataport.udp_fragment.address" として ConnectorProfile で公開す
+   * る。一つのデータグラムに収まらない大きなサンプルも、低遅延の信頼
+   * 性のない配送で受信できる。欠けたサンプルは再送されず、タイムアウ
+   * トで破棄される。
+   *
+   * init() に渡されるプロパティ (コネクタプロファイルの
+   * dataport.provider.*)
+   * - udp_fragment.host: 公開するホスト名またはアドレス。省略した場合
+   *   はループバック以外の最初の IPv4 アドレス。
+   * - udp_fragment.port: 受信ポート番号。0 または省略した場合は自動。
+   * - udp_fragment.receive_buffer: ソケットの受信バッファサイズ
+   *   (デフォルト 4194304)。カーネルの上限 (net.core.rmem_max) で制
+   *   限される。
+   * - udp_fragment.max_samples, udp_fragment.timeout,
+   *   udp_fragment.max_sample_size: UDPInPortProviderBase を参照
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class UDPFragmentInPortProvider
+   * @brief UDPFragmentInPortProvider class
+   *
+   * The InPort provider which receives samples divided into fragments
+   * by UDP unicast. init() opens a UDP socket and its address is
+   * published in ConnectorProfile as
+   * "dataport.udp_fragment.address". Large samples which do not fit
+   * in a datagram can be received by low latency unreliable
+   * delivery. Incomplete samples are not retransmitted but discarded
+   * by the timeout.
+   *
+   * Properties given to init() (dataport.provider.* of the connector
+   * profile)
+   * - udp_fragment.host: Host name or address to be published. The
+   *   first non-loopback IPv4 address if omitted.
+   * - udp_fragment.port: Receiving port number. Chosen automatically
+   *   if 0 or omitted.
+   * - udp_fragment.receive_buffer: Receive buffer size of the socket
+   *   (default 4194304). It is limited by the kernel
+   *   (net.core.rmem_max).
+   * - udp_fragment.max_samples, udp_fragment.timeout,
+   *   udp_fragment.max_sample_size: See UDPInPortProviderBase
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class UDPFragmentInPortProvider
+    : public UDPInPortProviderBase
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    UDPFragmentInPortProvider();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~UDPFragmentInPortProvider() override;
+
+    /*!
+     * @if jp
+     * @brief 設定初期化
+     *
+     * 受信ソケットを開き、アドレスを公開するプロパティに追加する。
+     *
+     * @param prop 設定情報
+     * @else
+     * @brief Initializing configuration
+     *
+     * This operation opens the receiving socket and adds its address
+     * to the properties to be published.
+     *
+     * @param prop Configuration information
+     * @endif
+     */
+    void init(coil::Properties& prop) override;
+  };  // class UDPFragmentInPortProvider
+} // namespace RTC
+
+#endif  // RTC_UDPFRAGMENTINPORTPROVIDER_H
@@ -0,0 +1,323 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPInPortProviderBase.cpp
+ * @brief UDPInPortProviderBase class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "UDPInPortProviderBase.h"
+
+#include <rtm/InPortConnector.h>
+#include <coil/stringutil.h>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  UDPInPortProviderBase::~UDPInPortProviderBase()
+  {
+    if (m_thread.joinable())
+      {
+        uint64_t one(1);
+        ssize_t ret(::write(m_wakeup, &one, sizeof(one)));
+        (void)ret;
+        m_thread.join();
+      }
+    if (m_fd >= 0)
+      {
+        UDPReassembler::Statistics stats(getStatistics());
+        RTC_INFO(("%s statistics: received %llu, lost %llu, duplicated %llu, "
+                  "fragments %llu, invalid %llu, discarded %llu, "
+                  "recovered %llu, rejected %llu", m_prefix.c_str(),
+                  stats.received, stats.lost, stats.duplicated,
+                  stats.fragments, stats.invalid, stats.discarded,
+                  stats.recovered, stats.rejected));
+        ::close(m_fd);
+      }
+    if (m_wakeup >= 0) { ::close(m_wakeup); }
+  }
+
+  /*!
+   * @if jp
+   * @brief バッファをセットする
+   * @else
+   * @brief Setting outside buffer's pointer
+   * @endif
+   */
+  void UDPInPortProviderBase::setBuffer(BufferBase<ByteData>* buffer)
+  {
+    m_buffer = buffer;
+  }
+
+  /*!
+   * @if jp
+   * @brief リスナを設定する
+   * @else
+   * @brief Set the listener
+   * @endif
+   */
+  void UDPInPortProviderBase::setListener(ConnectorInfo& info,
+                                          ConnectorListenersBase* listeners)
+  {
+    std::lock_guard<std::mutex> guard(m_connectorMutex);
+    m_profile = info;
+    m_listeners = listeners;
+  }
+
+  /*!
+   * @if jp
+   * @brief Connectorを設定する
+   * @else
+   * @brief set Connector
+   * @endif
+   */
+  void UDPInPortProviderBase::setConnector(InPortConnector* connector)
+  {
+    std::lock_guard<std::mutex> guard(m_connectorMutex);
+    m_connector = connector;
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信統計を取得する
+   * @else
+   * @brief Get the reception statistics
+   * @endif
+   */
+  UDPReassembler::Statistics UDPInPortProviderBase::getStatistics()
+  {
+    std::lock_guard<std::mutex> guard(m_statsMutex);
+    return m_stats;
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信を開始する
+   * @else
+   * @brief Start receiving
+   * @endif
+   */
+  bool UDPInPortProviderBase::startReceiving(int fd, coil::Properties& prop,
+                                             const std::string& prefix)
+  {
+    m_prefix = prefix;
+    size_t max_samples(4);
+    if (!coil::stringTo(max_samples,
+                        prop.getProperty(prefix + ".max_samples", "4").c_str()))
+      {
+        RTC_WARN(("Invalid %s.max_samples: %s", prefix.c_str(),
+                  prop[prefix + ".max_samples"].c_str()));
+        max_samples = 4;
+      }
+    unsigned int timeout(100);
+    if (!coil::stringTo(timeout,
+                        prop.getProperty(prefix + ".timeout", "100").c_str()))
+      {
+        RTC_WARN(("Invalid %s.timeout: %s", prefix.c_str(),
+                  prop[prefix + ".timeout"].c_str()));
+        timeout = 100;
+      }
+    size_t max_sample_size(16777216);
+    if (!coil::stringTo(max_sample_size,
+                        prop.getProperty(prefix + ".max_sample_size",
+                                         "16777216").c_str()))
+      {
+        RTC_WARN(("Invalid %s.max_sample_size: %s", prefix.c_str(),
+                  prop[prefix + ".max_sample_size"].c_str()));
+        max_sample_size = 16777216;
+      }
+    size_t max_senders(16);
+    if (!coil::stringTo(max_senders,
+                        prop.getProperty(prefix + ".max_senders", "16").c_str()))
+      {
+        RTC_WARN(("Invalid %s.max_senders: %s", prefix.c_str(),
+                  prop[prefix + ".max_senders"].c_str()));
+        max_senders = 16;
+      }
+    unsigned int sender_timeout(10000);
+    if (!coil::stringTo(sender_timeout,
+                        prop.getProperty(prefix + ".sender_timeout",
+                                         "10000").c_str()))
+      {
+        RTC_WARN(("Invalid %s.sender_timeout: %s", prefix.c_str(),
+                  prop[prefix + ".sender_timeout"].c_str()));
+        sender_timeout = 10000;
+      }
+    m_reassembler.reset(new UDPReassembler(max_samples,
+                                           std::chrono::milliseconds(timeout),
+                                           max_sample_size, max_senders,
+                                           std::chrono::milliseconds(sender_timeout)));
+
+    m_wakeup = ::eventfd(0, EFD_CLOEXEC);
+    if (m_wakeup < 0)
+      {
+        ::close(fd);
+        return false;
+      }
+    m_fd = fd;
+    m_thread = std::thread([this] { run(); });
+    return true;
+  }
+
+  //----------------------------------------------------------------------
+  // private functions
+
+  /*!
+   * @if jp
+   * @brief 受信スレッド
+   *
+   * 一度に複数のデータグラムを受信する。受信がない間も再構成のタイム
+   * アウトを処理する。
+   *
+   * @else
+   * @brief Receiving thread
+   *
+   * Several datagrams are received at once. The reassembly timeout is
+   * processed also while nothing is received.
+   *
+   * @endif
+   */
+  void UDPInPortProviderBase::run()
+  {
+    const size_t batch(8);
+    const size_t max_datagram(65536);
+    std::vector<unsigned char> buffer(batch * max_datagram);
+    std::vector<iovec> iov(batch);
+    std::vector<mmsghdr> msgs(batch);
+    for (size_t i(0); i < batch; ++i)
+      {
+        iov[i].iov_base = &buffer[i * max_datagram];
+        iov[i].iov_len = max_datagram;
+        msgs[i].msg_hdr = msghdr();
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+    pollfd fds[2];
+    fds[0].fd = m_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = m_wakeup;
+    fds[1].events = POLLIN;
+
+    for (;;)
+      {
+        int ret(::poll(fds, 2, 100));
+        if (ret < 0)
+          {
+            if (errno == EINTR) { continue; }
+            RTC_ERROR(("poll() failed: %s", std::strerror(errno)));
+            return;
+          }
+        if ((fds[1].revents & POLLIN) != 0) { return; }
+
+        unsigned long long lost(m_reassembler->getStatistics().lost);
+        // also under continuous reception, so that idle senders go away
+        m_reassembler->expire();
+        if ((fds[0].revents & POLLIN) != 0)
+          {
+            int count(::recvmmsg(m_fd, msgs.data(),
+                                 static_cast<unsigned int>(batch),
+                                 MSG_DONTWAIT, nullptr));
+            for (int i(0); i < count; ++i)
+              {
+                const std::vector<unsigned char>*
+                  sample(m_reassembler->push(&buffer[i * max_datagram],
+                                             msgs[i].msg_len));
+                if (sample != nullptr) { received(*sample); }
+              }
+          }
+
+        std::lock_guard<std::mutex> guard(m_statsMutex);
+        m_stats = m_reassembler->getStatistics();
+        if (m_stats.lost != lost)
+          {
+            RTC_DEBUG(("%s: %llu samples lost",
+                       m_prefix.c_str(), m_stats.lost - lost));
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 再構成したサンプルをバッファに書き込む
+   * @else
+   * @brief Write the reassembled sample into the buffer
+   * @endif
+   */
+  void UDPInPortProviderBase::received(const std::vector<unsigned char>& sample)
+  {
+    std::lock_guard<std::mutex> guard(m_connectorMutex);
+    if (m_listeners == nullptr || m_connector == nullptr)
+      {
+        RTC_DEBUG(("%s: the sample received before the connection is dropped.",
+                   m_prefix.c_str()));
+        return;
+      }
+    m_cdr.writeData(sample.data(), static_cast<unsigned long>(sample.size()));
+    m_cdr.isLittleEndian(m_connector->isLittleEndian());
+    onReceived(m_cdr);
+    convertReturn(m_connector->write(m_cdr), m_cdr);
+  }
+
+  /*!
+   * @if jp
+   * @brief バッファへの書き込み結果をリスナに通知する
+   * @else
+   * @brief Notify the result of writing to the buffer to the listeners
+   * @endif
+   */
+  void UDPInPortProviderBase::convertReturn(BufferStatus status,
+                                            ByteData& data)
+  {
+    switch (status)
+      {
+      case BufferStatus::OK:
+        onBufferWrite(data);
+        break;
+
+      case BufferStatus::FULL:
+        onBufferFull(data);
+        onReceiverFull(data);
+        break;
+
+      case BufferStatus::TIMEOUT:
+        onBufferWriteTimeout(data);
+        onReceiverTimeout(data);
+        break;
+
+      case BufferStatus::BUFFER_ERROR:          /* FALLTHROUGH */
+      case BufferStatus::PRECONDITION_NOT_MET:
+        onReceiverError(data);
+        break;
+
+      case BufferStatus::EMPTY:                 /* FALLTHROUGH */
+      case BufferStatus::NOT_SUPPORTED:         /* FALLTHROUGH */
+      default:
+        break;
+      }
+  }
+} // namespace RTC
@@ -0,0 +1,253 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPInPortProviderBase.h
+ * @brief UDPInPortProviderBase class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_UDPINPORTPROVIDERBASE_H
+#define RTC_UDPINPORTPROVIDERBASE_H
+
+#include <rtm/BufferBase.h>
+#include <rtm/InPortProvider.h>
+#include <rtm/ConnectorListener.h>
+#include <rtm/ConnectorBase.h>
+
+#include "UDPFragment.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class UDPInPortProviderBase
+   * @brief UDP で受信する InPort プロバイダの基底クラス
+   *
+   * 派生クラスが用意したソケットから受信スレッドでデータグラムを
+   * recvmmsg() でまとめて受信し、UDPReassembler で再構成したサンプル
+   * をコネクタに書き込む。受信スレッドは派生クラスが startReceiving()
+   * を呼んだ時点 (init() または subscribeInterface()) で開始されるため、
+   * setListener() と setConnector() が呼ばれるまでに受信したサンプル
+   * は捨てられる。
+   *
+   * startReceiving() に渡されるプロパティ (<prefix> はインターフェー
+   * ス型)
+   * - <prefix>.max_samples: 同時に再構成するサンプル数 (デフォルト 4)
+   * - <prefix>.timeout: サンプルの再構成のタイムアウト [ms] (デフォル
+   *   ト 100)
+   * - <prefix>.max_sample_size: 受信するサンプルの最大長 [byte] (デフォ
+   *   ルト 16777216)。これより長いサンプルは破棄される。
+   * - <prefix>.max_senders: 同時に受信する送信者数 (デフォルト 16)
+   * - <prefix>.sender_timeout: 受信のない送信者を破棄するまでの時間
+   *   [ms] (デフォルト 10000)
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class UDPInPortProviderBase
+   * @brief Base class of the InPort providers receiving UDP
+   *
+   * Datagrams are received together by recvmmsg() on a receiving
+   * thread from the socket prepared by the derived class, and the
+   * samples reassembled by UDPReassembler are written to the
+   * connector. Since the receiving thread is started when the derived
+   * class calls startReceiving() (in init() or subscribeInterface()),
+   * the samples received before setListener() and setConnector() are
+   * called are dropped.
+   *
+   * Properties given to startReceiving() (<prefix> is the interface
+   * type)
+   * - <prefix>.max_samples: Number of samples reassembled at the same
+   *   time (default 4)
+   * - <prefix>.timeout: Timeout of the reassembly of a sample [ms]
+   *   (default 100)
+   * - <prefix>.max_sample_size: Maximum length of a received sample in
+   *   bytes (default 16777216). Longer samples are discarded.
+   * - <prefix>.max_senders: Number of senders received from at the
+   *   same time (default 16)
+   * - <prefix>.sender_timeout: Time until a sender with no reception
+   *   is removed [ms] (default 10000)
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class UDPInPortProviderBase
+    : public InPortProvider
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * 受信スレッドを停止し、ソケットを閉じる。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * The receiving thread is stopped and the socket is closed.
+     *
+     * @endif
+     */
+    ~UDPInPortProviderBase() override;
+
+    /*!
+     * @if jp
+     * @brief バッファをセットする
+     * @param buffer OutPortProviderがデータを取り出すバッファへのポインタ
+     * @else
+     * @brief Setting outside buffer's pointer
+     * @param buffer A pointer to a data buffer to be used by OutPortProvider
+     * @endif
+     */
+    void setBuffer(BufferBase<ByteData>* buffer) override;
+
+    /*!
+     * @if jp
+     * @brief リスナを設定する
+     * @param info 接続情報
+     * @param listeners リスナオブジェクト
+     * @else
+     * @brief Set the listener
+     * @param info Connector information
+     * @param listeners Listener objects
+     * @endif
+     */
+    void setListener(ConnectorInfo& info,
+                     ConnectorListenersBase* listeners) override;
+
+    /*!
+     * @if jp
+     * @brief Connectorを設定する
+     * @param connector InPortConnector
+     * @else
+     * @brief set Connector
+     * @param connector InPortConnector
+     * @endif
+     */
+    void setConnector(InPortConnector* connector) override;
+
+    /*!
+     * @if jp
+     * @brief 受信統計を取得する
+     * @else
+     * @brief Get the reception statistics
+     * @endif
+     */
+    UDPReassembler::Statistics getStatistics();
+
+  protected:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    UDPInPortProviderBase() = default;
+
+    /*!
+     * @if jp
+     * @brief 受信を開始する
+     *
+     * ソケットの所有権はこのクラスに移り、失敗した場合は閉じられる。
+     *
+     * @param fd 受信するソケット
+     * @param prop 設定情報
+     * @param prefix プロパティのプレフィックス
+     * @return 成功した場合 true
+     *
+     * @else
+     * @brief Start receiving
+     *
+     * The ownership of the socket is moved to this class, and it is
+     * closed on failure.
+     *
+     * @param fd Socket to receive
+     * @param prop Configuration information
+     * @param prefix Prefix of the properties
+     * @return true if succeeded
+     *
+     * @endif
+     */
+    bool startReceiving(int fd, coil::Properties& prop,
+                        const std::string& prefix);
+
+    /*!
+     * @if jp
+     * @brief 受信しているかどうか
+     * @else
+     * @brief Check if receiving
+     * @endif
+     */
+    bool isReceiving() const { return m_fd >= 0; }
+
+  private:
+    void run();
+    void received(const std::vector<unsigned char>& sample);
+    void convertReturn(BufferStatus status, ByteData& data);
+
+    inline void onBufferWrite(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_WRITE, m_profile, data);
+    }
+    inline void onBufferFull(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_FULL, m_profile, data);
+    }
+    inline void onBufferWriteTimeout(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_BUFFER_WRITE_TIMEOUT, m_profile, data);
+    }
+    inline void onReceived(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVED, m_profile, data);
+    }
+    inline void onReceiverFull(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_FULL, m_profile, data);
+    }
+    inline void onReceiverTimeout(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_TIMEOUT, m_profile, data);
+    }
+    inline void onReceiverError(ByteData& data)
+    {
+      m_listeners->notifyIn(ConnectorDataListenerType::ON_RECEIVER_ERROR, m_profile, data);
+    }
+
+    CdrBufferBase* m_buffer{nullptr};
+    // m_listeners, m_profile and m_connector are set while receiving
+    std::mutex m_connectorMutex;
+    ConnectorListenersBase* m_listeners{nullptr};
+    ConnectorInfo m_profile;
+    InPortConnector* m_connector{nullptr};
+    ByteData m_cdr;
+
+    std::string m_prefix;
+    int m_fd{-1};
+    int m_wakeup{-1};
+    std::thread m_thread;
+    std::unique_ptr<UDPReassembler> m_reassembler;
+    std::mutex m_statsMutex;
+    UDPReassembler::Statistics m_stats;
+  };  // class UDPInPortProviderBase
+} // namespace RTC
+
+#endif  // RTC_UDPINPORTPROVIDERBASE_H
@@ -0,0 +1,376 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPMulticastInPortConsumer.cpp
+ * @brief UDPMulticastInPortConsumer class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "UDPMulticastInPortConsumer.h"
+
+#include <rtm/CORBA_SeqUtil.h>
+#include <rtm/NVUtil.h>
+#include <coil/stringutil.h>
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <random>
+#include <sstream>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  UDPMulticastInPortConsumer::UDPMulticastInPortConsumer()
+    : rtclog("UDPMulticastInPortConsumer")
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  UDPMulticastInPortConsumer::~UDPMulticastInPortConsumer()
+  {
+    if (m_group) { m_group->leave(this); }
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void UDPMulticastInPortConsumer::init(coil::Properties& prop)
+  {
+    RTC_TRACE(("init()"));
+    // the connector calls init() again with the whole connector properties
+    if (m_group) { return; }
+
+    if (!coil::stringTo(m_ttl, prop.getProperty("udp_multicast.ttl", "1").c_str()))
+      {
+        RTC_WARN(("Invalid udp_multicast.ttl: %s",
+                  prop["udp_multicast.ttl"].c_str()));
+        m_ttl = 1;
+      }
+    if (!coil::stringTo(m_mtu, prop.getProperty("udp_multicast.mtu", "1500").c_str()))
+      {
+        RTC_WARN(("Invalid udp_multicast.mtu: %s",
+                  prop["udp_multicast.mtu"].c_str()));
+        m_mtu = 1500;
+      }
+    if (!coil::stringTo(m_fec, prop.getProperty("udp_multicast.fec", "0").c_str()))
+      {
+        RTC_WARN(("Invalid udp_multicast.fec: %s",
+                  prop["udp_multicast.fec"].c_str()));
+        m_fec = 0;
+      }
+    m_interface = prop.getProperty("udp_multicast.interface");
+    m_address = prop.getProperty("udp_multicast.address");
+    m_port = prop.getProperty("udp_multicast.port", "5710");
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続先へのデータ送信
+   * @else
+   * @brief Send data to the destination port
+   * @endif
+   */
+  DataPortStatus UDPMulticastInPortConsumer::put(ByteData& data)
+  {
+    RTC_PARANOID(("put()"));
+    if (!m_joined) { return DataPortStatus::CONNECTION_LOST; }
+    return m_group->send(this, data);
+  }
+
+  /*!
+   * @if jp
+   * @brief InterfaceProfile情報を公開する
+   * @else
+   * @brief Publish InterfaceProfile information
+   * @endif
+   */
+  void UDPMulticastInPortConsumer::
+  publishInterfaceProfile(SDOPackage::NVList& properties)
+  {
+    RTC_TRACE(("publishInterfaceProfile()"));
+    if (!m_group)
+      {
+        m_group = getGroup();
+        if (!m_group)
+          {
+            RTC_ERROR(("Failed to open the multicast group of %s.",
+                       m_outportName.c_str()));
+            return;
+          }
+      }
+    RTC_DEBUG(("multicast group: %s", m_group->getEndpoint().c_str()));
+    CORBA_SeqUtil::push_back(properties,
+                             NVUtil::newNV("dataport.udp_multicast.address",
+                                           m_group->getEndpoint().c_str()));
+  }
+
+  /*!
+   * @if jp
+   * @brief データ送信通知への登録
+   * @else
+   * @brief Subscribe to the data sending notification
+   * @endif
+   */
+  bool UDPMulticastInPortConsumer::
+  subscribeInterface(const SDOPackage::NVList& properties)
+  {
+    RTC_TRACE(("subscribeInterface()"));
+    RTC_DEBUG_STR((NVUtil::toString(properties)));
+
+    if (!m_group)
+      {
+        RTC_ERROR(("The multicast group is not published."));
+        return false;
+      }
+    if (!m_joined)
+      {
+        m_group->join(this);
+        m_joined = true;
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief データ送信通知からの登録解除
+   * @else
+   * @brief Unsubscribe the data send notification
+   * @endif
+   */
+  void UDPMulticastInPortConsumer::
+  unsubscribeInterface(const SDOPackage::NVList& /*properties*/)
+  {
+    RTC_TRACE(("unsubscribeInterface()"));
+    if (m_group) { m_group->leave(this); }
+    m_joined = false;
+  }
+
+  /*!
+   * @if jp
+   * @brief データを送信する OutPort の名前を設定する
+   * @else
+   * @brief Set the name of the OutPort sending data
+   * @endif
+   */
+  void UDPMulticastInPortConsumer::setOutPortName(const std::string& name)
+  {
+    m_outportName = name;
+  }
+
+  /*!
+   * @if jp
+   * @brief OutPort のグループを取得する
+   *
+   * 同じ OutPort の同じアドレスのグループが既にあればそれを共有する。
+   * アドレスが指定されていない場合は、OutPort が使用していない
+   * 239.255.0.0/16 のアドレスとポートをランダムに選ぶ。
+   *
+   * @else
+   * @brief Get the group of the OutPort
+   *
+   * The group of the same OutPort and address is shared if it already
+   * exists. If the address is not given, an address and a port in
+   * 239.255.0.0/16 not used by the OutPorts are chosen at random.
+   *
+   * @endif
+   */
+  std::shared_ptr<UDPMulticastInPortConsumer::Group>
+  UDPMulticastInPortConsumer::getGroup() const
+  {
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<Group>> groups;
+
+    std::string owner(m_outportName);
+    if (owner.empty())
+      {
+        // without the OutPort name the group is not shared
+        std::ostringstream oss;
+        oss << static_cast<const void*>(this);
+        owner = oss.str();
+      }
+    std::string key(owner + "|" +
+                    (m_address.empty() ? std::string() : m_address + ":" + m_port));
+
+    std::lock_guard<std::mutex> guard(mutex);
+    std::shared_ptr<Group> group(groups[key].lock());
+    if (group) { return group; }
+
+    std::string endpoint;
+    if (!m_address.empty())
+      {
+        endpoint = m_address + ":" + m_port;
+      }
+    else
+      {
+        std::random_device seed;
+        std::mt19937 gen(seed());
+        std::uniform_int_distribution<int> octet(1, 254);
+        std::uniform_int_distribution<int> portno(20000, 59999);
+        for (;;)
+          {
+            endpoint = "239.255." + std::to_string(octet(gen)) + "." +
+              std::to_string(octet(gen)) + ":" + std::to_string(portno(gen));
+            bool used(false);
+            for (auto & other : groups)
+              {
+                std::shared_ptr<Group> g(other.second.lock());
+                if (g && g->getEndpoint() == endpoint) { used = true; }
+              }
+            if (!used) { break; }
+          }
+      }
+
+    std::string::size_type pos(endpoint.rfind(':'));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    unsigned short port;
+    if (::inet_pton(AF_INET, endpoint.substr(0, pos).c_str(), &addr.sin_addr) != 1 ||
+        !IN_MULTICAST(ntohl(addr.sin_addr.s_addr)) ||
+        !coil::stringTo(port, endpoint.substr(pos + 1).c_str()))
+      {
+        RTC_ERROR(("Invalid multicast group: %s", endpoint.c_str()));
+        return nullptr;
+      }
+    addr.sin_port = htons(port);
+
+    group = std::make_shared<Group>(endpoint, addr, m_ttl, m_interface,
+                                    m_mtu, m_fec);
+    if (!group->isValid()) { return nullptr; }
+    groups[key] = group;
+    return group;
+  }
+
+  //============================================================
+  // Group
+  //============================================================
+  UDPMulticastInPortConsumer::Group::Group(const std::string& endpoint,
+                                           const sockaddr_in& addr, int ttl,
+                                           const std::string& iface,
+                                           size_t mtu, size_t fec)
+    : m_endpoint(endpoint), m_addr(addr)
+  {
+    int fd(::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0));
+    if (fd < 0) { return; }
+
+    unsigned char ttl_(static_cast<unsigned char>(ttl));
+    unsigned char loop(1);
+    ::setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl_, sizeof(ttl_));
+    ::setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+    if (!iface.empty())
+      {
+        in_addr ifaddr{};
+        if (::inet_pton(AF_INET, iface.c_str(), &ifaddr) != 1 ||
+            ::setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF,
+                         &ifaddr, sizeof(ifaddr)) != 0)
+          {
+            ::close(fd);
+            return;
+          }
+      }
+    m_sender.setMTU(mtu);
+    m_sender.setFECGroup(fec);
+    m_fd = fd;
+  }
+
+  UDPMulticastInPortConsumer::Group::~Group()
+  {
+    if (m_fd >= 0) { ::close(m_fd); }
+  }
+
+  /*!
+   * @if jp
+   * @brief グループに参加する
+   * @else
+   * @brief Join the group
+   * @endif
+   */
+  void UDPMulticastInPortConsumer::Group::
+  join(const UDPMulticastInPortConsumer* member)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (std::find(m_members.begin(), m_members.end(), member) == m_members.end())
+      {
+        m_members.push_back(member);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief グループから離脱する
+   * @else
+   * @brief Leave the group
+   * @endif
+   */
+  void UDPMulticastInPortConsumer::Group::
+  leave(const UDPMulticastInPortConsumer* member)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_members.erase(std::remove(m_members.begin(), m_members.end(), member),
+                    m_members.end());
+  }
+
+  /*!
+   * @if jp
+   * @brief サンプルを送信する
+   *
+   * グループに最初に参加したコンシューマ以外からの呼び出しでは何もし
+   * ない。同じ OutPort の他の接続が同じサンプルを送信するためである。
+   *
+   * @else
+   * @brief Send a sample
+   *
+   * Nothing is done unless called by the consumer which joined the
+   * group first, since another connection of the same OutPort sends
+   * the same sample.
+   *
+   * @endif
+   */
+  DataPortStatus
+  UDPMulticastInPortConsumer::Group::
+  send(const UDPMulticastInPortConsumer* member, ByteData& data)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_members.empty() || m_members.front() != member)
+      {
+        return DataPortStatus::PORT_OK;
+      }
+    if (!m_sender.send(m_fd, reinterpret_cast<const sockaddr*>(&m_addr),
+                       sizeof(m_addr), data.getBuffer(), data.getDataLength()))
+      {
+        return DataPortStatus::PORT_ERROR;
+      }
+    return DataPortStatus::PORT_OK;
+  }
+} // namespace RTC
@@ -0,0 +1,279 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPMulticastInPortConsumer.h
+ * @brief UDPMulticastInPortConsumer class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_UDPMULTICASTINPORTCONSUMER_H
+#define RTC_UDPMULTICASTINPORTCONSUMER_H
+
+#include <rtm/InPortConsumer.h>
+#include <rtm/SystemLogger.h>
+
+#include "UDPFragment.h"
+
+#include <netinet/in.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class UDPMulticastInPortConsumer
+   * @brief UDPMulticastInPortConsumer クラス
+   *
+   * マルチキャストグループにデータを送信する InPort コンシューマ。グ
+   * ループは OutPort 側が所有し、OutPortBase::publishInterfaces() の
+   * 中でコネクタプロファイルの "dataport.udp_multicast.address" として
+   * 公開される。InPort 側の UDPMulticastInPortProvider はそのグループ
+   * に参加する。MTU より大きいサンプルは UDPFragmentSender により分割
+   * される。
+   *
+   * 同じ OutPort の接続は一つのグループと送信ソケットを共有する。グルー
+   * プに最初に参加したコンシューマだけが送信し、他の接続の put() は何
+   * もしないため、OutPort の一回の書き込みは購読者の数によらず一度だ
+   * け送信される。サンプルの識別は OutPort 毎の送信者ID とシーケンス
+   * 番号で行われ、データの内容は参照しない。送信するコンシューマが切
+   * 断された場合は、次に参加したコンシューマが送信を引き継ぐ。
+   *
+   * init() に渡されるプロパティ (コネクタプロファイルの
+   * dataport.consumer.*)
+   * - udp_multicast.address: グループのアドレス。省略した場合は
+   *   OutPort 毎に 239.255.0.0/16 からランダムに選んだアドレスとポー
+   *   トを使用する。
+   * - udp_multicast.port: ポート番号 (アドレスを指定した場合のデフォル
+   *   ト 5710)
+   * - udp_multicast.ttl: マルチキャストの TTL (デフォルト 1)
+   * - udp_multicast.interface: 送信するインターフェースのアドレス
+   * - udp_multicast.mtu: MTU (デフォルト 1500)
+   * - udp_multicast.fec: FEC のパリティ一つあたりのフラグメント数。0
+   *   (デフォルト) の場合は FEC を使用しない。
+   *
+   * 最初に接続したコンシューマの設定がグループの送信ソケットに使われる。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class UDPMulticastInPortConsumer
+   * @brief UDPMulticastInPortConsumer class
+   *
+   * The InPort consumer which sends data to a multicast group. The
+   * group is owned by the OutPort side, and is published in
+   * OutPortBase::publishInterfaces() as "dataport.udp_multicast.address"
+   * of the connector profile. UDPMulticastInPortProvider of the InPort
+   * side joins the group. Samples larger than the MTU are divided by
+   * UDPFragmentSender.
+   *
+   * The connections of an OutPort share one group and sending socket.
+   * Only the consumer which joined the group first sends, and put() of
+   * the other connections does nothing, so a sample written by the
+   * OutPort is sent once regardless of the number of subscribers.
+   * Samples are identified by the sender ID of the OutPort and the
+   * sequence number, not by their contents. When the sending consumer
+   * is disconnected, the consumer joined next takes over sending.
+   *
+   * Properties given to init() (dataport.consumer.* of the connector
+   * profile)
+   * - udp_multicast.address: Group address. If omitted, an address and
+   *   a port chosen at random from 239.255.0.0/16 for each OutPort are
+   *   used.
+   * - udp_multicast.port: Port number (default 5710 if the address is
+   *   given)
+   * - udp_multicast.ttl: TTL of multicast (default 1)
+   * - udp_multicast.interface: Address of the sending interface
+   * - udp_multicast.mtu: MTU (default 1500)
+   * - udp_multicast.fec: Number of fragments per FEC parity. FEC is
+   *   not used if 0 (default).
+   *
+   * The settings of the first connected consumer are used for the
+   * sending socket of the group.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class UDPMulticastInPortConsumer
+    : public InPortConsumer
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    UDPMulticastInPortConsumer();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~UDPMulticastInPortConsumer() override;
+
+    /*!
+     * @if jp
+     * @brief 設定初期化
+     *
+     * グループを開いた後の呼び出し (コネクタがコネクタプロファイル全
+     * 体で再度呼ぶ場合) は無視される。
+     *
+     * @param prop 設定情報
+     * @else
+     * @brief Initializing configuration
+     *
+     * Calls after the group is opened, that is, the second call by the
+     * connector with the whole connector properties, are ignored.
+     *
+     * @param prop Configuration information
+     * @endif
+     */
+    void init(coil::Properties& prop) override;
+
+    /*!
+     * @if jp
+     * @brief 接続先へのデータ送信
+     *
+     * このコンシューマがグループの送信を担当している場合に送信する。
+     *
+     * @param data 送信するデータ
+     * @return リターンコード
+     *         PORT_OK         正常終了
+     *         PORT_ERROR      送信に失敗した
+     *         CONNECTION_LOST 接続されていない
+     *
+     * @else
+     * @brief Send data to the destination port
+     *
+     * The sample is sent if this consumer is in charge of sending to
+     * the group.
+     *
+     * @param data The data that will be sent
+     * @return Return code
+     *         PORT_OK         Normal return
+     *         PORT_ERROR      Failed to send
+     *         CONNECTION_LOST Not connected
+     *
+     * @endif
+     */
+    DataPortStatus put(ByteData& data) override;
+
+    /*!
+     * @if jp
+     * @brief InterfaceProfile情報を公開する
+     *
+     * OutPort のグループを開き、そのアドレスを
+     * "dataport.udp_multicast.address" として公開する。
+     *
+     * @param properties InterfaceProfile情報を受け取るプロパティ
+     * @else
+     * @brief Publish InterfaceProfile information
+     *
+     * The group of the OutPort is opened, and its address is published
+     * as "dataport.udp_multicast.address".
+     *
+     * @param properties Properties to get InterfaceProfile information
+     * @endif
+     */
+    void publishInterfaceProfile(SDOPackage::NVList& properties) override;
+
+    /*!
+     * @if jp
+     * @brief データ送信通知への登録
+     * @param properties 登録情報
+     * @return 登録処理結果(登録成功:true、登録失敗:false)
+     * @else
+     * @brief Subscribe to the data sending notification
+     * @param properties Information for subscription
+     * @return Subscription result (Successful:true, Failed:false)
+     * @endif
+     */
+    bool subscribeInterface(const SDOPackage::NVList& properties) override;
+
+    /*!
+     * @if jp
+     * @brief データ送信通知からの登録解除
+     * @param properties 登録解除情報
+     * @else
+     * @brief Unsubscribe the data send notification
+     * @param properties Information for unsubscription
+     * @endif
+     */
+    void unsubscribeInterface(const SDOPackage::NVList& properties) override;
+
+    /*!
+     * @if jp
+     * @brief データを送信する OutPort の名前を設定する
+     * @param name OutPort の名前
+     * @else
+     * @brief Set the name of the OutPort sending data
+     * @param name Name of the OutPort
+     * @endif
+     */
+    void setOutPortName(const std::string& name) override;
+
+  private:
+    /*!
+     * @if jp
+     * @brief マルチキャストグループへの送信ソケット
+     * @else
+     * @brief Sending socket to a multicast group
+     * @endif
+     */
+    class Group
+    {
+    public:
+      Group(const std::string& endpoint, const sockaddr_in& addr, int ttl,
+            const std::string& iface, size_t mtu, size_t fec);
+      ~Group();
+      bool isValid() const { return m_fd >= 0; }
+      const std::string& getEndpoint() const { return m_endpoint; }
+      void join(const UDPMulticastInPortConsumer* member);
+      void leave(const UDPMulticastInPortConsumer* member);
+      DataPortStatus send(const UDPMulticastInPortConsumer* member,
+                          ByteData& data);
+    private:
+      std::mutex m_mutex;
+      std::string m_endpoint;
+      int m_fd{-1};
+      sockaddr_in m_addr;
+      UDPFragmentSender m_sender;
+      // consumers in joining order, the first one sends
+      std::vector<const UDPMulticastInPortConsumer*> m_members;
+    };
+
+    std::shared_ptr<Group> getGroup() const;
+
+    mutable Logger rtclog;
+    std::string m_outportName;
+    std::string m_address;
+    std::string m_port;
+    int m_ttl{1};
+    std::string m_interface;
+    size_t m_mtu{1500};
+    size_t m_fec{0};
+    std::shared_ptr<Group> m_group;
+    bool m_joined{false};
+  };  // class UDPMulticastInPortConsumer
+} // namespace RTC
+
+#endif  // RTC_UDPMULTICASTINPORTCONSUMER_H
@@ -0,0 +1,173 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPMulticastInPortProvider.cpp
+ * @brief UDPMulticastInPortProvider class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "UDPMulticastInPortProvider.h"
+
+#include <rtm/NVUtil.h>
+#include <coil/stringutil.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  UDPMulticastInPortProvider::UDPMulticastInPortProvider()
+  {
+    // PortProfile setting
+    setInterfaceType("udp_multicast");
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  UDPMulticastInPortProvider::~UDPMulticastInPortProvider() = default;
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void UDPMulticastInPortProvider::init(coil::Properties& prop)
+  {
+    if (isReceiving()) { return; }
+
+    m_prop = prop;
+    m_rcvbuf = 0;
+    if (!coil::stringTo(m_rcvbuf, prop.getProperty("udp_multicast.receive_buffer", "0").c_str()))
+      {
+        RTC_WARN(("Invalid udp_multicast.receive_buffer: %s",
+                  prop["udp_multicast.receive_buffer"].c_str()));
+        m_rcvbuf = 0;
+      }
+    m_interface = prop.getProperty("udp_multicast.interface");
+  }
+
+  /*!
+   * @if jp
+   * @brief OutPort 側が公開したグループに参加する
+   * @else
+   * @brief Join the group published by the OutPort side
+   * @endif
+   */
+  bool UDPMulticastInPortProvider::subscribeInterface(const SDOPackage::NVList& prop)
+  {
+    if (isReceiving()) { return true; }
+
+    CORBA::Long index(NVUtil::find_index(prop, "dataport.udp_multicast.address"));
+    const char* endpoint(nullptr);
+    if (index < 0 || !(prop[index].value >>= endpoint))
+      {
+        RTC_ERROR(("dataport.udp_multicast.address not found."));
+        return false;
+      }
+    std::string address(endpoint);
+    std::string::size_type pos(address.rfind(':'));
+    if (pos == std::string::npos)
+      {
+        RTC_ERROR(("Invalid dataport.udp_multicast.address: %s", endpoint));
+        return false;
+      }
+
+    std::string group(address.substr(0, pos));
+    std::string port(address.substr(pos + 1));
+    int fd(join(group, port));
+    if (fd < 0 || !startReceiving(fd, m_prop, "udp_multicast"))
+      {
+        RTC_ERROR(("Failed to join the multicast group %s: %s",
+                   endpoint, std::strerror(errno)));
+        return false;
+      }
+    RTC_DEBUG(("udp_multicast group: %s", endpoint));
+    return true;
+  }
+
+  //----------------------------------------------------------------------
+  // private functions
+
+  /*!
+   * @if jp
+   * @brief マルチキャストグループに参加する
+   * @return 参加したソケット、失敗した場合は -1
+   * @else
+   * @brief Join the multicast group
+   * @return The joined socket, or -1 on failure
+   * @endif
+   */
+  int UDPMulticastInPortProvider::join(const std::string& group,
+                                       const std::string& port)
+  {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    unsigned short portno;
+    if (::inet_pton(AF_INET, group.c_str(), &addr.sin_addr) != 1 ||
+        !IN_MULTICAST(ntohl(addr.sin_addr.s_addr)) ||
+        !coil::stringTo(portno, port.c_str()))
+      {
+        errno = EINVAL;
+        return -1;
+      }
+    addr.sin_port = htons(portno);
+
+    ip_mreq mreq{};
+    mreq.imr_multiaddr = addr.sin_addr;
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+    if (!m_interface.empty() &&
+        ::inet_pton(AF_INET, m_interface.c_str(), &mreq.imr_interface) != 1)
+      {
+        errno = EINVAL;
+        return -1;
+      }
+
+    int fd(::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0));
+    if (fd < 0) { return -1; }
+    int on(1);
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (m_rcvbuf > 0)
+      {
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &m_rcvbuf, sizeof(m_rcvbuf));
+      }
+    // binding the group address receives only the datagrams of the group
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0)
+      {
+        int err(errno);
+        ::close(fd);
+        errno = err;
+        return -1;
+      }
+    return fd;
+  }
+} // namespace RTC
@@ -0,0 +1,140 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPMulticastInPortProvider.h
+ * @brief UDPMulticastInPortProvider class
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_UDPMULTICASTINPORTPROVIDER_H
+#define RTC_UDPMULTICASTINPORTPROVIDER_H
+
+#include "UDPInPortProviderBase.h"
+
+#include <string>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class UDPMulticastInPortProvider
+   * @brief UDPMulticastInPortProvider クラス
+   *
+   * マルチキャストグループに参加してデータを受信する InPort プロバイ
+   * ダ。グループは OutPort 側の UDPMulticastInPortConsumer が所有し、
+   * コネクタプロファイルの "dataport.udp_multicast.address" として公開
+   * する。プロバイダは両方のポートが Interface 情報を公開した後、
+   * subscribeInterface() でそのグループに参加する。受信したフラグメン
+   * トは UDPReassembler で再構成され、送信者ID とシーケンス番号から損
+   * 失と重複が数えられる。受信はプロバイダ毎のスレッドで行われる。
+   *
+   * init() に渡されるプロパティ (コネクタプロファイルの
+   * dataport.provider.*)
+   * - udp_multicast.interface: 参加するインターフェースのアドレス
+   * - udp_multicast.receive_buffer: ソケットの受信バッファサイズ
+   * - udp_multicast.max_samples, udp_multicast.timeout,
+   *   udp_multicast.max_sample_size: UDPInPortProviderBase を参照
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class UDPMulticastInPortProvider
+   * @brief UDPMulticastInPortProvider class
+   *
+   * The InPort provider which joins a multicast group and receives
+   * data. The group is owned by UDPMulticastInPortConsumer of the
+   * OutPort side, and is published as "dataport.udp_multicast.address"
+   * of the connector profile. The provider joins the group in
+   * subscribeInterface() after both ports published their interface
+   * information. The received fragments are reassembled by
+   * UDPReassembler, and lost and duplicated samples are counted by the
+   * sender ID and the sequence numbers. Data are received on a thread
+   * of each provider.
+   *
+   * Properties given to init() (dataport.provider.* of the connector
+   * profile)
+   * - udp_multicast.interface: Address of the interface to join
+   * - udp_multicast.receive_buffer: Receive buffer size of the socket
+   * - udp_multicast.max_samples, udp_multicast.timeout,
+   *   udp_multicast.max_sample_size: See UDPInPortProviderBase
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class UDPMulticastInPortProvider
+    : public UDPInPortProviderBase
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    UDPMulticastInPortProvider();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~UDPMulticastInPortProvider() override;
+
+    /*!
+     * @if jp
+     * @brief 設定初期化
+     * @param prop 設定情報
+     * @else
+     * @brief Initializing configuration
+     * @param prop Configuration information
+     * @endif
+     */
+    void init(coil::Properties& prop) override;
+
+    /*!
+     * @if jp
+     * @brief OutPort 側が公開したグループに参加する
+     *
+     * "dataport.udp_multicast.address" のグループに参加し、受信スレッ
+     * ドを開始する。
+     *
+     * @param prop コネクタプロファイルのプロパティ
+     * @return 成功した場合 true
+     *
+     * @else
+     * @brief Join the group published by the OutPort side
+     *
+     * This operation joins the group of "dataport.udp_multicast.address"
+     * and starts the receiving thread.
+     *
+     * @param prop Properties of the connector profile
+     * @return true if succeeded
+     *
+     * @endif
+     */
+    bool subscribeInterface(const SDOPackage::NVList& prop) override;
+
+  private:
+    int join(const std::string& group, const std::string& port);
+
+    coil::Properties m_prop;
+    std::string m_interface;
+    int m_rcvbuf{0};
+  };  // class UDPMulticastInPortProvider
+} // namespace RTC
+
+#endif  // RTC_UDPMULTICASTINPORTPROVIDER_H
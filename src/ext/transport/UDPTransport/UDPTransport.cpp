@@ -0,0 +1,64 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPTransport.cpp
+ * @brief UDPTransport module
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include "UDPTransport.h"
+#include "UDPMulticastInPortProvider.h"
+#include "UDPMulticastInPortConsumer.h"
+#include "UDPFragmentInPortProvider.h"
+#include "UDPFragmentInPortConsumer.h"
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void UDPTransportInit(RTC::Manager* /*manager*/)
+  {
+    {
+      RTC::InPortProviderFactory& factory(RTC::InPortProviderFactory::instance());
+      factory.addFactory("udp_multicast",
+                         ::coil::Creator< ::RTC::InPortProvider,
+                                          ::RTC::UDPMulticastInPortProvider>,
+                         ::coil::Destructor< ::RTC::InPortProvider,
+                                             ::RTC::UDPMulticastInPortProvider>);
+      factory.addFactory("udp_fragment",
+                         ::coil::Creator< ::RTC::InPortProvider,
+                                          ::RTC::UDPFragmentInPortProvider>,
+                         ::coil::Destructor< ::RTC::InPortProvider,
+                                             ::RTC::UDPFragmentInPortProvider>);
+    }
+
+    {
+      RTC::InPortConsumerFactory& factory(RTC::InPortConsumerFactory::instance());
+      factory.addFactory("udp_multicast",
+                         ::coil::Creator< ::RTC::InPortConsumer,
+                                          ::RTC::UDPMulticastInPortConsumer>,
+                         ::coil::Destructor< ::RTC::InPortConsumer,
+                                             ::RTC::UDPMulticastInPortConsumer>);
+      factory.addFactory("udp_fragment",
+                         ::coil::Creator< ::RTC::InPortConsumer,
+                                          ::RTC::UDPFragmentInPortConsumer>,
+                         ::coil::Destructor< ::RTC::InPortConsumer,
+                                             ::RTC::UDPFragmentInPortConsumer>);
+    }
+  }
+}
@@ -0,0 +1,48 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  UDPTransport.h
+ * @brief UDPTransport module
+ * @date  $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_UDPTRANSPORT_H
+#define RTC_UDPTRANSPORT_H
+
+#include <rtm/Manager.h>
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * UDPMulticastInPortProvider、UDPMulticastInPortConsumer のファクト
+   * リを "udp_multicast" として、UDPFragmentInPortProvider、
+   * UDPFragmentInPortConsumer のファクトリを "udp_fragment" として登
+   * 録する初期化関数。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * This function registers the factories of
+   * UDPMulticastInPortProvider and UDPMulticastInPortConsumer as
+   * "udp_multicast", and those of UDPFragmentInPortProvider and
+   * UDPFragmentInPortConsumer as "udp_fragment".
+   *
+   * @endif
+   */
+  DLL_EXPORT void UDPTransportInit(RTC::Manager* manager);
+}
+
+#endif // RTC_UDPTRANSPORT_H
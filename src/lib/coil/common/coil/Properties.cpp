@@ -20,7 +20,9 @@
 #include <coil/Properties.h>
 #include <coil/stringutil.h>
 
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <string>
 #include <vector>
@@ -31,6 +33,9 @@ using std::size_t;
 
 namespace coil
 {
+  // Number of children above which a hash index of leaf is created
+  static const size_t PROPERTIES_INDEX_THRESHOLD = 8;
+
   /*!
    * @if jp
    * @brief コンストラクタ(rootノードのみ作成)
@@ -90,20 +95,7 @@ namespace coil
     : name(prop.name), value(prop.value),
       default_value(prop.default_value), set_value(prop.set_value), root(nullptr), m_empty("")
   {
-    std::vector<std::string> keys;
-    keys = prop.propertyNames();
-    for (const auto & key : keys)
-      {
-        const Properties* node(nullptr);
-        if ((node = prop.findNode(key)) != nullptr)
-          {
-            setDefault(key,  node->default_value);
-            if (node->set_value)
-              {
-                setProperty(key, node->value);
-              }
-          }
-      }
+    _copy(*this, prop);
   }
 
   /*!
@@ -121,20 +113,7 @@ namespace coil
     default_value = prop.default_value;
     set_value = prop.set_value;
 
-    std::vector<std::string> keys;
-    keys = prop.propertyNames();
-    for (const auto & key : keys)
-      {
-        const Properties* node(prop.findNode(key));
-        if (node != nullptr)
-          {
-            setDefault(key,  node->default_value);
-            if (node->set_value)
-              {
-                setProperty(key, node->value);
-              }
-          }
-      }
+    _copy(*this, prop);
 
     return *this;
   }
@@ -170,10 +149,8 @@ namespace coil
    */
   const std::string& Properties::getProperty(const std::string& key) const
   {
-    std::vector<std::string> keys;
-    split(key, '.', keys);
     Properties* node(nullptr);
-    if ((node = _getNode(keys, 0, this)) != nullptr)
+    if ((node = _findPath(key)) != nullptr)
       {
         return (node->set_value) ? node->value : node->default_value;
       }
@@ -195,6 +172,38 @@ namespace coil
     return invalue.empty() ? def : invalue;
   }
 
+  /*!
+   * @if jp
+   * @brief 事前に分割したキーを持つプロパティを、プロパティリストから探す
+   * @else
+   * @brief Search for the property with the precompiled key
+   * @endif
+   */
+  const std::string& Properties::getProperty(const PropertyPath& path) const
+  {
+    Properties* node(nullptr);
+    if ((node = findNode(path)) != nullptr)
+      {
+        return (node->set_value) ? node->value : node->default_value;
+      }
+    return m_empty;
+  }
+
+  /*!
+   * @if jp
+   * @brief 事前に分割したキーを持つプロパティを、プロパティリストから探す
+   * @else
+   * @brief Search for the property with the precompiled key
+   * @endif
+   */
+  const std::string& Properties::getProperty(const PropertyPath& path,
+                                             const std::string& def) const
+  {
+    const std::string& invalue(getProperty(path));
+
+    return invalue.empty() ? def : invalue;
+  }
+
   /*!
    * @if jp
    * @brief 指定されたキーを持つプロパティを、プロパティリストから探す
@@ -216,10 +225,13 @@ namespace coil
    */
   std::string& Properties::operator[](const std::string& key)
   {
-    setProperty(key, getProperty(key));
-    Properties& prop(getNode(key));
-
-    return prop.value;
+    Properties* node(_createPath(key));
+    if (!node->set_value)
+      {
+        node->value = node->default_value;
+        node->set_value = true;
+      }
+    return node->value;
   }
 
   /*!
@@ -231,10 +243,8 @@ namespace coil
    */
   const std::string& Properties::getDefault(const std::string& key) const
   {
-    std::vector<std::string> keys;
-    split(key, '.', keys);
     Properties* node(nullptr);
-    if ((node = _getNode(keys, 0, this)) != nullptr)
+    if ((node = _findPath(key)) != nullptr)
       {
         return node->default_value;
       }
@@ -251,21 +261,7 @@ namespace coil
   std::string Properties::setProperty(const std::string& key,
                                       const std::string& invalue)
   {
-    std::vector<std::string> keys;
-    split(key, '.', keys);
-
-    Properties* curr(this);
-    for (auto & k : keys)
-      {
-        Properties* next(curr->hasKey(k.c_str()));
-        if (next == nullptr)
-          {
-            next = new Properties(k.c_str());
-            next->root = curr;
-            curr->leaf.emplace_back(next);
-          }
-        curr = next;
-      }
+    Properties* curr(_createPath(key));
     std::string retval(curr->value);
     curr->value = invalue;
     curr->set_value = true;
@@ -282,21 +278,7 @@ namespace coil
   std::string Properties::setDefault(const std::string& key,
                                      const std::string& invalue)
   {
-    std::vector<std::string> keys;
-    split(key, '.', keys);
-
-    Properties* curr(this);
-    for (auto & k : keys)
-      {
-        Properties* next(curr->hasKey(k.c_str()));
-        if (next == nullptr)
-          {
-            next = new Properties(k.c_str());
-            next->root = curr;
-            curr->leaf.emplace_back(next);
-          }
-        curr = next;
-      }
+    Properties* curr(_createPath(key));
     curr->default_value = invalue;
     return invalue;
   }
@@ -448,13 +430,33 @@ namespace coil
    */
   Properties* Properties::findNode(const std::string& key) const
   {
-    if (key.empty())
+    return _findPath(key);
+  }
+
+  /*!
+   * @if jp
+   * @brief 事前に分割したキーを持つノードを取得する
+   * @else
+   * @brief Get node of properties with the precompiled key
+   * @endif
+   */
+  Properties* Properties::findNode(const PropertyPath& path) const
+  {
+    if (path.m_keys.empty())
       {
         return nullptr;
       }
-    std::vector<std::string> keys;
-    split(key, '.', keys);
-    return _getNode(keys, 0, this);
+    const Properties* curr(this);
+    for (size_t i(0); i < path.m_keys.size(); ++i)
+      {
+        const std::string& k(path.m_keys[i]);
+        curr = curr->_findChild(k.c_str(), k.size(), path.m_hashes[i]);
+        if (curr == nullptr)
+          {
+            return nullptr;
+          }
+      }
+    return const_cast<Properties*>(curr);
   }
 
   /*!
@@ -476,7 +478,7 @@ namespace coil
         return *leafptr;
       }
     this->createNode(key);
-    return *findNode(key);
+    return *_createPath(key);
   }
 
   /*!
@@ -510,19 +512,36 @@ namespace coil
    */
   Properties* Properties::removeNode(const char* leaf_name)
   {
-    std::vector<Properties*>::iterator it(leaf.begin()), it_end(leaf.end());
-    Properties* prop;
-    while (it != it_end)
+    size_t len(std::strlen(leaf_name));
+    Properties* prop(_findChild(leaf_name, len,
+                                m_index ? _hash(leaf_name, len) : 0));
+    if (prop == nullptr)
+      {
+        return nullptr;
+      }
+    if (m_index)
       {
-        if ((*it)->name == leaf_name)
+        auto range(m_index->equal_range(_hash(prop->name.c_str(),
+                                              prop->name.size())));
+        for (auto it(range.first); it != range.second; ++it)
           {
-            prop = *it;
-            leaf.erase(it);
-            return prop;
+            if (it->second == prop)
+              {
+                m_index->erase(it);
+                break;
+              }
           }
-        ++it;
       }
-    return nullptr;
+    // searching from the back since clear() removes the last child
+    for (auto it(leaf.rbegin()); it != leaf.rend(); ++it)
+      {
+        if (*it == prop)
+          {
+            leaf.erase(std::next(it).base());
+            break;
+          }
+      }
+    return prop;
   }
 
   /*!
@@ -534,14 +553,8 @@ namespace coil
    */
   Properties* Properties::hasKey(const char* key) const
   {
-    for (auto prop : leaf)
-      {
-        if (prop->name == key)
-          {
-            return prop;
-          }
-      }
-    return nullptr;
+    size_t len(std::strlen(key));
+    return _findChild(key, len, m_index ? _hash(key, len) : 0);
   }
 
   /*!
@@ -571,7 +584,7 @@ namespace coil
   {
     std::vector<std::string> keys;
     keys = prop.propertyNames();
-    for (size_t i(0), len(prop.size()); i < len; ++i)
+    for (size_t i(0), len(keys.size()); i < len; ++i)
       {
         (*this)[keys[i]] = prop[keys[i]];
       }
@@ -664,7 +677,10 @@ namespace coil
                        std::vector<Properties*>::size_type index,
                        const Properties* curr)
   {
-    Properties* next(curr->hasKey(keys[index].c_str()));
+    const std::string& key(keys[index]);
+    Properties* next(curr->_findChild(key.c_str(), key.size(),
+                                      curr->m_index ?
+                                      _hash(key.c_str(), key.size()) : 0));
 
     if (next == nullptr)
       {
@@ -681,6 +697,186 @@ namespace coil
       }
   }
 
+  /*!
+   * @if jp
+   * @brief キーの一要素のハッシュ値を計算する
+   * @else
+   * @brief Calculate the hash value of a key segment
+   * @endif
+   */
+  size_t Properties::_hash(const char* key, size_t len)
+  {
+    // FNV-1a
+    size_t hash(static_cast<size_t>(2166136261U));
+    for (size_t i(0); i < len; ++i)
+      {
+        hash ^= static_cast<unsigned char>(key[i]);
+        hash *= static_cast<size_t>(16777619U);
+      }
+    return hash;
+  }
+
+  /*!
+   * @if jp
+   * @brief 子ノードを名前とハッシュ値で検索する
+   * @else
+   * @brief Find a child node by its name and hash value
+   * @endif
+   */
+  Properties* Properties::_findChild(const char* key, size_t len,
+                                     size_t hash) const
+  {
+    if (m_index)
+      {
+        auto range(m_index->equal_range(hash));
+        for (auto it(range.first); it != range.second; ++it)
+          {
+            const std::string& name(it->second->name);
+            if (name.size() == len && name.compare(0, len, key, len) == 0)
+              {
+                return it->second;
+              }
+          }
+        return nullptr;
+      }
+    for (auto prop : leaf)
+      {
+        if (prop->name.size() == len &&
+            prop->name.compare(0, len, key, len) == 0)
+          {
+            return prop;
+          }
+      }
+    return nullptr;
+  }
+
+  /*!
+   * @if jp
+   * @brief 子ノードを追加する
+   * @else
+   * @brief Add a child node
+   * @endif
+   */
+  Properties* Properties::_addChild(const char* key, size_t len, size_t hash)
+  {
+    Properties* next(new Properties(std::string(key, len).c_str()));
+    next->root = this;
+    leaf.emplace_back(next);
+    if (m_index)
+      {
+        m_index->emplace(hash, next);
+      }
+    else if (leaf.size() > PROPERTIES_INDEX_THRESHOLD)
+      {
+        m_index.reset(new std::unordered_multimap<size_t, Properties*>());
+        for (auto prop : leaf)
+          {
+            m_index->emplace(_hash(prop->name.c_str(), prop->name.size()),
+                             prop);
+          }
+      }
+    return next;
+  }
+
+  /*!
+   * @if jp
+   * @brief '.' 区切りのキーでノードを検索する
+   * @else
+   * @brief Find a node by a '.' separated key
+   * @endif
+   */
+  Properties* Properties::_findPath(const std::string& key) const
+  {
+    if (key.empty())
+      {
+        return nullptr;
+      }
+    const Properties* curr(this);
+    std::string::size_type begin(0), len(key.size());
+    for (std::string::size_type end(0); end <= len; ++end)
+      {
+        if (end == len || (key[end] == '.' && !coil::isEscaped(key, end)))
+          {
+            const char* k(key.c_str() + begin);
+            curr = curr->_findChild(k, end - begin, curr->m_index ?
+                                    _hash(k, end - begin) : 0);
+            if (curr == nullptr)
+              {
+                return nullptr;
+              }
+            begin = end + 1;
+          }
+      }
+    return const_cast<Properties*>(curr);
+  }
+
+  /*!
+   * @if jp
+   * @brief '.' 区切りのキーのノードを、存在しなければ生成して取得する
+   * @else
+   * @brief Get the node of a '.' separated key, creating it if not exist
+   * @endif
+   */
+  Properties* Properties::_createPath(const std::string& key)
+  {
+    if (key.empty())
+      {
+        return this;
+      }
+    Properties* curr(this);
+    std::string::size_type begin(0), len(key.size());
+    for (std::string::size_type end(0); end <= len; ++end)
+      {
+        if (end == len || (key[end] == '.' && !coil::isEscaped(key, end)))
+          {
+            const char* k(key.c_str() + begin);
+            size_t hash(curr->m_index ? _hash(k, end - begin) : 0);
+            Properties* next(curr->_findChild(k, end - begin, hash));
+            if (next == nullptr)
+              {
+                next = curr->_addChild(k, end - begin, hash);
+              }
+            curr = next;
+            begin = end + 1;
+          }
+      }
+    return curr;
+  }
+
+  /*!
+   * @if jp
+   * @brief 子ノードをコピーする
+   * @else
+   * @brief Copy the children
+   * @endif
+   */
+  void Properties::_copy(Properties& dst, const Properties& src)
+  {
+    for (auto prop : src.leaf)
+      {
+        const std::string& k(prop->name);
+        size_t hash(dst.m_index ? _hash(k.c_str(), k.size()) : 0);
+        Properties* next(dst._findChild(k.c_str(), k.size(), hash));
+        if (next == nullptr)
+          {
+            next = dst._addChild(k.c_str(), k.size(), hash);
+          }
+        if (prop->leaf.empty())
+          {
+            next->default_value = prop->default_value;
+            if (prop->set_value)
+              {
+                next->value = prop->value;
+                next->set_value = true;
+              }
+          }
+        else
+          {
+            _copy(*next, *prop);
+          }
+      }
+  }
+
   /*!
    * @if jp
    * @brief プロパティの名称リストを取得する
@@ -860,4 +1056,21 @@ namespace coil
           _dump(out, *prop, index + 1);
       }
   }
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  PropertyPath::PropertyPath(const std::string& key)
+    : m_key(key)
+  {
+    Properties::split(key, '.', m_keys);
+    for (auto & k : m_keys)
+      {
+        m_hashes.emplace_back(Properties::_hash(k.c_str(), k.size()));
+      }
+  }
 } // namespace coil
@@ -21,7 +21,9 @@
 #define COIL_PROPERTIES_H
 
 #include <limits>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <map>
 
@@ -42,6 +44,8 @@
  */
 namespace coil
 {
+  class PropertyPath;
+
   /*!
    * @if jp
    *
@@ -422,6 +426,64 @@ namespace coil
     const std::string& getProperty(const std::string& key,
                                    const std::string& def) const;
 
+    /*!
+     * @if jp
+     *
+     * @brief 事前に分割したキーを持つプロパティを、プロパティリストから探す
+     *
+     * getProperty(const std::string&) と同じ結果を返すが、キーの分割と
+     * ハッシュ計算を毎回行わない。同じキーで繰り返し検索する場合に使用する。
+     *
+     * @param path プロパティパス
+     *
+     * @return 指定されたキー値を持つこのプロパティリストの値
+     *
+     * @else
+     *
+     * @brief Search for the property with the precompiled key
+     *
+     * This returns the same result as getProperty(const std::string&)
+     * without splitting and hashing the key on each call. This is
+     * intended for repeated lookups with the same key.
+     *
+     * @param path The property path
+     *
+     * @return The value in this property list with the specified key value.
+     *
+     * @endif
+     */
+    const std::string& getProperty(const PropertyPath& path) const;
+
+    /*!
+     * @if jp
+     *
+     * @brief 事前に分割したキーを持つプロパティを、プロパティリストから探す
+     *
+     * そのキーがプロパティリストにないか値が空の場合は、デフォルト値の
+     * 引数が返される。
+     *
+     * @param path プロパティパス
+     * @param def デフォルト値
+     *
+     * @return 指定されたキー値を持つこのプロパティリストの値
+     *
+     * @else
+     *
+     * @brief Search for the property with the precompiled key
+     *
+     * The method returns the default value argument if the property is
+     * not found or empty.
+     *
+     * @param path The property path
+     * @param def The default value.
+     *
+     * @return The value in this property list with the specified key value.
+     *
+     * @endif
+     */
+    const std::string& getProperty(const PropertyPath& path,
+                                   const std::string& def) const;
+
     /*!
      * @if jp
      *
@@ -934,6 +996,25 @@ namespace coil
      * @endif
      */
     Properties* findNode(const std::string& key) const;
+
+    /*!
+     * @if jp
+     * @brief 事前に分割したキーを持つノードを取得する
+     *
+     * @param path 取得対象ノードのプロパティパス
+     *
+     * @return 対象ノード、存在しない場合は nullptr
+     *
+     * @else
+     * @brief Get node of properties with the precompiled key
+     *
+     * @param path Property path of the target node
+     *
+     * @return Target node, or nullptr if not found
+     *
+     * @endif
+     */
+    Properties* findNode(const PropertyPath& path) const;
     /*!
      * @if jp
      * @brief ノードを取得する
@@ -1230,6 +1311,83 @@ namespace coil
                                 std::vector<Properties*>::size_type index,
                                 const Properties* curr);
 
+    /*!
+     * @if jp
+     * @brief キーの一要素のハッシュ値を計算する
+     * @else
+     * @brief Calculate the hash value of a key segment
+     * @endif
+     */
+    static size_t _hash(const char* key, size_t len);
+
+    /*!
+     * @if jp
+     * @brief 子ノードを名前とハッシュ値で検索する
+     *
+     * 子ノードが一定数を超えるとハッシュ索引を用い、それ以下では線形探索
+     * を行う。hash はハッシュ索引がある場合のみ使用される。
+     *
+     * @else
+     * @brief Find a child node by its name and hash value
+     *
+     * A hash index is used if the number of children exceeds a
+     * threshold, otherwise the children are searched linearly. hash is
+     * used only if the hash index exists.
+     *
+     * @endif
+     */
+    Properties* _findChild(const char* key, size_t len, size_t hash) const;
+
+    /*!
+     * @if jp
+     * @brief 子ノードを追加する
+     * @else
+     * @brief Add a child node
+     * @endif
+     */
+    Properties* _addChild(const char* key, size_t len, size_t hash);
+
+    /*!
+     * @if jp
+     * @brief '.' 区切りのキーでノードを検索する
+     *
+     * split() と _getNode() の組み合わせと同じ結果を、キーを分割した文字列
+     * を生成せずに返す。
+     *
+     * @else
+     * @brief Find a node by a '.' separated key
+     *
+     * This returns the same result as split() followed by _getNode()
+     * without creating the split strings.
+     *
+     * @endif
+     */
+    Properties* _findPath(const std::string& key) const;
+
+    /*!
+     * @if jp
+     * @brief '.' 区切りのキーのノードを、存在しなければ生成して取得する
+     * @else
+     * @brief Get the node of a '.' separated key, creating it if not exist
+     * @endif
+     */
+    Properties* _createPath(const std::string& key);
+
+    /*!
+     * @if jp
+     * @brief 子ノードをコピーする
+     *
+     * 末端ノードの値とデフォルト値のみをコピーする。
+     *
+     * @else
+     * @brief Copy the children
+     *
+     * Only the values and the default values of the leaf nodes are copied.
+     *
+     * @endif
+     */
+    static void _copy(Properties& dst, const Properties& src);
+
     /*!
      * @if jp
      * @brief プロパティの名称リストを取得する
@@ -1343,6 +1501,10 @@ namespace coil
     Properties* root{nullptr};
     std::vector<Properties*> leaf;
     const std::string m_empty = "";
+    // Hash index of leaf, created when the number of children grows.
+    std::unique_ptr<std::unordered_multimap<size_t, Properties*>> m_index;
+
+    friend class PropertyPath;
 
     /*!
      * @if jp
@@ -1370,5 +1532,64 @@ namespace coil
     friend std::ostream& operator<<(std::ostream& lhs, const Properties& rhs);
 
   };  // class Properties
+
+  /*!
+   * @if jp
+   *
+   * @class PropertyPath
+   * @brief 事前に分割されたプロパティのキー
+   *
+   * '.' 区切りのキーを分割し、各要素のハッシュ値を計算した結果を保持する。
+   * 同じキーで繰り返し Properties を検索する場合に、キーの解析を一度だけ
+   * 行うために使用する。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   *
+   * @class PropertyPath
+   * @brief Precompiled property key
+   *
+   * This holds the segments of a '.' separated key and their hash
+   * values, so that the key is parsed only once for repeated lookups of
+   * Properties.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class PropertyPath
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     *
+     * @param key '.' 区切りのプロパティキー
+     *
+     * @else
+     * @brief Constructor
+     *
+     * @param key '.' separated property key
+     *
+     * @endif
+     */
+    explicit PropertyPath(const std::string& key);
+
+    /*!
+     * @if jp
+     * @brief キー文字列を取得する
+     * @else
+     * @brief Get the key string
+     * @endif
+     */
+    const std::string& str() const { return m_key; }
+
+  private:
+    friend class Properties;
+    std::string m_key;
+    std::vector<std::string> m_keys;
+    std::vector<size_t> m_hashes;
+  };
 } // namespace coil
 #endif  // COIL_PROPERTIES_H
@@ -21,12 +21,16 @@
 
 #include <array>
 #include <climits>
+#include <cmath>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
 #include <iostream>
 #include <cctype>
+#include <cerrno>
+#include <limits>
+#include <locale>
 #include <regex>
 #include <utility>
 #include <unordered_set>
@@ -37,6 +41,17 @@ using std::toupper;
 using std::isalpha;
 #endif
 
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#include <locale.h>
+#define COIL_HAVE_STRTOD_L
+#elif defined(__APPLE__) || defined(__FreeBSD__)
+#include <xlocale.h>
+#define COIL_HAVE_STRTOD_L
+#elif defined(__GLIBC__)
+#include <locale.h>
+#define COIL_HAVE_STRTOD_L
+#endif
+
 namespace coil
 {
   /*!
@@ -798,6 +813,233 @@ namespace coil
     return stringToDuration(val, str);
   }
 
+  /*!
+   * @if jp
+   * @brief 与えられた文字列を符号付き整数に変換
+   * @else
+   * @brief Convert the given string to a signed integer.
+   * @endif
+   */
+  template <typename To>
+  bool stringToSigned(To& val, const char* str)
+  {
+    if (str == nullptr) { return false; }
+    char* end(nullptr);
+    errno = 0;
+    long long num(std::strtoll(str, &end, 10));
+    if (end == str || errno == ERANGE) { return false; }
+    if (num < static_cast<long long>(std::numeric_limits<To>::min()) ||
+        num > static_cast<long long>(std::numeric_limits<To>::max()))
+      {
+        return false;
+      }
+    val = static_cast<To>(num);
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 与えられた文字列を符号なし整数に変換
+   *
+   * std::stringstream と同様に、負の値は符号なし整数として折り返す。
+   *
+   * @else
+   * @brief Convert the given string to an unsigned integer.
+   *
+   * A negative value wraps around as an unsigned integer in the same
+   * way as std::stringstream.
+   *
+   * @endif
+   */
+  template <typename To>
+  bool stringToUnsigned(To& val, const char* str)
+  {
+    if (str == nullptr) { return false; }
+    const char* digits(str);
+    while (std::isspace(static_cast<unsigned char>(*digits)) != 0) { ++digits; }
+    bool negative(*digits == '-');
+    if (negative || *digits == '+') { ++digits; }
+    if (std::isdigit(static_cast<unsigned char>(*digits)) == 0) { return false; }
+
+    char* end(nullptr);
+    errno = 0;
+    unsigned long long num(std::strtoull(digits, &end, 10));
+    if (end == digits || errno == ERANGE) { return false; }
+    if (num > static_cast<unsigned long long>(std::numeric_limits<To>::max()))
+      {
+        return false;
+      }
+    val = negative ? static_cast<To>(-static_cast<To>(num)) : static_cast<To>(num);
+    return true;
+  }
+
+#ifdef COIL_HAVE_STRTOD_L
+  /*!
+   * @if jp
+   * @brief "C" ロケールで文字列を浮動小数点数に変換
+   * @else
+   * @brief Convert a string to a floating point number in the "C" locale
+   * @endif
+   */
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+  using c_locale_t = _locale_t;
+  static c_locale_t classicLocale()
+  {
+    static c_locale_t loc(_create_locale(LC_NUMERIC, "C"));
+    return loc;
+  }
+  static float strtoClassic(const char* str, char** end, float*)
+  {
+    return _strtof_l(str, end, classicLocale());
+  }
+  static double strtoClassic(const char* str, char** end, double*)
+  {
+    return _strtod_l(str, end, classicLocale());
+  }
+  static long double strtoClassic(const char* str, char** end, long double*)
+  {
+    return _strtold_l(str, end, classicLocale());
+  }
+#else
+  using c_locale_t = locale_t;
+  static c_locale_t classicLocale()
+  {
+    static c_locale_t loc(newlocale(LC_NUMERIC_MASK, "C",
+                                    static_cast<locale_t>(0)));
+    return loc;
+  }
+  static float strtoClassic(const char* str, char** end, float*)
+  {
+    return strtof_l(str, end, classicLocale());
+  }
+  static double strtoClassic(const char* str, char** end, double*)
+  {
+    return strtod_l(str, end, classicLocale());
+  }
+  static long double strtoClassic(const char* str, char** end, long double*)
+  {
+    return strtold_l(str, end, classicLocale());
+  }
+#endif
+#endif  // COIL_HAVE_STRTOD_L
+
+  /*!
+   * @if jp
+   * @brief 与えられた文字列を浮動小数点数に変換
+   *
+   * strtod 系の関数は LC_NUMERIC に従って小数点を解釈するため、"C" ロ
+   * ケールを指定する strtod_l 系の関数を使用する。それがない環境では
+   * classic ロケールの std::istringstream で変換する。
+   *
+   * @else
+   * @brief Convert the given string to a floating point number.
+   *
+   * Since the strtod family interprets the decimal point by
+   * LC_NUMERIC, the strtod_l family with the "C" locale is used. Where
+   * it is not available, std::istringstream with the classic locale is
+   * used.
+   *
+   * @endif
+   */
+  template <typename To>
+  bool stringToFloating(To& val, const char* str, To huge)
+  {
+    if (str == nullptr) { return false; }
+#ifdef COIL_HAVE_STRTOD_L
+    if (classicLocale() != static_cast<c_locale_t>(0))
+      {
+        char* end(nullptr);
+        errno = 0;
+        To num(strtoClassic(str, &end, static_cast<To*>(nullptr)));
+        if (end == str) { return false; }
+        if (errno == ERANGE && (num == huge || num == -huge)) { return false; }
+        val = num;
+        return true;
+      }
+#else
+    (void)huge;
+#endif  // COIL_HAVE_STRTOD_L
+    std::istringstream is(str);
+    is.imbue(std::locale::classic());
+    To num;
+    if ((is >> num).fail()) { return false; }
+    val = num;
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 与えられた文字列を数値に変換
+   * @else
+   * @brief Convert the given string to a number.
+   * @endif
+   */
+  template <>
+  bool stringTo<short>(short& val, const char* str)
+  {
+    return stringToSigned(val, str);
+  }
+
+  template <>
+  bool stringTo<unsigned short>(unsigned short& val, const char* str)
+  {
+    return stringToUnsigned(val, str);
+  }
+
+  template <>
+  bool stringTo<int>(int& val, const char* str)
+  {
+    return stringToSigned(val, str);
+  }
+
+  template <>
+  bool stringTo<unsigned int>(unsigned int& val, const char* str)
+  {
+    return stringToUnsigned(val, str);
+  }
+
+  template <>
+  bool stringTo<long>(long& val, const char* str)
+  {
+    return stringToSigned(val, str);
+  }
+
+  template <>
+  bool stringTo<unsigned long>(unsigned long& val, const char* str)
+  {
+    return stringToUnsigned(val, str);
+  }
+
+  template <>
+  bool stringTo<long long>(long long& val, const char* str)
+  {
+    return stringToSigned(val, str);
+  }
+
+  template <>
+  bool stringTo<unsigned long long>(unsigned long long& val, const char* str)
+  {
+    return stringToUnsigned(val, str);
+  }
+
+  template <>
+  bool stringTo<float>(float& val, const char* str)
+  {
+    return stringToFloating(val, str, HUGE_VALF);
+  }
+
+  template <>
+  bool stringTo<double>(double& val, const char* str)
+  {
+    return stringToFloating(val, str, HUGE_VAL);
+  }
+
+  template <>
+  bool stringTo<long double>(long double& val, const char* str)
+  {
+    return stringToFloating(val, str, HUGE_VALL);
+  }
+
   /*!
    * @if jp
    * @brief 与えられた文字列リストから重複を削除
@@ -28,6 +28,8 @@
 #include <cerrno>
 #include <cstdlib>
 #include <chrono>
+#include <type_traits>
+#include <utility>
 
 #if defined(VXWORKS_66) && !defined(__RTP__)
 #else
@@ -922,6 +924,150 @@ namespace coil
   template<>
   bool stringTo<std::chrono::hours>(std::chrono::hours& val, const char* str);
 
+  /*!
+   * @if jp
+   * @brief 与えられた文字列を数値に変換
+   *
+   * 引数で与えられた文字列を整数または浮動小数点数に変換する。
+   * std::stringstream を使用せず strtol/strtod 系の関数で変換する。浮
+   * 動小数点数は setlocale() の設定によらず "C" ロケールで解釈する。
+   * 先頭の空白は読み飛ばし、数値に続く文字は無視する。値が型の範囲を
+   * 超える場合は失敗となる。
+   *
+   * @param val 変換先の数値
+   * @param str 変換元文字列
+   *
+   * @return true: 成功, false: 失敗
+   *
+   * @else
+   * @brief Convert the given string to a number.
+   *
+   * Convert string given by the argument to an integer or a floating
+   * point number. The conversion is done by the strtol/strtod family
+   * instead of std::stringstream. Floating point numbers are parsed in
+   * the "C" locale regardless of setlocale(). Leading white spaces are
+   * skipped and characters following the number are ignored. It fails
+   * if the value is out of the range of the type.
+   *
+   * @param val The number of conversion destination
+   * @param str String of conversion source
+   *
+   * @return true: successful, false: failed
+   *
+   * @endif
+   */
+  template<>
+  bool stringTo<short>(short& val, const char* str);
+  template<>
+  bool stringTo<unsigned short>(unsigned short& val, const char* str);
+  template<>
+  bool stringTo<int>(int& val, const char* str);
+  template<>
+  bool stringTo<unsigned int>(unsigned int& val, const char* str);
+  template<>
+  bool stringTo<long>(long& val, const char* str);
+  template<>
+  bool stringTo<unsigned long>(unsigned long& val, const char* str);
+  template<>
+  bool stringTo<long long>(long long& val, const char* str);
+  template<>
+  bool stringTo<unsigned long long>(unsigned long long& val, const char* str);
+  template<>
+  bool stringTo<float>(float& val, const char* str);
+  template<>
+  bool stringTo<double>(double& val, const char* str);
+  template<>
+  bool stringTo<long double>(long double& val, const char* str);
+
+  /*!
+   * @if jp
+   * @brief std::istream から T に読み込む operator>> があるかどうか
+   * @else
+   * @brief Whether operator>> reading T from std::istream exists
+   * @endif
+   */
+  template <typename T>
+  class has_extractor
+  {
+    template <typename U>
+    static auto test(int)
+      -> decltype(std::declval<std::istream&>() >> std::declval<U&>(),
+                  std::true_type());
+    template <typename>
+    static std::false_type test(...);
+  public:
+    static const bool value = decltype(test<T>(0))::value;
+  };
+
+  /*!
+   * @if jp
+   * @brief 与えられたカンマ区切りの文字列をstd::vectorに変換
+   *
+   * 引数で与えられた文字列を "," で分割し、前後の空白を除いた各要素を
+   * stringTo() で変換する。空文字列は空の vector となる。いずれかの要
+   * 素の変換に失敗した場合は失敗となり、val は変更されない。
+   * std::vector<To> に対する operator>> が定義されている場合、このオー
+   * バーロードは使用されず、従来通りその operator>> で変換する。
+   *
+   * @param val 変換先のvector
+   * @param str 変換元文字列
+   *
+   * @return true: 成功, false: 失敗
+   *
+   * @else
+   * @brief Convert the given comma separated string to std::vector.
+   *
+   * Split string given by the argument with "," and convert each
+   * element with stringTo() after removing the leading and trailing
+   * blanks. An empty string becomes an empty vector. If any element
+   * fails, the conversion fails and val is not modified. If an
+   * operator>> for std::vector<To> is defined, this overload is not
+   * used and the conversion is done by the operator>> as before.
+   *
+   * @param val The vector of conversion destination
+   * @param str String of conversion source
+   *
+   * @return true: successful, false: failed
+   *
+   * @endif
+   */
+  template <typename To>
+  typename std::enable_if<!has_extractor<std::vector<To>>::value, bool>::type
+  stringTo(std::vector<To>& val, const char* str)
+  {
+    if (str == nullptr) { return false; }
+
+    std::vector<To> ret;
+    std::string elem;
+    const char* begin(str);
+    while (*begin == ' ' || *begin == '\t') { ++begin; }
+    if (*begin == '\0')
+      {
+        val.clear();
+        return true;
+      }
+    for (;;)
+      {
+        const char* end(begin);
+        while (*end != ',' && *end != '\0') { ++end; }
+        const char* head(begin);
+        const char* tail(end);
+        while (head < tail && (*head == ' ' || *head == '\t')) { ++head; }
+        while (tail > head && (*(tail - 1) == ' ' || *(tail - 1) == '\t'))
+          {
+            --tail;
+          }
+        elem.assign(head, tail);
+        To item;
+        if (!stringTo(item, elem.c_str())) { return false; }
+        ret.emplace_back(std::move(item));
+        if (*end == '\0') { break; }
+        begin = end + 1;
+      }
+    val.swap(ret);
+    return true;
+  }
+
   /*!
    * @if jp
    * @brief ポインタを16進数文字列に変換する
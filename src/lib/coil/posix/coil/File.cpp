@@ -18,6 +18,8 @@
 
 #include <coil/File.h>
 
+#include <cstdlib>
+
 namespace coil
 {
   /*!
@@ -148,4 +150,52 @@ namespace coil
           }
       }
   }
+
+  /*!
+   * @if jp
+   * @brief ファイルの最終更新時刻を取得する
+   * @else
+   * @brief Get the last modification time of a file
+   * @endif
+   */
+  long long getModifiedTime(const std::string& path)
+  {
+    struct stat stat_buf;
+    if (stat(path.c_str(), &stat_buf) != 0) { return -1; }
+    return static_cast<long long>(stat_buf.st_mtime);
+  }
+
+  /*!
+   * @if jp
+   * @brief ディレクトリ一覧を指定ディレクトリから再帰的に探査する
+   * @else
+   * @brief Get the directory tree under the given directory
+   * @endif
+   */
+  void getDirectoryList(const std::string& dir, coil::vstring& dirlist)
+  {
+    dirlist.emplace_back(dir);
+    struct dirent **namelist=nullptr;
+#ifndef COIL_OS_QNX
+    int files = scandir(dir.c_str(), &namelist, nullptr, nullptr);
+#else
+    int files = scandir(const_cast<char*>(dir.c_str()), &namelist, NULL, NULL);
+#endif
+
+    for (int i = 0; i < files; ++i)
+      {
+        std::string dname = namelist[i]->d_name;
+        free(namelist[i]);
+        if (dname == "." || dname == "..") { continue; }
+
+        std::string fullpath = dir + "/" + dname;
+        struct stat stat_buf;
+        if(stat(fullpath.c_str(), &stat_buf) != 0) { continue; }
+        if ((stat_buf.st_mode & S_IFMT) == S_IFDIR)
+          {
+            getDirectoryList(fullpath, dirlist); // recursive call
+          }
+      }
+    free(namelist);
+  }
 } //namespace coil
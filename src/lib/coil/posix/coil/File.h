@@ -232,6 +232,51 @@ namespace coil
   * @endif
   */
   void getFileList(const std::string& dir, const std::string& ext, coil::vstring &filelist);
+
+  /*!
+   * @if jp
+   *
+   * @brief եκǽ
+   *
+   * @param path եޤϥǥ쥯ȥΥѥ
+   *
+   * @return ǽ (ݥå)¸ߤʤ -1
+   *
+   * @else
+   *
+   * @brief Get the last modification time of a file
+   *
+   * @param path Path of a file or a directory
+   *
+   * @return Last modification time (seconds since the epoch), or -1 if
+   *         the file does not exist
+   *
+   * @endif
+   */
+  long long getModifiedTime(const std::string& path);
+
+  /*!
+   * @if jp
+   *
+   * @brief ǥ쥯ȥǥ쥯ȥ꤫ƵŪõ
+   *
+   * dir ȤȤƤΥ֥ǥ쥯ȥ dirlist ɲä롣
+   *
+   * @param dir ǥ쥯ȥѥ
+   * @param dirlist ǥ쥯ȥ
+   *
+   * @else
+   *
+   * @brief Get the directory tree under the given directory
+   *
+   * dir itself and all its subdirectories are appended to dirlist.
+   *
+   * @param dir Directory path
+   * @param dirlist Directory list
+   *
+   * @endif
+   */
+  void getDirectoryList(const std::string& dir, coil::vstring& dirlist);
 } // namespace coil
 
 #endif // COIL_FILE_H
@@ -21,6 +21,8 @@
 #include <netdb.h>       // gethostbyname
 #include <arpa/inet.h>   // inet_ntop
 #include <netinet/in.h>  // sockaddr_in
+#include <ifaddrs.h>      // getifaddrs
+#include <net/if.h>      // IFF_UP
 #include <sys/wait.h>
 
 #include <coil/Routing.h>
@@ -169,4 +171,37 @@ namespace coil
     return false;
   }
 
+  /*!
+   * @if jp
+   * @brief ループバック以外の最初の IPv4 アドレスを取得する
+   * @else
+   * @brief Get the first non-loopback IPv4 address
+   * @endif
+   */
+  bool default_ipaddr(std::string& ipaddr)
+  {
+    struct ::ifaddrs* addrs(nullptr);
+    if (::getifaddrs(&addrs) != 0) { return false; }
+
+    bool found(false);
+    for (struct ::ifaddrs* ifa(addrs); ifa != nullptr; ifa = ifa->ifa_next)
+      {
+        if (ifa->ifa_addr == nullptr ||
+            ifa->ifa_addr->sa_family != AF_INET ||
+            (ifa->ifa_flags & IFF_UP) == 0 ||
+            (ifa->ifa_flags & IFF_LOOPBACK) != 0) { continue; }
+        char buf[INET_ADDRSTRLEN];
+        const struct ::sockaddr_in* sin(
+          reinterpret_cast<const struct ::sockaddr_in*>(ifa->ifa_addr));
+        if (::inet_ntop(AF_INET, &sin->sin_addr, buf, sizeof(buf)) != nullptr)
+          {
+            ipaddr = buf;
+            found = true;
+            break;
+          }
+      }
+    ::freeifaddrs(addrs);
+    return found;
+  }
+
 } // namespace coil
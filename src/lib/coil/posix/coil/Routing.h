@@ -119,6 +119,30 @@ namespace coil
    */
   bool ifname_to_ipaddr(const std::string& ifname, std::string& ipaddr);
 
+  /*!
+   * @if jp
+   * @brief 롼ץХåʳκǽ IPv4 ɥ쥹
+   *
+   * ͭʥͥåȥ󥿡եΤ롼ץХåʳǺǽ
+   * ˸Ĥä IPv4 ɥ쥹֤Ĥʤ false ֤
+   *
+   * @param ipaddr IP ɥ쥹
+   * @return  true,  false
+   *
+   * @else
+   * @brief Get the first non-loopback IPv4 address
+   *
+   * This operation returns the first IPv4 address found on the network
+   * interfaces which are up and not loopback. If no such address is
+   * found, this operation returns false.
+   *
+   * @param ipaddr IP address
+   * @return successful: true, failed: false
+   *
+   * @endif
+   */
+  bool default_ipaddr(std::string& ipaddr);
+
 
   } // namespace coil
 #endif  // COIL_ROUTING_H
@@ -531,4 +531,55 @@ namespace coil
   }
 
 
+
+  /*!
+   * @if jp
+   * @brief ファイルの最終更新時刻を取得する
+   * @else
+   * @brief Get the last modification time of a file
+   * @endif
+   */
+  long long getModifiedTime(const std::string& path)
+  {
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (GetFileAttributesEx(path.c_str(), GetFileExInfoStandard, &data) == 0)
+      {
+        return -1;
+      }
+    ULARGE_INTEGER t;
+    t.LowPart = data.ftLastWriteTime.dwLowDateTime;
+    t.HighPart = data.ftLastWriteTime.dwHighDateTime;
+    // FILETIME is 100ns intervals since 1601-01-01
+    return static_cast<long long>(t.QuadPart / 10000000ULL) - 11644473600LL;
+  }
+
+  /*!
+   * @if jp
+   * @brief ディレクトリ一覧を指定ディレクトリから再帰的に探査する
+   * @else
+   * @brief Get the directory tree under the given directory
+   * @endif
+   */
+  void getDirectoryList(const std::string& dir, coil::vstring& dirlist)
+  {
+      dirlist.emplace_back(dir);
+      HANDLE hFind;
+      WIN32_FIND_DATA win32fd;
+      std::string dir_fff = dir + "\\*";
+      hFind = FindFirstFile(dir_fff.c_str(), &win32fd);
+
+      if (hFind == INVALID_HANDLE_VALUE) {
+          return;
+      }
+      do {
+          if ((win32fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0U) {
+              std::string filename = win32fd.cFileName;
+              if (filename != "." && filename != "..")
+              {
+                  getDirectoryList(dir + "\\" + filename, dirlist);
+              }
+          }
+      } while (FindNextFile(hFind, &win32fd));
+      FindClose(hFind);
+  }
 } // namespace coil
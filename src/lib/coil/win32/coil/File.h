@@ -271,6 +271,51 @@ namespace coil
   */
   void getFileList(const std::string& dir, const std::string& ext, coil::vstring &filelist);
 
+
+  /*!
+   * @if jp
+   *
+   * @brief ファイルの最終更新時刻を取得する
+   *
+   * @param path ファイルまたはディレクトリのパス
+   *
+   * @return 最終更新時刻 (エポックからの秒)、存在しない場合は -1
+   *
+   * @else
+   *
+   * @brief Get the last modification time of a file
+   *
+   * @param path Path of a file or a directory
+   *
+   * @return Last modification time (seconds since the epoch), or -1 if
+   *         the file does not exist
+   *
+   * @endif
+   */
+  long long getModifiedTime(const std::string& path);
+
+  /*!
+   * @if jp
+   *
+   * @brief ディレクトリ一覧を指定ディレクトリから再帰的に探査する
+   *
+   * dir 自身とその全てのサブディレクトリを dirlist に追加する。
+   *
+   * @param dir ディレクトリパス
+   * @param dirlist ディレクトリ一覧
+   *
+   * @else
+   *
+   * @brief Get the directory tree under the given directory
+   *
+   * dir itself and all its subdirectories are appended to dirlist.
+   *
+   * @param dir Directory path
+   * @param dirlist Directory list
+   *
+   * @endif
+   */
+  void getDirectoryList(const std::string& dir, coil::vstring& dirlist);
 };
 
 #endif // COIL_FILE_H
@@ -39,7 +39,7 @@ namespace RTC
      */
     ByteData::~ByteData()
     {
-        delete[] m_buf;
+        release();
     }
 
     /*!
@@ -60,7 +60,14 @@ namespace RTC
      * @endif
      */
     ByteData::ByteData(const ByteData &rhs)
+        : m_arrivalSequence(rhs.m_arrivalSequence),
+          m_arrivalTime(rhs.m_arrivalTime)
     {
+        if (rhs.m_shared)
+        {
+            setSharedBuffer(rhs.m_shared, rhs.m_len);
+            return;
+        }
         m_len = rhs.m_len;
         m_buf = new unsigned char[m_len];
         memcpy(m_buf, rhs.m_buf, m_len);
@@ -85,6 +92,12 @@ namespace RTC
      */
     ByteData::ByteData(const ByteDataStreamBase &rhs)
     {
+        std::shared_ptr<unsigned char> shared(rhs.getSharedBuffer());
+        if (shared)
+        {
+            setSharedBuffer(shared, rhs.getDataLength());
+            return;
+        }
         m_len = rhs.getDataLength();
         m_buf = new unsigned char[m_len];
         rhs.readData(m_buf, m_len);
@@ -109,6 +122,14 @@ namespace RTC
      */
     ByteData& ByteData::operator= (const ByteData &rhs)
     {
+        m_arrivalSequence = rhs.m_arrivalSequence;
+        m_arrivalTime = rhs.m_arrivalTime;
+        if (rhs.m_shared)
+        {
+            if (this != &rhs) { setSharedBuffer(rhs.m_shared, rhs.m_len); }
+            return *this;
+        }
+        if (m_shared) { release(); }
         if(m_len != rhs.m_len)
         {
             m_len = rhs.m_len;
@@ -138,6 +159,13 @@ namespace RTC
      */
     ByteData& ByteData::operator= (const ByteDataStreamBase &rhs)
     {
+        std::shared_ptr<unsigned char> shared(rhs.getSharedBuffer());
+        if (shared)
+        {
+            setSharedBuffer(shared, rhs.getDataLength());
+            return *this;
+        }
+        if (m_shared) { release(); }
         if(m_len != rhs.getDataLength())
         {
             m_len = rhs.getDataLength();
@@ -167,6 +195,54 @@ namespace RTC
     {
         return m_buf;
     }
+    /*!
+     * @if jp
+     *
+     * @brief 共有バッファを参照する
+     *
+     * @param buffer 共有するバッファ
+     * @param length データの長さ
+     *
+     * @else
+     *
+     * @brief Refer to a shared buffer
+     *
+     * @param buffer Shared buffer
+     * @param length Data length
+     *
+     * @endif
+     */
+    void ByteData::setSharedBuffer(std::shared_ptr<unsigned char> buffer,
+                                   unsigned long length)
+    {
+        release();
+        if (!buffer)
+        {
+            return;
+        }
+        m_shared = std::move(buffer);
+        m_buf = m_shared.get();
+        m_len = length;
+    }
+    /*!
+     * @if jp
+     *
+     * @brief 共有バッファを取得
+     *
+     * @return 共有バッファ。共有していない場合は空
+     *
+     * @else
+     *
+     * @brief Get the shared buffer
+     *
+     * @return Shared buffer, or empty if not shared
+     *
+     * @endif
+     */
+    std::shared_ptr<unsigned char> ByteData::getSharedBuffer() const
+    {
+        return m_shared;
+    }
     /*!
      * @if jp
      *
@@ -247,6 +323,7 @@ namespace RTC
             return;
         }
 
+        if (m_shared) { release(); }
         if(m_len != length)
         {
             delete[] m_buf;
@@ -295,11 +372,11 @@ namespace RTC
      */
     void ByteData::setDataLength(unsigned long length)
     {
-        if (length <= 0 || m_len == length)
+        if (length <= 0 || (m_len == length && !m_shared))
         {
             return;
         }
-        delete[] m_buf;
+        release();
 
         m_len = length;
         m_buf = new unsigned char[m_len];
@@ -325,4 +402,93 @@ namespace RTC
     {
         return m_little_endian;
     }
+    /*!
+     * @if jp
+     *
+     * @brief 到着情報の設定
+     *
+     * @param sequence 到着番号
+     * @param time 到着時刻
+     *
+     * @else
+     *
+     * @brief Set the arrival information
+     *
+     * @param sequence Arrival number
+     * @param time Arrival time
+     *
+     * @endif
+     */
+    void ByteData::setArrival(unsigned long long sequence,
+                              std::chrono::steady_clock::time_point time)
+    {
+        m_arrivalSequence = sequence;
+        m_arrivalTime = time;
+    }
+    /*!
+     * @if jp
+     *
+     * @brief 到着番号の取得
+     *
+     * @return 到着番号
+     *
+     * @else
+     *
+     * @brief Get the arrival number
+     *
+     * @return Arrival number
+     *
+     * @endif
+     */
+    unsigned long long ByteData::getArrivalSequence() const
+    {
+        return m_arrivalSequence;
+    }
+    /*!
+     * @if jp
+     *
+     * @brief 到着時刻の取得
+     *
+     * @return 到着時刻
+     *
+     * @else
+     *
+     * @brief Get the arrival time
+     *
+     * @return Arrival time
+     *
+     * @endif
+     */
+    std::chrono::steady_clock::time_point ByteData::getArrivalTime() const
+    {
+        return m_arrivalTime;
+    }
+    /*!
+     * @if jp
+     *
+     * @brief バッファを解放する
+     *
+     * 共有バッファの場合は参照をやめるだけで解放しない。
+     *
+     * @else
+     *
+     * @brief Release the buffer
+     *
+     * A shared buffer is only stopped referring to and not freed.
+     *
+     * @endif
+     */
+    void ByteData::release()
+    {
+        if (m_shared)
+        {
+            m_shared.reset();
+        }
+        else
+        {
+            delete[] m_buf;
+        }
+        m_buf = nullptr;
+        m_len = 0;
+    }
 } // namespace RTC
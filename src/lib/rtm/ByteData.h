@@ -1,6 +1,8 @@
 ﻿#ifndef RTC_BYTEDATA_H
 #define RTC_BYTEDATA_H
 
+#include <chrono>
+#include <memory>
 
 
 namespace RTC
@@ -191,6 +193,52 @@ namespace RTC
          * @endif
          */
         unsigned char* getBuffer() const;
+        /*!
+         * @if jp
+         *
+         * @brief 共有バッファを参照する
+         *
+         * データをコピーせずに buffer の先頭 length バイトを参照する。
+         * バッファはシリアライザやトランスポートと共有されるため、参照
+         * 中は変更してはならない。writeData() や setDataLength() を呼ぶ
+         * と共有をやめて自身のバッファを確保する。
+         *
+         * @param buffer 共有するバッファ
+         * @param length データの長さ
+         *
+         * @else
+         *
+         * @brief Refer to a shared buffer
+         *
+         * The first length bytes of buffer are referred to without
+         * copying. Since the buffer is shared with serializers and
+         * transports, it must not be modified while referred to.
+         * writeData() and setDataLength() stop sharing and allocate an
+         * own buffer.
+         *
+         * @param buffer Shared buffer
+         * @param length Data length
+         *
+         * @endif
+         */
+        void setSharedBuffer(std::shared_ptr<unsigned char> buffer,
+                             unsigned long length);
+        /*!
+         * @if jp
+         *
+         * @brief 共有バッファを取得
+         *
+         * @return 共有バッファ。共有していない場合は空
+         *
+         * @else
+         *
+         * @brief Get the shared buffer
+         *
+         * @return Shared buffer, or empty if not shared
+         *
+         * @endif
+         */
+        std::shared_ptr<unsigned char> getSharedBuffer() const;
         /*!
          * @if jp
          *
@@ -262,10 +310,77 @@ namespace RTC
          * @endif
          */
         bool getEndian();
+        /*!
+         * @if jp
+         *
+         * @brief 到着情報の設定
+         *
+         * 受信側のコネクタがバッファに書き込む前に、コネクタ毎の到着番
+         * 号と到着時刻を設定する。バッファから同じデータが再度読み出さ
+         * れたことや、読み出されずに破棄されたデータを知るために用いる。
+         * コピーにも引き継がれる。
+         *
+         * @param sequence 1 から始まる到着番号。0 は到着情報なし。
+         * @param time 到着時刻
+         *
+         * @else
+         *
+         * @brief Set the arrival information
+         *
+         * The receiving connector sets the arrival number per connector
+         * and the arrival time before writing the data to the buffer.
+         * They are used to know that the same data is read from the
+         * buffer again, or that data has been discarded without being
+         * read. They are kept by copies.
+         *
+         * @param sequence Arrival number starting from 1. 0 means no
+         *                 arrival information.
+         * @param time Arrival time
+         *
+         * @endif
+         */
+        void setArrival(unsigned long long sequence,
+                        std::chrono::steady_clock::time_point time);
+        /*!
+         * @if jp
+         *
+         * @brief 到着番号の取得
+         *
+         * @return 到着番号。到着情報がない場合は 0。
+         *
+         * @else
+         *
+         * @brief Get the arrival number
+         *
+         * @return Arrival number, or 0 if there is no arrival information
+         *
+         * @endif
+         */
+        unsigned long long getArrivalSequence() const;
+        /*!
+         * @if jp
+         *
+         * @brief 到着時刻の取得
+         *
+         * @return 到着時刻
+         *
+         * @else
+         *
+         * @brief Get the arrival time
+         *
+         * @return Arrival time
+         *
+         * @endif
+         */
+        std::chrono::steady_clock::time_point getArrivalTime() const;
     private:
+        void release();
         unsigned char* m_buf{nullptr};
+        std::shared_ptr<unsigned char> m_shared;
         unsigned long m_len{0};
         bool m_little_endian{true};
+        unsigned long long m_arrivalSequence{0};
+        std::chrono::steady_clock::time_point m_arrivalTime;
     };
 
 } // namespace RTC
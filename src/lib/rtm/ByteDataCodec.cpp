@@ -0,0 +1,428 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ByteDataCodec.cpp
+ * @brief Byte data codec class for composite serializers
+ * @date $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/ByteDataCodec.h>
+#include <coil/stringutil.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief 仮想デストラクタ
+   * @else
+   * @brief Virtual destructor
+   * @endif
+   */
+  ByteDataCodec::~ByteDataCodec() = default;
+
+  /*!
+   * @if jp
+   * @brief 初期化
+   * @else
+   * @brief Initialization
+   * @endif
+   */
+  void ByteDataCodec::init(const coil::Properties& /*prop*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief 前のデータに依存する符号化を行うかどうか
+   * @else
+   * @brief Whether the encoding depends on the previous data
+   * @endif
+   */
+  bool ByteDataCodec::stateful() const
+  {
+    return false;
+  }
+
+  /*!
+   * @if jp
+   * @brief 符号化の状態をリセットする
+   * @else
+   * @brief Reset the encoding state
+   * @endif
+   */
+  void ByteDataCodec::reset()
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief コーデックの状態をプロパティに書き出す
+   * @else
+   * @brief Write the status of the codec to properties
+   * @endif
+   */
+  void ByteDataCodec::getStatus(coil::Properties& /*prop*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief 次に復号するデータの到着情報を設定する
+   * @else
+   * @brief Set the arrival information of the data decoded next
+   * @endif
+   */
+  void ByteDataCodec::setArrival(unsigned long long /*sequence*/,
+                                 std::chrono::steady_clock::time_point /*time*/)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  ByteDataCodecChain::ByteDataCodecChain()
+    : rtclog("ByteDataCodecChain"), m_threshold(256), m_maxSize(67108864)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  ByteDataCodecChain::~ByteDataCodecChain()
+  {
+    if (m_stats.encoded + m_stats.stored + m_stats.decoded > 0)
+      {
+        std::string names;
+        for (auto const& codec : m_codecs)
+          {
+            names += (names.empty() ? "" : "+") + codec.first;
+          }
+        RTC_INFO(("%s statistics: encoded %llu, stored %llu, decoded %llu, "
+                  "errors %llu, ratio %.3f, encode %lld us, decode %lld us",
+                  names.c_str(), m_stats.encoded, m_stats.stored,
+                  m_stats.decoded, m_stats.errors, m_stats.ratio(),
+                  static_cast<long long>(std::chrono::duration_cast<
+                    std::chrono::microseconds>(m_stats.encode_time).count()),
+                  static_cast<long long>(std::chrono::duration_cast<
+                    std::chrono::microseconds>(m_stats.decode_time).count())));
+      }
+    for (auto & codec : m_codecs)
+      {
+        ByteDataCodecFactory::instance().deleteObject(codec.second);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief コーデックを生成する
+   * @else
+   * @brief Create codecs
+   * @endif
+   */
+  bool ByteDataCodecChain::setCodecs(const coil::vstring& names)
+  {
+    for (auto const& name : names)
+      {
+        ByteDataCodec* codec(ByteDataCodecFactory::instance().createObject(name));
+        if (codec == nullptr)
+          {
+            RTC_ERROR(("Codec not found: %s", name.c_str()));
+            return false;
+          }
+        m_codecs.emplace_back(name, codec);
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 初期化
+   * @else
+   * @brief Initialization
+   * @endif
+   */
+  void ByteDataCodecChain::init(const coil::Properties& prop)
+  {
+    const coil::Properties* node(prop.findNode("compression"));
+    if (node == nullptr) { return; }
+
+    std::string threshold(node->getProperty("threshold", "256"));
+    if (!coil::stringTo(m_threshold, threshold.c_str()))
+      {
+        RTC_WARN(("Invalid compression.threshold: %s", threshold.c_str()));
+        m_threshold = 256;
+      }
+    std::string max_size(node->getProperty("max_size", "67108864"));
+    if (!coil::stringTo(m_maxSize, max_size.c_str()))
+      {
+        RTC_WARN(("Invalid compression.max_size: %s", max_size.c_str()));
+        m_maxSize = 67108864;
+      }
+    for (auto & codec : m_codecs)
+      {
+        const coil::Properties* codec_prop(node->findNode(codec.first));
+        if (codec_prop != nullptr) { codec.second->init(*codec_prop); }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 全てのコーデックの符号化の状態をリセットする
+   * @else
+   * @brief Reset the encoding state of all codecs
+   * @endif
+   */
+  void ByteDataCodecChain::reset()
+  {
+    for (auto & codec : m_codecs)
+      {
+        codec.second->reset();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 全てのコーデックに次に復号するデータの到着情報を設定する
+   * @else
+   * @brief Set the arrival information of the data decoded next to all
+   *        codecs
+   * @endif
+   */
+  void ByteDataCodecChain::setArrival(unsigned long long sequence,
+                                      std::chrono::steady_clock::time_point time)
+  {
+    for (auto & codec : m_codecs)
+      {
+        codec.second->setArrival(sequence, time);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 全てのコーデックで符号化する
+   * @else
+   * @brief Encode data with all codecs
+   * @endif
+   */
+  bool ByteDataCodecChain::encode(const unsigned char* data, size_t length,
+                                  std::vector<unsigned char>& out)
+  {
+    auto begin(std::chrono::steady_clock::now());
+    const unsigned char* src(data);
+    size_t src_len(length);
+    bool encoded(false);
+    for (size_t i(0); i < m_codecs.size(); ++i)
+      {
+        std::vector<unsigned char>&
+          dst(i + 1 == m_codecs.size() ? out : m_work[i % 2]);
+        encoded = encodeStage(m_codecs[i].second, src, src_len, dst) || encoded;
+        src = dst.data();
+        src_len = dst.size();
+      }
+    auto end(std::chrono::steady_clock::now());
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (encoded) { ++m_stats.encoded; } else { ++m_stats.stored; }
+    m_stats.raw_bytes += length;
+    m_stats.encoded_bytes += out.size();
+    m_stats.encode_time += end - begin;
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 全てのコーデックで逆順に復号する
+   * @else
+   * @brief Decode data with all codecs in the reverse order
+   * @endif
+   */
+  bool ByteDataCodecChain::decode(const unsigned char* data, size_t length,
+                                  std::vector<unsigned char>& out)
+  {
+    auto begin(std::chrono::steady_clock::now());
+    const unsigned char* src(data);
+    size_t src_len(length);
+    for (size_t i(m_codecs.size()); i > 0; --i)
+      {
+        std::vector<unsigned char>& dst(i == 1 ? out : m_work[i % 2]);
+        if (!decodeStage(m_codecs[i - 1].second, src, src_len, dst))
+          {
+            RTC_WARN(("Decoding by %s failed.", m_codecs[i - 1].first.c_str()));
+            std::lock_guard<std::mutex> guard(m_mutex);
+            ++m_stats.errors;
+            return false;
+          }
+        src = dst.data();
+        src_len = dst.size();
+      }
+    auto end(std::chrono::steady_clock::now());
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    ++m_stats.decoded;
+    m_stats.decode_time += end - begin;
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計情報を取得する
+   * @else
+   * @brief Get the statistics
+   * @endif
+   */
+  ByteDataCodecChain::Statistics ByteDataCodecChain::getStatistics()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_stats;
+  }
+
+  /*!
+   * @if jp
+   * @brief 各コーデックの状態をプロパティに書き出す
+   * @else
+   * @brief Write the status of each codec to properties
+   * @endif
+   */
+  void ByteDataCodecChain::getStatus(coil::Properties& prop)
+  {
+    for (auto & codec : m_codecs)
+      {
+        coil::Properties status;
+        codec.second->getStatus(status);
+        if (status.size() > 0) { prop.getNode(codec.first) << status; }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief marshaling_type をシリアライザ名とコーデック名に分ける
+   * @else
+   * @brief Split a marshaling_type into a serializer name and codec names
+   * @endif
+   */
+  std::string
+  ByteDataCodecChain::splitMarshalingType(const std::string& marshalingtype,
+                                          coil::vstring& codecs)
+  {
+    coil::vstring types(coil::split(marshalingtype, "+", true));
+    if (types.empty()) { return marshalingtype; }
+    codecs.assign(types.begin() + 1, types.end());
+    return types[0];
+  }
+
+  //----------------------------------------------------------------------
+  // private functions
+
+  /*!
+   * @if jp
+   * @brief 一つのコーデックで符号化し、ヘッダを付ける
+   *
+   * 閾値未満の場合、長さが 32 bit を超える場合、符号化に失敗した場合、
+   * 小さくならなかった場合はそのまま格納する。stateful() なコーデック
+   * は閾値とサイズによらず適用する。
+   *
+   * @return 符号化した場合 true、そのまま格納した場合 false
+   *
+   * @else
+   * @brief Encode data with a codec and add the header
+   *
+   * The data is stored as it is if it is less than the threshold, the
+   * length exceeds 32 bits, the encoding failed or the data did not
+   * become smaller. Codecs whose stateful() is true are applied
+   * regardless of the threshold and the size.
+   *
+   * @return true if encoded, false if stored as it is
+   *
+   * @endif
+   */
+  bool ByteDataCodecChain::encodeStage(ByteDataCodec* codec,
+                                       const unsigned char* data,
+                                       size_t length,
+                                       std::vector<unsigned char>& out)
+  {
+    const size_t header_size(5);
+    out.resize(header_size);
+    bool stateful(codec->stateful());
+    bool encoded((stateful || length >= m_threshold) &&
+                 length <= 0xffffffffUL &&
+                 codec->encode(data, length, m_encoded) &&
+                 (stateful || m_encoded.size() < length));
+    out[0] = encoded ? 1 : 0;
+    for (size_t i(0); i < 4; ++i)
+      {
+        out[1 + i] = static_cast<unsigned char>((length >> (8 * i)) & 0xff);
+      }
+    if (encoded)
+      {
+        out.insert(out.end(), m_encoded.begin(), m_encoded.end());
+      }
+    else
+      {
+        out.insert(out.end(), data, data + length);
+      }
+    return encoded;
+  }
+
+  /*!
+   * @if jp
+   * @brief ヘッダを解釈し、一つのコーデックで復号する
+   * @else
+   * @brief Interpret the header and decode data with a codec
+   * @endif
+   */
+  bool ByteDataCodecChain::decodeStage(ByteDataCodec* codec,
+                                       const unsigned char* data,
+                                       size_t length,
+                                       std::vector<unsigned char>& out)
+  {
+    const size_t header_size(5);
+    if (length < header_size) { return false; }
+
+    size_t original(0);
+    for (size_t i(0); i < 4; ++i)
+      {
+        original |= static_cast<size_t>(data[1 + i]) << (8 * i);
+      }
+    if (original > m_maxSize)
+      {
+        RTC_WARN(("Decoded length %lu exceeds compression.max_size %lu.",
+                  static_cast<unsigned long>(original),
+                  static_cast<unsigned long>(m_maxSize)));
+        return false;
+      }
+    const unsigned char* body(data + header_size);
+    size_t body_len(length - header_size);
+    switch (data[0])
+      {
+      case 0:
+        if (body_len != original) { return false; }
+        out.assign(body, body + body_len);
+        return true;
+
+      case 1:
+        return codec->decode(body, body_len, original, out) &&
+          out.size() == original;
+
+      default:
+        return false;
+      }
+  }
+} // namespace RTC
@@ -0,0 +1,480 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ByteDataCodec.h
+ * @brief Byte data codec class for composite serializers
+ * @date $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_BYTEDATACODEC_H
+#define RTC_BYTEDATACODEC_H
+
+#include <coil/Properties.h>
+#include <coil/Factory.h>
+#include <coil/stringutil.h>
+#include <rtm/SystemLogger.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class ByteDataCodec
+   * @brief シリアライズ後のバイト列を変換するコーデックの基底クラス
+   *
+   * 圧縮などのバイト列の変換を実装する。コーデックは
+   * ByteDataCodecFactory に名前を付けて登録し、"cdr+lz4" のように
+   * marshaling_type の後ろに "+" で連結して使用する。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class ByteDataCodec
+   * @brief Base class of codecs which convert serialized byte data
+   *
+   * A codec implements a conversion of byte data such as compression.
+   * Codecs are registered to ByteDataCodecFactory by name and are used
+   * by appending them to the marshaling_type with "+", such as
+   * "cdr+lz4".
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class ByteDataCodec
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief 仮想デストラクタ
+     * @else
+     * @brief Virtual destructor
+     * @endif
+     */
+    virtual ~ByteDataCodec();
+
+    /*!
+     * @if jp
+     * @brief 初期化
+     *
+     * @param prop コネクタプロパティの compression.<コーデック名> ノード
+     *
+     * @else
+     * @brief Initialization
+     *
+     * @param prop compression.<codec name> node of the connector
+     *             properties
+     *
+     * @endif
+     */
+    virtual void init(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 前のデータに依存する符号化を行うかどうか
+     *
+     * true の場合、ByteDataCodecChain は閾値やサイズに関わらず全ての
+     * データをこのコーデックで符号化する。デフォルトは false。
+     *
+     * @else
+     * @brief Whether the encoding depends on the previous data
+     *
+     * If true, ByteDataCodecChain encodes all data with this codec
+     * regardless of the threshold and the size. The default is false.
+     *
+     * @endif
+     */
+    virtual bool stateful() const;
+
+    /*!
+     * @if jp
+     * @brief 符号化の状態をリセットする
+     *
+     * 送信に失敗した場合などに呼ばれ、次のデータを前のデータに依存せ
+     * ずに符号化させる。デフォルト実装は何もしない。
+     *
+     * @else
+     * @brief Reset the encoding state
+     *
+     * This is called when sending failed and so on, and makes the next
+     * data be encoded independently of the previous data. The default
+     * implementation does nothing.
+     *
+     * @endif
+     */
+    virtual void reset();
+
+    /*!
+     * @if jp
+     * @brief コーデックの状態をプロパティに書き出す
+     *
+     * 統計情報などを ConnectorProfile で公開するために使用される。
+     * デフォルト実装は何もしない。
+     *
+     * @param prop 書き出し先のプロパティ
+     *
+     * @else
+     * @brief Write the status of the codec to properties
+     *
+     * This is used to publish statistics and so on in the
+     * ConnectorProfile. The default implementation does nothing.
+     *
+     * @param prop Properties to be written
+     *
+     * @endif
+     */
+    virtual void getStatus(coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 次に復号するデータの到着情報を設定する
+     *
+     * 受信側のコネクタがバッファから読み出したデータの到着番号と到着
+     * 時刻を、そのデータの decode() の前に通知する。到着情報を持たない
+     * コネクタでは呼ばれない。デフォルト実装は何もしない。
+     *
+     * @param sequence コネクタ毎の到着番号
+     * @param time プロバイダが受信した時刻
+     *
+     * @else
+     * @brief Set the arrival information of the data decoded next
+     *
+     * The receiving connector notifies the arrival number and the
+     * arrival time of the data read from the buffer before decode() of
+     * the data. This is not called by connectors without the arrival
+     * information. The default implementation does nothing.
+     *
+     * @param sequence Arrival number per connector
+     * @param time Time when the provider received the data
+     *
+     * @endif
+     */
+    virtual void setArrival(unsigned long long sequence,
+                            std::chrono::steady_clock::time_point time);
+
+    /*!
+     * @if jp
+     * @brief 符号化する
+     *
+     * @param data 符号化するデータ
+     * @param length データの長さ
+     * @param out 符号化したデータ
+     * @return 成功した場合 true
+     *
+     * @else
+     * @brief Encode data
+     *
+     * @param data Data to be encoded
+     * @param length Length of the data
+     * @param out Encoded data
+     * @return true if succeeded
+     *
+     * @endif
+     */
+    virtual bool encode(const unsigned char* data, size_t length,
+                        std::vector<unsigned char>& out) = 0;
+
+    /*!
+     * @if jp
+     * @brief 復号する
+     *
+     * @param data 復号するデータ
+     * @param length データの長さ
+     * @param original_length 符号化前のデータの長さ
+     * @param out 復号したデータ
+     * @return 成功した場合 true
+     *
+     * @else
+     * @brief Decode data
+     *
+     * @param data Data to be decoded
+     * @param length Length of the data
+     * @param original_length Length of the data before encoding
+     * @param out Decoded data
+     * @return true if succeeded
+     *
+     * @endif
+     */
+    virtual bool decode(const unsigned char* data, size_t length,
+                        size_t original_length,
+                        std::vector<unsigned char>& out) = 0;
+  };
+
+  using ByteDataCodecFactory = coil::GlobalFactory<ByteDataCodec>;
+
+  /*!
+   * @if jp
+   * @class ByteDataCodecChain
+   * @brief シリアライズ後のバイト列に順にコーデックを適用する
+   *
+   * 各段の出力には 5 バイトのヘッダ (符号化されたかどうか、変換前の長
+   * さ) が付く。変換前の長さが compression.threshold バイト未満の場合
+   * や、符号化しても小さくならない場合はそのまま格納する。ただし
+   * stateful() なコーデックは常に適用する。復号時、ヘッダの長さが
+   * compression.max_size を超えるデータは領域を確保せずに破棄する。符
+   * 号化・復号したサイズと時間の統計を取る。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class ByteDataCodecChain
+   * @brief Apply codecs to serialized byte data in order
+   *
+   * The output of each stage has a 5 bytes header (whether the data is
+   * encoded and the length before the conversion). If the length is
+   * less than compression.threshold bytes or the encoded data is not
+   * smaller, the data is stored as it is, except for stateful() codecs
+   * which are always applied. On decoding, data whose length in the
+   * header exceeds compression.max_size is discarded without
+   * allocating the buffer. Statistics of the size and time of encoding
+   * and decoding are recorded.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class ByteDataCodecChain
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief 統計情報
+     * @else
+     * @brief Statistics
+     * @endif
+     */
+    struct Statistics
+    {
+      unsigned long long encoded{0};
+      unsigned long long stored{0};
+      unsigned long long decoded{0};
+      unsigned long long errors{0};
+      unsigned long long raw_bytes{0};
+      unsigned long long encoded_bytes{0};
+      std::chrono::nanoseconds encode_time{0};
+      std::chrono::nanoseconds decode_time{0};
+
+      /*!
+       * @if jp
+       * @brief 圧縮率 (符号化後のサイズ / 符号化前のサイズ)
+       * @else
+       * @brief Compression ratio (encoded size / raw size)
+       * @endif
+       */
+      double ratio() const
+      {
+        return raw_bytes == 0 ? 1.0 :
+          static_cast<double>(encoded_bytes) / static_cast<double>(raw_bytes);
+      }
+    };
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    ByteDataCodecChain();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~ByteDataCodecChain();
+
+    ByteDataCodecChain(const ByteDataCodecChain&) = delete;
+    ByteDataCodecChain& operator=(const ByteDataCodecChain&) = delete;
+
+    /*!
+     * @if jp
+     * @brief コーデックを生成する
+     *
+     * @param names 適用する順のコーデック名
+     * @return 全てのコーデックを生成できた場合 true
+     *
+     * @else
+     * @brief Create codecs
+     *
+     * @param names Codec names in the order of application
+     * @return true if all codecs were created
+     *
+     * @endif
+     */
+    bool setCodecs(const coil::vstring& names);
+
+    /*!
+     * @if jp
+     * @brief 初期化
+     *
+     * compression.threshold (デフォルト: 256) と compression.max_size
+     * (デフォルト: 67108864) を読み、各コーデックを
+     * compression.<コーデック名> ノードで初期化する。
+     *
+     * @param prop コネクタプロパティ
+     *
+     * @else
+     * @brief Initialization
+     *
+     * compression.threshold (default: 256) and compression.max_size
+     * (default: 67108864) are read, and each codec is initialized with
+     * the compression.<codec name> node.
+     *
+     * @param prop Connector properties
+     *
+     * @endif
+     */
+    void init(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 全てのコーデックの符号化の状態をリセットする
+     * @else
+     * @brief Reset the encoding state of all codecs
+     * @endif
+     */
+    void reset();
+
+    /*!
+     * @if jp
+     * @brief 全てのコーデックで符号化する
+     * @param data データ
+     * @param length データの長さ
+     * @param out 符号化したデータ
+     * @return 成功した場合 true
+     * @else
+     * @brief Encode data with all codecs
+     * @param data Data
+     * @param length Length of the data
+     * @param out Encoded data
+     * @return true if succeeded
+     * @endif
+     */
+    bool encode(const unsigned char* data, size_t length,
+                std::vector<unsigned char>& out);
+
+    /*!
+     * @if jp
+     * @brief 全てのコーデックで逆順に復号する
+     * @param data データ
+     * @param length データの長さ
+     * @param out 復号したデータ
+     * @return 成功した場合 true
+     * @else
+     * @brief Decode data with all codecs in the reverse order
+     * @param data Data
+     * @param length Length of the data
+     * @param out Decoded data
+     * @return true if succeeded
+     * @endif
+     */
+    bool decode(const unsigned char* data, size_t length,
+                std::vector<unsigned char>& out);
+
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     * @else
+     * @brief Get the statistics
+     * @endif
+     */
+    Statistics getStatistics();
+
+    /*!
+     * @if jp
+     * @brief 全てのコーデックに次に復号するデータの到着情報を設定する
+     * @param sequence コネクタ毎の到着番号
+     * @param time プロバイダが受信した時刻
+     * @else
+     * @brief Set the arrival information of the data decoded next to
+     *        all codecs
+     * @param sequence Arrival number per connector
+     * @param time Time when the provider received the data
+     * @endif
+     */
+    void setArrival(unsigned long long sequence,
+                    std::chrono::steady_clock::time_point time);
+
+    /*!
+     * @if jp
+     * @brief 各コーデックの状態をプロパティに書き出す
+     *
+     * 各コーデックの状態はコーデック名のノードに書き出される。
+     *
+     * @param prop 書き出し先のプロパティ
+     *
+     * @else
+     * @brief Write the status of each codec to properties
+     *
+     * The status of each codec is written to the node of the codec
+     * name.
+     *
+     * @param prop Properties to be written
+     *
+     * @endif
+     */
+    void getStatus(coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief marshaling_type をシリアライザ名とコーデック名に分ける
+     *
+     * "cdr+lz4" は "cdr" と {"lz4"} に分けられる。
+     *
+     * @param marshalingtype marshaling_type
+     * @param codecs コーデック名のリスト
+     * @return シリアライザ名
+     *
+     * @else
+     * @brief Split a marshaling_type into a serializer name and codec
+     *        names
+     *
+     * "cdr+lz4" is split into "cdr" and {"lz4"}.
+     *
+     * @param marshalingtype marshaling_type
+     * @param codecs List of codec names
+     * @return Serializer name
+     *
+     * @endif
+     */
+    static std::string splitMarshalingType(const std::string& marshalingtype,
+                                           coil::vstring& codecs);
+
+  private:
+    bool encodeStage(ByteDataCodec* codec, const unsigned char* data,
+                     size_t length, std::vector<unsigned char>& out);
+    bool decodeStage(ByteDataCodec* codec, const unsigned char* data,
+                     size_t length, std::vector<unsigned char>& out);
+
+    Logger rtclog;
+    std::vector<std::pair<std::string, ByteDataCodec*>> m_codecs;
+    size_t m_threshold;
+    size_t m_maxSize;
+    std::vector<unsigned char> m_work[2];
+    std::vector<unsigned char> m_encoded;
+    Statistics m_stats;
+    std::mutex m_mutex;
+  };
+} // namespace RTC
+
+EXTERN template class DLL_PLUGIN coil::GlobalFactory<::RTC::ByteDataCodec>;
+
+#endif  // RTC_BYTEDATACODEC_H
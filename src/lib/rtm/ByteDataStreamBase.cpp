@@ -73,6 +73,27 @@ namespace RTC
 
     }
 
+    /*!
+     * @if jp
+     * @brief 外部のバッファをコピーせずに参照する
+     *
+     * @param buffer 参照するバッファ
+     * @param length データのサイズ
+     *
+     * @else
+     * @brief Refer to an external buffer without copying
+     *
+     * @param buffer Buffer to refer to
+     * @param length Data length
+     *
+     * @endif
+     */
+    void ByteDataStreamBase::referData(const unsigned char* buffer,
+                                       unsigned long length)
+    {
+      writeData(buffer, length);
+    }
+
 
     /*!
      * @if jp
@@ -92,5 +113,23 @@ namespace RTC
 
     }
 
+    /*!
+     * @if jp
+     * @brief 共有可能なバッファを取得
+     *
+     * @return 空
+     *
+     * @else
+     * @brief Get a shareable buffer
+     *
+     * @return Empty
+     *
+     * @endif
+     */
+    std::shared_ptr<unsigned char> ByteDataStreamBase::getSharedBuffer() const
+    {
+        return nullptr;
+    }
+
 
 } // namespace RTC
@@ -23,6 +23,10 @@
 #include <coil/Properties.h>
 #include <coil/Factory.h>
 #include <rtm/Typename.h>
+#include <rtm/ByteDataCodec.h>
+
+#include <cstring>
+#include <memory>
 
 /*!
  * @if jp
@@ -126,6 +130,32 @@ namespace RTC
       * @endif
       */
      virtual void writeData(const unsigned char *buffer, unsigned long length) = 0;
+     /*!
+      * @if jp
+      * @brief 外部のバッファをコピーせずに参照する
+      *
+      * writeData() と同様にデータを設定するが、コピーせずにバッファを
+      * 参照してもよい。呼び出し側は、次に writeData()、referData()、
+      * serialize() を呼ぶまでバッファを解放・変更してはならない。デフォ
+      * ルト実装は writeData() を呼ぶ。
+      *
+      * @param buffer 参照するバッファ
+      * @param length データのサイズ
+      *
+      * @else
+      * @brief Refer to an external buffer without copying
+      *
+      * This sets the data as writeData() but may refer to the buffer
+      * without copying. The caller must not free or modify the buffer
+      * until writeData(), referData() or serialize() is called next.
+      * The default implementation calls writeData().
+      *
+      * @param buffer Buffer to refer to
+      * @param length Data length
+      *
+      * @endif
+      */
+     virtual void referData(const unsigned char *buffer, unsigned long length);
    /*!
      * @if jp
      * @brief 引数のバッファにデータを書き込む
@@ -171,6 +201,34 @@ namespace RTC
       * @endif
       */
      virtual void isLittleEndian(bool little_endian);
+     /*!
+      * @if jp
+      * @brief 共有可能なバッファを取得
+      *
+      * シリアライズ結果を参照カウント付きのバッファに保持している場合
+      * は、それを返す。ByteData はこのバッファをコピーせずに参照し、ト
+      * ランスポートはそのまま送信に使用できる。バッファの先頭
+      * getDataLength() バイトが readData() で読み出されるデータと等し
+      * くなければならない。返したバッファは以後変更してはならない。デ
+      * フォルト実装は空を返す。
+      *
+      * @return 共有可能なバッファ。ない場合は空
+      *
+      * @else
+      * @brief Get a shareable buffer
+      *
+      * If the serialized data are held in a reference counted buffer,
+      * this returns it. ByteData refers to the buffer without copying
+      * and transports can send it as it is. The first getDataLength()
+      * bytes of the buffer must equal the data read by readData(). The
+      * returned buffer must not be modified afterwards. The default
+      * implementation returns empty.
+      *
+      * @return Shareable buffer, or empty if none
+      *
+      * @endif
+      */
+     virtual std::shared_ptr<unsigned char> getSharedBuffer() const;
   };
 
   /*!
@@ -268,6 +326,233 @@ namespace RTC
 
   using SerializerFactory = coil::GlobalFactory<ByteDataStreamBase>;
 
+  template <class DataType>
+  ::RTC::ByteDataStreamBase *createSerializer(const std::string &marshalingtype);
+
+  /*!
+   * @if jp
+   * @class CodecSerializerBase
+   * @brief CodecSerializer のデータ型に依存しないインターフェース
+   * @else
+   * @class CodecSerializerBase
+   * @brief Data type independent interface of CodecSerializer
+   * @endif
+   */
+  class CodecSerializerBase
+  {
+  public:
+     virtual ~CodecSerializerBase() = default;
+
+     /*!
+      * @if jp
+      * @brief 圧縮の統計情報を取得する
+      * @else
+      * @brief Get the compression statistics
+      * @endif
+      */
+     virtual ByteDataCodecChain::Statistics getStatistics() = 0;
+
+     /*!
+      * @if jp
+      * @brief コーデックの符号化の状態をリセットする
+      *
+      * 送信に失敗した場合に呼ばれる。
+      *
+      * @else
+      * @brief Reset the encoding state of the codecs
+      *
+      * This is called when sending failed.
+      *
+      * @endif
+      */
+     virtual void reset() = 0;
+
+     /*!
+      * @if jp
+      * @brief 各コーデックの状態をプロパティに書き出す
+      * @else
+      * @brief Write the status of each codec to properties
+      * @endif
+      */
+     virtual void getStatus(coil::Properties &prop) = 0;
+
+     /*!
+      * @if jp
+      * @brief 次にデシリアライズするデータの到着情報を設定する
+      *
+      * 受信側のコネクタがバッファから読み出したデータについて、
+      * deserialize() の前に呼ぶ。
+      *
+      * @param sequence コネクタ毎の到着番号
+      * @param time プロバイダが受信した時刻
+      *
+      * @else
+      * @brief Set the arrival information of the data deserialized next
+      *
+      * The receiving connector calls this for the data read from the
+      * buffer before deserialize().
+      *
+      * @param sequence Arrival number per connector
+      * @param time Time when the provider received the data
+      *
+      * @endif
+      */
+     virtual void setArrival(unsigned long long sequence,
+                             std::chrono::steady_clock::time_point time) = 0;
+  };
+
+  /*!
+   * @if jp
+   * @class CodecSerializer
+   * @brief シリアライザの出力をコーデックで変換するシリアライザ
+   *
+   * "cdr+lz4" のような marshaling_type に対して生成され、"cdr" のシリ
+   * アライザの出力を ByteDataCodecChain で圧縮し、受信側では復号して
+   * から "cdr" のシリアライザで復元する。
+   *
+   * SerializerFactory には登録されないため、deleteSerializer() で削除
+   * する。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class CodecSerializer
+   * @brief Serializer which converts the output of a serializer with
+   *        codecs
+   *
+   * This is created for a marshaling_type such as "cdr+lz4". The output
+   * of the "cdr" serializer is compressed with ByteDataCodecChain, and
+   * the receiving side decodes it before deserializing with the "cdr"
+   * serializer.
+   *
+   * It is not registered to SerializerFactory and should be deleted
+   * with deleteSerializer().
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  template <typename DataType>
+  class CodecSerializer : public ByteDataStream<DataType>,
+                          public CodecSerializerBase
+  {
+  public:
+     CodecSerializer() = default;
+
+     ~CodecSerializer() override
+     {
+        if (m_base != nullptr)
+        {
+           SerializerFactory::instance().deleteObject(m_base);
+        }
+     }
+
+     CodecSerializer(const CodecSerializer&) = delete;
+     CodecSerializer& operator=(const CodecSerializer&) = delete;
+
+     /*!
+      * @if jp
+      * @brief 元のシリアライザとコーデックを生成する
+      *
+      * @param marshalingtype "cdr+lz4" のような marshaling_type
+      * @return 成功した場合 true
+      *
+      * @else
+      * @brief Create the underlying serializer and codecs
+      *
+      * @param marshalingtype marshaling_type such as "cdr+lz4"
+      * @return true if succeeded
+      *
+      * @endif
+      */
+     bool setup(const std::string &marshalingtype)
+     {
+        coil::vstring codecs;
+        std::string base{ByteDataCodecChain::splitMarshalingType(marshalingtype,
+                                                                codecs)};
+        m_base = createSerializer<DataType>(base);
+        m_stream = dynamic_cast<ByteDataStream<DataType>*>(m_base);
+        return m_stream != nullptr && m_chain.setCodecs(codecs);
+     }
+
+     void init(const coil::Properties &prop) override
+     {
+        m_base->init(prop);
+        m_chain.init(prop);
+     }
+
+     void writeData(const unsigned char *buffer, unsigned long length) override
+     {
+        m_data.assign(buffer, buffer + length);
+     }
+
+     void readData(unsigned char *buffer, unsigned long length) const override
+     {
+        if (length > m_data.size()) { length = static_cast<unsigned long>(m_data.size()); }
+        if (length > 0) { std::memcpy(buffer, m_data.data(), length); }
+     }
+
+     unsigned long getDataLength() const override
+     {
+        return static_cast<unsigned long>(m_data.size());
+     }
+
+     void isLittleEndian(bool little_endian) override
+     {
+        m_base->isLittleEndian(little_endian);
+     }
+
+     bool serialize(const DataType &data) override
+     {
+        if (!m_stream->serialize(data)) { return false; }
+        m_raw.resize(m_base->getDataLength());
+        m_base->readData(m_raw.data(), static_cast<unsigned long>(m_raw.size()));
+        return m_chain.encode(m_raw.data(), m_raw.size(), m_data);
+     }
+
+     bool deserialize(DataType &data) override
+     {
+        if (!m_chain.decode(m_data.data(), m_data.size(), m_raw)) { return false; }
+        m_base->writeData(m_raw.data(), static_cast<unsigned long>(m_raw.size()));
+        return m_stream->deserialize(data);
+     }
+
+     /*!
+      * @if jp
+      * @brief 圧縮の統計情報を取得する
+      * @else
+      * @brief Get the compression statistics
+      * @endif
+      */
+     ByteDataCodecChain::Statistics getStatistics() override
+     {
+        return m_chain.getStatistics();
+     }
+
+     void reset() override
+     {
+        m_chain.reset();
+     }
+
+     void getStatus(coil::Properties &prop) override
+     {
+        m_chain.getStatus(prop);
+     }
+
+     void setArrival(unsigned long long sequence,
+                     std::chrono::steady_clock::time_point time) override
+     {
+        m_chain.setArrival(sequence, time);
+     }
+
+  private:
+     ::RTC::ByteDataStreamBase *m_base{nullptr};
+     ByteDataStream<DataType> *m_stream{nullptr};
+     ByteDataCodecChain m_chain;
+     std::vector<unsigned char> m_raw;
+     std::vector<unsigned char> m_data;
+  };
+
   /*!
    * @if jp
    *
@@ -348,14 +633,21 @@ namespace RTC
    * @if jp
    *
    * @brief GlobalFactoryからシリアライザを生成する
+   *
+   * "cdr+lz4" のように "+" でコーデックを連結した名称の場合は
+   * CodecSerializer を生成する。削除には deleteSerializer() を使用す
+   * る。
    * 
    * @param marshalingtype シリアライザの名称
    *
    * @else
    *
-   * @brief 
+   * @brief Create a serializer from GlobalFactory
    *
-   * @param marshalingtype 
+   * If codecs are appended to the name with "+" such as "cdr+lz4",
+   * CodecSerializer is created. Use deleteSerializer() to delete it.
+   *
+   * @param marshalingtype Serializer name
    *
    * @endif
    */
@@ -363,7 +655,44 @@ namespace RTC
   ::RTC::ByteDataStreamBase *createSerializer(const std::string &marshalingtype)
   {
      std::string mtype = addDataTypeToMarshalingType<DataType>(marshalingtype);
-     return SerializerFactory::instance().createObject(mtype);
+     if (marshalingtype.find('+') == std::string::npos)
+     {
+        return SerializerFactory::instance().createObject(mtype);
+     }
+
+     CodecSerializer<DataType> *serializer = new CodecSerializer<DataType>();
+     if (!serializer->setup(marshalingtype))
+     {
+        delete serializer;
+        return nullptr;
+     }
+     return serializer;
+  }
+
+  /*!
+   * @if jp
+   *
+   * @brief createSerializer() で生成したシリアライザを削除する
+   *
+   * @param serializer シリアライザ
+   *
+   * @else
+   *
+   * @brief Delete a serializer created by createSerializer()
+   *
+   * @param serializer Serializer
+   *
+   * @endif
+   */
+  inline void deleteSerializer(::RTC::ByteDataStreamBase *&serializer)
+  {
+     if (dynamic_cast<CodecSerializerBase*>(serializer) != nullptr)
+     {
+        delete serializer;
+        serializer = nullptr;
+        return;
+     }
+     SerializerFactory::instance().deleteObject(serializer);
   }
 
   /*!
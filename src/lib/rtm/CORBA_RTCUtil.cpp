@@ -20,6 +20,11 @@
 #include <rtm/CORBA_RTCUtil.h>
 #include <rtm/NamingManager.h>
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 namespace CORBA_RTCUtil
@@ -1150,6 +1155,277 @@ namespace CORBA_RTCUtil
       }
     return RTC::BAD_PARAMETER;
   }
+  /*!
+   * @if jp
+   * @brief スコープ内でこのスレッドのリモート呼び出しのタイムアウトを設
+   *        定する
+   * @else
+   * @brief Set the timeout of the remote calls of this thread within
+   *        the scope
+   * @endif
+   */
+  ScopedCallTimeout::ScopedCallTimeout(std::chrono::milliseconds timeout)
+    : m_set(false)
+  {
+#ifdef ORB_IS_OMNIORB
+    if (timeout > std::chrono::milliseconds::zero())
+      {
+        omniORB::setClientThreadCallTimeout(
+          static_cast<CORBA::ULong>(timeout.count()));
+        m_set = true;
+      }
+#else
+    (void)timeout;
+#endif  // ORB_IS_OMNIORB
+  }
+
+  ScopedCallTimeout::~ScopedCallTimeout()
+  {
+#ifdef ORB_IS_OMNIORB
+    // 0 falls back to the object or the global timeout
+    if (m_set) { omniORB::setClientThreadCallTimeout(0); }
+#endif  // ORB_IS_OMNIORB
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続の各段のタイムアウトを取得する
+   * @else
+   * @brief Get the timeout of each step of a connection
+   * @endif
+   */
+  std::chrono::milliseconds
+  get_connect_step_timeout(const SDOPackage::NVList& prop)
+  {
+    std::chrono::milliseconds timeout(0);
+    std::string value(NVUtil::toString(prop, "port.connect_step_timeout"));
+    if (value.empty() || !coil::stringTo(timeout, value.c_str()) ||
+        timeout < std::chrono::milliseconds::zero())
+      {
+        return std::chrono::milliseconds::zero();
+      }
+    return timeout;
+  }
+
+  //============================================================
+  // AsyncResult
+  //============================================================
+  struct AsyncResult::State
+  {
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool done{false};
+    bool abandoned{false};
+    RTC::ReturnCode_t ret{RTC::RTC_ERROR};
+
+    bool isAbandoned()
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      return abandoned;
+    }
+
+    // returns false if the caller has already given up
+    bool complete(RTC::ReturnCode_t retval)
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      if (abandoned) { return false; }
+      ret = retval;
+      done = true;
+      cond.notify_all();
+      return true;
+    }
+  };
+
+  AsyncResult::AsyncResult(std::shared_ptr<State> state)
+    : m_state(std::move(state))
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief 完了を待ち、結果を返す
+   * @else
+   * @brief Wait for the completion and return the result
+   * @endif
+   */
+  RTC::ReturnCode_t AsyncResult::get()
+  {
+    if (!m_state) { return RTC::RTC_ERROR; }
+    std::unique_lock<std::mutex> guard(m_state->mutex);
+    m_state->cond.wait(guard, [this]{ return m_state->done; });
+    return m_state->ret;
+  }
+
+  /*!
+   * @if jp
+   * @brief 期限まで完了を待ち、結果を返す
+   * @else
+   * @brief Wait for the completion until the deadline and return the
+   *        result
+   * @endif
+   */
+  RTC::ReturnCode_t
+  AsyncResult::get(std::chrono::steady_clock::time_point deadline)
+  {
+    if (!m_state) { return RTC::RTC_ERROR; }
+    std::unique_lock<std::mutex> guard(m_state->mutex);
+    if (!m_state->cond.wait_until(guard, deadline,
+                                  [this]{ return m_state->done; }))
+      {
+        m_state->abandoned = true;
+        m_state->done = true;
+        m_state->ret = RTC::RTC_ERROR;
+      }
+    return m_state->ret;
+  }
+
+  //============================================================
+  // worker threads of the asynchronous operations
+  //============================================================
+  struct AsyncPool
+  {
+    std::mutex mutex;
+    std::deque<std::function<void()> > tasks;
+    size_t threads{0};
+    size_t max{8};
+  };
+
+  static AsyncPool& asyncPool()
+  {
+    // never destroyed since workers may still run at exit
+    static AsyncPool* pool(new AsyncPool());
+    return *pool;
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカスレッドの処理
+   *
+   * キューが空になるとスレッドは終了する。
+   *
+   * @else
+   * @brief Body of a worker thread
+   *
+   * The thread exits when the queue becomes empty.
+   *
+   * @endif
+   */
+  static void runAsyncWorker()
+  {
+    AsyncPool& pool(asyncPool());
+    std::unique_lock<std::mutex> guard(pool.mutex);
+    while (!pool.tasks.empty())
+      {
+        std::function<void()> task(std::move(pool.tasks.front()));
+        pool.tasks.pop_front();
+        guard.unlock();
+        task();
+        guard.lock();
+      }
+    --pool.threads;
+  }
+
+  static void postAsync(std::function<void()> task)
+  {
+    AsyncPool& pool(asyncPool());
+    std::lock_guard<std::mutex> guard(pool.mutex);
+    pool.tasks.emplace_back(std::move(task));
+    if (pool.threads < pool.max)
+      {
+        std::thread(runAsyncWorker).detach();
+        ++pool.threads;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 非同期の接続・切断を実行するスレッドの最大数を設定する
+   * @else
+   * @brief Set the maximum number of the threads running asynchronous
+   *        connections and disconnections
+   * @endif
+   */
+  void set_max_async_threads(size_t threads)
+  {
+    AsyncPool& pool(asyncPool());
+    std::lock_guard<std::mutex> guard(pool.mutex);
+    pool.max = threads > 0 ? threads : 1;
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカスレッドで接続を開始する
+   *
+   * skip_connected が true の場合、既に接続されているポートは接続せず
+   * に RTC_OK とする。呼び出し側が放棄した後に成功した接続は切断する。
+   *
+   * @else
+   * @brief Start a connection on a worker thread
+   *
+   * If skip_connected is true, ports already connected are not
+   * connected and RTC_OK is returned. A connection which succeeds after
+   * the caller gave up is disconnected.
+   *
+   * @endif
+   */
+  static AsyncResult startConnect(const std::string& name,
+                                  const coil::Properties& prop,
+                                  const RTC::PortService_ptr port0,
+                                  const RTC::PortService_ptr port1,
+                                  bool skip_connected)
+  {
+    std::shared_ptr<AsyncResult::State>
+      state(std::make_shared<AsyncResult::State>());
+    RTC::PortService_var p0 = RTC::PortService::_duplicate(port0);
+    RTC::PortService_var p1 = RTC::PortService::_duplicate(port1);
+    postAsync([state, name, prop, p0, p1, skip_connected]() {
+        if (state->isAbandoned()) { return; }
+        RTC::ReturnCode_t ret(RTC::RTC_ERROR);
+        std::string id;
+        try
+          {
+            if (CORBA::is_nil(p0.in()) ||
+                (!CORBA::is_nil(p1.in()) && p0->_is_equivalent(p1.in())))
+              {
+                ret = RTC::BAD_PARAMETER;
+              }
+            else
+              {
+                RTC::ConnectorProfile_var
+                  cprof(create_connector(name, prop, p0.in(), p1.in()));
+                ScopedCallTimeout timeout(
+                  get_connect_step_timeout(cprof->properties));
+                if (skip_connected && already_connected(p0.in(), p1.in()))
+                  {
+                    ret = RTC::RTC_OK;
+                  }
+                else
+                  {
+                    ret = p0->connect(cprof.inout());
+                    id = static_cast<const char*>(cprof->connector_id);
+                  }
+              }
+          }
+        catch (...)
+          {
+            ret = RTC::RTC_ERROR;
+          }
+        if (state->complete(ret) || ret != RTC::RTC_OK || id.empty())
+          {
+            return;
+          }
+        // the caller has given up: do not leave the connection behind
+        try
+          {
+            disconnect_connector_id(p0.in(), id);
+          }
+        catch (...)
+          {
+          }
+      });
+    return AsyncResult(state);
+  }
+
   /*!
    * @if jp
    * @brief 指定したポートと指定したリスト内のポート全てと接続する
@@ -1173,20 +1449,89 @@ namespace CORBA_RTCUtil
                                   const RTC::PortService_ptr port,
                                   RTC::PortServiceList& target_ports)
   {
-    RTC::ReturnCode_t ret(RTC::RTC_OK);
+    std::vector<AsyncResult> results;
     for (CORBA::ULong i(0); i < target_ports.length(); ++i)
       {
         if (target_ports[i]->_is_equivalent(port)) { continue; }
-        if (CORBA_RTCUtil::already_connected(port, target_ports[i]))
-          { continue; }
-        if (RTC::RTC_OK !=
-            CORBA_RTCUtil::connect(name, prop, port, target_ports[i]))
+        results.emplace_back(startConnect(name, prop, port, target_ports[i],
+                                          true));
+      }
+
+    RTC::ReturnCode_t ret(RTC::RTC_OK);
+    for (auto & result : results)
+      {
+        if (RTC::RTC_OK != result.get())
           {
             ret = RTC::RTC_ERROR;
           }
       }
     return ret;
   }
+
+  /*!
+   * @if jp
+   * @brief 指定したポートを非同期に接続する
+   * @else
+   * @brief Connect the specified ports asynchronously
+   * @endif
+   */
+  AsyncResult connect_async(const std::string& name,
+                            const coil::Properties& prop,
+                            const RTC::PortService_ptr port0,
+                            const RTC::PortService_ptr port1)
+  {
+    return startConnect(name, prop, port0, port1, false);
+  }
+
+  /*!
+   * @if jp
+   * @brief 指定したコネクタを非同期に切断する
+   * @else
+   * @brief Disconnect the specified connector asynchronously
+   * @endif
+   */
+  AsyncResult disconnect_async(const RTC::PortService_ptr port_ref,
+                               const std::string& conn_id)
+  {
+    std::shared_ptr<AsyncResult::State>
+      state(std::make_shared<AsyncResult::State>());
+    RTC::PortService_var port = RTC::PortService::_duplicate(port_ref);
+    postAsync([state, port, conn_id]() {
+        RTC::ReturnCode_t ret(RTC::RTC_ERROR);
+        try
+          {
+            ret = disconnect_connector_id(port.in(), conn_id);
+          }
+        catch (...)
+          {
+            ret = RTC::RTC_ERROR;
+          }
+        state->complete(ret);
+      });
+    return AsyncResult(state);
+  }
+
+  /*!
+   * @if jp
+   * @brief 非同期の接続・切断の完了を待つ
+   * @else
+   * @brief Wait for asynchronous connections and disconnections
+   * @endif
+   */
+  std::vector<RTC::ReturnCode_t>
+  wait_for_all(std::vector<AsyncResult>& results,
+               std::chrono::milliseconds timeout)
+  {
+    std::chrono::steady_clock::time_point
+      deadline(std::chrono::steady_clock::now() + timeout);
+    std::vector<RTC::ReturnCode_t> rets;
+    rets.reserve(results.size());
+    for (auto & result : results)
+      {
+        rets.emplace_back(result.get(deadline));
+      }
+    return rets;
+  }
   /*!
    * @if jp
    * @brief 対象のポートの名前と指定したポート名が一致するか判定
@@ -23,7 +23,10 @@
 #include <rtm/CORBA_SeqUtil.h>
 #include <rtm/RTObject.h>
 
+#include <chrono>
+#include <memory>
 #include <utility>
+#include <vector>
 
 
 namespace CORBA_RTCUtil
@@ -819,6 +822,236 @@ namespace CORBA_RTCUtil
     const coil::Properties& prop,
     const RTC::PortService_ptr port,
     RTC::PortServiceList& target_ports);
+
+  /*!
+   * @if jp
+   * @class ScopedCallTimeout
+   * @brief スコープ内でこのスレッドのリモート呼び出しのタイムアウトを設
+   *        定する
+   *
+   * omniORB 以外では何もしない。timeout が 0 の場合も何もしない。
+   *
+   * @else
+   * @class ScopedCallTimeout
+   * @brief Set the timeout of the remote calls of this thread within
+   *        the scope
+   *
+   * This does nothing except with omniORB, or if timeout is 0.
+   *
+   * @endif
+   */
+  class ScopedCallTimeout
+  {
+  public:
+    explicit ScopedCallTimeout(std::chrono::milliseconds timeout);
+    ~ScopedCallTimeout();
+    ScopedCallTimeout(const ScopedCallTimeout&) = delete;
+    ScopedCallTimeout& operator=(const ScopedCallTimeout&) = delete;
+  private:
+    bool m_set;
+  };
+
+  /*!
+   * @if jp
+   * @brief 接続の各段のタイムアウトを取得する
+   *
+   * @param prop コネクタのプロパティ
+   * @return port.connect_step_timeout、指定がない場合は 0
+   *
+   * @else
+   * @brief Get the timeout of each step of a connection
+   *
+   * @param prop Connector properties
+   * @return port.connect_step_timeout, or 0 if not given
+   *
+   * @endif
+   */
+  std::chrono::milliseconds
+  get_connect_step_timeout(const SDOPackage::NVList& prop);
+
+  /*!
+   * @if jp
+   * @class AsyncResult
+   * @brief 非同期の接続・切断の結果
+   *
+   * connect_async() と disconnect_async() が返す。期限を指定した get()
+   * が期限までに完了しなかった処理を放棄すると、その結果は RTC_ERROR
+   * となり、後から成功した接続は切断される。
+   *
+   * @else
+   * @class AsyncResult
+   * @brief Result of an asynchronous connection or disconnection
+   *
+   * This is returned by connect_async() and disconnect_async(). When
+   * get() with a deadline gives up an operation not completed by the
+   * deadline, its result is RTC_ERROR, and a connection which succeeds
+   * later is disconnected.
+   *
+   * @endif
+   */
+  class AsyncResult
+  {
+  public:
+    struct State;
+
+    AsyncResult() = default;
+    explicit AsyncResult(std::shared_ptr<State> state);
+
+    /*!
+     * @if jp
+     * @brief 処理に対応付けられているかどうか
+     * @else
+     * @brief Whether this is associated with an operation
+     * @endif
+     */
+    bool valid() const { return m_state != nullptr; }
+
+    /*!
+     * @if jp
+     * @brief 完了を待ち、結果を返す
+     * @return 処理の戻り値
+     * @else
+     * @brief Wait for the completion and return the result
+     * @return The return value of the operation
+     * @endif
+     */
+    RTC::ReturnCode_t get();
+
+    /*!
+     * @if jp
+     * @brief 期限まで完了を待ち、結果を返す
+     *
+     * 期限までに完了しなかった場合は処理を放棄して RTC_ERROR を返す。
+     * 放棄した接続が後から成功した場合、そのコネクタは切断される。
+     *
+     * @param deadline 期限
+     * @return 処理の戻り値、または RTC_ERROR
+     *
+     * @else
+     * @brief Wait for the completion until the deadline and return the
+     *        result
+     *
+     * If not completed by the deadline, the operation is given up and
+     * RTC_ERROR is returned. If a given up connection succeeds later,
+     * the connector is disconnected.
+     *
+     * @param deadline Deadline
+     * @return The return value of the operation, or RTC_ERROR
+     *
+     * @endif
+     */
+    RTC::ReturnCode_t get(std::chrono::steady_clock::time_point deadline);
+
+  private:
+    std::shared_ptr<State> m_state;
+  };
+
+  /*!
+   * @if jp
+   * @brief 非同期の接続・切断を実行するスレッドの最大数を設定する
+   *
+   * 超えた分の処理は順に待たされる。デフォルトは 8。
+   *
+   * @param threads スレッドの最大数
+   * @else
+   * @brief Set the maximum number of the threads running asynchronous
+   *        connections and disconnections
+   *
+   * The operations exceeding it wait in order. The default is 8.
+   *
+   * @param threads The maximum number of the threads
+   * @endif
+   */
+  void set_max_async_threads(size_t threads);
+
+  /*!
+   * @if jp
+   * @brief 指定したポートを非同期に接続する
+   *
+   * connect() をワーカスレッドで実行し、その結果を AsyncResult で返す。
+   * 複数の接続を同時に実行することができる。prop の
+   * port.connect_step_timeout [s] を指定すると、接続を構成するリモー
+   * ト呼び出し (このスレッドからの呼び出しと、各ポートから次のポート
+   * への notify_connect()) のそれぞれがその時間で打ち切られる。ただし
+   * 呼び出しのタイムアウトを設定できるのは omniORB の場合のみである。
+   *
+   * @param name コネクタ名
+   * @param prop 設定
+   * @param port0 対象のポート1
+   * @param port1 対象のポート2
+   * @return connect() の結果
+   * @else
+   * @brief Connect the specified ports asynchronously
+   *
+   * connect() is executed on a worker thread and its result is returned
+   * as an AsyncResult. Many connections can be in flight at the same
+   * time. If port.connect_step_timeout [s] is given in prop, each remote
+   * call constituting the connection (the calls from the worker and
+   * notify_connect() from each port to the next one) is aborted after
+   * that time. The call timeout can only be set with omniORB.
+   *
+   * @param name Connector name
+   * @param prop Connector properties
+   * @param port0 The first port
+   * @param port1 The second port
+   * @return The result of connect()
+   * @endif
+   */
+  AsyncResult connect_async(const std::string& name,
+                            const coil::Properties& prop,
+                            const RTC::PortService_ptr port0,
+                            const RTC::PortService_ptr port1);
+
+  /*!
+   * @if jp
+   * @brief 指定したコネクタを非同期に切断する
+   *
+   * disconnect_connector_id() をワーカスレッドで実行し、その結果を
+   * AsyncResult で返す。放棄した切断も中断はされない。
+   *
+   * @param port_ref 対象のポート
+   * @param conn_id コネクタのID
+   * @return disconnect_connector_id() の結果
+   * @else
+   * @brief Disconnect the specified connector asynchronously
+   *
+   * disconnect_connector_id() is executed on a worker thread and its
+   * result is returned as an AsyncResult. A given up disconnection is
+   * not aborted.
+   *
+   * @param port_ref The port
+   * @param conn_id The connector ID
+   * @return The result of disconnect_connector_id()
+   * @endif
+   */
+  AsyncResult disconnect_async(const RTC::PortService_ptr port_ref,
+                               const std::string& conn_id);
+
+  /*!
+   * @if jp
+   * @brief 非同期の接続・切断の完了を待つ
+   *
+   * すべての結果の完了を待ち、それぞれの戻り値を返す。timeout を過ぎ
+   * ても完了しなかったものは放棄され、RTC_ERROR となる。
+   *
+   * @param results connect_async() などが返した結果のリスト
+   * @param timeout 全体のタイムアウト
+   * @return それぞれの戻り値のリスト
+   * @else
+   * @brief Wait for asynchronous connections and disconnections
+   *
+   * This function waits for all the results and returns their return
+   * values. The ones which are not completed by the timeout are given
+   * up and RTC_ERROR.
+   *
+   * @param results The results returned by connect_async() etc.
+   * @param timeout The timeout for all of them
+   * @return The list of the return values
+   * @endif
+   */
+  std::vector<RTC::ReturnCode_t>
+  wait_for_all(std::vector<AsyncResult>& results,
+               std::chrono::milliseconds timeout);
   /*!
    * @if jp
    * @brief ポートを名前から検索
@@ -88,14 +88,20 @@ namespace RTC
    */
   bool ConfigAdmin::unbindParameter(const char* param_name)
   {
-    std::vector<ConfigBase*>::iterator it;
-    it = std::find_if(m_params.begin(), m_params.end(),
-                      find_conf(param_name));
-    if (it == m_params.end())
+    auto index = m_paramIndex.find(param_name);
+    if (index == m_paramIndex.end())
       {
         return false;
       }
-    m_params.erase(it);
+    m_params.erase(m_params.begin() + index->second);
+    m_paramIndex.clear();
+    for (size_t i(0); i < m_params.size(); ++i)
+      {
+        m_paramIndex[m_params[i]->name] = i;
+      }
+    // the indexes in the dirty set are no longer valid
+    m_appliedId.clear();
+    m_dirtyParams.clear();
 
     // configsets
     const std::vector<coil::Properties*>& leaf(m_configsets.getLeaf());
@@ -128,7 +134,27 @@ namespace RTC
     m_changedParam.clear();
     if (m_changed && m_active)
       {
-        update(m_activeId.c_str());
+        if (m_activeId == m_appliedId)
+          {
+            // only the parameters changed since the last update
+            coil::Properties& prop(m_configsets.getNode(m_activeId));
+            std::set<size_t> dirty;
+            dirty.swap(m_dirtyParams);
+            for (auto const& index : dirty)
+              {
+                ConfigBase* param(m_params[index]);
+                coil::Properties* node(prop.findNode(param->name));
+                if (node != nullptr)
+                  {
+                    param->update(node->getValue());
+                  }
+              }
+            onUpdate(m_activeId.c_str());
+          }
+        else
+          {
+            update(m_activeId.c_str());
+          }
         m_changed = false;
       }
     return;
@@ -151,12 +177,15 @@ namespace RTC
 
     for (auto & param : m_params)
       {
-        if (prop.hasKey(param->name) != nullptr)
+        coil::Properties* node(prop.findNode(param->name));
+        if (node != nullptr)
           {
             // m_changedParam is updated here
-            param->update(prop[param->name].c_str());
+            param->update(node->getValue());
           }
       }
+    m_appliedId = config_set;
+    m_dirtyParams.clear();
     onUpdate(config_set);
   }
 
@@ -176,12 +205,10 @@ namespace RTC
     std::string key(config_set);
     key += "."; key += config_param;
 
-    std::vector<ConfigBase*>::iterator it;
-    it = std::find_if(m_params.begin(), m_params.end(),
-                      find_conf(config_param));
-    if (it != m_params.end())
+    auto index = m_paramIndex.find(config_param);
+    if (index != m_paramIndex.end())
       {
-        (*it)->update(m_configsets[key].c_str());
+        m_params[index->second]->update(m_configsets[key].c_str());
         return;
       }
   }
@@ -196,10 +223,7 @@ namespace RTC
    */
   bool ConfigAdmin::isExist(const char* param_name)
   {
-    std::vector<ConfigBase*>::iterator it;
-    it = std::find_if(m_params.begin(), m_params.end(),
-                      find_conf(param_name));
-    return it != m_params.end();
+    return m_paramIndex.count(param_name) != 0;
   }
 
 
@@ -245,6 +269,23 @@ namespace RTC
 
     coil::Properties& p(m_configsets.getNode(node));
 
+    if (node == m_appliedId)
+      {
+        // remember the parameters whose values are changed. Parameter
+        // names may be paths such as "gain.x", so they are looked up
+        // by path rather than by the direct children of the set.
+        for (size_t i(0); i < m_params.size(); ++i)
+          {
+            coil::Properties* value(config_set.findNode(m_params[i]->name));
+            if (value == nullptr) { continue; }
+            coil::Properties* current(p.findNode(m_params[i]->name));
+            if (current == nullptr ||
+                std::strcmp(current->getValue(), value->getValue()) != 0)
+              {
+                m_dirtyParams.insert(i);
+              }
+          }
+      }
     p << config_set;
     m_changed = true;
     m_active = false;
@@ -309,6 +350,11 @@ namespace RTC
     coil::Properties* p(m_configsets.removeNode(config_id));
     delete p; 
     m_newConfig.erase(it);
+    if (m_appliedId == config_id)
+      {
+        m_appliedId.clear();
+        m_dirtyParams.clear();
+      }
 
     m_changed = true;
     m_active = false;
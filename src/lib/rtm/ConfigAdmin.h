@@ -23,7 +23,9 @@
 #include <coil/stringutil.h>
 #include <rtm/ConfigurationListener.h>
 
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <iostream>
 
@@ -699,6 +701,7 @@ namespace RTC
       if (isExist(param_name)) { return false; }
       if (!trans(var, def_val)) { return false; }
       Config<VarType>* c = new Config<VarType>(param_name, var, def_val, trans);
+      m_paramIndex[param_name] = m_params.size();
       m_params.emplace_back(c);
       c->setCallback(this, &RTC::ConfigAdmin::onUpdateParam);
       update(getActiveId(), param_name);
@@ -745,6 +748,12 @@ namespace RTC
      * 回の更新からコンフィギュレーションセットの内容が更新されている場
      * 合のみ実行される。
      *
+     * アクティブなコンフィギュレーションセットが前回 update(config_set)
+     * で適用したものと同じ場合は、setConfigurationSetValues() によって
+     * 値が変更されたパラメータのみを更新する。コンフィギュレーションセッ
+     * トのプロパティを直接書き換えた場合は update(config_set) で適用す
+     * る必要がある。
+     *
      * @else
      *
      * @brief Update the values of configuration parameters
@@ -756,6 +765,12 @@ namespace RTC
      * active configuration set exists and the content of the
      * configuration set has been updated from the last update.
      *
+     * If the active configuration set is the one applied by the last
+     * update(config_set), only the parameters whose values have been
+     * changed by setConfigurationSetValues() are updated. Values
+     * written to the configuration set properties directly have to
+     * be applied by update(config_set).
+     *
      * @endif
      */
     void update();
@@ -1540,20 +1555,12 @@ namespace RTC
     ConfigAdmin(const ConfigAdmin& ca) = delete;
     ConfigAdmin& operator=(const ConfigAdmin& ca) = delete;
 
-    struct find_conf
-    {
-      std::string m_name;
-      explicit find_conf(const char* name) : m_name(name) {}
-      bool operator()(ConfigBase* conf)
-      {
-        if (conf == nullptr) { return false; }
-        return (m_name == conf->name);
-      }
-    };
-
     coil::Properties& m_configsets;
     coil::Properties  m_emptyconf;
     std::vector<ConfigBase*> m_params;
+    std::unordered_map<std::string, size_t> m_paramIndex;
+    std::string m_appliedId;
+    std::set<size_t> m_dirtyParams;
     std::string m_activeId;
     bool m_active;
     bool m_changed;
@@ -43,6 +43,10 @@ namespace RTC
    */
   ConnectorDataListener::~ConnectorDataListener() = default;
 
+  void ConnectorDataListener::releaseConnector(const std::string& /*connector_id*/)
+  {
+  }
+
   /*!
    * @if jp
    * @class ConnectorListener クラス
@@ -59,10 +63,7 @@ namespace RTC
    * @class ConnectorDataListener holder class
    * @endif
    */
-  ConnectorDataListenerHolder::ConnectorDataListenerHolder()
-  {
-      SerializerFactory::instance().deleteObject(m_cdr);
-  }
+  ConnectorDataListenerHolder::ConnectorDataListenerHolder() = default;
 
 
   ConnectorDataListenerHolder::~ConnectorDataListenerHolder()
@@ -127,20 +128,34 @@ namespace RTC
 
   ConnectorListenerHolder::ReturnCode ConnectorDataListenerHolder::notifyIn(ConnectorInfo& info, ByteData& data)
   {
-      std::string type = info.properties.getProperty("marshaling_type", "cdr");
+      static const coil::PropertyPath type_key("marshaling_type");
+      static const coil::PropertyPath inport_type_key("inport.marshaling_type");
+      std::string type = info.properties.getProperty(type_key, "cdr");
       std::string marshaling_type{ coil::eraseBothEndsBlank(
-        info.properties.getProperty("inport.marshaling_type", type)) };
+        info.properties.getProperty(inport_type_key, type)) };
       return notify(info, data, marshaling_type);
   }
 
   ConnectorListenerHolder::ReturnCode ConnectorDataListenerHolder::notifyOut(ConnectorInfo& info, ByteData& data)
   {
-      std::string type = info.properties.getProperty("marshaling_type", "cdr");
+      static const coil::PropertyPath type_key("marshaling_type");
+      static const coil::PropertyPath outport_type_key("outport.marshaling_type");
+      std::string type = info.properties.getProperty(type_key, "cdr");
       std::string marshaling_type{ coil::eraseBothEndsBlank(
-        info.properties.getProperty("outport.marshaling_type", type)) };
+        info.properties.getProperty(outport_type_key, type)) };
       return notify(info, data, marshaling_type);
   }
 
+  void ConnectorDataListenerHolder::releaseConnector(const std::string& connector_id)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto & listener : m_listeners)
+      {
+        listener.first->releaseConnector(connector_id);
+      }
+    m_serializers.release(connector_id);
+  }
+
   /*!
    * @if jp
    * @class ConnectorListener ホルダクラス
@@ -324,11 +339,21 @@ namespace RTC
    */
   ::RTC::ConnectorListenerStatus::Enum ConnectorListeners::notify(ConnectorListenerType type, ConnectorInfo& info)
   {
-      if (static_cast<uint8_t>(type) < connector_.size())
+      if (static_cast<uint8_t>(type) >= connector_.size())
       {
-          return connector_[static_cast<uint8_t>(type)].notify(info);
+          return ConnectorListenerStatus::NO_CHANGE;
       }
-      return ConnectorListenerStatus::NO_CHANGE;
+      ::RTC::ConnectorListenerStatus::Enum ret(
+        connector_[static_cast<uint8_t>(type)].notify(info));
+      if (type == ConnectorListenerType::ON_DISCONNECT)
+      {
+          // the serializers of stateful codecs are kept per connector
+          for (auto & holder : connectorData_)
+          {
+              holder.releaseConnector(info.id);
+          }
+      }
+      return ret;
   }
 
   /*!
@@ -28,6 +28,7 @@
 #include <vector>
 #include <utility>
 #include <array>
+#include <map>
 
 
 namespace RTC
@@ -481,6 +482,138 @@ namespace RTC
      */
     virtual ReturnCode operator()(ConnectorInfo& info,
                             ByteData& data, const std::string& marshalingtype) = 0;
+
+    /*!
+     * @if jp
+     *
+     * @brief コネクタの状態を解放する
+     *
+     * コネクタの切断時に呼ばれ、そのコネクタのために保持していた
+     * デシリアライザ等を解放する。デフォルトでは何もしない。
+     *
+     * @param connector_id 切断されたコネクタのID
+     *
+     * @else
+     *
+     * @brief Release the state of a connector
+     *
+     * This is called when the connector is disconnected, and releases
+     * the deserializer etc. kept for the connector. It does nothing by
+     * default.
+     *
+     * @param connector_id ID of the disconnected connector
+     *
+     * @endif
+     */
+    virtual void releaseConnector(const std::string& connector_id);
+  };
+
+  /*!
+   * @if jp
+   * @class ConnectorSerializerMap
+   * @brief コネクタ毎のシリアライザ
+   *
+   * "delta" のような状態を持つコーデックは、前のデータを元に復号する。
+   * 複数のコネクタのデータを一つのシリアライザで復号すると状態が混ざ
+   * るため、リスナはコネクタIDごとにシリアライザを保持する。
+   *
+   * @else
+   * @class ConnectorSerializerMap
+   * @brief Serializers per connector
+   *
+   * Stateful codecs such as "delta" decode data based on the previous
+   * one. Since a serializer shared by several connectors would mix up
+   * their states, listeners keep a serializer per connector ID.
+   *
+   * @endif
+   */
+  class ConnectorSerializerMap
+  {
+  public:
+    ConnectorSerializerMap() = default;
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~ConnectorSerializerMap()
+    {
+      for (auto & serializer : m_serializers)
+        {
+          deleteSerializer(serializer.second.second);
+        }
+    }
+    ConnectorSerializerMap(const ConnectorSerializerMap&) = delete;
+    ConnectorSerializerMap& operator=(const ConnectorSerializerMap&) = delete;
+
+    /*!
+     * @if jp
+     *
+     * @brief コネクタのシリアライザを取得する
+     *
+     * シリアライザがない場合、または marshaling_type が変わった場合は
+     * 生成し直す。
+     *
+     * @param connector_id コネクタID
+     * @param marshalingtype シリアライザの種類
+     * @return シリアライザ、生成できない場合は nullptr
+     *
+     * @else
+     *
+     * @brief Get the serializer of a connector
+     *
+     * The serializer is created again if it does not exist or the
+     * marshaling_type has changed.
+     *
+     * @param connector_id Connector ID
+     * @param marshalingtype Type of the serializer
+     * @return Serializer, or nullptr if it cannot be created
+     *
+     * @endif
+     */
+    template <class DataType>
+    ::RTC::ByteDataStream<DataType>* get(const std::string& connector_id,
+                                         const std::string& marshalingtype)
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      auto & entry = m_serializers[connector_id];
+      if (entry.second == nullptr || entry.first != marshalingtype)
+        {
+          deleteSerializer(entry.second);
+          entry.second = createSerializer<DataType>(marshalingtype);
+          entry.first = marshalingtype;
+        }
+      return dynamic_cast<::RTC::ByteDataStream<DataType>*>(entry.second);
+    }
+
+    /*!
+     * @if jp
+     * @brief コネクタのシリアライザを削除する
+     * @param connector_id コネクタID
+     * @else
+     * @brief Delete the serializer of a connector
+     * @param connector_id Connector ID
+     * @endif
+     */
+    void release(const std::string& connector_id)
+    {
+      ByteDataStreamBase* serializer(nullptr);
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto it = m_serializers.find(connector_id);
+        if (it == m_serializers.end()) { return; }
+        serializer = it->second.second;
+        m_serializers.erase(it);
+      }
+      deleteSerializer(serializer);
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::map<std::string,
+             std::pair<std::string, ByteDataStreamBase*>> m_serializers;
   };
 
   /*!
@@ -529,10 +662,7 @@ namespace RTC
      * @brief Destructor
      * @endif
      */
-    ~ConnectorDataListenerT() override
-    {
-        SerializerFactory::instance().deleteObject(m_cdr);
-    }
+    ~ConnectorDataListenerT() override = default;
 
     /*!
      * @if jp
@@ -564,13 +694,9 @@ namespace RTC
     {
       DataType data;
 
-      if(m_cdr == nullptr || m_marshalingtype != marshalingtype)
-      {
-        m_cdr = createSerializer<DataType>(marshalingtype);
-        m_marshalingtype = marshalingtype;
-      }
-      ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
-      
+      // each connector has its own serializer for stateful codecs
+      ::RTC::ByteDataStream<DataType> *cdr =
+        m_serializers.get<DataType>(info.id, marshalingtype);
 
       if (!cdr)
       {
@@ -595,7 +721,10 @@ namespace RTC
 
       cdr->writeData(cdrdata.getBuffer(), cdrdata.getDataLength());
 
-      cdr->deserialize(data);
+      if (!cdr->deserialize(data))
+      {
+          return NO_CHANGE;
+      }
 
       ReturnCode ret = this->operator()(info, data);
       if (ret == DATA_CHANGED || ret == BOTH_CHANGED)
@@ -636,9 +765,22 @@ namespace RTC
      */
     virtual ReturnCode operator()(ConnectorInfo& info,
                                  DataType& data) = 0;
+
+    /*!
+     * @if jp
+     * @brief コネクタのシリアライザを解放する
+     * @param connector_id 切断されたコネクタのID
+     * @else
+     * @brief Release the serializer of a connector
+     * @param connector_id ID of the disconnected connector
+     * @endif
+     */
+    void releaseConnector(const std::string& connector_id) override
+    {
+      m_serializers.release(connector_id);
+    }
   private:
-      ByteDataStreamBase* m_cdr{nullptr};
-      std::string m_marshalingtype;
+      ConnectorSerializerMap m_serializers;
   };
 
   /*!
@@ -1083,6 +1225,30 @@ namespace RTC
 
     virtual ReturnCode notifyOut(ConnectorInfo& info, ByteData& data);
 
+    /*!
+     * @if jp
+     *
+     * @brief コネクタの状態を解放する
+     *
+     * 登録されているリスナとこのホルダがコネクタのために保持していた
+     * シリアライザを解放する。コネクタの切断時に呼ばれる。
+     *
+     * @param connector_id 切断されたコネクタのID
+     *
+     * @else
+     *
+     * @brief Release the state of a connector
+     *
+     * This releases the serializers kept for the connector by the
+     * registered listeners and this holder. It is called when the
+     * connector is disconnected.
+     *
+     * @param connector_id ID of the disconnected connector
+     *
+     * @endif
+     */
+    virtual void releaseConnector(const std::string& connector_id);
+
 
     /*!
      * @if jp
@@ -1190,12 +1356,8 @@ namespace RTC
             }
           else
             {
-              if (m_cdr == nullptr || m_marshalingtype != marshalingtype)
-              {
-                  m_cdr = createSerializer<DataType>(marshalingtype);
-                  m_marshalingtype = marshalingtype;
-              }
-              ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
+              ::RTC::ByteDataStream<DataType> *cdr =
+                m_serializers.get<DataType>(info.id, marshalingtype);
 
               if (!cdr)
               {
@@ -1222,8 +1384,7 @@ namespace RTC
   protected:
     std::vector<Entry> m_listeners;
     std::mutex m_mutex;
-    ByteDataStreamBase* m_cdr{ nullptr };
-    std::string m_marshalingtype;
+    ConnectorSerializerMap m_serializers;
   };
 
   /*!
@@ -1942,13 +2103,9 @@ namespace RTC
 
           DataType data;
 
-          if (m_cdr == nullptr || m_marshalingtype != marshalingtype)
-          {
-              m_cdr = createSerializer<DataType>(marshalingtype);
-              m_marshalingtype = marshalingtype;
-          }
-          ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
-
+          // each connector has its own serializer for stateful codecs
+          ::RTC::ByteDataStream<DataType> *cdr =
+              m_serializers.get<DataType>(info.id, marshalingtype);
 
           if (!cdr)
           {
@@ -1972,7 +2129,7 @@ namespace RTC
 
           cdr->isLittleEndian(endian);
           cdr->writeData(cdrdata.getBuffer(), cdrdata.getDataLength());
-          cdr->deserialize(data);
+          bool deserialized(cdr->deserialize(data));
 
 
           for (auto & listener : m_listeners)
@@ -1982,6 +2139,10 @@ namespace RTC
                   dynamic_cast<ConnectorDataListenerT<DataType>*>(listener.first);
               if (datalistener != nullptr)
               {
+                  if (!deserialized)
+                  {
+                      continue;
+                  }
                   ConnectorListenerHolder::ReturnCode linstener_ret(datalistener->operator()(info, data));
                   if (linstener_ret == DATA_CHANGED || linstener_ret == BOTH_CHANGED)
                   {
@@ -1999,7 +2160,7 @@ namespace RTC
                   {
                       cdr->isLittleEndian(endian);
                       cdr->writeData(cdrdata.getBuffer(), cdrdata.getDataLength());
-                      cdr->deserialize(data);
+                      deserialized = cdr->deserialize(data);
                   }
                   ret = ret | linstener_ret;
               }
@@ -2189,11 +2350,21 @@ namespace RTC
      */
     ::RTC::ConnectorListenerStatus::Enum notify(ConnectorListenerType type, ConnectorInfo& info) override
     {
-        if (static_cast<uint8_t>(type) < connector_.size())
+        if (static_cast<uint8_t>(type) >= connector_.size())
         {
-            return connector_[static_cast<uint8_t>(type)].notify(info);
+            return ConnectorListenerStatus::NO_CHANGE;
         }
-        return ConnectorListenerStatus::NO_CHANGE;
+        ::RTC::ConnectorListenerStatus::Enum ret(
+          connector_[static_cast<uint8_t>(type)].notify(info));
+        if (type == ConnectorListenerType::ON_DISCONNECT)
+        {
+            // the serializers of stateful codecs are kept per connector
+            for (auto & holder : connectorData_)
+            {
+                holder.releaseConnector(info.id);
+            }
+        }
+        return ret;
     }
     /*!
      * @if jp
@@ -69,6 +69,7 @@ namespace RTC
 #endif
     NVUtil::copyFromProperties(nv, m_properties);
     CORBA_SeqUtil::push_back_list(m_profile.properties, nv);
+    ++m_profileGeneration;
     RTC_PARANOID(("updated properties:"));
     RTC_DEBUG_STR((m_properties));
 
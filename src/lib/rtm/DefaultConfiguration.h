@@ -80,8 +80,11 @@ namespace RTC {
     "corba.nameservers",                     "localhost",
     "corba.master_manager",                  "localhost:2810",
     "corba.nameservice.replace_endpoint",    "NO",
+    "corba.nameservice.cache.enable",        "YES",
+    "corba.nameservice.cache.ttl",           "10.0",
     "corba.update_master_manager.enable",    "YES",
     "corba.update_master_manager.interval",  "10.0",
+    "corba_cdr.max_get_timeout",             "5.0",
     "exec_cxt.periodic.type",                "PeriodicExecutionContext",
     "exec_cxt.periodic.rate",                "1000",
     "exec_cxt.sync_transition",              "YES",
@@ -90,6 +93,10 @@ namespace RTC {
     "manager.modules.abs_path_allowed",      "YES",
     "manager.is_master",                     "NO",
     "manager.corba_servant",                 "YES",
+    "manager.slave_query.timeout",           "3.0",
+    "manager.slave_query.cache_ttl",         "1.0",
+    "manager.slave_query.threads",           "4",
+    "manager.slave_launch.timeout",          "10.0",
     "manager.shutdown_on_nortcs",            "YES",
     "manager.shutdown_auto",                 "YES",
     "manager.auto_shutdown_duration",        "20.0",
@@ -121,10 +128,16 @@ namespace RTC {
     "manager.modules.Java.suffixes",         "class",
     "manager.modules.Java.load_paths",       "",
     "manager.modules.search_auto",       "YES",
+    "manager.modules.index.enable",       "NO",
+    "manager.modules.index.file_name",       "./rtc_module_index.conf",
     "manager.preload.modules",       "",
     "manager.components.precreate",       "",
     "manager.components.preconnect",       "",
     "manager.components.preactivation",       "",
+    "manager.components.startup_threads",       "1",
+    "manager.startup_profile.enable",       "NO",
+    "manager.startup_profile.format",       "json",
+    "manager.startup_profile.file_name",       "./rtc_startup%p.json",
     "manager.local_service.enabled_services","ALL",
     "sdo.service.provider.enabled_services",  "ALL",
     "sdo.service.consumer.enabled_services",  "ALL",
@@ -0,0 +1,338 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DeltaCodec.cpp
+ * @brief Delta encoding codec class
+ * @date $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/DeltaCodec.h>
+#include <coil/stringutil.h>
+
+#include <random>
+
+namespace RTC
+{
+  // frame: type(1) stream id(4) sequence number(4) payload
+  static const size_t delta_header_size = 9;
+  static const unsigned char delta_keyframe = 0;
+  static const unsigned char delta_delta = 1;
+  // an equal run shorter than this is included in the literal run
+  static const size_t delta_min_run = 4;
+
+  static void putUInt32(unsigned char* data, uint32_t value)
+  {
+    for (size_t i(0); i < 4; ++i)
+      {
+        data[i] = static_cast<unsigned char>((value >> (8 * i)) & 0xff);
+      }
+  }
+
+  static uint32_t getUInt32(const unsigned char* data)
+  {
+    uint32_t value(0);
+    for (size_t i(0); i < 4; ++i)
+      {
+        value |= static_cast<uint32_t>(data[i]) << (8 * i);
+      }
+    return value;
+  }
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  DeltaCodec::DeltaCodec()
+  {
+    std::random_device rd;
+    m_streamId = static_cast<uint32_t>(rd());
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  DeltaCodec::~DeltaCodec() = default;
+
+  /*!
+   * @if jp
+   * @brief 初期化
+   * @else
+   * @brief Initialization
+   * @endif
+   */
+  void DeltaCodec::init(const coil::Properties& prop)
+  {
+    if (!coil::stringTo(m_interval,
+                        prop.getProperty("keyframe_interval", "30").c_str()) ||
+        m_interval == 0)
+      {
+        m_interval = 30;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 前のデータに依存する符号化を行う
+   * @else
+   * @brief The encoding depends on the previous data
+   * @endif
+   */
+  bool DeltaCodec::stateful() const
+  {
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 次のデータをキーフレームとして送る
+   * @else
+   * @brief Send the next data as a keyframe
+   * @endif
+   */
+  void DeltaCodec::reset()
+  {
+    m_resync = true;
+  }
+
+  /*!
+   * @if jp
+   * @brief キーフレームまたは差分に符号化する
+   * @else
+   * @brief Encode data into a keyframe or a delta
+   * @endif
+   */
+  bool DeltaCodec::encode(const unsigned char* data, size_t length,
+                          std::vector<unsigned char>& out)
+  {
+    ++m_sendSeq;
+    out.resize(delta_header_size);
+    putUInt32(&out[1], m_streamId);
+    putUInt32(&out[5], m_sendSeq);
+
+    bool keyframe(m_resync || m_sent.size() != length ||
+                  m_sinceKeyframe + 1 >= m_interval ||
+                  !encodeDelta(data, length, out));
+    if (keyframe)
+      {
+        out.resize(delta_header_size);
+        out[0] = delta_keyframe;
+        out.insert(out.end(), data, data + length);
+        m_sinceKeyframe = 0;
+        m_resync = false;
+      }
+    else
+      {
+        out[0] = delta_delta;
+        ++m_sinceKeyframe;
+      }
+    m_sent.assign(data, data + length);
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief キーフレームまたは差分を復号する
+   *
+   * 同じ通し番号の差分は直前のデータを返す。これはバッファの
+   * readback ポリシーで同じデータが再度読まれた場合である。
+   *
+   * @else
+   * @brief Decode a keyframe or a delta
+   *
+   * A delta with the same sequence number returns the previous data.
+   * This happens when the same data is read again by the readback
+   * policy of the buffer.
+   *
+   * @endif
+   */
+  bool DeltaCodec::decode(const unsigned char* data, size_t length,
+                          size_t original_length,
+                          std::vector<unsigned char>& out)
+  {
+    if (length < delta_header_size) { return false; }
+    uint32_t stream_id(getUInt32(data + 1));
+    uint32_t seq(getUInt32(data + 5));
+    const unsigned char* payload(data + delta_header_size);
+    size_t payload_len(length - delta_header_size);
+
+    if (data[0] == delta_keyframe)
+      {
+        if (payload_len != original_length) { return false; }
+        m_received.assign(payload, payload + payload_len);
+        m_recvStreamId = stream_id;
+        m_recvSeq = seq;
+        m_valid = true;
+        out = m_received;
+        return true;
+      }
+    if (data[0] != delta_delta || !m_valid || stream_id != m_recvStreamId ||
+        m_received.size() != original_length)
+      {
+        return false;
+      }
+    if (seq != m_recvSeq)
+      {
+        // lost data: wait for the next keyframe
+        if (seq != m_recvSeq + 1 || !applyDelta(payload, payload_len))
+          {
+            m_valid = false;
+            return false;
+          }
+        m_recvSeq = seq;
+      }
+    out = m_received;
+    return true;
+  }
+
+  //----------------------------------------------------------------------
+  // private functions
+
+  /*!
+   * @if jp
+   * @brief 前のデータとの差分を符号化する
+   *
+   * 差分は (一致するバイト数, 異なるバイト数, 異なるバイトの XOR) の
+   * 繰り返しで表す。数は可変長整数で表す。
+   *
+   * @return 差分がデータ全体より小さい場合 true
+   *
+   * @else
+   * @brief Encode the difference from the previous data
+   *
+   * A delta is a sequence of (number of equal bytes, number of
+   * different bytes, XOR of the different bytes). The numbers are
+   * variable length integers.
+   *
+   * @return true if the delta is smaller than the whole data
+   *
+   * @endif
+   */
+  bool DeltaCodec::encodeDelta(const unsigned char* data, size_t length,
+                               std::vector<unsigned char>& out)
+  {
+    const unsigned char* prev(m_sent.data());
+    size_t limit(delta_header_size + length);
+    size_t i(0);
+    while (i < length)
+      {
+        size_t equal_begin(i);
+        while (i < length && data[i] == prev[i]) { ++i; }
+        size_t equal(i - equal_begin);
+
+        size_t literal_end(i);
+        for (size_t j(i); j < length; ++j)
+          {
+            if (data[j] != prev[j])
+              {
+                literal_end = j + 1;
+              }
+            else if (j + 1 - literal_end >= delta_min_run)
+              {
+                break;
+              }
+          }
+
+        putVarint(out, equal);
+        putVarint(out, literal_end - i);
+        for (; i < literal_end; ++i)
+          {
+            out.push_back(data[i] ^ prev[i]);
+          }
+        if (out.size() >= limit) { return false; }
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信した差分を直前のデータに適用する
+   * @else
+   * @brief Apply a received delta to the previous data
+   * @endif
+   */
+  bool DeltaCodec::applyDelta(const unsigned char* data, size_t length)
+  {
+    const unsigned char* end(data + length);
+    size_t pos(0);
+    while (data < end)
+      {
+        size_t equal(0), literal(0);
+        if (!getVarint(data, end, equal) || !getVarint(data, end, literal))
+          {
+            return false;
+          }
+        if (equal > m_received.size() - pos ||
+            literal > m_received.size() - pos - equal ||
+            literal > static_cast<size_t>(end - data))
+          {
+            return false;
+          }
+        pos += equal;
+        for (size_t i(0); i < literal; ++i)
+          {
+            m_received[pos++] ^= *data++;
+          }
+      }
+    return true;
+  }
+
+  void DeltaCodec::putVarint(std::vector<unsigned char>& out, size_t value)
+  {
+    while (value >= 0x80)
+      {
+        out.push_back(static_cast<unsigned char>((value & 0x7f) | 0x80));
+        value >>= 7;
+      }
+    out.push_back(static_cast<unsigned char>(value));
+  }
+
+  bool DeltaCodec::getVarint(const unsigned char*& data,
+                             const unsigned char* end, size_t& value)
+  {
+    value = 0;
+    for (size_t shift(0); data < end && shift < 64; shift += 7)
+      {
+        unsigned char c(*data++);
+        value |= static_cast<size_t>(c & 0x7f) << shift;
+        if ((c & 0x80) == 0) { return true; }
+      }
+    return false;
+  }
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void DeltaCodecInit()
+  {
+    RTC::ByteDataCodecFactory::
+      instance().addFactory("delta",
+                            ::coil::Creator< ::RTC::ByteDataCodec,
+                                             ::RTC::DeltaCodec>,
+                            ::coil::Destructor< ::RTC::ByteDataCodec,
+                                                ::RTC::DeltaCodec>);
+  }
+}
@@ -0,0 +1,144 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DeltaCodec.h
+ * @brief Delta encoding codec class
+ * @date $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_DELTACODEC_H
+#define RTC_DELTACODEC_H
+
+#include <rtm/ByteDataCodec.h>
+
+#include <cstdint>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class DeltaCodec
+   * @brief 前のデータとの差分を送るコーデック
+   *
+   * "delta" として登録され、"cdr+delta" や "cdr+delta+lz4" のように
+   * 使用する。キーフレーム (データ全体) と、前のデータとの XOR をラン
+   * レングス符号化した差分を送る。少数の要素だけが変化する大きな配列
+   * に適している。
+   *
+   * 符号化・復号の状態はコネクタ毎に保持され、型付きのデータリスナも
+   * コネクタ毎に復号の状態を持つ。各データはストリーム ID と通し番号
+   * を持ち、受信側で欠落や別ストリームのデータを検出した場合は次のキー
+   * フレームまでデータを破棄する。送信側は
+   * compression.delta.keyframe_interval (デフォルト: 30) 個毎、データ
+   * 長が変わった時、送信に失敗した時、およびパブリッシャが前のデータ
+   * を読み飛ばす可能性がある時にキーフレームを送る。再接続時はコネク
+   * タとともに状態が作り直されるため、最初のデータはキーフレームとな
+   * る。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class DeltaCodec
+   * @brief Codec which sends differences from the previous data
+   *
+   * This is registered as "delta" and used as "cdr+delta" or
+   * "cdr+delta+lz4". It sends keyframes (whole data) and deltas which
+   * are run-length encoded XOR against the previous data. It is suitable
+   * for large arrays of which only a few elements change.
+   *
+   * The encoding and decoding states are kept per connector, and typed
+   * data listeners also keep a decoding state per connector. Each data
+   * has a stream ID and a sequence number, and the receiving side
+   * discards data until the next keyframe when it detects a loss or
+   * data of another stream. The sending side sends a keyframe every
+   * compression.delta.keyframe_interval (default: 30) data, when the
+   * data length changes, when sending failed and when the publisher may
+   * skip the previous data. On reconnection the states are recreated
+   * with the connector, so the first data is a keyframe.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class DeltaCodec : public ByteDataCodec
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    DeltaCodec();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~DeltaCodec() override;
+
+    void init(const coil::Properties& prop) override;
+    bool stateful() const override;
+    void reset() override;
+    bool encode(const unsigned char* data, size_t length,
+                std::vector<unsigned char>& out) override;
+    bool decode(const unsigned char* data, size_t length,
+                size_t original_length,
+                std::vector<unsigned char>& out) override;
+
+  private:
+    bool encodeDelta(const unsigned char* data, size_t length,
+                     std::vector<unsigned char>& out);
+    bool applyDelta(const unsigned char* data, size_t length);
+    static void putVarint(std::vector<unsigned char>& out, size_t value);
+    static bool getVarint(const unsigned char*& data,
+                          const unsigned char* end, size_t& value);
+
+    uint32_t m_streamId;
+    uint32_t m_sendSeq{0};
+    size_t m_interval{30};
+    size_t m_sinceKeyframe{0};
+    bool m_resync{true};
+    std::vector<unsigned char> m_sent;
+
+    uint32_t m_recvStreamId{0};
+    uint32_t m_recvSeq{0};
+    bool m_valid{false};
+    std::vector<unsigned char> m_received;
+  };
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * DeltaCodec を "delta" として ByteDataCodecFactory に登録する。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * This function registers DeltaCodec to ByteDataCodecFactory as
+   * "delta".
+   *
+   * @endif
+   */
+  void DeltaCodecInit();
+}
+
+#endif  // RTC_DELTACODEC_H
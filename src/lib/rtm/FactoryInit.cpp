@@ -22,8 +22,13 @@
 // Buffers
 #include <rtm/CdrRingBuffer.h>
 
+// Serializer codecs
+#include <rtm/DeltaCodec.h>
+#include <rtm/LatencyCodec.h>
+
 // Threads
 #include <rtm/DefaultPeriodicTask.h>
+#include <rtm/PublisherScheduler.h>
 
 // default Publishers
 #include <rtm/PublisherFlush.h>
@@ -73,8 +78,13 @@ namespace RTM
     // Buffers
     CdrRingBufferInit();
 
+    // Serializer codecs
+    DeltaCodecInit();
+    LatencyCodecInit();
+
     // Threads
     DefaultPeriodicTaskInit();
+    PublisherPoolTaskInit();
 
     // Publishers
     PublisherFlushInit();
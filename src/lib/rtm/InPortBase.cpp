@@ -29,9 +29,13 @@
 #include <algorithm>
 #include <iterator>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace RTC
 {
+  // interval to reflect the connector statuses in the ConnectorProfiles
+  static const std::chrono::seconds connector_status_interval(1);
 
   /*!
    * @if jp
@@ -239,13 +243,10 @@ namespace RTC
   {
     RTC_TRACE(("getConnectorById(id = %s)", id));
 
-    std::string sid(id);
-    for (auto & connector : m_connectors)
+    auto it = m_connectorIndex.find(id);
+    if (it != m_connectorIndex.end())
       {
-        if (sid == connector->id())
-          {
-            return connector;
-          }
+        return it->second;
       }
     RTC_WARN(("ConnectorProfile with the id(%s) not found.", id));
     return nullptr;
@@ -490,16 +491,23 @@ namespace RTC
     // prop: [port.outport].
     coil::Properties prop(m_properties);
     {
-      coil::Properties conn_prop;
-      NVUtil::copyToProperties(conn_prop, cprof.properties);
-      prop << conn_prop.getNode("dataport");  // marge ConnectorProfile
+      const coil::Properties& conn_prop(getConnectorProperties(cprof));
+      const coil::Properties* node(conn_prop.findNode("dataport"));
+      if (node != nullptr)
+        {
+          prop << *node;  // marge ConnectorProfile
+        }
       /*
        * marge ConnectorProfile for buffer property.
        * e.g.
        *  prof[buffer.write.full_policy]
        *       << cprof[dataport.inport.buffer.write.full_policy]
        */
-      prop << conn_prop.getNode("dataport.inport");
+      node = conn_prop.findNode("dataport.inport");
+      if (node != nullptr)
+        {
+          prop << *node;
+        }
     }
     RTC_DEBUG(("ConnectorProfile::properties are as follows."));
     RTC_DEBUG_STR((prop));
@@ -567,16 +575,23 @@ namespace RTC
     // prop: [port.outport].
     coil::Properties prop(m_properties);
     {
-      coil::Properties conn_prop;
-      NVUtil::copyToProperties(conn_prop, cprof.properties);
-      prop << conn_prop.getNode("dataport");  // marge ConnectorProfile
+      const coil::Properties& conn_prop(getConnectorProperties(cprof));
+      const coil::Properties* node(conn_prop.findNode("dataport"));
+      if (node != nullptr)
+        {
+          prop << *node;  // marge ConnectorProfile
+        }
       /*
        * marge ConnectorProfile for buffer property.
        * e.g.
        *  prof[buffer.write.full_policy]
        *       << cprof[dataport.inport.buffer.write.full_policy]
        */
-      prop << conn_prop.getNode("dataport.inport");
+      node = conn_prop.findNode("dataport.inport");
+      if (node != nullptr)
+        {
+          prop << *node;
+        }
     }
     RTC_DEBUG(("ConnectorProfile::properties are as follows."));
     RTC_DEBUG_STR((prop));
@@ -616,6 +631,13 @@ namespace RTC
           }
         conn->setEndian(littleEndian);
 
+        // the interface owned by the OutPort side is published by now
+        if (!conn->subscribeInterface(cprof.properties))
+          {
+            RTC_ERROR(("interface subscription failed."));
+            return RTC::RTC_ERROR;
+          }
+
         RTC_DEBUG(("subscribeInterfaces() successfully finished."));
         return RTC::RTC_OK;
       }
@@ -660,11 +682,14 @@ namespace RTC
     std::string id(connector_profile.connector_id);
     RTC_PARANOID(("connector_id: %s", id.c_str()));
 
-    ConnectorList::iterator it(m_connectors.begin());
-
-    while (it != m_connectors.end())
+    auto index = m_connectorIndex.find(id);
+    if (index != m_connectorIndex.end())
       {
-        if (id == (*it)->id())
+        ConnectorList::iterator it(std::find(m_connectors.begin(),
+                                             m_connectors.end(),
+                                             index->second));
+        m_connectorIndex.erase(index);
+        if (it != m_connectors.end())
           {
             // Connector's dtor must call disconnect()
 // RtORB's bug? This causes double delete and segmeentation fault.
@@ -678,12 +703,70 @@ namespace RTC
             RTC_TRACE(("delete connector: %s", id.c_str()));
             return;
           }
-        ++it;
       }
     RTC_ERROR(("specified connector not found: %s", id.c_str()));
     return;
   }
 
+  /*!
+   * @if jp
+   * @brief ConnectorProfile のプロパティを更新する
+   * @else
+   * @brief Update the properties of the ConnectorProfiles
+   * @endif
+   */
+  void InPortBase::updateConnectorProperties()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_statusMutex);
+      std::chrono::steady_clock::time_point now(std::chrono::steady_clock::now());
+      if (m_statusUpdated != std::chrono::steady_clock::time_point() &&
+          now - m_statusUpdated < connector_status_interval)
+        {
+          return;
+        }
+      m_statusUpdated = now;
+    }
+    // connectors are deleted in notify_disconnect() with
+    // m_connectorsMutex locked, so the statuses are collected under it
+    std::vector<std::pair<std::string, coil::Properties>> statuses;
+    {
+      std::lock_guard<std::mutex> guard(m_connectorsMutex);
+      for (auto & connector : m_connectors)
+        {
+          coil::Properties status;
+          connector->getCodecStatus(status);
+          if (status.size() == 0) { continue; }
+          statuses.emplace_back(connector->id(), coil::Properties());
+          statuses.back().second.getNode("dataport") << status;
+        }
+    }
+    if (statuses.empty()) { return; }
+
+    std::lock_guard<std::mutex> guard(m_profile_mutex);
+    bool updated(false);
+    for (auto & status : statuses)
+      {
+        CORBA::Long index(findConnProfileIndex(status.first.c_str()));
+        if (index < 0) { continue; }
+        SDOPackage::NVList& nv(m_profile.connector_profiles[index].properties);
+        coil::Properties current;
+        NVUtil::copyToProperties(current, nv);
+        for (auto & name : status.second.propertyNames())
+          {
+            if (current.getProperty(name) != status.second.getProperty(name))
+              {
+                updated = true;
+                break;
+              }
+          }
+        NVUtil::mergeFromProperties(nv, status.second);
+      }
+    // changed statistics invalidate the profile cached by
+    // get_component_profile()
+    if (updated) { ++m_profileGeneration; }
+  }
+
   /*!
    * @if jp
    * @brief InPort provider の初期化
@@ -992,6 +1075,7 @@ namespace RTC
         RTC_TRACE(("InPortPushConnector created"));
 
         m_connectors.emplace_back(connector);
+        m_connectorIndex[connector->id()] = connector;
         RTC_PARANOID(("connector push backed: %d", m_connectors.size()));
         return connector;
       }
@@ -1066,6 +1150,7 @@ namespace RTC
           }
 
         m_connectors.emplace_back(connector);
+        m_connectorIndex[connector->id()] = connector;
         RTC_PARANOID(("connector push backed: %d", m_connectors.size()));
         return connector;
       }
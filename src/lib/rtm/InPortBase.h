@@ -26,6 +26,11 @@
 #include <rtm/ConnectorListener.h>
 #include <rtm/OutPortBase.h>
 
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 /*!
  * @if jp
  * @namespace RTC
@@ -702,6 +707,35 @@ namespace RTC
     void
     unsubscribeInterfaces(const ConnectorProfile& connector_profile) override;
 
+    /*!
+     * @if jp
+     * @brief ConnectorProfile のプロパティを更新する
+     *
+     * 各コネクタのシリアライザのコーデックの状態を、ConnectorProfile の
+     * dataport.<コーデック名>.* プロパティに反映する。"cdr+latency" の
+     * 接続では dataport.latency.count, dataport.latency.mean_us,
+     * dataport.latency.jitter_us, dataport.latency.lost などの遅延の統
+     * 計情報が得られる。
+     *
+     * 統計情報はデータを読み出す度に変わるため、キャッシュされた
+     * プロファイルを無効にしないよう、反映は 1 秒に 1 回までとする。
+     *
+     * @else
+     * @brief Update the properties of the ConnectorProfiles
+     *
+     * The status of the codecs of the serializer of each connector is
+     * reflected in the dataport.<codec name>.* properties of the
+     * ConnectorProfile. For "cdr+latency" connections, the latency
+     * statistics such as dataport.latency.count, dataport.latency.mean_us,
+     * dataport.latency.jitter_us and dataport.latency.lost are obtained.
+     *
+     * Since the statistics change on every read, they are reflected at
+     * most once a second not to invalidate the cached profile.
+     *
+     * @endif
+     */
+    void updateConnectorProperties() override;
+
 
     /*!
      * @if jp
@@ -882,6 +916,24 @@ namespace RTC
      * @endif
      */
     ConnectorList m_connectors;
+    /*!
+     * @if jp
+     * @brief コネクタIDから接続への索引
+     * @else
+     * @brief Index from connector IDs to connections
+     * @endif
+     */
+    std::unordered_map<std::string, InPortConnector*> m_connectorIndex;
+    /*!
+     * @if jp
+     * @brief コネクタの状態を ConnectorProfile に反映した時刻
+     * @else
+     * @brief Time when the connector statuses were reflected in the
+     *        ConnectorProfiles
+     * @endif
+     */
+    std::chrono::steady_clock::time_point m_statusUpdated;
+    std::mutex m_statusMutex;
     /*!
      * @if jp
      * @brief 接続エンディアン
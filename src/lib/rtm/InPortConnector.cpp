@@ -46,7 +46,21 @@ namespace RTC
    */
   InPortConnector::~InPortConnector()
   {
-      SerializerFactory::instance().deleteObject(m_cdr);
+      deleteSerializer(m_cdr);
+  }
+
+  /*!
+   * @if jp
+   * @brief シリアライザのコーデックの状態を取得する
+   * @else
+   * @brief Get the status of the codecs of the serializer
+   * @endif
+   */
+  void InPortConnector::getCodecStatus(coil::Properties& prop)
+  {
+    std::lock_guard<std::mutex> guard(m_cdrMutex);
+    CodecSerializerBase* codec(dynamic_cast<CodecSerializerBase*>(m_cdr));
+    if (codec != nullptr) { codec->getStatus(prop); }
   }
 
   /*!
@@ -179,4 +193,9 @@ namespace RTC
 
   }
 
+  bool InPortConnector::subscribeInterface(const SDOPackage::NVList& /*properties*/)
+  {
+    return true;
+  }
+
 } // namespace RTC
@@ -26,6 +26,7 @@
 #include <rtm/PortBase.h>
 #include <rtm/ByteData.h>
 
+#include <mutex>
 
 namespace RTC
 {
@@ -220,11 +221,17 @@ namespace RTC
     template<class DataType>
     DataPortStatus read(DataType& data)
     {
-      if(m_cdr == nullptr)
+      ByteDataStreamBase* stream(nullptr);
       {
-        m_cdr = createSerializer<DataType>(m_marshaling_type);
+        std::lock_guard<std::mutex> guard(m_cdrMutex);
+        if(m_cdr == nullptr)
+        {
+          m_cdr = createSerializer<DataType>(m_marshaling_type);
+          if (m_cdr != nullptr) { m_cdr->init(m_profile.properties); }
+        }
+        stream = m_cdr;
       }
-      ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
+      ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(stream);
         
         if (!cdr)
         {
@@ -233,9 +240,10 @@ namespace RTC
         }
         cdr->isLittleEndian(isLittleEndian());
         DataPortStatus ret = read((ByteDataStreamBase*)cdr);
-        if (ret == DataPortStatus::PORT_OK)
+        if (ret == DataPortStatus::PORT_OK && !cdr->deserialize(data))
         {
-            cdr->deserialize(data);
+            RTC_WARN(("Deserialization failed: %s", m_marshaling_type.c_str()));
+            return DataPortStatus::PORT_ERROR;
         }
         return ret;
     }
@@ -280,6 +288,32 @@ namespace RTC
 
     virtual BufferStatus write(ByteData &cdr);
 
+    /*!
+     * @if jp
+     * @brief シリアライザのコーデックの状態を取得する
+     *
+     * marshaling_type にコーデックが指定されている場合、各コーデックの
+     * 状態をコーデック名のノードに書き出す。"cdr+latency" の場合は
+     * latency.count, latency.mean_us などの遅延の統計情報が得られる。
+     * まだデータを読み出していない場合は何も書き出さない。
+     *
+     * @param prop 書き出し先のプロパティ
+     *
+     * @else
+     * @brief Get the status of the codecs of the serializer
+     *
+     * When codecs are specified in the marshaling_type, the status of
+     * each codec is written to the node of the codec name. For
+     * "cdr+latency", the latency statistics such as latency.count and
+     * latency.mean_us are obtained. Nothing is written if no data has
+     * been read yet.
+     *
+     * @param prop Properties to be written
+     *
+     * @endif
+     */
+    void getCodecStatus(coil::Properties& prop);
+
 
     /*!
     * @if jp
@@ -380,6 +414,29 @@ namespace RTC
      */
     virtual void unsubscribeInterface(const coil::Properties& prop);
 
+    /*!
+     * @if jp
+     * @brief OutPort 側が公開したインターフェースに接続する
+     *
+     * push 型の接続で InPortBase::subscribeInterfaces() から呼ばれる。
+     * デフォルトでは何もしない。
+     *
+     * @param properties コネクタプロファイルのプロパティ
+     * @return 成功した場合 true
+     *
+     * @else
+     * @brief Subscribe to the interface published by the OutPort side
+     *
+     * This is called from InPortBase::subscribeInterfaces() for push
+     * connections. It does nothing by default.
+     *
+     * @param properties Properties of the connector profile
+     * @return true if succeeded
+     *
+     * @endif
+     */
+    virtual bool subscribeInterface(const SDOPackage::NVList& properties);
+
   protected:
     /*!
      * @if jp
@@ -456,6 +513,15 @@ namespace RTC
      */
     ByteDataStreamBase* m_cdr;
 
+    /*!
+     * @if jp
+     * @brief シリアライザの生成と参照の排他制御
+     * @else
+     * @brief Mutex for the creation and the reference of the serializer
+     * @endif
+     */
+    std::mutex m_cdrMutex;
+
   };
 } // namespace RTC
 
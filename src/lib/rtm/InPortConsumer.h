@@ -24,6 +24,8 @@
 #include <rtm/DataPortStatus.h>
 #include <rtm/ByteData.h>
 
+#include <string>
+
 namespace coil
 {
   class Properties;
@@ -214,6 +216,29 @@ namespace RTC
      */
     virtual void unsubscribeInterface(const SDOPackage::NVList& properties) = 0;
 
+    /*!
+     * @if jp
+     * @brief データを送信する OutPort の名前を設定する
+     *
+     * コンシューマの生成直後、init() より前に呼ばれる。同じ OutPort の
+     * 接続の間で資源を共有するコンシューマが使用する。デフォルトでは何
+     * もしない。
+     *
+     * @param name OutPort の名前
+     *
+     * @else
+     * @brief Set the name of the OutPort sending data
+     *
+     * This is called just after the consumer is created, before
+     * init(). Consumers sharing resources among the connections of an
+     * OutPort use it. It does nothing by default.
+     *
+     * @param name Name of the OutPort
+     *
+     * @endif
+     */
+    virtual void setOutPortName(const std::string& /*name*/) {}
+
     /*!
      * @if jp
      * @brief インターフェースプロファイルを公開するたのファンクタ
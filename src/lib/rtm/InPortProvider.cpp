@@ -86,6 +86,18 @@ namespace RTC
     return true;
   }
 
+  /*!
+   * @if jp
+   * @brief OutPort 側が公開した Interface 情報を取得する
+   * @else
+   * @brief Subscribe to the interface published by the OutPort side
+   * @endif
+   */
+  bool InPortProvider::subscribeInterface(const SDOPackage::NVList& /*prop*/)
+  {
+    return true;
+  }
+
   //----------------------------------------------------------------------
   // protected functions
 
@@ -389,6 +389,32 @@ namespace RTC
      */
     virtual bool publishInterface(SDOPackage::NVList& prop);
 
+    /*!
+     * @if jp
+     * @brief OutPort 側が公開した Interface 情報を取得する
+     *
+     * push 型の接続で、両方のポートが Interface 情報を公開した後に呼ば
+     * れる。OutPort 側が所有するインターフェース (マルチキャストグルー
+     * プ等) に接続するプロバイダが使用する。デフォルトでは何もしない。
+     *
+     * @param prop コネクタプロファイルのプロパティ
+     * @return true: 正常終了
+     *
+     * @else
+     * @brief Subscribe to the interface published by the OutPort side
+     *
+     * For push connections, this is called after both ports published
+     * their interface information. Providers connecting to an
+     * interface owned by the OutPort side, such as a multicast group,
+     * use it. It does nothing by default.
+     *
+     * @param prop Properties of the connector profile
+     * @return true: normal return
+     *
+     * @endif
+     */
+    virtual bool subscribeInterface(const SDOPackage::NVList& prop);
+
   protected:
     /*!
      * @if jp
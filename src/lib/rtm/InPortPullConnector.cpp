@@ -88,7 +88,8 @@ namespace RTC
       }
     
     DataPortStatus ret = m_consumer->get(m_data);
-    data->writeData(m_data.getBuffer(), m_data.getDataLength());
+    // m_data stays until the next read, so the serializer may refer to it
+    data->referData(m_data.getBuffer(), m_data.getDataLength());
     return ret;
   }
 
@@ -122,7 +122,6 @@ namespace RTC
     }
     
     BufferStatus ret = m_buffer->read(m_data);
-    data->writeData(m_data.getBuffer(), m_data.getDataLength());
 
     if (m_sync_readwrite)
     {
@@ -138,29 +137,60 @@ namespace RTC
         }
     }
 
+    DataPortStatus status(DataPortStatus::PORT_ERROR);
     switch (ret)
       {
       case BufferStatus::OK:
         onBufferRead(m_data);
-        return DataPortStatus::PORT_OK;
+        status = DataPortStatus::PORT_OK;
+        if (m_data.getArrivalSequence() != 0)
+          {
+            CodecSerializerBase*
+              codec(dynamic_cast<CodecSerializerBase*>(data));
+            if (codec != nullptr)
+              {
+                codec->setArrival(m_data.getArrivalSequence(),
+                                  m_data.getArrivalTime());
+              }
+          }
         break;
       case BufferStatus::EMPTY:
         onBufferEmpty(m_data);
-        return DataPortStatus::BUFFER_EMPTY;
+        status = DataPortStatus::BUFFER_EMPTY;
         break;
       case BufferStatus::TIMEOUT:
         onBufferReadTimeout(m_data);
-        return DataPortStatus::BUFFER_TIMEOUT;
+        status = DataPortStatus::BUFFER_TIMEOUT;
         break;
       case BufferStatus::PRECONDITION_NOT_MET:
-        return DataPortStatus::PRECONDITION_NOT_MET;
+        status = DataPortStatus::PRECONDITION_NOT_MET;
         break;
       case BufferStatus::BUFFER_ERROR:  /* FALLTHROUGH */
       case BufferStatus::FULL:          /* FALLTHROUGH */
       case BufferStatus::NOT_SUPPORTED: /* FALLTHROUGH */
       default:
-        return DataPortStatus::PORT_ERROR;
+        status = DataPortStatus::PORT_ERROR;
+        break;
       }
+
+    // m_data stays until the next read, so the serializer may refer to
+    // it in place. This is done after the listeners which may change it.
+    data->referData(m_data.getBuffer(), m_data.getDataLength());
+    return status;
+  }
+
+  /*!
+   * @if jp
+   * @brief OutPort 側が公開したインターフェースに接続する
+   * @else
+   * @brief Subscribe to the interface published by the OutPort side
+   * @endif
+   */
+  bool InPortPushConnector::subscribeInterface(const SDOPackage::NVList& properties)
+  {
+    RTC_TRACE(("subscribeInterface()"));
+    if (m_provider == nullptr) { return false; }
+    return m_provider->subscribeInterface(properties);
   }
 
   /*!
@@ -231,8 +261,17 @@ namespace RTC
     m_listeners->notify(ConnectorListenerType::ON_DISCONNECT, m_profile);
   }
 
+  /*!
+   * @if jp
+   * @brief データをバッファに書き込む
+   * @else
+   * @brief Write data to the buffer
+   * @endif
+   */
   BufferStatus InPortPushConnector::write(ByteData &cdr)
   {
+      cdr.setArrival(++m_arrivalSequence, std::chrono::steady_clock::now());
+
       if (m_sync_readwrite)
       {
           {
@@ -24,6 +24,8 @@
 #include <rtm/InPortConsumer.h>
 #include <rtm/PublisherBase.h>
 
+#include <atomic>
+
 namespace RTC
 {
   class InPortProvider;
@@ -231,6 +233,27 @@ namespace RTC
      */
     void deactivate() override {}  // do nothing
 
+    /*!
+     * @if jp
+     * @brief OutPort 側が公開したインターフェースに接続する
+     *
+     * プロバイダの subscribeInterface() を呼ぶ。
+     *
+     * @param properties コネクタプロファイルのプロパティ
+     * @return 成功した場合 true
+     *
+     * @else
+     * @brief Subscribe to the interface published by the OutPort side
+     *
+     * This calls subscribeInterface() of the provider.
+     *
+     * @param properties Properties of the connector profile
+     * @return true if succeeded
+     *
+     * @endif
+     */
+    bool subscribeInterface(const SDOPackage::NVList& properties) override;
+
   protected:
     /*!
      * @if jp
@@ -253,6 +276,30 @@ namespace RTC
      */
     virtual CdrBufferBase* createBuffer(ConnectorInfo& info);
 
+    /*!
+     * @if jp
+     * @brief データをバッファに書き込む
+     *
+     * プロバイダが受信したデータに到着番号と到着時刻を付けてバッファ
+     * に書き込む。これらは読み出し時にコーデックに渡され、遅延をバッ
+     * ファでの待ち時間と分けて計測するのに用いられる。
+     *
+     * @param cdr 受信したデータ
+     * @return バッファの書き込み結果
+     *
+     * @else
+     * @brief Write data to the buffer
+     *
+     * The data received by the provider is written to the buffer with
+     * the arrival number and the arrival time. They are passed to the
+     * codecs when the data is read, and used to measure the latency
+     * separately from the time spent in the buffer.
+     *
+     * @param cdr Received data
+     * @return The result of writing to the buffer
+     *
+     * @endif
+     */
     BufferStatus write(ByteData &cdr) override;
 
     /*!
@@ -326,6 +373,7 @@ namespace RTC
 
     ByteData m_data;
 
+    std::atomic<unsigned long long> m_arrivalSequence{0};
   };
 } // namespace RTC
 
@@ -0,0 +1,472 @@
+﻿// -*- C++ -*-
+/*!
+ * @file LatencyCodec.cpp
+ * @brief Latency tracing codec class
+ * @date $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/LatencyCodec.h>
+#include <coil/stringutil.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace RTC
+{
+  // frame: clock(1) stream id(4) sequence number(4) sending time(8) payload
+  static const size_t latency_header_size = 17;
+  static const unsigned char latency_monotonic = 0;
+  static const unsigned char latency_realtime = 1;
+
+  static void putUInt(unsigned char* data, uint64_t value, size_t size)
+  {
+    for (size_t i(0); i < size; ++i)
+      {
+        data[i] = static_cast<unsigned char>((value >> (8 * i)) & 0xff);
+      }
+  }
+
+  static uint64_t getUInt(const unsigned char* data, size_t size)
+  {
+    uint64_t value(0);
+    for (size_t i(0); i < size; ++i)
+      {
+        value |= static_cast<uint64_t>(data[i]) << (8 * i);
+      }
+    return value;
+  }
+
+  static std::string toMicroseconds(std::chrono::nanoseconds ns)
+  {
+    return coil::otos(static_cast<double>(ns.count()) / 1000.0);
+  }
+
+  /*!
+   * @if jp
+   * @brief 平均値
+   * @else
+   * @brief Mean
+   * @endif
+   */
+  std::chrono::nanoseconds LatencyCodec::Statistics::mean() const
+  {
+    if (count == 0) { return std::chrono::nanoseconds(0); }
+    return sum / static_cast<std::chrono::nanoseconds::rep>(count);
+  }
+
+  /*!
+   * @if jp
+   * @brief キューイング遅延の平均値
+   * @else
+   * @brief Mean of the queueing delay
+   * @endif
+   */
+  std::chrono::nanoseconds LatencyCodec::Statistics::queueMean() const
+  {
+    if (queue_count == 0) { return std::chrono::nanoseconds(0); }
+    return queue_sum / static_cast<std::chrono::nanoseconds::rep>(queue_count);
+  }
+
+  /*!
+   * @if jp
+   * @brief ヒストグラムから分位点を求める
+   * @else
+   * @brief Estimate a quantile from the histogram
+   * @endif
+   */
+  std::chrono::nanoseconds
+  LatencyCodec::Statistics::quantile(double ratio) const
+  {
+    unsigned long long total(0);
+    for (auto const& bin : histogram) { total += bin; }
+    if (total == 0) { return std::chrono::nanoseconds(0); }
+
+    double target(ratio * static_cast<double>(total));
+    unsigned long long sum(0);
+    for (size_t i(0); i < histogram_size; ++i)
+      {
+        sum += histogram[i];
+        if (static_cast<double>(sum) >= target)
+          {
+            std::chrono::nanoseconds upper(std::chrono::microseconds(1LL << i));
+            return upper < max ? upper : max;
+          }
+      }
+    return max;
+  }
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  LatencyCodec::LatencyCodec()
+    : rtclog("LatencyCodec")
+  {
+    std::random_device rd;
+    m_streamId = static_cast<uint32_t>(rd());
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  LatencyCodec::~LatencyCodec()
+  {
+    if (m_stats.count == 0) { return; }
+    RTC_INFO(("latency statistics: count %llu, min %s us, mean %s us, "
+              "max %s us, p99 %s us, jitter %.3f us, lost %llu, "
+              "queue mean %s us, dropped %llu",
+              m_stats.count, toMicroseconds(m_stats.min).c_str(),
+              toMicroseconds(m_stats.mean()).c_str(),
+              toMicroseconds(m_stats.max).c_str(),
+              toMicroseconds(m_stats.quantile(0.99)).c_str(),
+              m_stats.jitter / 1000.0, m_stats.lost,
+              toMicroseconds(m_stats.queueMean()).c_str(), m_stats.dropped));
+  }
+
+  /*!
+   * @if jp
+   * @brief 初期化
+   * @else
+   * @brief Initialization
+   * @endif
+   */
+  void LatencyCodec::init(const coil::Properties& prop)
+  {
+    std::string clock(coil::normalize(prop.getProperty("clock", "monotonic")));
+    if (clock == "realtime")
+      {
+        m_clock = latency_realtime;
+      }
+    else
+      {
+        if (clock != "monotonic")
+          {
+            RTC_WARN(("Invalid compression.latency.clock: %s", clock.c_str()));
+          }
+        m_clock = latency_monotonic;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信側の状態を持つため、常に適用される
+   * @else
+   * @brief Always applied since the receiving side has states
+   * @endif
+   */
+  bool LatencyCodec::stateful() const
+  {
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信時刻を付加する
+   * @else
+   * @brief Attach the sending time
+   * @endif
+   */
+  bool LatencyCodec::encode(const unsigned char* data, size_t length,
+                            std::vector<unsigned char>& out)
+  {
+    out.resize(latency_header_size + length);
+    out[0] = m_clock;
+    putUInt(&out[1], m_streamId, 4);
+    putUInt(&out[5], ++m_sendSeq, 4);
+    if (length > 0)
+      {
+        std::memcpy(&out[latency_header_size], data, length);
+      }
+    putUInt(&out[9], static_cast<uint64_t>(now(m_clock)), 8);
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信時刻を取り除き、遅延を記録する
+   *
+   * 到着情報が設定されている場合は、現在までの時間から到着後の時間を
+   * 除いたものを遅延とし、到着後の時間をキューイング遅延とする。
+   *
+   * @else
+   * @brief Remove the sending time and record the latency
+   *
+   * When the arrival information is set, the time since the arrival is
+   * subtracted from the latency and recorded as the queueing delay.
+   *
+   * @endif
+   */
+  bool LatencyCodec::decode(const unsigned char* data, size_t length,
+                            size_t original_length,
+                            std::vector<unsigned char>& out)
+  {
+    int64_t received(0);
+    if (length > 0) { received = now(data[0]); }
+    unsigned long long arrival(m_arrivalSequence);
+    std::chrono::nanoseconds queued(0);
+    if (arrival != 0)
+      {
+        queued = std::chrono::duration_cast<std::chrono::nanoseconds>
+          (std::chrono::steady_clock::now() - m_arrivalTime);
+        m_arrivalSequence = 0;
+      }
+    if (length != latency_header_size + original_length ||
+        (data[0] != latency_monotonic && data[0] != latency_realtime))
+      {
+        return false;
+      }
+    int64_t sent(static_cast<int64_t>(getUInt(&data[9], 8)));
+    record(static_cast<uint32_t>(getUInt(&data[1], 4)),
+           static_cast<uint32_t>(getUInt(&data[5], 4)),
+           received - sent - queued.count(), arrival, queued);
+    out.assign(data + latency_header_size, data + length);
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計情報をプロパティに書き出す
+   * @else
+   * @brief Write the statistics to properties
+   * @endif
+   */
+  void LatencyCodec::getStatus(coil::Properties& prop)
+  {
+    Statistics stats(getStatistics());
+    if (stats.count + stats.duplicated + stats.negative + stats.reread == 0)
+      {
+        return;
+      }
+
+    size_t bins(histogram_size);
+    while (bins > 1 && stats.histogram[bins - 1] == 0) { --bins; }
+    std::string histogram;
+    for (size_t i(0); i < bins; ++i)
+      {
+        histogram += (i == 0 ? "" : ",") + coil::otos(stats.histogram[i]);
+      }
+
+    prop["count"] = coil::otos(stats.count);
+    prop["lost"] = coil::otos(stats.lost);
+    prop["duplicated"] = coil::otos(stats.duplicated);
+    prop["reordered"] = coil::otos(stats.reordered);
+    prop["negative"] = coil::otos(stats.negative);
+    prop["dropped"] = coil::otos(stats.dropped);
+    prop["reread"] = coil::otos(stats.reread);
+    prop["last_us"] = toMicroseconds(stats.last);
+    prop["min_us"] = toMicroseconds(stats.min);
+    prop["max_us"] = toMicroseconds(stats.max);
+    prop["mean_us"] = toMicroseconds(stats.mean());
+    prop["p50_us"] = toMicroseconds(stats.quantile(0.5));
+    prop["p90_us"] = toMicroseconds(stats.quantile(0.9));
+    prop["p99_us"] = toMicroseconds(stats.quantile(0.99));
+    prop["jitter_us"] = coil::otos(stats.jitter / 1000.0);
+    prop["histogram"] = histogram;
+    if (stats.queue_count > 0)
+      {
+        prop["queue_last_us"] = toMicroseconds(stats.queue_last);
+        prop["queue_max_us"] = toMicroseconds(stats.queue_max);
+        prop["queue_mean_us"] = toMicroseconds(stats.queueMean());
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 次に復号するデータの到着情報を設定する
+   * @else
+   * @brief Set the arrival information of the data decoded next
+   * @endif
+   */
+  void LatencyCodec::setArrival(unsigned long long sequence,
+                                std::chrono::steady_clock::time_point time)
+  {
+    m_arrivalSequence = sequence;
+    m_arrivalTime = time;
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計情報を取得する
+   * @else
+   * @brief Get the statistics
+   * @endif
+   */
+  LatencyCodec::Statistics LatencyCodec::getStatistics()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_stats;
+  }
+
+  /*!
+   * @if jp
+   * @brief 指定された時計の現在時刻をナノ秒で取得する
+   * @else
+   * @brief Get the current time of the specified clock in nanoseconds
+   * @endif
+   */
+  int64_t LatencyCodec::now(unsigned char clock)
+  {
+    if (clock == latency_realtime)
+      {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>
+          (std::chrono::system_clock::now().time_since_epoch()).count();
+      }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>
+      (std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信したデータの遅延と通し番号を記録する
+   *
+   * 通し番号の飛びを欠落、同じ番号を重複、戻った番号を順序の入れ替わ
+   * りとして数える。入れ替わったデータは欠落として数えたものを一つ減
+   * らす。ストリーム ID が変わった場合は送信側が作り直されたものとし
+   * て通し番号を追い直す。重複したデータの遅延は記録しない。
+   *
+   * 到着番号が分かる場合、前回と同じ到着番号は同じデータの再読み出し
+   * として何も記録しない。到着番号の飛びは受信後に破棄されたデータと
+   * して数え、その分を通し番号の飛びによる欠落から除く。
+   *
+   * @else
+   * @brief Record the latency and the sequence number of received data
+   *
+   * A gap of the sequence numbers is counted as losses, the same number
+   * as a duplicate and a number going back as reordering. Reordered data
+   * decrements the losses counted for it. When the stream ID changes,
+   * the sending side is regarded as recreated and the sequence numbers
+   * are followed again. The latency of duplicated data is not recorded.
+   *
+   * When the arrival numbers are known, the same arrival number as the
+   * previous one is the same data read again and nothing is recorded.
+   * A gap of the arrival numbers is counted as data dropped after the
+   * reception, and is excluded from the losses by the gap of the
+   * sequence numbers.
+   *
+   * @endif
+   */
+  void LatencyCodec::record(uint32_t stream_id, uint32_t seq, int64_t latency,
+                            unsigned long long arrival,
+                            std::chrono::nanoseconds queued)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    unsigned long long dropped(0);
+    if (arrival != 0)
+      {
+        if (arrival == m_lastArrival)
+          {
+            ++m_stats.reread;
+            return;
+          }
+        if (arrival > m_lastArrival)
+          {
+            dropped = arrival - m_lastArrival - 1;
+            m_stats.dropped += dropped;
+          }
+        m_lastArrival = arrival;
+
+        if (queued > m_stats.queue_max) { m_stats.queue_max = queued; }
+        m_stats.queue_last = queued;
+        m_stats.queue_sum += queued;
+        ++m_stats.queue_count;
+      }
+
+    if (!m_receiving || stream_id != m_recvStreamId)
+      {
+        m_receiving = true;
+        m_recvStreamId = stream_id;
+        m_recvSeq = seq;
+      }
+    else
+      {
+        int32_t diff(static_cast<int32_t>(seq - m_recvSeq));
+        if (diff == 0)
+          {
+            ++m_stats.duplicated;
+            return;
+          }
+        if (diff > 0)
+          {
+            unsigned long long missing(static_cast<unsigned long long>(diff - 1));
+            if (missing > dropped) { m_stats.lost += missing - dropped; }
+            m_recvSeq = seq;
+          }
+        else
+          {
+            ++m_stats.reordered;
+            if (m_stats.lost > 0) { --m_stats.lost; }
+          }
+      }
+
+    if (latency < 0)
+      {
+        ++m_stats.negative;
+        return;
+      }
+
+    std::chrono::nanoseconds ns(latency);
+    if (m_stats.count == 0)
+      {
+        m_stats.min = ns;
+        m_stats.max = ns;
+      }
+    else
+      {
+        if (ns < m_stats.min) { m_stats.min = ns; }
+        if (ns > m_stats.max) { m_stats.max = ns; }
+        // RFC 3550 interarrival jitter
+        double d(std::fabs(static_cast<double>(latency - m_lastLatency)));
+        m_stats.jitter += (d - m_stats.jitter) / 16.0;
+      }
+    m_lastLatency = latency;
+    m_stats.last = ns;
+    m_stats.sum += ns;
+    ++m_stats.count;
+
+    size_t bin(0);
+    for (int64_t us(latency / 1000); us > 0 && bin + 1 < histogram_size; us >>= 1)
+      {
+        ++bin;
+      }
+    ++m_stats.histogram[bin];
+  }
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void LatencyCodecInit()
+  {
+    RTC::ByteDataCodecFactory::
+      instance().addFactory("latency",
+                            ::coil::Creator< ::RTC::ByteDataCodec,
+                                             ::RTC::LatencyCodec>,
+                            ::coil::Destructor< ::RTC::ByteDataCodec,
+                                                ::RTC::LatencyCodec>);
+  }
+}
@@ -0,0 +1,265 @@
+﻿// -*- C++ -*-
+/*!
+ * @file LatencyCodec.h
+ * @brief Latency tracing codec class
+ * @date $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_LATENCYCODEC_H
+#define RTC_LATENCYCODEC_H
+
+#include <rtm/ByteDataCodec.h>
+
+#include <cstdint>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class LatencyCodec
+   * @brief 送信時刻を付加してコネクタ毎の遅延を計測するコーデック
+   *
+   * "latency" として登録され、"cdr+latency" や "cdr+latency+lz4" の
+   * ように使用する。データ型を変更せずに、送信側コネクタがシリアライ
+   * ズ直後に付けた時刻と、受信側のプロバイダがデータを受信した時刻の
+   * 差を遅延として記録する。送信側の他のコーデックの処理時間も含める
+   * にはコーデックの先頭に置く。
+   *
+   * 受信したデータがバッファに書き込まれてからデシリアライズされるま
+   * での時間は、遅延とは別にキューイング遅延 (queue_*) として記録する。
+   * 受信側の他のコーデックの復号時間はこちらに含まれる。プル型の接続
+   * など到着時刻が分からない場合は、デシリアライズの直前までを遅延と
+   * する。
+   *
+   * 各データはストリーム ID、通し番号、送信時刻を持つ。受信側では遅延
+   * のヒストグラム、最小・最大・平均、RFC 3550 のジッタ、欠落・重複・
+   * 順序の入れ替わりを記録する。到着番号が分かる場合は、バッファの上
+   * 書きなどで読み出されずに破棄されたデータを欠落と分けて dropped、
+   * バッファの readback による同じデータの再読み出しを重複と分けて
+   * reread として数える。これらは InPort の ConnectorProfile の
+   * dataport.latency.* プロパティとして取得できる。
+   *
+   * 時計は compression.latency.clock で指定する。"monotonic" (デフォ
+   * ルト) は同一ホスト内でのみ比較でき、"realtime" はホスト間で時刻が
+   * 同期されている必要がある。負の遅延はヒストグラムに含めず、
+   * negative として数える。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class LatencyCodec
+   * @brief Codec which attaches the sending time and measures the
+   *        latency per connector
+   *
+   * This is registered as "latency" and used as "cdr+latency" or
+   * "cdr+latency+lz4". Without changing the data type, the difference
+   * between the time stamped by the sending connector just after
+   * serialization and the time when the receiving provider received
+   * the data is recorded as the latency. Put it first among the codecs
+   * to include the processing time of the other codecs on the sending
+   * side.
+   *
+   * The time from writing the received data to the buffer until it is
+   * deserialized is recorded separately from the latency as the
+   * queueing delay (queue_*), which includes the decoding time of the
+   * other codecs on the receiving side. When the arrival time is not
+   * known, as with pull connections, the latency lasts until just
+   * before deserialization.
+   *
+   * Each data has a stream ID, a sequence number and the sending
+   * time. The receiving side records the latency histogram, the
+   * minimum, maximum and mean, the RFC 3550 jitter, and losses,
+   * duplicates and reordering. When the arrival numbers are known,
+   * data discarded without being read, e.g. by overwriting the buffer,
+   * is counted as dropped apart from the losses, and the same data read
+   * again by the readback of the buffer is counted as reread apart from
+   * the duplicates. They are available as the dataport.latency.*
+   * properties of the ConnectorProfile of the InPort.
+   *
+   * The clock is specified with compression.latency.clock. "monotonic"
+   * (default) is only comparable within a host, and "realtime" requires
+   * the clocks of the hosts to be synchronized. A negative latency is
+   * not included in the histogram and counted as negative.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class LatencyCodec : public ByteDataCodec
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief ヒストグラムのビン数
+     *
+     * ビン 0 は 1 マイクロ秒未満、ビン n は [2^(n-1), 2^n) マイクロ秒。
+     *
+     * @else
+     * @brief Number of histogram bins
+     *
+     * Bin 0 is less than 1 microsecond and bin n is [2^(n-1), 2^n)
+     * microseconds.
+     *
+     * @endif
+     */
+    static const size_t histogram_size = 32;
+
+    /*!
+     * @if jp
+     * @brief 遅延の統計情報
+     * @else
+     * @brief Latency statistics
+     * @endif
+     */
+    struct Statistics
+    {
+      unsigned long long count{0};
+      unsigned long long lost{0};
+      unsigned long long duplicated{0};
+      unsigned long long reordered{0};
+      unsigned long long negative{0};
+      unsigned long long dropped{0};
+      unsigned long long reread{0};
+      std::chrono::nanoseconds min{0};
+      std::chrono::nanoseconds max{0};
+      std::chrono::nanoseconds sum{0};
+      std::chrono::nanoseconds last{0};
+      double jitter{0.0};
+      unsigned long long histogram[histogram_size]{};
+      // queueing delay from the arrival until deserialization
+      unsigned long long queue_count{0};
+      std::chrono::nanoseconds queue_max{0};
+      std::chrono::nanoseconds queue_sum{0};
+      std::chrono::nanoseconds queue_last{0};
+
+      /*!
+       * @if jp
+       * @brief 平均値
+       * @else
+       * @brief Mean
+       * @endif
+       */
+      std::chrono::nanoseconds mean() const;
+
+      /*!
+       * @if jp
+       * @brief キューイング遅延の平均値
+       * @else
+       * @brief Mean of the queueing delay
+       * @endif
+       */
+      std::chrono::nanoseconds queueMean() const;
+
+      /*!
+       * @if jp
+       * @brief ヒストグラムから分位点を求める
+       * @param ratio 0 から 1 の割合
+       * @return 分位点を含むビンの上限 (最大値を超えない)
+       * @else
+       * @brief Estimate a quantile from the histogram
+       * @param ratio Ratio from 0 to 1
+       * @return Upper bound of the bin containing the quantile, not
+       *         exceeding the maximum
+       * @endif
+       */
+      std::chrono::nanoseconds quantile(double ratio) const;
+    };
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    LatencyCodec();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * 受信したデータがあれば統計情報をログに出力する。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * The statistics are logged if any data has been received.
+     *
+     * @endif
+     */
+    ~LatencyCodec() override;
+
+    void init(const coil::Properties& prop) override;
+    bool stateful() const override;
+    bool encode(const unsigned char* data, size_t length,
+                std::vector<unsigned char>& out) override;
+    bool decode(const unsigned char* data, size_t length,
+                size_t original_length,
+                std::vector<unsigned char>& out) override;
+    void getStatus(coil::Properties& prop) override;
+    void setArrival(unsigned long long sequence,
+                    std::chrono::steady_clock::time_point time) override;
+
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     * @else
+     * @brief Get the statistics
+     * @endif
+     */
+    Statistics getStatistics();
+
+  private:
+    static int64_t now(unsigned char clock);
+    void record(uint32_t stream_id, uint32_t seq, int64_t latency,
+                unsigned long long arrival, std::chrono::nanoseconds queued);
+
+    Logger rtclog;
+    unsigned char m_clock{0};
+    uint32_t m_streamId;
+    uint32_t m_sendSeq{0};
+
+    bool m_receiving{false};
+    uint32_t m_recvStreamId{0};
+    uint32_t m_recvSeq{0};
+    int64_t m_lastLatency{0};
+    // arrival of the data decoded next, and of the last recorded data
+    unsigned long long m_arrivalSequence{0};
+    std::chrono::steady_clock::time_point m_arrivalTime;
+    unsigned long long m_lastArrival{0};
+    Statistics m_stats;
+    std::mutex m_mutex;
+  };
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * LatencyCodec を "latency" として ByteDataCodecFactory に登録する。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * This function registers LatencyCodec to ByteDataCodecFactory as
+   * "latency".
+   *
+   * @endif
+   */
+  void LatencyCodecInit();
+}
+
+#endif  // RTC_LATENCYCODEC_H
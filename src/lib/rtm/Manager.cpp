@@ -41,6 +41,7 @@
 #include <rtm/CORBA_RTCUtil.h>
 #include <rtm/SdoServiceConsumerBase.h>
 #include <rtm/LocalServiceAdmin.h>
+#include <rtm/PublisherScheduler.h>
 #include <rtm/SystemLogger.h>
 #include <rtm/LogstreamBase.h>
 #include <rtm/NumberingPolicyBase.h>
@@ -52,8 +53,12 @@
 #endif
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <set>
 #include <utility>
 #include <iterator>
 
@@ -116,14 +121,40 @@ namespace RTC
         if (manager == nullptr)
           {
             manager = new Manager();
-            manager->initManager(argc, argv);
-            manager->initFactories();
-            manager->initLogger();
-            manager->initORB();
-            manager->initNaming();
-            manager->initExecContext();
-            manager->initComposite();
-            manager->initManagerServant();
+            StartupProfiler& profiler(manager->m_startupProfiler);
+            {
+              StartupProfiler::Scope scope(profiler, "initManager", "phase");
+              manager->initManager(argc, argv);
+            }
+            {
+              StartupProfiler::Scope scope(profiler, "initFactories", "phase");
+              manager->initFactories();
+            }
+            {
+              StartupProfiler::Scope scope(profiler, "initLogger", "phase");
+              manager->initLogger();
+            }
+            {
+              StartupProfiler::Scope scope(profiler, "initORB", "phase");
+              manager->initORB();
+            }
+            {
+              StartupProfiler::Scope scope(profiler, "initNaming", "phase");
+              manager->initNaming();
+            }
+            {
+              StartupProfiler::Scope scope(profiler, "initExecContext", "phase");
+              manager->initExecContext();
+            }
+            {
+              StartupProfiler::Scope scope(profiler, "initComposite", "phase");
+              manager->initComposite();
+            }
+            {
+              StartupProfiler::Scope scope(profiler, "initManagerServant",
+                                           "phase");
+              manager->initManagerServant();
+            }
           }
       }
     return manager;
@@ -171,6 +202,7 @@ namespace RTC
     shutdownORB();
     // 終了待ち合わせ
     m_threadOrb.join();
+    PublisherScheduler::instance().shutdown();
     m_listeners.manager_.postShutdown();
     shutdownLogger();
   }
@@ -215,6 +247,8 @@ namespace RTC
 
     try
       {
+        StartupProfiler::Scope scope(m_startupProfiler,
+                                     "activatePOAManager", "phase");
         if (CORBA::is_nil(this->thePOAManager()))
         {
           RTC_ERROR(("Could not get POA manager."));
@@ -275,7 +309,11 @@ namespace RTC
           }
       }
 
-    initLocalService();
+    {
+      StartupProfiler::Scope scope(m_startupProfiler,
+                                   "initLocalService", "phase");
+      initLocalService();
+    }
 
     for (auto const& mod : coil::split(m_config["manager.modules.preload"], ","))
       {
@@ -335,10 +373,27 @@ namespace RTC
     m_config["sdo.service.consumer.available_services"]
       = coil::eraseBlank(coil::flatten(SdoServiceConsumerFactory::instance().getIdentifiers()));
 
-    invokeInitProc();
-    initPreCreation();
-    initPreConnection();
-    initPreActivation();
+    {
+      StartupProfiler::Scope scope(m_startupProfiler,
+                                   "invokeInitProc", "phase");
+      invokeInitProc();
+    }
+    {
+      StartupProfiler::Scope scope(m_startupProfiler,
+                                   "initPreCreation", "phase");
+      initPreCreation();
+    }
+    {
+      StartupProfiler::Scope scope(m_startupProfiler,
+                                   "initPreConnection", "phase");
+      initPreConnection();
+    }
+    {
+      StartupProfiler::Scope scope(m_startupProfiler,
+                                   "initPreActivation", "phase");
+      initPreActivation();
+    }
+    saveStartupProfile();
 
     return true;
   }
@@ -549,6 +604,8 @@ std::vector<coil::Properties> Manager::getLoadableModules()
                                 RtcDeleteFunc delete_func)
   {
     RTC_TRACE(("Manager::registerFactory(%s)", profile["type_name"].c_str()));
+    StartupProfiler::Scope profile_scope(m_startupProfiler,
+      "factory " + profile["type_name"], "factory");
 
     std::string policy_name =
       m_config.getProperty("manager.components.naming_policy", "default");
@@ -647,6 +704,13 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   RTObject_impl* Manager::createComponent(const char* comp_args)
   {
     RTC_TRACE(("Manager::createComponent(%s)", comp_args));
+    StartupProfiler::Scope profile_scope(m_startupProfiler,
+                                         std::string("create ") + comp_args,
+                                         "component");
+    // Components may be created concurrently at startup. Module loading,
+    // factories and the configuration of the manager are shared, so
+    // everything up to the initialization of the component is serialized.
+    std::unique_lock<std::recursive_mutex> guard(m_createMutex);
     std::string argstr(comp_args);
     m_listeners.rtclifecycle_.preCreate(argstr);
     //------------------------------------------------------------
@@ -817,6 +881,8 @@ std::vector<coil::Properties> Manager::getLoadableModules()
     configureComponent(comp, prop);
     m_listeners.rtclifecycle_.postConfigure(prop);
 
+    guard.unlock();
+
     //------------------------------------------------------------
     // Component initialization
     m_listeners.rtclifecycle_.preInitialize();
@@ -851,6 +917,8 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   bool Manager::registerComponent(RTObject_impl* comp)
   {
     RTC_TRACE(("Manager::registerComponent(%s)", comp->getInstanceName()));
+    StartupProfiler::Scope profile_scope(m_startupProfiler,
+      std::string("register ") + comp->getInstanceName(), "naming");
     // ### NamingManager のみで代用可能
     m_compManager.registerObject(comp);
 
@@ -1905,6 +1973,8 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   {
     RTC_TRACE(("Manager::initFactories()"));
     RTM::FactoryInit();
+    PublisherScheduler::instance().
+      init(m_config.getNode("manager.publisher_pool"));
     return true;
   }
 
@@ -2565,14 +2635,61 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   {
     RTC_TRACE(("Connection pre-connection: %s",
                m_config["manager.components.preconnect"].c_str()));
-    for (auto&& connector : coil::split(m_config["manager.components.preconnect"], ","))
+    coil::vstring connectors =
+      coil::split(m_config["manager.components.preconnect"], ",", true);
+    coil::vstring failed;
+    connectPorts(connectors, failed);
+  }
+
+  /*!
+   * @if jp
+   * @brief 複数のポートを一括して接続する
+   * @else
+   * @brief Connect many ports at once
+   * @endif
+   */
+  ReturnCode_t Manager::connectPorts(const coil::vstring& connectors,
+                                     coil::vstring& failed)
+  {
+    RTC_TRACE(("connectPorts(%d connectors)",
+               static_cast<int>(connectors.size())));
+    auto start = std::chrono::steady_clock::now();
+    failed.clear();
+
+    // "RTC0.port0" -> "RTC0", "RTC0.port0"
+    // "rtcname://host/ns/RTC0.port0" -> "rtcname://host/ns/RTC0", "RTC0.port0"
+    auto split_port = [](const std::string& port_str,
+                         std::string& comp_name, std::string& port_name)
       {
-        connector = coil::eraseBothEndsBlank(std::move(connector));
-        if (connector.empty())
+        coil::vstring tmp = coil::split(port_str, ".");
+        if (tmp.empty()) { return false; }
+        tmp.pop_back();
+        comp_name = coil::eraseBlank(coil::flatten(tmp, "."));
+        port_name = port_str;
+        if (comp_name.find("://") != std::string::npos)
           {
-            continue;
+            port_name = coil::split(port_str, "/").back();
           }
+        return true;
+      };
 
+    struct Connection
+    {
+      size_t connector;
+      coil::Properties prop;
+      coil::vstring ports;
+      std::vector<std::string> keys;
+      std::vector<RTC::PortService_var> refs;
+      ReturnCode_t result;
+    };
+
+    // Connection specifications are parsed first and the components of
+    // all the ports are collected.
+    std::vector<Connection> connections;
+    coil::vstring comp_names;
+    for (size_t i(0); i < connectors.size(); ++i)
+      {
+        const std::string& connector(connectors[i]);
         std::string port0_str = coil::split(connector, "?")[0];
         coil::vstring ports;
         coil::mapstring configs;
@@ -2603,117 +2720,222 @@ std::vector<coil::Properties> Manager::getLoadableModules()
             configs["interface_type"] = "corba_cdr";
           }
 
-        coil::vstring tmp = coil::split(port0_str, ".");
-        tmp.pop_back();
-        std::string comp0_name = coil::eraseBlank(coil::flatten(tmp, "."));
-
-        std::string port0_name = port0_str;
-        RTObject_impl* comp0 = nullptr;
-        RTC::RTObject_var comp0_ref;
+        coil::Properties prop;
+        for (auto const& config : configs)
+          {
+            std::string key{coil::eraseBothEndsBlank(config.first)};
+            std::string value{coil::eraseBothEndsBlank(config.second)};
+            prop["dataport." + key] = std::move(value);
+          }
 
-        if (comp0_name.find("://") == std::string::npos)
+        std::vector<coil::vstring> port_pairs;
+        if (ports.empty())
           {
-            comp0 = getComponent(comp0_name.c_str());
-            if (comp0 == nullptr)
-            {
-              RTC_ERROR(("%s not found.", comp0_name.c_str()));
-              continue;
-            }
-            comp0_ref = comp0->getObjRef();
+            port_pairs.push_back({port0_str});
           }
-        else
+        for (auto const& port : ports)
+          {
+            port_pairs.push_back({port0_str, port});
+          }
+        for (auto & port_pair : port_pairs)
           {
-            RTC::RTCList rtcs = m_namingManager->string_to_component(comp0_name);
-            if (rtcs.length() == 0)
+            for (auto const& port_str : port_pair)
               {
-                RTC_ERROR(("%s not found.", comp0_name.c_str()));
-                continue;
+                std::string comp_name, port_name;
+                if (split_port(port_str, comp_name, port_name) &&
+                    std::find(comp_names.begin(), comp_names.end(),
+                              comp_name) == comp_names.end())
+                  {
+                    comp_names.emplace_back(std::move(comp_name));
+                  }
               }
-            comp0_ref = RTObject::_duplicate(rtcs[0]);
-            coil::vstring tmp_port0_name = coil::split(port0_str, "/");
-            port0_name = tmp_port0_name.back();
+            connections.push_back({i, prop, std::move(port_pair), {}, {},
+                                   RTC::BAD_PARAMETER});
           }
+      }
 
-        RTC::PortService_var port0_var = CORBA_RTCUtil::get_port_by_name(comp0_ref.in(), port0_name);
-        if (CORBA::is_nil(port0_var))
+    // Remote components are resolved at once so that the name services
+    // are not searched again for every connection.
+    coil::vstring remote_names;
+    for (auto const& comp_name : comp_names)
+      {
+        if (comp_name.find("://") != std::string::npos)
           {
-            RTC_DEBUG(("port %s found: ", port0_str.c_str()));
-            continue;
+            remote_names.emplace_back(comp_name);
           }
+      }
+    std::map<std::string, RTC::RTCList> remote_comps;
+    std::vector<RTC::RTCList> remote_rtcs =
+      m_namingManager->string_to_components(remote_names);
+    for (size_t i(0); i < remote_names.size(); ++i)
+      {
+        remote_comps[remote_names[i]] = remote_rtcs[i];
+      }
 
-        if (ports.empty())
+    // Names which refer to the same object share a group, and the ports
+    // of each group are obtained only once.
+    std::vector<RTC::RTObject_var> comp_refs;
+    std::map<std::string, size_t> comp_group;
+    for (auto const& comp_name : comp_names)
+      {
+        RTC::RTObject_var comp_ref;
+        if (comp_name.find("://") == std::string::npos)
           {
-            coil::Properties prop;
-
-            for (auto const& config : configs)
+            RTObject_impl* comp = getComponent(comp_name.c_str());
+            if (comp == nullptr)
               {
-                std::string key = config.first;
-                std::string value = config.second;
-                coil::eraseBothEndsBlank(key);
-                coil::eraseBothEndsBlank(value);
-                prop["dataport." + key] = value;
+                RTC_ERROR(("%s not found.", comp_name.c_str()));
+                continue;
               }
-
-            if (RTC::RTC_OK != CORBA_RTCUtil::connect(connector, prop, port0_var.in(), RTC::PortService::_nil()))
+            comp_ref = comp->getObjRef();
+          }
+        else
+          {
+            auto itr = remote_comps.find(comp_name);
+            if (itr == remote_comps.end() || itr->second.length() == 0)
               {
-                RTC_ERROR(("Connection error: %s", connector.c_str()));
+                RTC_ERROR(("%s not found.", comp_name.c_str()));
+                continue;
               }
+            comp_ref = RTObject::_duplicate(itr->second[0]);
           }
 
-        for (auto const& port : ports)
+        size_t g(0);
+        for (; g < comp_refs.size(); ++g)
           {
-            tmp = coil::split(port, ".");
-            tmp.pop_back();
-            std::string comp_name = coil::eraseBlank(coil::flatten(tmp, "."));
-            std::string port_name = port;
-            RTObject_impl* comp = nullptr;
-            RTC::RTObject_var comp_ref;
+            if (comp_refs[g]->_is_equivalent(comp_ref.in())) { break; }
+          }
+        if (g == comp_refs.size())
+          {
+            comp_refs.emplace_back(comp_ref._retn());
+          }
+        comp_group[comp_name] = g;
+      }
 
-            if (comp_name.find("://") == std::string::npos)
+    std::vector<std::map<std::string, RTC::PortService_var>>
+      group_ports(comp_refs.size());
+    std::vector<std::function<void(void)>> tasks;
+    for (size_t g(0); g < comp_refs.size(); ++g)
+      {
+        tasks.emplace_back([this, &comp_refs, &group_ports, g]
+          {
+            try
               {
-                comp = getComponent(comp_name.c_str());
-                if (comp == nullptr)
+                RTC::PortServiceList_var ports = comp_refs[g]->get_ports();
+                for (CORBA::ULong p(0); p < ports->length(); ++p)
                   {
-                      RTC_ERROR(("%s not found.", comp_name.c_str()));
-                      continue;
+                    RTC::PortProfile_var pp = ports[p]->get_port_profile();
+#ifdef ORB_IS_TAO
+                    group_ports[g][static_cast<const char*>(pp->name)] =
+                      RTC::PortService::_duplicate(ports[p].in());
+#else
+                    group_ports[g][static_cast<const char*>(pp->name)] =
+                      RTC::PortService::_duplicate(ports[p]);
+#endif
                   }
-                comp_ref = comp->getObjRef();
               }
-            else
+            catch (...)
               {
-                RTC::RTCList rtcs = m_namingManager->string_to_component(comp_name);
-                if (rtcs.length() == 0)
-                  {
-                    RTC_ERROR(("%s not found.", comp_name.c_str()));
-                    continue;
-                  }
-                comp_ref = RTObject::_duplicate(rtcs[0]);
-                coil::vstring tmp_port_name = coil::split(port, "/");
-                port_name = tmp_port_name.back();
+                RTC_ERROR(("Failed to get the ports of a component."));
               }
+          });
+      }
+    invokeParallel(tasks);
 
-            RTC::PortService_var port_var = CORBA_RTCUtil::get_port_by_name(comp_ref.in(), port_name);
-
-            if (CORBA::is_nil(port_var))
+    for (auto & conn : connections)
+      {
+        for (auto const& port_str : conn.ports)
+          {
+            std::string comp_name, port_name;
+            if (!split_port(port_str, comp_name, port_name)) { break; }
+            auto group = comp_group.find(comp_name);
+            if (group == comp_group.end()) { break; }
+            auto port = group_ports[group->second].find(port_name);
+            if (port == group_ports[group->second].end())
               {
-                RTC_DEBUG(("port %s found: ", port.c_str()));
-                continue;
+                RTC_ERROR(("port %s not found.", port_str.c_str()));
+                break;
               }
+            conn.keys.emplace_back(std::to_string(group->second) + ":" +
+                                   port_name);
+            conn.refs.emplace_back(
+              RTC::PortService::_duplicate(port->second.in()));
+          }
+      }
 
-            coil::Properties prop;
-            for (auto const& config : configs)
+    // Connections which share a port are put into different batches so
+    // that no port is connected concurrently. The batches are processed
+    // in order and the connections in a batch are made in parallel.
+    std::vector<std::vector<Connection*>> batches;
+    std::vector<std::set<std::string>> batch_ports;
+    for (auto & conn : connections)
+      {
+        if (conn.refs.size() != conn.ports.size()) { continue; }
+        size_t b(0);
+        for (; b < batches.size(); ++b)
+          {
+            bool used(false);
+            for (auto const& key : conn.keys)
               {
-                std::string key{coil::eraseBothEndsBlank(std::move(config.first))};
-                std::string value{coil::eraseBothEndsBlank(std::move(config.second))};
-                prop["dataport." + key] = std::move(value);
+                if (batch_ports[b].count(key) != 0) { used = true; }
               }
+            if (!used) { break; }
+          }
+        if (b == batches.size())
+          {
+            batches.emplace_back();
+            batch_ports.emplace_back();
+          }
+        batches[b].emplace_back(&conn);
+        batch_ports[b].insert(conn.keys.begin(), conn.keys.end());
+      }
 
-            if (RTC::RTC_OK != CORBA_RTCUtil::connect(connector, prop, port0_var.in(), port_var.in()))
+    for (auto const& batch : batches)
+      {
+        tasks.clear();
+        for (auto const& conn : batch)
+          {
+            tasks.emplace_back([this, conn, &connectors]
               {
-                RTC_ERROR(("Connection error: %s", connector.c_str()));
-              }
+                const std::string& name(connectors[conn->connector]);
+                auto t0 = std::chrono::steady_clock::now();
+                RTC::PortService_ptr port1 = conn->refs.size() > 1 ?
+                  conn->refs[1].in() : RTC::PortService::_nil();
+                conn->result = CORBA_RTCUtil::connect(name, conn->prop,
+                                                      conn->refs[0].in(),
+                                                      port1);
+                if (conn->result != RTC::RTC_OK)
+                  {
+                    RTC_ERROR(("Connection error: %s", name.c_str()));
+                  }
+                std::chrono::duration<double> delta =
+                  std::chrono::steady_clock::now() - t0;
+                RTC_DEBUG(("Connection %s: %f [s]", name.c_str(), delta.count()));
+              });
           }
+        invokeParallel(tasks);
       }
+
+    std::vector<bool> connector_failed(connectors.size(), false);
+    size_t failed_count(0);
+    for (auto const& conn : connections)
+      {
+        if (conn.result == RTC::RTC_OK) { continue; }
+        ++failed_count;
+        if (!connector_failed[conn.connector])
+          {
+            connector_failed[conn.connector] = true;
+            failed.emplace_back(connectors[conn.connector]);
+          }
+      }
+
+    std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+    RTC_INFO(("connectPorts: %d connections (%d failed) in %d batches, %f [s]",
+              static_cast<int>(connections.size()),
+              static_cast<int>(failed_count),
+              static_cast<int>(batches.size()), elapsed.count()));
+    return failed.empty() ? RTC::RTC_OK : RTC::RTC_ERROR;
   }
 
   /*!
@@ -2734,11 +2956,32 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   {
     RTC_TRACE(("Components pre-activation: %s",
                m_config["manager.components.preactivation"].c_str()));
+    auto start = std::chrono::steady_clock::now();
 
-    for (auto&& c : coil::split(m_config["manager.components.preactivation"], ","))
+    coil::vstring comps =
+      coil::split(m_config["manager.components.preactivation"], ",", true);
+    coil::vstring remote_names;
+    for (auto const& c : comps)
       {
-        c = coil::eraseBothEndsBlank(std::move(c));
-        if (!c.empty())
+        if (c.find("://") != std::string::npos)
+          {
+            remote_names.emplace_back(c);
+          }
+      }
+    std::map<std::string, RTC::RTCList> remote_comps;
+    std::vector<RTC::RTCList> remote_rtcs =
+      m_namingManager->string_to_components(remote_names);
+    for (size_t i(0); i < remote_names.size(); ++i)
+      {
+        remote_comps[remote_names[i]] = remote_rtcs[i];
+      }
+    // the tasks may run concurrently, so they only look the map up
+    const std::map<std::string, RTC::RTCList>& remotes(remote_comps);
+
+    std::vector<std::function<void(void)>> tasks;
+    for (auto const& c : comps)
+      {
+        tasks.emplace_back([this, &c, &remotes]
           {
             RTC::RTObject_var comp_ref;
             if (c.find("://") == std::string::npos)
@@ -2746,19 +2989,19 @@ std::vector<coil::Properties> Manager::getLoadableModules()
                 RTObject_impl* comp = getComponent(c.c_str());
                 if (comp == nullptr)
                   {
-                    RTC_ERROR(("%s not found.", c.c_str())); continue;
+                    RTC_ERROR(("%s not found.", c.c_str())); return;
                   }
                 comp_ref = comp->getObjRef();
               }
             else
               {
-                RTC::RTCList rtcs = m_namingManager->string_to_component(c);
-                if (rtcs.length() == 0)
+                auto itr = remotes.find(c);
+                if (itr == remotes.end() || itr->second.length() == 0)
                   {
                     RTC_ERROR(("%s not found.", c.c_str()));
-                    continue;
+                    return;
                   }
-                comp_ref = RTObject::_duplicate(rtcs[0]);
+                comp_ref = RTObject::_duplicate(itr->second[0]);
               }
             RTC::ReturnCode_t ret = CORBA_RTCUtil::activate(comp_ref.in());
             if (ret != RTC::RTC_OK)
@@ -2769,8 +3012,14 @@ std::vector<coil::Properties> Manager::getLoadableModules()
             {
               RTC_INFO(("%s activated.", c.c_str()));
             }
-          }
+          });
       }
+    invokeParallel(tasks);
+
+    std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+    RTC_INFO(("Pre-activation: %d components, %f [s]",
+              comps.size(), elapsed.count()));
   }
 
   /*!
@@ -2791,9 +3040,132 @@ std::vector<coil::Properties> Manager::getLoadableModules()
   {
     RTC_TRACE(("Components pre-creation: %s",
                m_config["manager.components.precreate"].c_str()));
-    for (auto const& comp : coil::split(m_config["manager.components.precreate"], ","))
+    auto start = std::chrono::steady_clock::now();
+    coil::vstring comps =
+      coil::split(m_config["manager.components.precreate"], ",");
+
+    std::atomic<size_t> created(0);
+    std::vector<std::function<void(void)>> tasks;
+    for (auto const& comp : comps)
+      {
+        tasks.emplace_back([this, &comp, &created]
+          {
+            auto t0 = std::chrono::steady_clock::now();
+            if (this->createComponent(comp.c_str()) != nullptr)
+              {
+                ++created;
+              }
+            std::chrono::duration<double> delta =
+              std::chrono::steady_clock::now() - t0;
+            RTC_DEBUG(("Pre-creation %s: %f [s]", comp.c_str(), delta.count()));
+          });
+      }
+    invokeParallel(tasks);
+
+    std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+    RTC_INFO(("Pre-creation: %d/%d components created, %f [s]",
+              created.load(), comps.size(), elapsed.count()));
+  }
+
+  /*!
+  * @if jp
+  * @brief タスクを並列に実行する
+  *
+  * manager.components.startup_threads で指定された数のスレッドで
+  * tasks を実行し、すべての完了を待つ。スレッド数が1以下の場合は呼び
+  * 出しスレッドで順に実行する。複数のスレッドの場合、タスク間の依存
+  * 関係は考慮されず、実行順序は保証されない。
+  *
+  * @param tasks 実行するタスクのリスト
+  *
+  * @else
+  * @brief Run tasks in parallel
+  *
+  * The tasks are run by the number of threads specified by
+  * manager.components.startup_threads and this function waits for all
+  * of them. If the number of threads is 1 or less, the tasks are run in
+  * order on the calling thread. With more threads, dependencies among
+  * the tasks are not considered and their order is not guaranteed.
+  *
+  * @param tasks The list of tasks to be run
+  *
+  * @endif
+  */
+  void Manager::invokeParallel(const std::vector<std::function<void(void)>>& tasks)
+  {
+    unsigned int nthreads(1);
+    if (!coil::stringTo(nthreads,
+                        m_config["manager.components.startup_threads"].c_str())
+        || nthreads == 0)
+      {
+        nthreads = 1;
+      }
+    if (nthreads > tasks.size())
+      {
+        nthreads = static_cast<unsigned int>(tasks.size());
+      }
+    if (nthreads <= 1)
+      {
+        for (auto const& task : tasks) { task(); }
+        return;
+      }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (unsigned int i(0); i < nthreads; ++i)
+      {
+        workers.emplace_back([this, &tasks, &next]
+          {
+            for (size_t j = next++; j < tasks.size(); j = next++)
+              {
+                try
+                  {
+                    tasks[j]();
+                  }
+                catch (...)
+                  {
+                    RTC_ERROR(("Unknown exception in a startup task."));
+                  }
+              }
+          });
+      }
+    for (auto & worker : workers)
+      {
+        worker.join();
+      }
+  }
+
+  /*!
+  * @if jp
+  * @brief 起動処理のプロファイルを出力する
+  * @else
+  * @brief Write the profile of the startup
+  * @endif
+  */
+  void Manager::saveStartupProfile()
+  {
+    if (!m_startupProfiler.isRecording()) { return; }
+    m_startupProfiler.finish();
+    if (!coil::toBool(m_config["manager.startup_profile.enable"],
+                      "YES", "NO", false))
+      {
+        return;
+      }
+
+    std::string file_name =
+      formatString(m_config["manager.startup_profile.file_name"].c_str(),
+                   m_config);
+    std::string format = m_config["manager.startup_profile.format"];
+    if (m_startupProfiler.save(file_name, format))
+      {
+        RTC_INFO(("Startup profile (%s) was written to %s",
+                  format.c_str(), file_name.c_str()));
+      }
+    else
       {
-        this->createComponent(comp.c_str());
+        RTC_ERROR(("Writing startup profile to %s failed.",
+                   file_name.c_str()));
       }
   }
 
@@ -32,6 +32,7 @@
 #include <rtm/ObjectManager.h>
 #include <rtm/SystemLogger.h>
 #include <rtm/ManagerActionListener.h>
+#include <rtm/StartupProfiler.h>
 
 #ifdef ORB_IS_ORBEXPRESS
 #include <RTPortableServer.h>
@@ -979,6 +980,48 @@ namespace RTC
      */
     std::vector<RTObject_impl*> getComponents();
 
+    /*!
+     * @if jp
+     *
+     * @brief 複数のポートを一括して接続する
+     *
+     * manager.components.preconnect と同じ形式の接続指定のリストを受け
+     * 取り、全ての接続を行う。
+     *
+     * 例: RTC0.port0?port=RTC0.port1&interface_type=corba_cdr&dataflow_type=pull
+     *
+     * リモートのコンポーネント (rtcname://, rtcloc:// 形式) は一度にま
+     * とめて名前解決され、同じオブジェクトを指すコンポーネントのポート
+     * は一度だけ取得される。ポートを共有しない接続は並列に行われる。
+     *
+     * @param connectors 接続指定のリスト
+     * @param failed 失敗した接続指定のリスト
+     * @return 全て成功した場合 RTC_OK、それ以外は RTC_ERROR
+     *
+     * @else
+     *
+     * @brief Connect many ports at once
+     *
+     * This operation takes a list of connection specifications in the
+     * same format as manager.components.preconnect and makes all the
+     * connections.
+     *
+     * e.g. RTC0.port0?port=RTC0.port1&interface_type=corba_cdr&dataflow_type=pull
+     *
+     * Remote components (rtcname:// or rtcloc:// format) are resolved
+     * together and the ports of the components that refer to the same
+     * object are obtained only once. Connections that do not share a
+     * port are made in parallel.
+     *
+     * @param connectors List of the connection specifications
+     * @param failed List of the failed connection specifications
+     * @return RTC_OK if all succeeded, otherwise RTC_ERROR
+     *
+     * @endif
+     */
+    ReturnCode_t connectPorts(const coil::vstring& connectors,
+                              coil::vstring& failed);
+
 
     void
     addManagerActionListener(RTM::ManagerActionListener* listener,
@@ -1262,6 +1305,22 @@ namespace RTC
      * @endif
      */
     NamingManager* getNaming();
+
+    /*!
+     * @if jp
+     * @brief 起動処理のプロファイラを取得する
+     *
+     * @return StartupProfiler
+     *
+     * @else
+     *
+     * @brief Getting the profiler of the startup
+     *
+     * @return StartupProfiler
+     *
+     * @endif
+     */
+    StartupProfiler& getStartupProfiler() { return m_startupProfiler; }
     
     //============================================================
     // Protected functions
@@ -1820,6 +1879,50 @@ namespace RTC
      * @endif
      */
     void initPreCreation();
+    /*!
+     * @if jp
+     * @brief タスクを並列に実行する
+     *
+     * manager.components.startup_threads で指定された数のスレッドで
+     * tasks を実行し、すべての完了を待つ。スレッド数が1以下の場合は呼び
+     * 出しスレッドで順に実行する。複数のスレッドの場合、タスク間の依存
+     * 関係は考慮されず、実行順序は保証されない。
+     *
+     * @param tasks 実行するタスクのリスト
+     *
+     * @else
+     * @brief Run tasks in parallel
+     *
+     * The tasks are run by the number of threads specified by
+     * manager.components.startup_threads and this function waits for all
+     * of them. If the number of threads is 1 or less, the tasks are run in
+     * order on the calling thread. With more threads, dependencies among
+     * the tasks are not considered and their order is not guaranteed.
+     *
+     * @param tasks The list of tasks to be run
+     *
+     * @endif
+     */
+    void invokeParallel(const std::vector<std::function<void(void)>>& tasks);
+    /*!
+     * @if jp
+     * @brief 起動処理のプロファイルを出力する
+     *
+     * manager.startup_profile.enable が YES の場合、記録されたイベント
+     * を manager.startup_profile.file_name に
+     * manager.startup_profile.format の形式で出力する。以降の記録は行
+     * われない。
+     *
+     * @else
+     * @brief Write the profile of the startup
+     *
+     * If manager.startup_profile.enable is YES, the recorded events are
+     * written to manager.startup_profile.file_name in the format of
+     * manager.startup_profile.format. Recording is stopped afterwards.
+     *
+     * @endif
+     */
+    void saveStartupProfile();
     /*!
      * @if jp
      * @brief 
@@ -2218,6 +2321,15 @@ namespace RTC
      */
     bool m_needsTimer{false};
 
+    /*!
+     * @if jp
+     * @brief 起動処理のプロファイラ
+     * @else
+     * @brief Profiler of the startup
+     * @endif
+     */
+    StartupProfiler m_startupProfiler;
+
     //------------------------------------------------------------
     // Logger
     //------------------------------------------------------------
@@ -2258,6 +2370,7 @@ namespace RTC
       explicit InstanceName(const char* name);
       explicit InstanceName(std::string  name);
       bool operator()(RTObject_impl* comp);
+      const std::string& key() const { return m_name; }
       std::string m_name;
     };
 
@@ -2273,6 +2386,15 @@ namespace RTC
      */
     ComponentManager m_compManager;
 
+    /*!
+     * @if jp
+     * @brief コンポーネント生成の排他制御用 mutex
+     * @else
+     * @brief The mutex to serialize the creation of components
+     * @endif
+     */
+    std::recursive_mutex m_createMutex;
+
     //============================================================
     // コンポーネントファクトリ
     //============================================================
@@ -2386,6 +2508,7 @@ namespace RTC
       {
         return m_name == factory->name();
       }
+      const std::string& key() const { return m_name; }
       std::string m_name;
     };
     using ECFactoryManager = ObjectManager<const char*, ECFactoryBase,
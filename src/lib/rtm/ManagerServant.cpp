@@ -16,6 +16,7 @@
  * $Id$
  *
  */
+#include <coil/OS.h>
 #include <coil/Process.h>
 #include <coil/Properties.h>
 #include <coil/stringutil.h>
@@ -26,6 +27,11 @@
 #include <rtm/CORBA_SeqUtil.h>
 #include <rtm/CORBA_IORUtil.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <string>
 
@@ -40,6 +46,29 @@ namespace RTM
     rtclog.setName("ManagerServant");
     coil::Properties config(m_mgr.getConfig());    
 
+    std::chrono::milliseconds duration;
+    if (coil::stringTo(duration, config["manager.slave_query.timeout"].c_str())
+        && duration > std::chrono::milliseconds::zero())
+      {
+        m_slaveTimeout = duration;
+      }
+    if (coil::stringTo(duration, config["manager.slave_query.cache_ttl"].c_str())
+        && duration >= std::chrono::milliseconds::zero())
+      {
+        m_slaveCacheTtl = duration;
+      }
+    size_t threads(0);
+    if (coil::stringTo(threads, config["manager.slave_query.threads"].c_str())
+        && threads > 0)
+      {
+        m_queryThreadMax = threads;
+      }
+    if (coil::stringTo(duration, config["manager.slave_launch.timeout"].c_str())
+        && duration > std::chrono::milliseconds::zero())
+      {
+        m_launchTimeout = duration;
+      }
+
     if (!createINSManager())
       {
         RTC_WARN(("Manager CORBA servant creation failed."));
@@ -51,6 +80,21 @@ namespace RTM
       { // this is master manager
         RTC_TRACE(("This manager is master."));
         m_isMaster = true;
+        for (auto & lang : coil::split(config["manager.supported_languages"], ","))
+          {
+            size_t size(0);
+            std::string key("manager.modules." + lang + ".slave_pool_size");
+            if (coil::stringTo(size, config[key].c_str()) && size > 0)
+              {
+                RTC_INFO(("Slave manager pool (%s): %d", lang.c_str(),
+                          static_cast<int>(size)));
+                m_slavePoolSize[lang] = size;
+              }
+          }
+        if (!m_slavePoolSize.empty())
+          {
+            m_poolThread = std::thread([this]{ runSlavePool(); });
+          }
         RTC_INFO(("Master manager servant was successfully created."));
         return;
       }
@@ -84,6 +128,9 @@ namespace RTM
 
   ManagerServant::~ManagerServant()
   {
+    stopSlavePool();
+    stopSlaveQuery();
+
     std::lock_guard<std::mutex> guardm(m_masterMutex);
     for (CORBA::ULong i(0); i < m_masters.length(); ++i)
       {
@@ -367,6 +414,7 @@ namespace RTM
   {
     RTC_TRACE(("create_component(%s)", module_name));
     RTC_TRACE(("This manager is master: %s", m_isMaster ? "YES" : "NO"));
+    clearSlaveCache();
     std::string create_arg(module_name);
     if (create_arg.empty()) // invalid arg
       {
@@ -484,6 +532,7 @@ namespace RTM
   RTC::ReturnCode_t ManagerServant::delete_component(const char* instance_name)
   {
     RTC_TRACE(("delete_component(%s)", instance_name));
+    clearSlaveCache();
 
     RTC::RTObject_impl* comp = m_mgr.getComponent(instance_name);
     if (comp == nullptr)
@@ -529,32 +578,40 @@ namespace RTM
       }
 
     // get slaves' component references
-    std::lock_guard<std::mutex> guard(m_slaveMutex);
-    RTC_DEBUG(("%d slave managers exists.", m_slaves.length()));
-    for (int i(0), len(m_slaves.length()); i < len; ++i)
+    ::RTC::RTCList_var srtcs = new ::RTC::RTCList();
+    if (!m_slaveRtcs.get(srtcs.inout(), m_slaveCacheTtl))
       {
-        try
+        unsigned long generation(m_slaveRtcs.generation());
+        ::RTM::ManagerList slaves;
+        {
+          std::lock_guard<std::mutex> guard(m_slaveMutex);
+          slaves = m_slaves;
+        }
+        RTC_DEBUG(("%d slave managers exists.", slaves.length()));
+        std::shared_ptr<std::vector< ::RTC::RTCList_var> >
+          results(std::make_shared<std::vector< ::RTC::RTCList_var> >(
+                    slaves.length()));
+        std::vector<bool> done(callSlaves("get_components", slaves,
+          [results](RTM::Manager_ptr mgr, CORBA::ULong i)
           {
-            if (!CORBA::is_nil(m_slaves[i]))
-              {
-                ::RTC::RTCList_var srtcs;
-                srtcs = m_slaves[i]->get_components();
+            (*results)[i] = mgr->get_components();
+          }));
+        for (size_t i(0); i < done.size(); ++i)
+          {
+            if (!done[i]) { continue; }
 #ifndef ORB_IS_RTORB
-                CORBA_SeqUtil::push_back_list(crtcs.inout(), srtcs.in());
+            CORBA_SeqUtil::push_back_list(srtcs.inout(), (*results)[i].in());
 #else  // ORB_IS_RTORB
-                CORBA_SeqUtil::push_back_list(srtcs, crtcs);
+            CORBA_SeqUtil::push_back_list(srtcs, (*results)[i]);
 #endif  // ORB_IS_RTORB
-                continue;
-              }
-          }
-        catch (...)
-          {
-            RTC_INFO(("slave (%d) has disappeared.", i));
-            m_slaves[i] = RTM::Manager::_nil();
           }
-        CORBA_SeqUtil::erase(m_slaves, i); --i;
-        len = m_slaves.length();
+        m_slaveRtcs.set(srtcs.in(), generation);
       }
+#ifndef ORB_IS_RTORB
+    CORBA_SeqUtil::push_back_list(crtcs.inout(), srtcs.in());
+#else  // ORB_IS_RTORB
+    CORBA_SeqUtil::push_back_list(crtcs, srtcs);
+#endif  // ORB_IS_RTORB
     return crtcs._retn();
   }
 
@@ -584,32 +641,40 @@ namespace RTM
       }
 
     // copy slaves' component profiles
-    std::lock_guard<std::mutex> guard(m_slaveMutex);
-    RTC_DEBUG(("%d slave managers exists.", m_slaves.length()));
-    for (int i(0), len(m_slaves.length()); i < len; ++i)
+    ::RTC::ComponentProfileList_var sprofs = new ::RTC::ComponentProfileList();
+    if (!m_slaveProfiles.get(sprofs.inout(), m_slaveCacheTtl))
       {
-        try
+        unsigned long generation(m_slaveProfiles.generation());
+        ::RTM::ManagerList slaves;
+        {
+          std::lock_guard<std::mutex> guard(m_slaveMutex);
+          slaves = m_slaves;
+        }
+        RTC_DEBUG(("%d slave managers exists.", slaves.length()));
+        std::shared_ptr<std::vector< ::RTC::ComponentProfileList_var> >
+          results(std::make_shared<std::vector< ::RTC::ComponentProfileList_var> >(
+                    slaves.length()));
+        std::vector<bool> done(callSlaves("get_component_profiles", slaves,
+          [results](RTM::Manager_ptr mgr, CORBA::ULong i)
           {
-            if (!CORBA::is_nil(m_slaves[i]))
-              {
-                ::RTC::ComponentProfileList_var sprofs;
-                sprofs = m_slaves[i]->get_component_profiles();
+            (*results)[i] = mgr->get_component_profiles();
+          }));
+        for (size_t i(0); i < done.size(); ++i)
+          {
+            if (!done[i]) { continue; }
 #ifndef ORB_IS_RTORB
-                CORBA_SeqUtil::push_back_list(cprofs.inout(), sprofs.in());
+            CORBA_SeqUtil::push_back_list(sprofs.inout(), (*results)[i].in());
 #else  // ORB_IS_RTORB
-                CORBA_SeqUtil::push_back_list(cprofs, sprofs);
+            CORBA_SeqUtil::push_back_list(sprofs, (*results)[i]);
 #endif  // ORB_IS_RTORB
-                continue;
-              }
-          }
-        catch (...)
-          {
-            RTC_INFO(("slave (%d) has disappeared.", i));
-            m_slaves[i] = RTM::Manager::_nil();
           }
-        CORBA_SeqUtil::erase(m_slaves, i); --i;
-        len = m_slaves.length();
+        m_slaveProfiles.set(sprofs.in(), generation);
       }
+#ifndef ORB_IS_RTORB
+    CORBA_SeqUtil::push_back_list(cprofs.inout(), sprofs.in());
+#else  // ORB_IS_RTORB
+    CORBA_SeqUtil::push_back_list(cprofs, sprofs);
+#endif  // ORB_IS_RTORB
     return cprofs._retn();
   }
 
@@ -782,6 +847,9 @@ namespace RTM
       }
 
     CORBA_SeqUtil::push_back(m_slaves, RTM::Manager::_duplicate(mgr));
+    clearSlaveCache();
+    ++m_slaveGeneration;
+    m_slaveCond.notify_all();
     RTC_TRACE(("add_slave_manager() done, %d slaves", m_slaves.length()));
     return RTC::RTC_OK;
   }
@@ -807,6 +875,7 @@ namespace RTM
       }
 
     CORBA_SeqUtil::erase(m_slaves, index);
+    clearSlaveCache();
     RTC_TRACE(("remove_slave_manager() done, %d slaves", m_slaves.length()));
     return RTC::RTC_OK;
   }
@@ -949,6 +1018,35 @@ namespace RTM
     return ::CORBA::Object::_nil();
   }
 
+  /*!
+   * @if jp
+   * @brief 複数のポートを一括して接続する
+   * @else
+   * @brief Connect many ports at once
+   * @endif
+   */
+  RTM::ConnectionList*
+  ManagerServant::connect_ports(const RTM::ConnectionList& connections)
+  {
+    RTC_TRACE(("connect_ports(%d)", static_cast<int>(connections.length())));
+    coil::vstring connectors;
+    for (CORBA::ULong i(0); i < connections.length(); ++i)
+      {
+        connectors.emplace_back(static_cast<const char*>(connections[i]));
+      }
+
+    coil::vstring failed;
+    m_mgr.connectPorts(connectors, failed);
+
+    RTM::ConnectionList_var ret = new RTM::ConnectionList();
+    ret->length(static_cast<CORBA::ULong>(failed.size()));
+    for (CORBA::ULong i(0); i < ret->length(); ++i)
+      {
+        ret[i] = CORBA::string_dup(failed[i].c_str());
+      }
+    return ret._retn();
+  }
+
   //======================================================================
   // Local functions
   /*!
@@ -1204,109 +1302,15 @@ namespace RTM
     if (CORBA::is_nil(mgrobj))
       {
         RTC_INFO(("Manager: %s not found.", mgrstr.c_str()));
-        RTC_INFO(("Creating new manager named %s", mgrstr.c_str()));
-
-        std::string rtcd_cmd_key("manager.modules.");
-        rtcd_cmd_key += lang + ".manager_cmd";
-        coil::Properties& prop = m_mgr.getConfig();
-        std::string rtcd_cmd = prop[rtcd_cmd_key];
-
-        if (rtcd_cmd.empty())
-          {
-            RTC_WARN(("rtcd command name not found. Default rtcd is used"));
-            rtcd_cmd = "rtcd";
-          }
-
-        std::string lang_path_key("manager.modules.");
-        lang_path_key += lang + ".load_paths";
-        if (param.find("config_file") != param.end())
-          {
-            rtcd_cmd += " -f \"" + coil::escape(param["config_file"]) + "\"";
-          }
-        else if (prop.findNode("config_file"))
-          {
-            rtcd_cmd += " -f \"" + coil::escape(prop["config_file"]) + "\"";
-          }
-
-        rtcd_cmd += " -o \"manager.modules.load_path:" + coil::escape(prop["manager.modules.load_path"]) + "\"";
-        rtcd_cmd += " -o \"" + lang_path_key + ":" + coil::escape(prop[lang_path_key]) + "\"";
-        
-        rtcd_cmd += " -o \"manager.is_master:NO\"";
-        rtcd_cmd += " -o \"manager.corba_servant:YES\"";
-        rtcd_cmd += " -o \"corba.master_manager:" + prop["corba.master_manager"] + "\"";
-        rtcd_cmd += " -o \"manager.name:" + prop["manager.name"] + "\"";
-        rtcd_cmd += " -o \"manager.instance_name:" + mgrstr + "\"";
-        rtcd_cmd += " -o \"manager.shutdown_auto:NO\"";
-
-
-        coil::vstring slaves_names;
-        if (mgrstr == "manager_%p")
-          {
-            std::lock_guard<std::mutex> guard(m_slaveMutex);
-                        
-            for (CORBA::ULong i(0); i < m_slaves.length(); ++i)
-              {
-                try
-                  {
-                    RTM::NVList_var nvlist = m_slaves[i]->get_configuration();
-                    coil::Properties sleave_prop;
-                    NVUtil::copyToProperties(sleave_prop, nvlist);
-                    std::string name = sleave_prop["manager.instance_name"];
-                    if (isProcessIDManager(name))
-                      {
-                        slaves_names.emplace_back(std::move(name));
-                      }
-                  }
-                catch (...)
-                  {
-                     RTC_ERROR(("A slave manager thrown exception."));
-                     CORBA_SeqUtil::erase(m_slaves, i); --i;
-                     RTC_ERROR(("This slave manager is removed from slave list."));
-                   }
-               }
-          }
-
-        RTC_DEBUG(("Invoking command: %s.", rtcd_cmd.c_str()));
-        int ret(coil::launch_shell(rtcd_cmd));
-        if (ret == -1)
+        // an idle slave manager in the pool is used if available
+        if (mgrstr == "manager_%p" && param.find("config_file") == param.end())
           {
-            RTC_DEBUG(("%s: failed", rtcd_cmd.c_str()));
-            return RTC::RTObject::_nil();
+            mgrobj = takePooledSlave(lang);
           }
-
-        for (size_t i(0); i < 1000; ++i) // Timeout: 1000 x 10ms
+        if (CORBA::is_nil(mgrobj))
           {
-            RTC_DEBUG(("Detecting new slave manager (%s).", mgrstr.c_str()));
-            if (mgrstr == "manager_%p")
-              {
-                std::lock_guard<std::mutex> guard(m_slaveMutex);
-                for (CORBA::ULong j(0); j < m_slaves.length(); ++j)
-                  {
-                    RTM::NVList_var nvlist = m_slaves[j]->get_configuration();
-                    coil::Properties sleave_prop;
-                    NVUtil::copyToProperties(sleave_prop, nvlist);
-                    std::string name = sleave_prop["manager.instance_name"];
-
-                    if (isProcessIDManager(name))
-                      {
-                        if (std::count(slaves_names.begin(), slaves_names.end(), name) == 0)
-                          {
-                            mgrobj = m_slaves[j];
-                          }
-                      }
-                  }
-              }
-            else
-              {
-                mgrobj = findManagerByName(mgrstr);
-              }
-            if (!CORBA::is_nil(mgrobj))
-              {
-                RTC_INFO(("New slave manager (%s) launched.", mgrstr.c_str()));
-                break;
-              }
-            RTC_DEBUG(("Waiting for slave manager started."));
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            RTC_INFO(("Creating new manager named %s", mgrstr.c_str()));
+            mgrobj = launchSlaveManager(lang, mgrstr, param);
           }
       }
 
@@ -1413,7 +1417,12 @@ namespace RTM
             return RTC::RTObject::_nil();
           }
 
-        for (size_t i(0); i < 1000; ++i) // Timeout: 1000 x 10ms
+        // the launched manager is a master which never registers to this
+        // manager, so it is polled with an increasing interval
+        std::chrono::steady_clock::time_point
+          deadline(std::chrono::steady_clock::now() + m_launchTimeout);
+        std::chrono::milliseconds interval(1);
+        while (std::chrono::steady_clock::now() < deadline)
           {
             RTC_DEBUG(("Detecting new slave manager (%s).", mgrstr.c_str()));
             mgrobj = findManagerByName(mgrstr);
@@ -1423,7 +1432,8 @@ namespace RTM
                 break;
               }
             RTC_DEBUG(("Waiting for slave manager started."));
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            std::this_thread::sleep_for(interval);
+            interval = std::min(interval * 2, std::chrono::milliseconds(100));
           }
 
         if (CORBA::is_nil(mgrobj))
@@ -1532,6 +1542,427 @@ namespace RTM
       return false;
     }
 
+  /*!
+   * @if jp
+   * @brief スレーブマネージャを起動する
+   * @else
+   * @brief Launch a slave manager
+   * @endif
+   */
+  RTM::Manager_ptr
+  ManagerServant::launchSlaveManager(const std::string& lang,
+                                     const std::string& mgrstr,
+                                     coil::mapstring& param)
+  {
+    RTC_TRACE(("launchSlaveManager(%s, %s)", lang.c_str(), mgrstr.c_str()));
+    std::string rtcd_cmd_key("manager.modules.");
+    rtcd_cmd_key += lang + ".manager_cmd";
+    coil::Properties& prop = m_mgr.getConfig();
+    std::string rtcd_cmd = prop[rtcd_cmd_key];
+
+    if (rtcd_cmd.empty())
+      {
+        RTC_WARN(("rtcd command name not found. Default rtcd is used"));
+        rtcd_cmd = "rtcd";
+      }
+
+    std::string lang_path_key("manager.modules.");
+    lang_path_key += lang + ".load_paths";
+    if (param.find("config_file") != param.end())
+      {
+        rtcd_cmd += " -f \"" + coil::escape(param["config_file"]) + "\"";
+      }
+    else if (prop.findNode("config_file"))
+      {
+        rtcd_cmd += " -f \"" + coil::escape(prop["config_file"]) + "\"";
+      }
+
+    rtcd_cmd += " -o \"manager.modules.load_path:" + coil::escape(prop["manager.modules.load_path"]) + "\"";
+    rtcd_cmd += " -o \"" + lang_path_key + ":" + coil::escape(prop[lang_path_key]) + "\"";
+
+    rtcd_cmd += " -o \"manager.is_master:NO\"";
+    rtcd_cmd += " -o \"manager.corba_servant:YES\"";
+    rtcd_cmd += " -o \"corba.master_manager:" + prop["corba.master_manager"] + "\"";
+    rtcd_cmd += " -o \"manager.name:" + prop["manager.name"] + "\"";
+    rtcd_cmd += " -o \"manager.instance_name:" + mgrstr + "\"";
+    rtcd_cmd += " -o \"manager.shutdown_auto:NO\"";
+
+    // the launched manager is identified by this token in its configuration
+    std::string token(coil::otos(coil::getpid()) + "_" +
+                      coil::otos(++m_launchCount));
+    rtcd_cmd += " -o \"manager.launch_token:" + token + "\"";
+
+    ::RTM::ManagerList known;
+    unsigned long generation;
+    {
+      std::lock_guard<std::mutex> guard(m_slaveMutex);
+      known = m_slaves;
+      generation = m_slaveGeneration;
+    }
+
+    RTC_DEBUG(("Invoking command: %s.", rtcd_cmd.c_str()));
+    int ret(coil::launch_shell(rtcd_cmd));
+    if (ret == -1)
+      {
+        RTC_DEBUG(("%s: failed", rtcd_cmd.c_str()));
+        return RTM::Manager::_nil();
+      }
+
+    // the new manager calls add_slave_manager() when it has started
+    std::chrono::steady_clock::time_point
+      deadline(std::chrono::steady_clock::now() + m_launchTimeout);
+    while (!m_terminating)
+      {
+        ::RTM::ManagerList slaves;
+        {
+          std::unique_lock<std::mutex> guard(m_slaveMutex);
+          if (!m_slaveCond.wait_until(guard, deadline, [&]{
+                return m_slaveGeneration != generation || m_terminating; }))
+            {
+              break;
+            }
+          generation = m_slaveGeneration;
+          slaves = m_slaves;
+        }
+        RTC_DEBUG(("Detecting new slave manager (%s).", mgrstr.c_str()));
+        for (CORBA::ULong i(0); i < slaves.length(); ++i)
+          {
+            if (CORBA::is_nil(slaves[i]) ||
+                !(CORBA_SeqUtil::find(known, is_equiv(slaves[i])) < 0))
+              {
+                continue;
+              }
+            CORBA_SeqUtil::push_back(known, RTM::Manager::_duplicate(slaves[i]));
+            try
+              {
+                RTM::NVList_var nvlist = slaves[i]->get_configuration();
+                if (NVUtil::isStringValue(nvlist.in(), "manager.launch_token",
+                                          token.c_str()))
+                  {
+                    RTC_INFO(("New slave manager (%s) launched.",
+                              mgrstr.c_str()));
+                    return RTM::Manager::_duplicate(slaves[i]);
+                  }
+              }
+            catch (...)
+              {
+                RTC_DEBUG(("A slave manager thrown exception."));
+              }
+          }
+      }
+    return RTM::Manager::_nil();
+  }
+
+  /*!
+   * @if jp
+   * @brief 待機中のスレーブマネージャをプールから取り出す
+   * @else
+   * @brief Take an idle slave manager from the pool
+   * @endif
+   */
+  RTM::Manager_ptr ManagerServant::takePooledSlave(const std::string& lang)
+  {
+    std::lock_guard<std::mutex> guard(m_poolMutex);
+    auto it = m_slavePool.find(lang);
+    if (it == m_slavePool.end()) { return RTM::Manager::_nil(); }
+
+    while (!it->second.empty())
+      {
+        RTM::Manager_var mgr = it->second.front();
+        it->second.erase(it->second.begin());
+        m_poolCond.notify_all();
+        try
+          {
+            if (!mgr->_non_existent())
+              {
+                RTC_INFO(("Idle slave manager (%s) taken from the pool.",
+                          lang.c_str()));
+                return mgr._retn();
+              }
+          }
+        catch (...)
+          {
+          }
+        RTC_WARN(("An idle slave manager in the pool has disappeared."));
+      }
+    return RTM::Manager::_nil();
+  }
+
+  /*!
+   * @if jp
+   * @brief スレーブマネージャのプールを補充するスレッドの処理
+   * @else
+   * @brief Body of the thread filling the slave manager pool
+   * @endif
+   */
+  void ManagerServant::runSlavePool()
+  {
+    std::unique_lock<std::mutex> guard(m_poolMutex);
+    while (!m_terminating)
+      {
+        std::string lang;
+        for (auto & size : m_slavePoolSize)
+          {
+            if (m_slavePool[size.first].size() < size.second)
+              {
+                lang = size.first;
+                break;
+              }
+          }
+        if (lang.empty())
+          {
+            m_poolCond.wait(guard);
+            continue;
+          }
+
+        guard.unlock();
+        coil::mapstring param;
+        RTM::Manager_var mgr = launchSlaveManager(lang, "manager_%p", param);
+        guard.lock();
+
+        if (CORBA::is_nil(mgr))
+          {
+            RTC_WARN(("Launching a pooled slave manager (%s) failed.",
+                      lang.c_str()));
+            // retry later rather than launching processes continuously
+            m_poolCond.wait_for(guard, m_launchTimeout);
+            continue;
+          }
+        m_slavePool[lang].emplace_back(mgr);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief スレーブマネージャのプールを停止し、待機中のマネージャを終了する
+   * @else
+   * @brief Stop the slave manager pool and shut down the idle managers
+   * @endif
+   */
+  void ManagerServant::stopSlavePool()
+  {
+    m_terminating = true;
+    {
+      std::lock_guard<std::mutex> guard(m_slaveMutex);
+      m_slaveCond.notify_all();
+    }
+    std::map<std::string, std::vector<RTM::Manager_var> > pool;
+    {
+      std::lock_guard<std::mutex> guard(m_poolMutex);
+      m_poolCond.notify_all();
+    }
+    if (m_poolThread.joinable())
+      {
+        m_poolThread.join();
+      }
+    {
+      std::lock_guard<std::mutex> guard(m_poolMutex);
+      pool.swap(m_slavePool);
+    }
+    for (auto & mgrs : pool)
+      {
+        for (auto & mgr : mgrs.second)
+          {
+            try
+              {
+                mgr->shutdown();
+              }
+            catch (...)
+              {
+              }
+          }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 全スレーブマネージャのオペレーションを並列に呼び出す
+   * @else
+   * @brief Call an operation of all the slave managers concurrently
+   * @endif
+   */
+  std::vector<bool>
+  ManagerServant::callSlaves(const char* op, ::RTM::ManagerList& slaves,
+                             std::function<void(RTM::Manager_ptr, CORBA::ULong)> call)
+  {
+    // the state is shared with the calls which outlive the deadline
+    struct CallState
+    {
+      std::mutex mutex;
+      std::condition_variable cond;
+      std::vector<int> status;  // 0: running, 1: succeeded, 2: failed
+      CORBA::ULong remaining;
+    };
+    CORBA::ULong len(slaves.length());
+    std::shared_ptr<CallState> state(std::make_shared<CallState>());
+    state->status.assign(len, 0);
+    state->remaining = len;
+    std::chrono::steady_clock::time_point
+      deadline(std::chrono::steady_clock::now() + m_slaveTimeout);
+
+    {
+      std::lock_guard<std::mutex> guard(m_queryMutex);
+      if (m_queryStop) { return std::vector<bool>(len, false); }
+      for (CORBA::ULong i(0); i < len; ++i)
+        {
+          RTM::Manager_var mgr(RTM::Manager::_duplicate(slaves[i]));
+          m_queryTasks.emplace_back([state, call, mgr, i, deadline]()
+            {
+              std::chrono::steady_clock::time_point
+                now(std::chrono::steady_clock::now());
+              if (now >= deadline) { return; }
+#ifdef ORB_IS_OMNIORB
+              omniORB::setClientThreadCallTimeout(static_cast<CORBA::ULong>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                  deadline - now).count() + 1));
+#endif  // ORB_IS_OMNIORB
+              int status(2);
+              try
+                {
+                  if (!CORBA::is_nil(mgr))
+                    {
+                      call(mgr.in(), i);
+                      status = 1;
+                    }
+                }
+              catch (...)
+                {
+                  // a call timed out is not a disappeared slave
+                  if (std::chrono::steady_clock::now() >= deadline)
+                    {
+                      status = 0;
+                    }
+                }
+              std::lock_guard<std::mutex> guard(state->mutex);
+              state->status[i] = status;
+              --state->remaining;
+              state->cond.notify_all();
+            });
+        }
+      while (m_queryIdle < m_queryTasks.size() &&
+             m_queryThreads.size() < m_queryThreadMax)
+        {
+          ++m_queryIdle;
+          m_queryThreads.emplace_back([this]{ runSlaveQuery(); });
+        }
+      m_queryCond.notify_all();
+    }
+
+    std::vector<bool> done(len, false);
+    std::vector<CORBA::ULong> failed;
+    {
+      std::unique_lock<std::mutex> guard(state->mutex);
+      state->cond.wait_until(guard, deadline,
+                             [&state]{ return state->remaining == 0; });
+      for (CORBA::ULong i(0); i < len; ++i)
+        {
+          if (state->status[i] == 1)
+            {
+              done[i] = true;
+            }
+          else if (state->status[i] == 2)
+            {
+              failed.emplace_back(i);
+            }
+          else
+            {
+              RTC_WARN(("%s: slave (%d) did not respond in time.", op, i));
+            }
+        }
+    }
+    if (failed.empty()) { return done; }
+
+    std::lock_guard<std::mutex> guard(m_slaveMutex);
+    for (auto & i : failed)
+      {
+        RTC_INFO(("slave (%d) has disappeared.", i));
+      }
+    for (CORBA::ULong j(0); j < m_slaves.length();)
+      {
+        bool remove(CORBA::is_nil(m_slaves[j]));
+        for (auto & i : failed)
+          {
+            if (remove) { break; }
+            try
+              {
+                remove = !CORBA::is_nil(slaves[i]) &&
+                  slaves[i]->_is_equivalent(m_slaves[j]);
+              }
+            catch (...)
+              {
+              }
+          }
+        if (remove)
+          {
+            CORBA_SeqUtil::erase(m_slaves, j);
+            continue;
+          }
+        ++j;
+      }
+    return done;
+  }
+
+  /*!
+   * @if jp
+   * @brief スレーブへの問い合わせを行うワーカスレッドの処理
+   * @else
+   * @brief Body of the worker threads querying the slaves
+   * @endif
+   */
+  void ManagerServant::runSlaveQuery()
+  {
+    std::unique_lock<std::mutex> guard(m_queryMutex);
+    for (;;)
+      {
+        m_queryCond.wait(guard, [this]
+          { return m_queryStop || !m_queryTasks.empty(); });
+        if (m_queryStop) { return; }
+        std::function<void()> task(std::move(m_queryTasks.front()));
+        m_queryTasks.pop_front();
+        --m_queryIdle;
+        guard.unlock();
+        task();
+        guard.lock();
+        ++m_queryIdle;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief スレーブへの問い合わせを行うワーカスレッドを停止する
+   * @else
+   * @brief Stop the worker threads querying the slaves
+   * @endif
+   */
+  void ManagerServant::stopSlaveQuery()
+  {
+    std::vector<std::thread> threads;
+    {
+      std::lock_guard<std::mutex> guard(m_queryMutex);
+      m_queryStop = true;
+      m_queryTasks.clear();
+      threads.swap(m_queryThreads);
+      m_queryCond.notify_all();
+    }
+    for (auto & thread : threads)
+      {
+        thread.join();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief スレーブへの問い合わせ結果のキャッシュを破棄する
+   * @else
+   * @brief Clear the cache of the results of the slave queries
+   * @endif
+   */
+  void ManagerServant::clearSlaveCache()
+  {
+    m_slaveRtcs.clear();
+    m_slaveProfiles.clear();
+  }
+
   const char* CompParam::prof_list[prof_list_size] = { "RTC", "vendor", "category", "implementation_id", "language", "version" };
 
   CompParam::CompParam(std::string module_name)
@@ -20,7 +20,15 @@
 #ifndef RTM_MANAGERSERVANT_H
 #define RTM_MANAGERSERVANT_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
 #include <mutex>
+#include <thread>
+#include <vector>
 #include <rtm/idl/ManagerSkel.h>
 #include <rtm/Manager.h>
 #include <rtm/SystemLogger.h>
@@ -557,6 +565,28 @@ namespace RTM
      */
     CORBA::Object_ptr get_service(const char* name) override;
 
+    /*!
+     * @if jp
+     * @brief 複数のポートを一括して接続する
+     *
+     * Manager::connectPorts() を呼び出す。
+     *
+     * @param connections 接続指定のリスト
+     * @return 失敗した接続指定のリスト
+     *
+     * @else
+     * @brief Connect many ports at once
+     *
+     * This operation calls Manager::connectPorts().
+     *
+     * @param connections List of the connection specifications
+     * @return List of the failed specifications
+     *
+     * @endif
+     */
+    RTM::ConnectionList*
+    connect_ports(const RTM::ConnectionList& connections) override;
+
     /*!
      * @if jp
      * @brief Managerのリファレンスを取得する。
@@ -733,6 +763,212 @@ namespace RTM
     static bool isProcessIDManager(const std::string& mgrname);
 
   private:
+    /*!
+     * @if jp
+     *
+     * @brief 全スレーブマネージャのオペレーションを並列に呼び出す
+     *
+     * スレーブマネージャのリストのコピーに対して、スレーブごとの呼び出
+     * しをワーカスレッドのプール (最大 manager.slave_query.threads 個)
+     * に積み、全ての呼び出しが終了するか manager.slave_query.timeout が
+     * 経過するまで待つ。期限内に例外を返したスレーブはリストから削除さ
+     * れる。期限内に終了しなかった呼び出しは結果を破棄され、期限までに
+     * 開始されなかった呼び出しは行われない。omniORB ではワーカスレッド
+     * のクライアント呼び出しのタイムアウトを期限に合わせるため、応答し
+     * ないスレーブがワーカを占有し続けることはない。call は結果をイン
+     * デックスに対応する共有領域に格納しなければならない。
+     *
+     * @param op オペレーション名 (ログ用)
+     * @param slaves スレーブマネージャのリスト
+     * @param call スレーブごとに呼び出される関数
+     *
+     * @return スレーブごとの呼び出しが期限内に成功したかどうか
+     *
+     * @else
+     *
+     * @brief Call an operation of all the slave managers concurrently
+     *
+     * The call for each slave of the given copy of the slave manager
+     * list is queued to the pool of worker threads (at most
+     * manager.slave_query.threads), and this function waits until all
+     * the calls return or manager.slave_query.timeout passes. Slaves
+     * which raised an exception within the deadline are removed from
+     * the list. Results of calls not finished within the deadline are
+     * discarded, and calls not started by the deadline are not made.
+     * With omniORB the client call timeout of the worker threads is set
+     * to the deadline, so that a slave not responding does not keep
+     * occupying a worker. call has to store its result in a shared
+     * storage at the given index.
+     *
+     * @param op Operation name (for logging)
+     * @param slaves Slave manager list
+     * @param call Function called for each slave
+     *
+     * @return Whether the call for each slave succeeded within the deadline
+     *
+     * @endif
+     */
+    std::vector<bool>
+    callSlaves(const char* op, ::RTM::ManagerList& slaves,
+               std::function<void(RTM::Manager_ptr, CORBA::ULong)> call);
+
+    /*!
+     * @if jp
+     * @brief スレーブへの問い合わせ結果のキャッシュを破棄する
+     * @else
+     * @brief Clear the cache of the results of the slave queries
+     * @endif
+     */
+    void clearSlaveCache();
+
+    /*!
+     * @if jp
+     *
+     * @brief スレーブマネージャを起動する
+     *
+     * manager_cmd でスレーブマネージャのプロセスを起動し、そのマネージャ
+     * が add_slave_manager() で登録されるまで待つ。起動したプロセスは
+     * コマンドラインで渡された manager.launch_token により識別される。
+     *
+     * @param lang 言語
+     * @param mgrstr マネージャのインスタンス名
+     * @param param create 引数のパラメータ
+     *
+     * @return 起動したマネージャ、失敗した場合は nil
+     *
+     * @else
+     *
+     * @brief Launch a slave manager
+     *
+     * This launches a slave manager process by manager_cmd and waits
+     * until the manager is registered by add_slave_manager(). The
+     * launched process is identified by manager.launch_token given on
+     * its command line.
+     *
+     * @param lang Language
+     * @param mgrstr Instance name of the manager
+     * @param param Parameters of the create argument
+     *
+     * @return The launched manager, or nil if failed
+     *
+     * @endif
+     */
+    RTM::Manager_ptr launchSlaveManager(const std::string& lang,
+                                        const std::string& mgrstr,
+                                        coil::mapstring& param);
+
+    /*!
+     * @if jp
+     * @brief 待機中のスレーブマネージャをプールから取り出す
+     *
+     * @param lang 言語
+     *
+     * @return 待機中のマネージャ、無い場合は nil
+     *
+     * @else
+     * @brief Take an idle slave manager from the pool
+     *
+     * @param lang Language
+     *
+     * @return An idle manager, or nil if the pool is empty
+     *
+     * @endif
+     */
+    RTM::Manager_ptr takePooledSlave(const std::string& lang);
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャのプールを補充するスレッドの処理
+     * @else
+     * @brief Body of the thread filling the slave manager pool
+     * @endif
+     */
+    void runSlavePool();
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャのプールを停止し、待機中のマネージャを終了する
+     * @else
+     * @brief Stop the slave manager pool and shut down the idle managers
+     * @endif
+     */
+    void stopSlavePool();
+
+    /*!
+     * @if jp
+     * @brief スレーブへの問い合わせを行うワーカスレッドの処理
+     * @else
+     * @brief Body of the worker threads querying the slaves
+     * @endif
+     */
+    void runSlaveQuery();
+
+    /*!
+     * @if jp
+     * @brief スレーブへの問い合わせを行うワーカスレッドを停止する
+     * @else
+     * @brief Stop the worker threads querying the slaves
+     * @endif
+     */
+    void stopSlaveQuery();
+
+    /*!
+     * @if jp
+     * @brief スレーブへの問い合わせ結果のキャッシュ
+     *
+     * clear() は世代を進める。問い合わせ前に generation() で取得した世
+     * 代が set() の時点で変わっていれば結果は格納されないため、問い合
+     * わせ中に破棄されたキャッシュが古い結果で埋め戻されることはない。
+     *
+     * @else
+     * @brief Cache of the result of a slave query
+     *
+     * clear() advances the generation. A result is not stored by set()
+     * if the generation taken by generation() before the query has
+     * changed, so that a cache cleared during the query is not refilled
+     * with the stale result.
+     *
+     * @endif
+     */
+    template <class Seq>
+    class SlaveResultCache
+    {
+    public:
+      bool get(Seq& seq, std::chrono::steady_clock::duration ttl)
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (!m_valid ||
+            std::chrono::steady_clock::now() - m_time > ttl) { return false; }
+        seq = m_seq;
+        return true;
+      }
+      unsigned long generation()
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        return m_generation;
+      }
+      void set(const Seq& seq, unsigned long generation)
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (generation != m_generation) { return; }
+        m_seq = seq;
+        m_time = std::chrono::steady_clock::now();
+        m_valid = true;
+      }
+      void clear()
+      {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_valid = false;
+        ++m_generation;
+      }
+    private:
+      std::mutex m_mutex;
+      Seq m_seq;
+      std::chrono::steady_clock::time_point m_time;
+      bool m_valid{false};
+      unsigned long m_generation{0};
+    };
+
     /*!
      * @if jp
      * @brief ロガーオブジェクト
@@ -805,6 +1041,92 @@ namespace RTM
      */
     CORBA::Boolean m_isMaster{false};
 
+    /*!
+     * @if jp
+     * @brief スレーブへの問い合わせの期限
+     * @else
+     * @brief Deadline of the slave queries
+     * @endif
+     */
+    std::chrono::milliseconds m_slaveTimeout{std::chrono::seconds(3)};
+
+    /*!
+     * @if jp
+     * @brief スレーブへの問い合わせ結果のキャッシュの有効期間
+     * @else
+     * @brief Time to live of the cache of the slave queries
+     * @endif
+     */
+    std::chrono::milliseconds m_slaveCacheTtl{std::chrono::seconds(1)};
+
+    SlaveResultCache< ::RTC::RTCList> m_slaveRtcs;
+    SlaveResultCache< ::RTC::ComponentProfileList> m_slaveProfiles;
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャの登録を通知する条件変数
+     *
+     * m_slaveMutex とともに使用し、add_slave_manager() で
+     * m_slaveGeneration を更新して通知する。
+     *
+     * @else
+     * @brief Condition variable notifying registration of slave managers
+     *
+     * This is used with m_slaveMutex, and add_slave_manager() notifies
+     * it after updating m_slaveGeneration.
+     *
+     * @endif
+     */
+    std::condition_variable m_slaveCond;
+    unsigned long m_slaveGeneration{0};
+
+    /*!
+     * @if jp
+     * @brief スレーブマネージャの起動の期限
+     * @else
+     * @brief Deadline of launching a slave manager
+     * @endif
+     */
+    std::chrono::milliseconds m_launchTimeout{std::chrono::seconds(10)};
+    std::atomic<unsigned long> m_launchCount{0};
+    std::atomic<bool> m_terminating{false};
+
+    /*!
+     * @if jp
+     * @brief 言語ごとの待機中のスレーブマネージャのプール
+     * @else
+     * @brief Pool of idle slave managers for each language
+     * @endif
+     */
+    std::map<std::string, std::vector<RTM::Manager_var> > m_slavePool;
+    std::map<std::string, size_t> m_slavePoolSize;
+    std::mutex m_poolMutex;
+    std::condition_variable m_poolCond;
+    std::thread m_poolThread;
+
+    /*!
+     * @if jp
+     * @brief スレーブへの問い合わせを行うワーカスレッドのプール
+     *
+     * スレッドは manager.slave_query.threads 個まで必要に応じて生成さ
+     * れ、デストラクタで join される。
+     *
+     * @else
+     * @brief Pool of the worker threads querying the slaves
+     *
+     * Up to manager.slave_query.threads threads are created on demand,
+     * and they are joined in the destructor.
+     *
+     * @endif
+     */
+    std::vector<std::thread> m_queryThreads;
+    std::deque<std::function<void()> > m_queryTasks;
+    size_t m_queryThreadMax{4};
+    size_t m_queryIdle{0};
+    bool m_queryStop{false};
+    std::mutex m_queryMutex;
+    std::condition_variable m_queryCond;
+
     /*!
      * @if jp
      * @brief Manager_var が等価かどうかのファンクタ
@@ -20,6 +20,7 @@
 #include <rtm/RTC.h>
 
 #include <coil/File.h>
+#include <coil/OS.h>
 #include <coil/Process.h>
 
 // RTC includes
@@ -27,6 +28,11 @@
 #include <rtm/ModuleManager.h>
 #include <coil/stringutil.h>
 
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+
 #ifdef __QNX__
 using std::FILE;
 using std::fgets;
@@ -44,7 +50,8 @@ namespace RTC
    * @endif
    */
   ModuleManager::ModuleManager(coil::Properties& prop)
-    : rtclog("ModuleManager"), m_properties(prop)
+    : rtclog("ModuleManager"), m_properties(prop),
+      m_indexLoaded(false), m_indexDirty(false)
   {
     for (auto path : coil::split(prop[CONFIG_PATH], ","))
     {
@@ -58,6 +65,9 @@ namespace RTC
     m_downloadAllowed = coil::toBool(prop[ALLOW_URL], "yes", "no", false);
     m_initFuncSuffix  = prop[INITFUNC_SFX];
     m_initFuncPrefix  = prop[INITFUNC_PFX];
+    m_indexEnabled = coil::toBool(prop[MOD_INDEX_ENABLE], "YES", "NO", false);
+    m_indexFile = coil::replaceEnv(prop[MOD_INDEX_FILE]);
+    if (m_indexFile.empty()) { m_indexEnabled = false; }
 
     if (coil::toBool(prop["manager.is_master"], "YES", "NO", false))
     {
@@ -162,7 +172,12 @@ namespace RTC
 
     DLLEntity *dll(new DLLEntity());
 
-    int retval = dll->dll.open(file_path.c_str());
+    int retval;
+    {
+      StartupProfiler::Scope scope(Manager::instance().getStartupProfiler(),
+                                   "dlopen " + file_path, "module");
+      retval = dll->dll.open(file_path.c_str());
+    }
     if (retval != 0)
     {
       RTC_ERROR(("Module file %s load failed: %s",
@@ -203,8 +218,13 @@ namespace RTC
         throw InvalidOperation("Invalid file name");
       }
 
+    StartupProfiler& profiler(Manager::instance().getStartupProfiler());
     void (*initfptr)(Manager *);
-    *reinterpret_cast<void **>(&initfptr) = this->symbol(name, init_func);
+    {
+      StartupProfiler::Scope scope(profiler, "symbol " + init_func, "module");
+      *reinterpret_cast<void **>(&initfptr) = this->symbol(name, init_func);
+    }
+    StartupProfiler::Scope scope(profiler, "init " + init_func, "module");
     (*initfptr)(&(Manager::instance()));
 
     return name;
@@ -229,8 +249,13 @@ namespace RTC
       throw InvalidOperation("Invalid file name");
     }
 
+    StartupProfiler& profiler(Manager::instance().getStartupProfiler());
     void(*initfptr)(Manager *);
-    *reinterpret_cast<void **>(&initfptr) = this->symbol(name, init_func);
+    {
+      StartupProfiler::Scope scope(profiler, "symbol " + init_func, "module");
+      *reinterpret_cast<void **>(&initfptr) = this->symbol(name, init_func);
+    }
+    StartupProfiler::Scope scope(profiler, "init " + init_func, "module");
     (*initfptr)(&(Manager::instance()));
 
     return name;
@@ -377,6 +402,11 @@ namespace RTC
   std::vector<coil::Properties> ModuleManager::getLoadableModules()
   {
     RTC_TRACE(("getLoadableModules()"));
+    std::lock_guard<std::mutex> guard(m_modprofMutex);
+    if (m_indexEnabled && !m_indexLoaded)
+      {
+        loadModuleIndex();
+      }
 
     // getting loadable module file path list.
     coil::Properties& gprop(Manager::instance().getConfig());
@@ -405,6 +435,10 @@ namespace RTC
     removeInvalidModules();
     RTC_DEBUG(("Modile profile size: %d (invalid mod-profiles deleted)",
                m_modprofs.size()));
+    if (m_indexDirty)
+      {
+        saveModuleIndex();
+      }
     return m_modprofs;
   }
 
@@ -548,7 +582,7 @@ namespace RTC
         for (auto & suffixe : suffixes)
           {
             coil::vstring tmp;
-            coil::getFileList(path, suffixe, tmp);
+            scanModuleFiles(path, suffixe, tmp);
             RTC_DEBUG(("File list (path:%s, ext:%s): %s", path.c_str(),
                        suffixe.c_str(), coil::flatten(tmp).c_str()));
             flist.insert(flist.end(),
@@ -577,21 +611,37 @@ namespace RTC
   void ModuleManager::addNewFile(const std::string& fpath,
                                  coil::vstring& modules, const std::string& lang)
   {
-    for (auto & modprof : m_modprofs)
+    for (auto it = m_modprofs.begin(); it != m_modprofs.end(); ++it)
       {
                   
-        if (modprof["module_file_path"] == fpath)
+        if ((*it)["module_file_path"] == fpath)
           {
-
+            // a module file updated after profiling has to be profiled again
+            auto idx = m_moduleIndex.find(fpath);
+            if (m_indexEnabled && idx != m_moduleIndex.end() &&
+                idx->second.mtime != coil::getModifiedTime(fpath))
+              {
+                RTC_DEBUG(("Module %s has been modified.", fpath.c_str()));
+                m_modprofs.erase(it);
+                break;
+              }
             RTC_DEBUG(("Module %s already exists in cache.",
                        fpath.c_str()));
             return;
           }
       }
-    for (auto & loadfailmod : m_loadfailmods[lang])
+    coil::vstring& loadfailmods(m_loadfailmods[lang]);
+    for (auto it = loadfailmods.begin(); it != loadfailmods.end(); ++it)
       {
-        if (loadfailmod == fpath)
+        if (*it == fpath)
           {
+            auto idx = m_moduleIndex.find(fpath);
+            if (m_indexEnabled && idx != m_moduleIndex.end() &&
+                idx->second.mtime != coil::getModifiedTime(fpath))
+              {
+                loadfailmods.erase(it);
+                break;
+              }
             return;
           }
       }
@@ -616,6 +666,31 @@ namespace RTC
 
     for (const auto & module : modules)
       {
+        // the module index holds the profile of unmodified module files
+        long long mtime(coil::getModifiedTime(module));
+        if (m_indexEnabled)
+          {
+            auto idx = m_moduleIndex.find(module);
+            if (idx != m_moduleIndex.end() && idx->second.mtime == mtime &&
+                idx->second.stamp > mtime && idx->second.language == lang)
+              {
+                RTC_DEBUG(("Module %s found in the module index.",
+                           module.c_str()));
+                if (!idx->second.loadable)
+                  {
+                    m_loadfailmods[lang].emplace_back(module);
+                    continue;
+                  }
+                modprops.emplace_back(idx->second.profile);
+                continue;
+              }
+          }
+        ModuleIndexEntry entry;
+        entry.mtime = mtime;
+        entry.stamp = static_cast<long long>(std::time(nullptr));
+        entry.language = lang;
+        entry.init_func = getInitFuncName(module);
+
         std::string cmd(lprop["profile_cmd"]);
         cmd += " \"" + module + "\"";
 
@@ -641,14 +716,216 @@ namespace RTC
         if (props["implementation_id"].empty())
           {
             m_loadfailmods[lang].emplace_back(module);
+            if (m_indexEnabled)
+              {
+                m_moduleIndex[module] = std::move(entry);
+                m_indexDirty = true;
+              }
             continue;
           }
         props["module_file_name"] = coil::basename(module.c_str());
         props["module_file_path"] = module;
         props["language"] = lang;
+        if (m_indexEnabled)
+          {
+            entry.loadable = true;
+            entry.profile = props;
+            m_moduleIndex[module] = std::move(entry);
+            m_indexDirty = true;
+          }
         modprops.emplace_back(std::move(props));
       }
 #endif
   }
 
+  /*!
+   * @if jp
+   * @brief ディレクトリ以下の指定拡張子のファイルリストを取得する
+   * @else
+   * @brief Getting file list with the given suffix under the directory
+   * @endif
+   */
+  void ModuleManager::scanModuleFiles(const std::string& path,
+                                      const std::string& suffix,
+                                      coil::vstring& flist)
+  {
+    if (!m_indexEnabled)
+      {
+        coil::getFileList(path, suffix, flist);
+        return;
+      }
+
+    std::string key(suffix + ":" + path);
+    auto idx = m_dirIndex.find(key);
+    if (idx != m_dirIndex.end())
+      {
+        const DirIndexEntry& entry(idx->second);
+        bool valid(entry.dirs.size() == entry.mtimes.size());
+        for (size_t i(0); valid && i < entry.dirs.size(); ++i)
+          {
+            // mtime has a resolution of seconds, a directory updated in
+            // the same second as the scan might have been listed partially
+            valid = entry.mtimes[i] < entry.stamp &&
+              coil::getModifiedTime(entry.dirs[i]) == entry.mtimes[i];
+          }
+        if (valid)
+          {
+            RTC_DEBUG(("File list (path:%s, ext:%s) found in the module index.",
+                       path.c_str(), suffix.c_str()));
+            flist.insert(flist.end(), entry.files.begin(), entry.files.end());
+            return;
+          }
+      }
+
+    // modification times have to be taken before scanning the files
+    DirIndexEntry entry;
+    entry.stamp = static_cast<long long>(std::time(nullptr));
+    coil::getDirectoryList(path, entry.dirs);
+    for (auto & dir : entry.dirs)
+      {
+        entry.mtimes.emplace_back(coil::getModifiedTime(dir));
+      }
+    coil::getFileList(path, suffix, entry.files);
+    flist.insert(flist.end(), entry.files.begin(), entry.files.end());
+    m_dirIndex[key] = std::move(entry);
+    m_indexDirty = true;
+  }
+
+  /*!
+   * @if jp
+   * @brief モジュールインデックスをファイルから読み込む
+   * @else
+   * @brief Loading the module index from the file
+   * @endif
+   */
+  void ModuleManager::loadModuleIndex()
+  {
+    RTC_TRACE(("loadModuleIndex(%s)", m_indexFile.c_str()));
+    m_indexLoaded = true;
+    std::ifstream ifs(m_indexFile.c_str());
+    if (!ifs)
+      {
+        RTC_DEBUG(("Module index file not found: %s", m_indexFile.c_str()));
+        return;
+      }
+    coil::Properties index;
+    index.load(ifs);
+    if (index["version"] != "1")
+      {
+        RTC_WARN(("Unknown module index version: %s",
+                  index["version"].c_str()));
+        return;
+      }
+
+    for (auto & node : index.getNode("module").getLeaf())
+      {
+        coil::Properties& mod(*node);
+        if (mod["path"].empty()) { continue; }
+        ModuleIndexEntry entry;
+        entry.mtime = std::atoll(mod["mtime"].c_str());
+        entry.stamp = std::atoll(mod["stamp"].c_str());
+        entry.language = mod["language"];
+        entry.init_func = mod["init_func"];
+        entry.loadable = coil::toBool(mod["loadable"], "YES", "NO", false);
+        if (entry.loadable)
+          {
+            entry.profile << mod.getNode("profile");
+          }
+        m_moduleIndex[mod["path"]] = std::move(entry);
+      }
+
+    for (auto & node : index.getNode("dir").getLeaf())
+      {
+        coil::Properties& dir(*node);
+        if (dir["path"].empty()) { continue; }
+        DirIndexEntry entry;
+        entry.stamp = std::atoll(dir["stamp"].c_str());
+        entry.dirs = coil::split(dir["dirs"], ",", true);
+        for (auto & mtime : coil::split(dir["mtimes"], ",", true))
+          {
+            entry.mtimes.emplace_back(std::atoll(mtime.c_str()));
+          }
+        entry.files = coil::split(dir["files"], ",", true);
+        m_dirIndex[dir["suffix"] + ":" + dir["path"]] = std::move(entry);
+      }
+    RTC_DEBUG(("Module index loaded: %d modules, %d directories",
+               m_moduleIndex.size(), m_dirIndex.size()));
+  }
+
+  /*!
+   * @if jp
+   * @brief モジュールインデックスをファイルに保存する
+   * @else
+   * @brief Saving the module index to the file
+   * @endif
+   */
+  void ModuleManager::saveModuleIndex()
+  {
+    RTC_TRACE(("saveModuleIndex(%s)", m_indexFile.c_str()));
+    coil::Properties index;
+    index["version"] = "1";
+
+    size_t count(0);
+    for (auto & idx : m_moduleIndex)
+      {
+        // entries of removed files are not saved
+        if (coil::getModifiedTime(idx.first) < 0) { continue; }
+        coil::Properties& mod(index.getNode("module." +
+                                            coil::otos(count++)));
+        mod["path"] = idx.first;
+        mod["mtime"] = coil::otos(idx.second.mtime);
+        mod["stamp"] = coil::otos(idx.second.stamp);
+        mod["language"] = idx.second.language;
+        mod["init_func"] = idx.second.init_func;
+        mod["loadable"] = idx.second.loadable ? "YES" : "NO";
+        if (idx.second.loadable)
+          {
+            mod.getNode("profile") << idx.second.profile;
+          }
+      }
+
+    count = 0;
+    for (auto & idx : m_dirIndex)
+      {
+        std::string::size_type pos(idx.first.find(':'));
+        coil::Properties& dir(index.getNode("dir." + coil::otos(count++)));
+        dir["suffix"] = idx.first.substr(0, pos);
+        dir["path"] = idx.first.substr(pos + 1);
+        dir["stamp"] = coil::otos(idx.second.stamp);
+        dir["dirs"] = coil::flatten(idx.second.dirs, ",");
+        coil::vstring mtimes;
+        for (auto & mtime : idx.second.mtimes)
+          {
+            mtimes.emplace_back(coil::otos(mtime));
+          }
+        dir["mtimes"] = coil::flatten(mtimes, ",");
+        dir["files"] = coil::flatten(idx.second.files, ",");
+      }
+
+    // write to a temporary file and rename it so that other processes
+    // never read a partially written index
+    std::string tmpfile(m_indexFile + "." + coil::otos(coil::getpid()));
+    {
+      std::ofstream ofs(tmpfile.c_str());
+      if (!ofs)
+        {
+          RTC_WARN(("Module index file cannot be written: %s",
+                    m_indexFile.c_str()));
+          return;
+        }
+      index.store(ofs, "OpenRTM-aist module index");
+    }
+#ifdef _WIN32
+    std::remove(m_indexFile.c_str());
+#endif
+    if (std::rename(tmpfile.c_str(), m_indexFile.c_str()) != 0)
+      {
+        RTC_WARN(("Module index file cannot be renamed: %s",
+                  m_indexFile.c_str()));
+        std::remove(tmpfile.c_str());
+        return;
+      }
+    m_indexDirty = false;
+  }
+
 } // namespace RTC
@@ -34,6 +34,7 @@
 #include <utility>
 #include <vector>
 #include <map>
+#include <mutex>
 
 #define CONFIG_EXT    "manager.modules.config_ext"
 #define CONFIG_PATH   "manager.modules.config_path"
@@ -46,6 +47,8 @@
 #define MOD_DWNDIR    "manager.modules.download_dir"
 #define MOD_DELMOD    "manager.modules.download_cleanup"
 #define MOD_PRELOAD   "manager.modules.preload"
+#define MOD_INDEX_ENABLE "manager.modules.index.enable"
+#define MOD_INDEX_FILE   "manager.modules.index.file_name"
 
 namespace RTC
 {
@@ -720,6 +723,54 @@ namespace RTC
     void getModuleProfiles(const std::string& lang,
                            const coil::vstring& modules, vProperties& modprops);
 
+    /*!
+     * @if jp
+     *
+     * @brief ディレクトリ以下の指定拡張子のファイルリストを取得する
+     *
+     * モジュールインデックスが有効な場合、インデックスに記録されたディ
+     * レクトリツリーの更新時刻が変化していなければ、ディレクトリを走査
+     * せずにインデックス上のファイルリストを返す。
+     *
+     * @param path ディレクトリパス
+     * @param suffix 拡張子
+     * @param flist ファイルリスト
+     *
+     * @else
+     *
+     * @brief Getting file list with the given suffix under the directory
+     *
+     * If the module index is enabled and the modification times of the
+     * directory tree recorded in the index are unchanged, the file list
+     * in the index is returned without scanning the directory.
+     *
+     * @param path Directory path
+     * @param suffix File suffix
+     * @param flist File list
+     *
+     * @endif
+     */
+    void scanModuleFiles(const std::string& path, const std::string& suffix,
+                         coil::vstring& flist);
+
+    /*!
+     * @if jp
+     * @brief モジュールインデックスをファイルから読み込む
+     * @else
+     * @brief Loading the module index from the file
+     * @endif
+     */
+    void loadModuleIndex();
+
+    /*!
+     * @if jp
+     * @brief モジュールインデックスをファイルに保存する
+     * @else
+     * @brief Saving the module index to the file
+     * @endif
+     */
+    void saveModuleIndex();
+
     /*!
      * @if jp
      * @brief ロガーストリーム
@@ -788,6 +839,10 @@ namespace RTC
         file_path = coil::replaceString(file_path, "//", "/");
         return m_filepath == file_path;
       }
+      const std::string& key() const
+      {
+        return m_filepath;
+      }
     };
     /*!
      * @if jp
@@ -878,6 +933,57 @@ namespace RTC
 
     vProperties m_modprofs;
     std::map<std::string, coil::vstring> m_loadfailmods;
+    std::mutex m_modprofMutex;
+
+    /*!
+     * @if jp
+     * @brief モジュールインデックスのエントリ
+     *
+     * モジュールファイルの更新時刻、初期化関数シンボル、および
+     * profile_cmd で取得したプロファイルを保持する。loadable が false
+     * のエントリは RTC モジュールではないファイルを表す。
+     *
+     * @else
+     * @brief Entry of the module index
+     *
+     * This holds the modification time, the initialization function
+     * symbol and the profile obtained by profile_cmd of a module file.
+     * An entry whose loadable is false is a file which is not a RTC
+     * module.
+     *
+     * @endif
+     */
+    struct ModuleIndexEntry
+    {
+      long long mtime{-1};
+      long long stamp{-1};
+      std::string language;
+      std::string init_func;
+      bool loadable{false};
+      coil::Properties profile;
+    };
+
+    /*!
+     * @if jp
+     * @brief ロードパスごとのファイルリストのエントリ
+     * @else
+     * @brief Entry of the file list for each load path
+     * @endif
+     */
+    struct DirIndexEntry
+    {
+      long long stamp{-1};
+      coil::vstring dirs;
+      std::vector<long long> mtimes;
+      coil::vstring files;
+    };
+
+    bool m_indexEnabled;
+    bool m_indexLoaded;
+    bool m_indexDirty;
+    std::string m_indexFile;
+    std::map<std::string, ModuleIndexEntry> m_moduleIndex;
+    std::map<std::string, DirIndexEntry> m_dirIndex;
 
   };   // class ModuleManager
 } // namespace RTC
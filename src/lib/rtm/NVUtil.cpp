@@ -183,6 +183,65 @@ namespace NVUtil
       }
   }
 
+  /*!
+   * @if jp
+   * @brief NVList の内容でキャッシュを更新する
+   * @else
+   * @brief Update the cache with the NVList
+   * @endif
+   */
+  const coil::Properties& PropertiesCache::update(const SDOPackage::NVList& nv)
+  {
+    CORBA::ULong len(nv.length());
+    if (m_entries.size() > len)
+      {
+        clear();
+      }
+
+    for (CORBA::ULong i(0), cached(m_entries.size()); i < cached; ++i)
+      {
+        const Entry& entry(m_entries[i]);
+        const char* value(nullptr);
+        bool isString(nv[i].value >>= value);
+        if (isString != entry.isString ||
+            entry.name != static_cast<const char*>(nv[i].name) ||
+            (isString && entry.value != value))
+          {
+            clear();
+            break;
+          }
+      }
+
+    for (CORBA::ULong i(m_entries.size()); i < len; ++i)
+      {
+        const char* value(nullptr);
+        const char* name(nv[i].name);
+        if (nv[i].value >>= value)
+          {
+            m_entries.push_back({name, value, true});
+            m_properties[name] = value;
+          }
+        else
+          {
+            m_entries.push_back({name, "", false});
+          }
+      }
+    return m_properties;
+  }
+
+  /*!
+   * @if jp
+   * @brief キャッシュを破棄する
+   * @else
+   * @brief Discard the cache
+   * @endif
+   */
+  void PropertiesCache::clear()
+  {
+    m_entries.clear();
+    m_properties.clear();
+  }
+
   /*!
    * @if jp
    * @brief NVList を Properties に変換するためのファンクタ
@@ -25,6 +25,7 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
 
 /*!
  * @if jp
@@ -311,6 +312,80 @@ namespace NVUtil
    */
   void copyToProperties(coil::Properties& prop, const SDOPackage::NVList& nv);
 
+  /*!
+   * @if jp
+   *
+   * @class PropertiesCache
+   * @brief NVList を Properties へ変換した結果のキャッシュ
+   *
+   * 接続処理では同じ ConnectorProfile::properties が何度も Properties へ
+   * 変換されるが、その間 NVList は末尾への追加しか行われないことがほと
+   * んどである。このクラスは前回変換した要素を保持し、それらが変更され
+   * ていなければ追加された要素のみを変換する。前回の要素が変更・削除さ
+   * れていた場合は全体を変換し直す。結果は copyToProperties() と同じで
+   * ある。スレッドセーフではない。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   *
+   * @class PropertiesCache
+   * @brief Cache of the properties converted from NVList
+   *
+   * During the connection process the same ConnectorProfile::properties
+   * are converted into the properties many times, while the NVList is
+   * almost always only appended. This class keeps the previously
+   * converted elements and converts only the appended elements if the
+   * previous ones are not modified. If they are modified or removed,
+   * the whole NVList is converted again. The result is the same as
+   * copyToProperties(). This class is not thread safe.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class PropertiesCache
+  {
+  public:
+    /*!
+     * @if jp
+     *
+     * @brief NVList の内容でキャッシュを更新する
+     *
+     * @param nv 変換元の NVList
+     * @return 変換された Properties
+     *
+     * @else
+     *
+     * @brief Update the cache with the NVList
+     *
+     * @param nv NVList of the source
+     * @return Converted properties
+     *
+     * @endif
+     */
+    const coil::Properties& update(const SDOPackage::NVList& nv);
+
+    /*!
+     * @if jp
+     * @brief キャッシュを破棄する
+     * @else
+     * @brief Discard the cache
+     * @endif
+     */
+    void clear();
+
+  private:
+    struct Entry
+    {
+      std::string name;
+      std::string value;
+      bool isString;
+    };
+    std::vector<Entry> m_entries;
+    coil::Properties m_properties;
+  };
+
   /*!
    * @if jp
    *
@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <map>
 
 namespace RTC
 {
@@ -39,13 +40,23 @@ namespace RTC
    */
   NamingOnCorba::NamingOnCorba(CORBA::ORB_ptr orb, const char* names)
     : m_cosnaming(orb, names), m_endpoint(""),
-      m_replaceEndpoint(false)
+      m_replaceEndpoint(false), m_cacheEnabled(true),
+      m_cacheTtl(std::chrono::seconds(10))
   {
     rtclog.setName("NamingOnCorba");
     coil::Properties& prop(Manager::instance().getConfig());
     m_replaceEndpoint =
       coil::toBool(prop["corba.nameservice.replace_endpoint"],
                    "YES", "NO", true);
+    m_cacheEnabled =
+      coil::toBool(prop["corba.nameservice.cache.enable"],
+                   "YES", "NO", true);
+    std::chrono::milliseconds ttl;
+    if (!prop["corba.nameservice.cache.ttl"].empty()
+        && coil::stringTo(ttl, prop["corba.nameservice.cache.ttl"].c_str()))
+      {
+        m_cacheTtl = ttl;
+      }
 
 
     coil::vstring host_port(coil::split(names, ":"));
@@ -73,6 +84,7 @@ namespace RTC
                                  const RTObject_impl* rtobj)
   {
     RTC_TRACE(("bindObject(name = %s, rtobj)", name));
+    invalidateCache();
 #ifdef ORB_IS_OMNIORB
     if (!m_endpoint.empty() && m_replaceEndpoint)
       {
@@ -105,6 +117,7 @@ namespace RTC
                                  const PortBase* port)
   {
     RTC_TRACE(("bindObject(name = %s, port)", name));
+    invalidateCache();
 #ifdef ORB_IS_OMNIORB
     if (!m_endpoint.empty() && m_replaceEndpoint)
       {
@@ -137,6 +150,7 @@ namespace RTC
                                  const RTM::ManagerServant* mgr)
   {
     RTC_TRACE(("bindObject(name = %s, mgr)", name));
+    invalidateCache();
 #ifdef ORB_IS_OMNIORB
     if (!m_endpoint.empty() && m_replaceEndpoint)
       {
@@ -175,6 +189,7 @@ namespace RTC
   void NamingOnCorba::unbindObject(const char* name)
   {
     RTC_TRACE(("unbindObject(name  = %s)", name));
+    invalidateCache();
     m_cosnaming.unbind(name);
   }
 
@@ -281,6 +296,15 @@ namespace RTC
                   std::string rtc_name = url.substr(host.size()+1, url.size() - host.size());
                   try
                   {
+                      coil::vstring names = coil::split(rtc_name, "/");
+                      bool search(names.size() == 2 && names[0] == "*");
+                      if (search && m_cacheEnabled
+                          && findInSnapshot(host, names[1], rtc_list))
+                      {
+                          return rtc_list;
+                      }
+                      rtc_list.length(0);
+
                       RTC::CorbaNaming cns = m_cosnaming;
                       if (host == "*")
                       {
@@ -290,9 +314,7 @@ namespace RTC
                           CORBA::ORB_var orb = Manager::instance().getORB();
                           cns = RTC::CorbaNaming(orb, host.c_str());
                       }
-                      coil::vstring names = coil::split(rtc_name, "/");
-
-                      if (names.size() == 2 && names[0] == "*")
+                      if (search)
                       {
                           CosNaming::NamingContext_var root_cxt = cns.getRootContext();
                           getComponentByName(root_cxt, names[1], rtc_list);
@@ -326,7 +348,278 @@ namespace RTC
       return rtc_list;
   }
 
+  /*!
+   * @if jp
+   * @brief 複数のRTC名をまとめてオブジェクトリファレンスに解決する
+   * @else
+   * @brief Resolve multiple RTC names into object references at once
+   * @endif
+   */
+  std::vector<RTC::RTCList>
+  NamingOnCorba::string_to_components(const coil::vstring& names)
+  {
+    RTC_TRACE(("string_to_components(%d names)", names.size()));
+    std::vector<RTC::RTCList> rtcs(names.size());
+    std::map<std::string, size_t> resolved;
+    for (size_t i(0); i < names.size(); ++i)
+      {
+        auto itr = resolved.find(names[i]);
+        if (itr != resolved.end())
+          {
+            rtcs[i] = rtcs[itr->second];
+            continue;
+          }
+        rtcs[i] = string_to_component(names[i]);
+        resolved[names[i]] = i;
+      }
+    return rtcs;
+  }
+
+  /*!
+   * @if jp
+   * @brief ネーミングツリーのキャッシュを破棄する
+   * @else
+   * @brief Discard the cached naming tree snapshots
+   * @endif
+   */
+  void NamingOnCorba::invalidateCache()
+  {
+    std::lock_guard<std::mutex> guard(m_cacheMutex);
+    m_cache.clear();
+    ++m_cacheGeneration;
+  }
+
+  /*!
+   * @if jp
+   * @brief オブジェクトリファレンスが生存しているか確認する
+   * @else
+   * @brief Check if the object reference is alive
+   * @endif
+   */
+  static bool isExistentComponent(RTC::RTObject_ptr obj)
+  {
+    try
+      {
+        return !CORBA::is_nil(obj) && !obj->_non_existent();
+      }
+    catch (...)
+      {
+        return false;
+      }
+  }
+
+  /*!
+   * @if jp
+   *
+   * @brief キャッシュされたネーミングツリーからRTCを検索する
+   *
+   * ディレクトリに "*" を指定したインスタンス名の検索にのみ使用する。
+   * 古いスナップショットで見つからない、または生存していないオブジェ
+   * クトが含まれる場合は、スナップショットを一度だけ作り直して再検索
+   * する。生存確認はキャッシュのロックを解放した状態で行う。
+   *
+   * @param host ネームサーバのホスト名 ("*" は既定のネームサーバ)
+   * @param name RTCのインスタンス名
+   * @param rtcs RTCのリスト
+   * @return キャッシュで解決できた場合 true
+   *
+   * @else
+   *
+   * @brief Find RTCs in the cached naming tree
+   *
+   * This is used only for the searches of an instance name whose
+   * directory is "*". If nothing is found in an old snapshot or a dead
+   * object is found, the snapshot is rebuilt once and the search is
+   * retried. The objects are checked for liveness without the cache
+   * lock held.
+   *
+   * @param host Host name of the name server ("*" is the default one)
+   * @param name Instance name of the RTC
+   * @param rtcs RTC list
+   * @return true if resolved by the cache
+   *
+   * @endif
+   */
+  bool NamingOnCorba::findInSnapshot(const std::string& host,
+                                     const std::string& name,
+                                     RTC::RTCList& rtcs)
+  {
+    bool fresh(false);
+    std::shared_ptr<const NamingSnapshot> snapshot(getSnapshot(host, false, fresh));
+    for (;;)
+      {
+        bool complete(true);
+        rtcs.length(0);
+        auto itr = snapshot->byName.find(name);
+        if (itr != snapshot->byName.end())
+          {
+            for (CORBA::ULong i(0); i < itr->second.length(); ++i)
+              {
+                if (isExistentComponent(itr->second[i]))
+                  {
+                    CORBA_SeqUtil::push_back(rtcs,
+                      RTC::RTObject::_duplicate(itr->second[i]));
+                  }
+                else
+                  {
+                    complete = false;
+                  }
+              }
+          }
+        complete = complete && (rtcs.length() > 0);
+        // A search result of a fresh snapshot is authoritative.
+        if (complete || fresh) { return true; }
+        snapshot = getSnapshot(host, true, fresh);
+      }
+  }
+
+  /*!
+   * @if jp
+   *
+   * @brief ネーミングツリーのスナップショットを取得する
+   *
+   * 有効期限内のスナップショットがあればそれを返し、なければネームサー
+   * バのツリー全体を一度だけ走査して作成する。走査は m_cacheMutex を
+   * ロックせずに行い、完成したスナップショットをキャッシュに入れる。走
+   * 査中に invalidateCache() が呼ばれた場合、スナップショットはこの呼
+   * び出しにのみ使用され、キャッシュには入れない。
+   *
+   * @param host ネームサーバのホスト名 ("*" は既定のネームサーバ)
+   * @param refresh true の場合は常に作り直す
+   * @param fresh 新たに作成した場合 true が設定される
+   * @return スナップショット
+   *
+   * @else
+   *
+   * @brief Get the snapshot of the naming tree
+   *
+   * A snapshot within its TTL is returned as is. Otherwise the whole
+   * tree of the name server is walked once to build a new one. The walk
+   * is done without m_cacheMutex locked, and the completed snapshot is
+   * swapped into the cache. If invalidateCache() is called during the
+   * walk, the snapshot is used only for this call and not cached.
+   *
+   * @param host Host name of the name server ("*" is the default one)
+   * @param refresh Always rebuild the snapshot if true
+   * @param fresh Set to true if the snapshot has just been built
+   * @return The snapshot
+   *
+   * @endif
+   */
+  std::shared_ptr<const NamingOnCorba::NamingSnapshot>
+  NamingOnCorba::getSnapshot(const std::string& host, bool refresh,
+                             bool& fresh)
+  {
+    auto now = std::chrono::steady_clock::now();
+    unsigned long generation(0);
+    {
+      std::lock_guard<std::mutex> guard(m_cacheMutex);
+      auto itr = m_cache.find(host);
+      if (!refresh && itr != m_cache.end()
+          && (now - itr->second->stamp) < m_cacheTtl)
+        {
+          fresh = false;
+          return itr->second;
+        }
+      generation = m_cacheGeneration;
+    }
+
+    std::shared_ptr<NamingSnapshot> snapshot(std::make_shared<NamingSnapshot>());
+    CosNaming::NamingContext_var root_cxt;
+    if (host == "*")
+      {
+        root_cxt = m_cosnaming.getRootContext();
+      }
+    else
+      {
+        CORBA::ORB_var orb = Manager::instance().getORB();
+        RTC::CorbaNaming cns(orb, host.c_str());
+        root_cxt = cns.getRootContext();
+      }
+    buildSnapshot(root_cxt.in(), *snapshot);
+    RTC_DEBUG(("Naming tree snapshot of %s: %d names.",
+               host.c_str(), snapshot->byName.size()));
+    snapshot->stamp = now;
+    fresh = true;
+
+    std::lock_guard<std::mutex> guard(m_cacheMutex);
+    if (generation == m_cacheGeneration)
+      {
+        m_cache[host] = snapshot;
+      }
+    return snapshot;
+  }
+
+  /*!
+   * @if jp
+   * @brief ネーミングコンテキスト以下のRTCをスナップショットに登録する
+   * @else
+   * @brief Register RTCs under the naming context to the snapshot
+   * @endif
+   */
+  void NamingOnCorba::buildSnapshot(CosNaming::NamingContext_ptr context,
+                                    NamingSnapshot& snapshot)
+  {
+    CORBA::ULong length = 500;
+    CosNaming::BindingList_var bl;
+    CosNaming::BindingIterator_var bi;
+    context->list(length, bl, bi);
 
+    for (;;)
+      {
+        for (CORBA::ULong i(0); i < bl->length(); ++i)
+          {
+            std::string id(bl[i].binding_name[0].id);
+            std::string kind(bl[i].binding_name[0].kind);
+
+            if (bl[i].binding_type == CosNaming::ncontext)
+              {
+                try
+                  {
+                    CORBA::Object_var obj =
+                      context->resolve(bl[i].binding_name);
+                    CosNaming::NamingContext_var next_context =
+                      CosNaming::NamingContext::_narrow(obj);
+                    if (CORBA::is_nil(next_context)) { continue; }
+                    buildSnapshot(next_context.in(), snapshot);
+                  }
+                catch (CORBA::SystemException&)
+                  {
+                    // federated contexts may be unreachable
+                  }
+              }
+            else if (bl[i].binding_type == CosNaming::nobject
+                     && kind == "rtc")
+              {
+                try
+                  {
+                    CORBA::Object_var obj =
+                      context->resolve(bl[i].binding_name);
+                    RTC::RTObject_var rtobj = RTC::RTObject::_narrow(obj);
+                    if (CORBA::is_nil(rtobj)) { continue; }
+#ifndef ORB_IS_RTORB
+                    CORBA_SeqUtil::push_back(snapshot.byName[id], rtobj);
+#else
+                    CORBA_SeqUtil::push_back(snapshot.byName[id], rtobj.in());
+#endif
+                  }
+                catch (...)
+                  {
+                  }
+              }
+          }
+        if (CORBA::is_nil(bi)) { break; }
+        CosNaming::BindingList_var next_bl;
+        CORBA::Boolean more = bi->next_n(length, next_bl.out());
+        bl = next_bl._retn();
+        if (!more)
+          {
+            bi->destroy();
+            if (bl->length() == 0) { break; }
+            bi = CosNaming::BindingIterator::_nil();
+          }
+      }
+  }
 
   /*!
   * @if jp
@@ -521,6 +814,28 @@ namespace RTC
 
 
   
+  //============================================================
+  // NamingBase
+  //============================================================
+  /*!
+   * @if jp
+   * @brief 複数のRTC名をまとめてオブジェクトリファレンスに解決する
+   * @else
+   * @brief Resolve multiple RTC names into object references at once
+   * @endif
+   */
+  std::vector<RTC::RTCList>
+  NamingBase::string_to_components(const coil::vstring& names)
+  {
+    std::vector<RTC::RTCList> rtcs;
+    rtcs.reserve(names.size());
+    for (auto const& name : names)
+      {
+        rtcs.emplace_back(string_to_component(name));
+      }
+    return rtcs;
+  }
+
   //============================================================
   // NamingManager
   //============================================================
@@ -1007,4 +1322,47 @@ namespace RTC
    }  
    return RTCList();
   }
+
+  /*!
+   * @if jp
+   * @brief 複数のRTC名をまとめてオブジェクトリファレンスに解決する
+   * @else
+   * @brief Resolve multiple RTC names into object references at once
+   * @endif
+   */
+  std::vector<RTCList>
+  NamingManager::string_to_components(const coil::vstring& names)
+  {
+    RTC_TRACE(("NamingManager::string_to_components(%d names)",
+               names.size()));
+    std::vector<RTCList> rtcs(names.size());
+    std::vector<size_t> unresolved(names.size());
+    for (size_t i(0); i < names.size(); ++i) { unresolved[i] = i; }
+
+    for (auto & n : m_names)
+      {
+        if (unresolved.empty()) { break; }
+        if (n->ns == nullptr) { continue; }
+
+        coil::vstring query;
+        query.reserve(unresolved.size());
+        for (auto const& i : unresolved) { query.emplace_back(names[i]); }
+
+        std::vector<RTCList> comps = n->ns->string_to_components(query);
+        std::vector<size_t> remains;
+        for (size_t j(0); j < unresolved.size(); ++j)
+          {
+            if (j < comps.size() && comps[j].length() > 0)
+              {
+                rtcs[unresolved[j]] = comps[j];
+              }
+            else
+              {
+                remains.emplace_back(unresolved[j]);
+              }
+          }
+        unresolved.swap(remains);
+      }
+    return rtcs;
+  }
 } // namespace RTC
@@ -22,12 +22,16 @@
 #include <rtm/RTC.h>
 
 #include <coil/Task.h>
+#include <coil/stringutil.h>
 #include <mutex>
 #include <rtm/CorbaNaming.h>
 #include <rtm/RTObject.h>
 #include <rtm/SystemLogger.h>
 #include <rtm/ManagerServant.h>
 
+#include <chrono>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -188,6 +192,34 @@ namespace RTC
      * @endif
      */
     virtual RTC::RTCList string_to_component(std::string name) = 0;
+    /*!
+     * @if jp
+     *
+     * @brief 複数のRTC名をまとめてオブジェクトリファレンスに解決する
+     *
+     * names の各要素を string_to_component() と同じ規則で解決し、同じ
+     * 順序で結果を返す。デフォルト実装は string_to_component() を順に呼
+     * び出す。
+     *
+     * @param names RTC名のリスト
+     * @return names と同じ長さのRTCリストのリスト
+     *
+     * @else
+     *
+     * @brief Resolve multiple RTC names into object references at once
+     *
+     * Each element of names is resolved with the same rules as
+     * string_to_component() and the results are returned in the same
+     * order. The default implementation calls string_to_component()
+     * for each name.
+     *
+     * @param names List of RTC names
+     * @return List of RTC lists which has the same length as names
+     *
+     * @endif
+     */
+    virtual std::vector<RTC::RTCList>
+    string_to_components(const coil::vstring& names);
   };
 
   /*!
@@ -404,13 +436,80 @@ namespace RTC
      * @endif
      */
     RTC::RTCList string_to_component(std::string name) override;
+    /*!
+     * @if jp
+     *
+     * @brief 複数のRTC名をまとめてオブジェクトリファレンスに解決する
+     *
+     * ネームサーバごとのキャッシュを一度だけ取得し、同じ名前は一度だけ
+     * 解決する。
+     *
+     * @param names rtcname形式のRTC名のリスト
+     * @return names と同じ長さのRTCリストのリスト
+     *
+     * @else
+     *
+     * @brief Resolve multiple RTC names into object references at once
+     *
+     * The naming tree snapshot of each name server is acquired only
+     * once and duplicated names are resolved only once.
+     *
+     * @param names List of RTC names in rtcname format
+     * @return List of RTC lists which has the same length as names
+     *
+     * @endif
+     */
+    std::vector<RTC::RTCList>
+    string_to_components(const coil::vstring& names) override;
+    /*!
+     * @if jp
+     *
+     * @brief ネーミングツリーのキャッシュを破棄する
+     *
+     * @else
+     *
+     * @brief Discard the cached naming tree snapshots
+     *
+     * @endif
+     */
+    void invalidateCache();
     CorbaNaming& getCorbaNaming() { return m_cosnaming; }
 
   private:
+    /*!
+     * @if jp
+     * @brief ネーミングツリーのスナップショット
+     *
+     * ネームサーバ上の kind が "rtc" のオブジェクトを、インスタンス名で
+     * 引けるように保持する。作成後は変更されない。
+     * @else
+     * @brief Snapshot of a naming tree
+     *
+     * Holds the objects of kind "rtc" on a name server, indexed by
+     * instance name. It is not modified after it is built.
+     * @endif
+     */
+    struct NamingSnapshot
+    {
+      std::chrono::steady_clock::time_point stamp;
+      std::map<std::string, RTC::RTCList> byName;
+    };
+    bool findInSnapshot(const std::string& host, const std::string& name,
+                        RTC::RTCList& rtcs);
+    std::shared_ptr<const NamingSnapshot>
+    getSnapshot(const std::string& host, bool refresh, bool& fresh);
+    void buildSnapshot(CosNaming::NamingContext_ptr context,
+                       NamingSnapshot& snapshot);
+
     Logger rtclog;
     CorbaNaming m_cosnaming;
     std::string m_endpoint;
     bool m_replaceEndpoint;
+    bool m_cacheEnabled;
+    std::chrono::steady_clock::duration m_cacheTtl;
+    std::map<std::string, std::shared_ptr<const NamingSnapshot> > m_cache;
+    unsigned long m_cacheGeneration{0};
+    std::mutex m_cacheMutex;
   };
 
 
@@ -835,6 +934,31 @@ namespace RTC
      * @endif
      */
     RTCList string_to_component(const std::string& name);
+
+    /*!
+     * @if jp
+     *
+     * @brief 複数のRTC名をまとめてオブジェクトリファレンスに解決する
+     *
+     * 登録された各ネームサーバに対して、まだ解決されていない名前だけを
+     * まとめて問い合わせる。
+     *
+     * @param names rtcloc/rtcname形式でのRTC名のリスト
+     * @return names と同じ長さのRTCリストのリスト
+     *
+     * @else
+     *
+     * @brief Resolve multiple RTC names into object references at once
+     *
+     * Only names which are not resolved yet are passed to each
+     * registered name server in a single request.
+     *
+     * @param names List of RTC names in rtcloc/rtcname format
+     * @return List of RTC lists which has the same length as names
+     *
+     * @endif
+     */
+    std::vector<RTCList> string_to_components(const coil::vstring& names);
     
   protected:
     /*!
@@ -24,9 +24,38 @@
 #include <mutex>
 
 #include <algorithm>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <string>
 
+/*!
+ * @if jp
+ * @brief 述語クラスがキーを持つかどうかを判定する
+ *
+ * Predicate が key() を持つ場合 value は true となる。key() は述語が
+ * 一致と判定するオブジェクトの間で等しい文字列を返さなければならない。
+ *
+ * @else
+ * @brief Check if a predicate class has a key
+ *
+ * value is true if Predicate has key(). key() must return the same
+ * string for the objects which the predicate regards as equal.
+ *
+ * @endif
+ */
+template <typename Predicate>
+struct ObjectManagerHasKey
+{
+  template <typename P>
+  static auto test(int)
+    -> decltype(std::declval<const P&>().key(), std::true_type());
+  template <typename P>
+  static std::false_type test(...);
+  static constexpr bool value = decltype(test<Predicate>(0))::value;
+};
+
 
 /*!
  * @if jp
@@ -42,6 +71,9 @@
  * @brief Class for managing objects
  *
  * This is a class for managing various objects.
+ * If Predicate has key(), objects are also indexed by the key and
+ * registerObject() and find() do not scan the objects. The key of an
+ * object must not change while it is registered.
  *
  * @since 0.4.0
  *
@@ -115,14 +147,13 @@ public:
    */
   bool registerObject(Object* obj)
   {
-    ObjectVectorItr it;
     std::lock_guard<std::mutex> guard(m_objects._mutex);
 
-    it = std::find_if(m_objects._obj.begin(), m_objects._obj.end(),
-                      Predicate(obj));
-    if (it == m_objects._obj.end())
+    Predicate pred(obj);
+    if (lookup(pred, HasKey()) == nullptr)
       {
         m_objects._obj.emplace_back(obj);
+        addIndex(pred, obj, HasKey());
         return true;
       }
     return false;
@@ -155,15 +186,15 @@ public:
    */
   Object* unregisterObject(const Identifier& id)
   {
-    ObjectVectorItr it;
     std::lock_guard<std::mutex> guard(m_objects._mutex);
 
-    it = std::find_if(m_objects._obj.begin(), m_objects._obj.end(),
-                      Predicate(id));
-    if (it != m_objects._obj.end())
+    Predicate pred(id);
+    Object* obj(lookup(pred, HasKey()));
+    if (obj != nullptr)
       {
-        Object* obj(*it);
-        m_objects._obj.erase(it);
+        m_objects._obj.erase(std::find(m_objects._obj.begin(),
+                                       m_objects._obj.end(), obj));
+        removeIndex(pred, HasKey());
         return obj;
       }
     return nullptr;
@@ -199,15 +230,9 @@ public:
    */
   Object* find(const Identifier& id) const
   {
-    ObjectVectorConstItr it;
     std::lock_guard<std::mutex> guard(m_objects._mutex);
-    it = std::find_if(m_objects._obj.begin(), m_objects._obj.end(),
-                      Predicate(id));
-    if (it != m_objects._obj.end())
-      {
-        return *it;
-      }
-    return nullptr;
+    Predicate pred(id);
+    return lookup(pred, HasKey());
   }
 
   /*!
@@ -264,6 +289,42 @@ public:
   }
 
 protected:
+  using HasKey = std::integral_constant<bool,
+                                        ObjectManagerHasKey<Predicate>::value>;
+
+  /*!
+   * @if jp
+   * @brief オブジェクトを検索する (ロック済みであること)
+   * @else
+   * @brief Find an object (the lock must be held)
+   * @endif
+   */
+  Object* lookup(Predicate& pred, std::true_type) const
+  {
+    auto it = m_objects._index.find(pred.key());
+    return it != m_objects._index.end() ? it->second : nullptr;
+  }
+  Object* lookup(Predicate& pred, std::false_type) const
+  {
+    ObjectVectorConstItr it;
+    it = std::find_if(m_objects._obj.begin(), m_objects._obj.end(), pred);
+    return it != m_objects._obj.end() ? *it : nullptr;
+  }
+  void addIndex(Predicate& pred, Object* obj, std::true_type)
+  {
+    m_objects._index[pred.key()] = obj;
+  }
+  void addIndex(Predicate& /* pred */, Object* /* obj */, std::false_type)
+  {
+  }
+  void removeIndex(Predicate& pred, std::true_type)
+  {
+    m_objects._index.erase(pred.key());
+  }
+  void removeIndex(Predicate& /* pred */, std::false_type)
+  {
+  }
+
   /*!
    * @if jp
    * @brief オブジェクト管理用構造体
@@ -276,6 +337,7 @@ protected:
     ~Objects() = default;
     mutable std::mutex _mutex;
     ObjectVector _obj;
+    std::unordered_map<std::string, Object*> _index;
   };
   /*!
    * @if jp
@@ -118,6 +118,10 @@ namespace RTC
     std::for_each(m_connectors.begin(),
                   m_connectors.end(),
                   connector_cleanup());
+    for (auto & consumer : m_publishedConsumers)
+      {
+        InPortConsumerFactory::instance().deleteObject(consumer.second);
+      }
     delete m_listeners;
   }
 
@@ -252,13 +256,10 @@ namespace RTC
   {
     RTC_TRACE(("getConnectorById(id = %s)", id));
 
-    std::string sid(id);
-    for (auto & connector : m_connectors)
+    auto it = m_connectorIndex.find(id);
+    if (it != m_connectorIndex.end())
       {
-        if (sid  == connector->id())
-          {
-            return connector;
-          }
+        return it->second;
       }
     RTC_WARN(("ConnectorProfile with the id(%s) not found.", id));
     return nullptr;
@@ -529,16 +530,23 @@ namespace RTC
     // prop: [port.outport].
     coil::Properties prop(m_properties);
     {
-      coil::Properties conn_prop;
-      NVUtil::copyToProperties(conn_prop, cprof.properties);
-      prop << conn_prop.getNode("dataport");  // marge ConnectorProfile
+      const coil::Properties& conn_prop(getConnectorProperties(cprof));
+      const coil::Properties* node(conn_prop.findNode("dataport"));
+      if (node != nullptr)
+        {
+          prop << *node;  // marge ConnectorProfile
+        }
       /*
        * marge ConnectorProfile for buffer property.
        * e.g.
        *  prof[buffer.write.full_policy]
        *       << cprof[dataport.outport.buffer.write.full_policy]
        */
-      prop << conn_prop.getNode("dataport.outport");
+      node = conn_prop.findNode("dataport.outport");
+      if (node != nullptr)
+        {
+          prop << *node;
+        }
     }
     RTC_DEBUG(("ConnectorProfile::properties are as follows."));
     RTC_PARANOID_STR((prop));
@@ -558,7 +566,26 @@ namespace RTC
 
     if (dflow_type == "push")
       {
-        RTC_PARANOID(("dataflow_type = push .... do nothing"));
+        RTC_PARANOID(("dataflow_type = push .... create consumer"));
+
+        // the consumer publishes the interfaces owned by the OutPort
+        // side, and is used by subscribeInterfaces()
+        InPortConsumer* consumer(publishConsumer(cprof, prop));
+        if (consumer == nullptr)
+          {
+            return RTC::BAD_PARAMETER;
+          }
+        std::string id(cprof.connector_id);
+        auto published = m_publishedConsumers.find(id);
+        if (published != m_publishedConsumers.end())
+          {
+            InPortConsumerFactory::instance().deleteObject(published->second);
+            published->second = consumer;
+          }
+        else
+          {
+            m_publishedConsumers.emplace(std::move(id), consumer);
+          }
         return RTC::RTC_OK;
       }
     else if (dflow_type == "pull")
@@ -604,16 +631,23 @@ namespace RTC
     // prop: [port.outport].
     coil::Properties prop(m_properties);
     {
-      coil::Properties conn_prop;
-      NVUtil::copyToProperties(conn_prop, cprof.properties);
-      prop << conn_prop.getNode("dataport");  // marge ConnectorProfile
+      const coil::Properties& conn_prop(getConnectorProperties(cprof));
+      const coil::Properties* node(conn_prop.findNode("dataport"));
+      if (node != nullptr)
+        {
+          prop << *node;  // marge ConnectorProfile
+        }
       /*
        * marge ConnectorProfile for buffer property.
        * e.g.
        *  prof[buffer.write.full_policy]
        *       << cprof[dataport.outport.buffer.write.full_policy]
        */
-      prop << conn_prop.getNode("dataport.outport");
+      node = conn_prop.findNode("dataport.outport");
+      if (node != nullptr)
+        {
+          prop << *node;
+        }
     }
     RTC_DEBUG(("ConnectorProfile::properties are as follows."));
     RTC_DEBUG_STR((prop));
@@ -697,11 +731,22 @@ namespace RTC
     std::string id(connector_profile.connector_id);
     RTC_PARANOID(("connector_id: %s", id.c_str()));
 
-    ConnectorList::iterator it(m_connectors.begin());
+    // the consumer published but not subscribed by a failed connection
+    auto published = m_publishedConsumers.find(id);
+    if (published != m_publishedConsumers.end())
+      {
+        InPortConsumerFactory::instance().deleteObject(published->second);
+        m_publishedConsumers.erase(published);
+      }
 
-    while (it != m_connectors.end())
+    auto index = m_connectorIndex.find(id);
+    if (index != m_connectorIndex.end())
       {
-        if (id == (*it)->id())
+        ConnectorList::iterator it(std::find(m_connectors.begin(),
+                                             m_connectors.end(),
+                                             index->second));
+        m_connectorIndex.erase(index);
+        if (it != m_connectors.end())
           {
             // Connector's dtor must call disconnect()
             coil::Properties prop;
@@ -712,7 +757,6 @@ namespace RTC
             RTC_TRACE(("delete connector: %s", id.c_str()));
             return;
           }
-        ++it;
       }
     RTC_ERROR(("specified connector not found: %s", id.c_str()));
     return;
@@ -931,16 +975,79 @@ namespace RTC
   }
 
 
+  /*!
+   * @if jp
+   * @brief InPort consumer の生成とインターフェース情報の公開
+   * @else
+   * @brief InPort consumer creation and publishing its interface
+   * @endif
+   */
+  InPortConsumer* OutPortBase::publishConsumer(ConnectorProfile& cprof,
+                                               coil::Properties& prop)
+  {
+    if (!prop["interface_type"].empty() &&
+        !coil::includes(coil::vstring(m_consumerTypes), prop["interface_type"]))
+      {
+        RTC_ERROR(("no consumer found"));
+        RTC_DEBUG(("interface_type:  %s", prop["interface_type"].c_str()));
+        RTC_DEBUG(("interface_types: %s",
+                   coil::flatten(m_consumerTypes).c_str()));
+        return nullptr;
+      }
+
+    RTC_DEBUG(("interface_type: %s", prop["interface_type"].c_str()));
+    InPortConsumer* consumer;
+    consumer = InPortConsumerFactory::
+      instance().createObject(prop["interface_type"]);
+
+    if (consumer == nullptr)
+      {
+        RTC_ERROR(("consumer creation failed"));
+        return nullptr;
+      }
+    RTC_TRACE(("consumer created"));
+    consumer->setOutPortName(getName());
+    consumer->init(prop.getNode("consumer"));
+
+#ifndef ORB_IS_RTORB
+    consumer->publishInterfaceProfile(cprof.properties);
+#else  // ORB_IS_RTORB
+    ::SDOPackage::NVList_ptr prop_ref(cprof.properties);
+    consumer->publishInterfaceProfile(*prop_ref);
+#endif  // ORB_IS_RTORB
+    return consumer;
+  }
+
   /*!
    * @if jp
    * @brief InPort consumer の生成
+   *
+   * publishInterfaces() で生成したコンシューマがあればそれを使用する。
+   *
    * @else
    * @brief InPort consumer creation
+   *
+   * The consumer created in publishInterfaces() is used if exists.
+   *
    * @endif
    */
   InPortConsumer* OutPortBase::createConsumer(const ConnectorProfile& cprof,
                                               coil::Properties& prop)
   {
+    auto published = m_publishedConsumers.find(std::string(cprof.connector_id));
+    if (published != m_publishedConsumers.end())
+      {
+        InPortConsumer* consumer(published->second);
+        m_publishedConsumers.erase(published);
+        if (!consumer->subscribeInterface(cprof.properties))
+          {
+            RTC_ERROR(("interface subscription failed."));
+            InPortConsumerFactory::instance().deleteObject(consumer);
+            return nullptr;
+          }
+        return consumer;
+      }
+
     if (!prop["interface_type"].empty() &&
         !coil::includes(coil::vstring(m_consumerTypes), prop["interface_type"]))
       {
@@ -959,6 +1066,7 @@ namespace RTC
     if (consumer != nullptr)
       {
         RTC_TRACE(("consumer created"));
+        consumer->setOutPortName(getName());
         consumer->init(prop.getNode("consumer"));
 
         if (!consumer->subscribeInterface(cprof.properties))
@@ -1031,6 +1139,7 @@ namespace RTC
         // end of direct interface_type
 
         m_connectors.emplace_back(connector);
+        m_connectorIndex[connector->id()] = connector;
         RTC_PARANOID(("connector pushback done: size = %d",
                       m_connectors.size()));
         return connector;
@@ -1087,6 +1196,7 @@ namespace RTC
           }
 
         m_connectors.emplace_back(connector);
+        m_connectorIndex[connector->id()] = connector;
         RTC_PARANOID(("connector pushback done: size = %d",
                       m_connectors.size()));
         return connector;
@@ -31,6 +31,9 @@
 #include <rtm/SystemLogger.h>
 #include <rtm/ConnectorListener.h>
 
+#include <string>
+#include <unordered_map>
+
 namespace RTC
 {
   class PublisherBase;
@@ -996,6 +999,24 @@ namespace RTC
      */
     OutPortProvider* createProvider(ConnectorProfile& cprof,
                                     coil::Properties& prop);
+    /*!
+     * @if jp
+     * @brief InPort consumer の生成とインターフェース情報の公開
+     *
+     * push 型の接続で、OutPort 側が所有するインターフェース (マルチキャ
+     * ストグループ等) の情報をコンシューマに公開させる。
+     *
+     * @else
+     * @brief InPort consumer creation and publishing its interface
+     *
+     * For push connections, the consumer publishes the information of
+     * the interfaces owned by the OutPort side, such as a multicast
+     * group.
+     *
+     * @endif
+     */
+    InPortConsumer* publishConsumer(ConnectorProfile& cprof,
+                                    coil::Properties& prop);
     /*!
      * @if jp
      * @brief InPort consumer の生成
@@ -1064,6 +1085,22 @@ namespace RTC
      * @endif
      */
     std::vector<OutPortConnector*> m_connectors;
+    /*!
+     * @if jp
+     * @brief コネクタIDから接続への索引
+     * @else
+     * @brief Index from connector IDs to connections
+     * @endif
+     */
+    std::unordered_map<std::string, OutPortConnector*> m_connectorIndex;
+    /*!
+     * @if jp
+     * @brief publishInterfaces() で生成され接続待ちのコンシューマ
+     * @else
+     * @brief Consumers created in publishInterfaces() and not connected yet
+     * @endif
+     */
+    std::unordered_map<std::string, InPortConsumer*> m_publishedConsumers;
     /*!
      * @if jp
      * @brief 利用可能provider
@@ -19,6 +19,7 @@
 
 #include <rtm/OutPortConnector.h>
 #include <rtm/InPortBase.h>
+#include <coil/stringutil.h>
 
 namespace RTC
 {
@@ -32,7 +33,9 @@ namespace RTC
   OutPortConnector::OutPortConnector(ConnectorInfo& info,
                                      ConnectorListenersBase* listeners)
     : rtclog("OutPortConnector"), m_profile(info), m_littleEndian(true),
-      m_directInPort(nullptr), m_listeners(listeners), m_directMode(false), m_marshaling_type("cdr"), m_cdr(nullptr)
+      m_directInPort(nullptr), m_listeners(listeners), m_directMode(false), m_marshaling_type("cdr"), m_cdr(nullptr),
+      m_skipPolicy(coil::normalize(info.properties.getProperty(
+        "publisher.push_policy", "new")) == "skip")
   {
   }
 
@@ -45,7 +48,7 @@ namespace RTC
    */
   OutPortConnector::~OutPortConnector()
   {
-    SerializerFactory::instance().deleteObject(m_cdr);
+    deleteSerializer(m_cdr);
   }
   /*!
    * @if jp
@@ -135,6 +138,20 @@ namespace RTC
     return m_littleEndian;
   }
 
+  /*!
+   * @if jp
+   * @brief 前に書き込んだデータが送信されない可能性があるか
+   * @else
+   * @brief Check if the previously written data may not be sent
+   * @endif
+   */
+  bool OutPortConnector::mayDropPreviousData()
+  {
+    CdrBufferBase* buffer(getBuffer());
+    if (buffer != nullptr && buffer->readable() > 0) { return true; }
+    return m_skipPolicy;
+  }
+
   /*!
   * @if jp
   * @brief ダイレクト接続モードに設定
@@ -184,6 +201,36 @@ namespace RTC
     return BufferStatus::OK;
   }
 
+  /*!
+   * @if jp
+   * @brief 新しいデータを待ってから読み出す
+   * @else
+   * @brief Read data after waiting for new data
+   * @endif
+   */
+  BufferStatus OutPortConnector::read(ByteData& data,
+                                      std::chrono::nanoseconds /*timeout*/)
+  {
+    return read(data);
+  }
+
+  /*!
+   * @if jp
+   * @brief 新しいデータを最大 count 個読み出す
+   * @else
+   * @brief Read up to count newest data
+   * @endif
+   */
+  BufferStatus OutPortConnector::readNewest(std::vector<ByteData>& data,
+                                            size_t /*count*/,
+                                            std::chrono::nanoseconds timeout)
+  {
+    data.resize(1);
+    BufferStatus ret(read(data[0], timeout));
+    if (ret != BufferStatus::OK) { data.clear(); }
+    return ret;
+  }
+
   void OutPortConnector::unsubscribeInterface(const coil::Properties& /*prop*/)
   {
 
@@ -28,6 +28,9 @@
 #include <rtm/CORBA_CdrMemoryStream.h>
 #include <rtm/ByteData.h>
 
+#include <chrono>
+#include <vector>
+
 
 
 namespace RTC
@@ -251,6 +254,7 @@ namespace RTC
       if(m_cdr == nullptr)
       {
           m_cdr = createSerializer<DataType>(m_marshaling_type);
+          if (m_cdr != nullptr) { m_cdr->init(m_profile.properties); }
       }
       ::RTC::ByteDataStream<DataType> *cdr = dynamic_cast<::RTC::ByteDataStream<DataType>*>(m_cdr);
       if (!cdr)
@@ -258,18 +262,85 @@ namespace RTC
           RTC_ERROR(("Can not find Marshalizer: %s", m_marshaling_type.c_str()));
           return DataPortStatus::PORT_ERROR;
       }
+      // stateful codecs such as "delta" restart from a keyframe unless
+      // the previous data surely reaches the peer
+      CodecSerializerBase* codec = dynamic_cast<CodecSerializerBase*>(m_cdr);
+      if (codec != nullptr && mayDropPreviousData()) { codec->reset(); }
       cdr->isLittleEndian(isLittleEndian());
       cdr->serialize(data);
       RTC_TRACE(("connector endian: %s", isLittleEndian() ? "little":"big"));
       
       // NOTE: need cast to ByteDataStreamBase* to call the another write()
       DataPortStatus ret = write((ByteDataStreamBase*)cdr);
+      if (ret != DataPortStatus::PORT_OK && codec != nullptr)
+      {
+          codec->reset();
+      }
 
       return ret;
     }
 
     virtual BufferStatus read(ByteData &data);
 
+    /*!
+     * @if jp
+     * @brief 新しいデータを待ってから読み出す
+     *
+     * 未読のデータがない場合は最大 timeout だけ書き込みを待ち、その後
+     * read(ByteData&) と同様にバッファから読み出す。デフォルト実装は待
+     * たずに read(ByteData&) を呼ぶ。
+     *
+     * @param data 読み出したデータ
+     * @param timeout 待ち時間
+     * @return バッファの読み出し結果
+     *
+     * @else
+     * @brief Read data after waiting for new data
+     *
+     * If no unread data exist, this operation waits for writing up to
+     * timeout, and then reads the buffer as read(ByteData&). The
+     * default implementation calls read(ByteData&) without waiting.
+     *
+     * @param data Read data
+     * @param timeout Waiting time
+     * @return Result of reading the buffer
+     *
+     * @endif
+     */
+    virtual BufferStatus read(ByteData &data, std::chrono::nanoseconds timeout);
+
+    /*!
+     * @if jp
+     * @brief 新しいデータを最大 count 個読み出す
+     *
+     * read(ByteData&, std::chrono::nanoseconds) と同様に待った後、未読
+     * のデータのうち新しいものから最大 count 個を古い順に読み出す。そ
+     * れより古い未読のデータは読み飛ばされる。未読のデータがない場合は
+     * read(ByteData&) で一つ読み出す。
+     *
+     * @param data 読み出したデータ
+     * @param count 読み出す最大数
+     * @param timeout 待ち時間
+     * @return バッファの読み出し結果
+     *
+     * @else
+     * @brief Read up to count newest data
+     *
+     * After waiting as read(ByteData&, std::chrono::nanoseconds), up to
+     * count newest unread data are read, oldest first. Older unread
+     * data are skipped. If no unread data exist, one is read by
+     * read(ByteData&).
+     *
+     * @param data Read data
+     * @param count Maximum number of data to read
+     * @param timeout Waiting time
+     * @return Result of reading the buffer
+     *
+     * @endif
+     */
+    virtual BufferStatus readNewest(std::vector<ByteData>& data, size_t count,
+                                    std::chrono::nanoseconds timeout);
+
     bool setInPort(InPortBase* directInPort);
     /*!
      * @if jp
@@ -311,6 +382,32 @@ namespace RTC
      */
     virtual void unsubscribeInterface(const coil::Properties& prop);
   protected:
+    /*!
+     * @if jp
+     * @brief 前に書き込んだデータが送信されない可能性があるか
+     *
+     * バッファに未送信のデータが残っている場合、パブリッシャは
+     * push_policy に従ってそれを読み飛ばすことがある。また "skip" ポリ
+     * シでは読み出したデータも送信されないことがある。これらの場合、
+     * 前のデータに依存するコーデックは次のデータをキーフレームとして符
+     * 号化する。
+     *
+     * @return 送信されない可能性がある場合 true
+     *
+     * @else
+     * @brief Check if the previously written data may not be sent
+     *
+     * If unsent data remain in the buffer, the publisher may skip them
+     * according to push_policy. With the "skip" policy, data read from
+     * the buffer may not be sent either. In these cases codecs depending
+     * on the previous data encode the next data as a keyframe.
+     *
+     * @return true if the data may not be sent
+     *
+     * @endif
+     */
+    virtual bool mayDropPreviousData();
+
     /*!
      * @if jp
      * @brief ロガーストリーム
@@ -384,6 +481,7 @@ namespace RTC
      */
     std::string m_marshaling_type;
     ByteDataStreamBase* m_cdr;
+    bool m_skipPolicy;
 
   };
 } // namespace RTC
@@ -20,6 +20,7 @@
 #include <rtm/Manager.h>
 #include <rtm/OutPortCorbaCdrConsumer.h>
 #include <rtm/NVUtil.h>
+#include <coil/stringutil.h>
 
 namespace RTC
 {
@@ -51,9 +52,32 @@ namespace RTC
    * @brief Initializing configuration
    * @endif
    */
-  void OutPortCorbaCdrConsumer::init(coil::Properties&  /*prop*/)
+  void OutPortCorbaCdrConsumer::init(coil::Properties& prop)
   {
     RTC_TRACE(("OutPortCorbaCdrConsumer::init()"));
+
+    double timeout(0.0);
+    if (!coil::stringTo(timeout,
+                        prop.getProperty("corba_cdr.get_timeout", "0").c_str())
+        || !(timeout >= 0.0))
+      {
+        RTC_WARN(("Invalid corba_cdr.get_timeout: %s",
+                  prop["corba_cdr.get_timeout"].c_str()));
+        timeout = 0.0;
+      }
+    m_getTimeout = static_cast<CORBA::Double>(timeout);
+
+    unsigned long count(1);
+    if (!coil::stringTo(count,
+                        prop.getProperty("corba_cdr.get_count", "1").c_str())
+        || count == 0)
+      {
+        RTC_WARN(("Invalid corba_cdr.get_count: %s",
+                  prop["corba_cdr.get_count"].c_str()));
+        count = 1;
+      }
+    m_getCount = static_cast<CORBA::ULong>(count);
+    RTC_DEBUG(("get_timeout: %f, get_count: %u", m_getTimeout, m_getCount));
   }
 
   /*!
@@ -95,44 +119,52 @@ namespace RTC
   OutPortCorbaCdrConsumer::get(ByteData& data)
   {
     RTC_TRACE(("OutPortCorbaCdrConsumer::get()"));
-    ::OpenRTM::CdrData_var cdr_data;
+    if (!m_pending.empty())
+      {
+        RTC_PARANOID(("%u data pending.",
+                      static_cast<unsigned int>(m_pending.size())));
+        data = m_pending.front();
+        m_pending.pop_front();
+        store(data);
+        return DataPortStatus::PORT_OK;
+      }
 
     try
       {
-        ::OpenRTM::PortStatus ret(_ptr()->get(cdr_data.out()));
+        if (m_getCount > 1)
+          {
+            return getNewest(data);
+          }
+
+        ::OpenRTM::CdrData_var cdr_data;
+        ::OpenRTM::PortStatus ret;
+        if (m_getTimeout > 0.0)
+          {
+            ret = _ptr()->get_wait(m_getTimeout, cdr_data.out());
+          }
+        else
+          {
+            ret = _ptr()->get(cdr_data.out());
+          }
 
         if (ret == ::OpenRTM::PORT_OK)
           {
             RTC_DEBUG(("get() successful"));
-
-#ifdef ORB_IS_ORBEXPRESS
-            data.writeData(static_cast<unsigned char*>(cdr_data.get_buffer()), static_cast<CORBA::ULong>(cdr_data.length()));
-#elif defined(ORB_IS_TAO)
-            data.writeData(static_cast<unsigned char*>(cdr_data->get_buffer()), static_cast<CORBA::ULong>(cdr_data->length()));
-#elif defined(ORB_IS_RTORB)
-            data.writeData(reinterpret_cast<unsigned char*>(&(cdr_data[0])), static_cast<CORBA::ULong>(cdr_data->length()));
-#else
-            data.writeData(static_cast<unsigned char*>(&(cdr_data[0])), static_cast<CORBA::ULong>(cdr_data->length()));
-#endif
+            copyData(cdr_data.inout(), data);
             RTC_PARANOID(("CDR data length: %d", cdr_data->length()));
-
-            onReceived(data);
-            onBufferWrite(data);
-
-            if (m_buffer->full())
-              {
-                RTC_INFO(("InPort buffer is full."));
-                onBufferFull(data);
-                onReceiverFull(data);
-              }
-            m_buffer->put(data);
-            m_buffer->advanceWptr();
-            m_buffer->advanceRptr();
-
+            store(data);
             return DataPortStatus::PORT_OK;
           }
         return convertReturn(ret, data);
       }
+    catch (CORBA::BAD_OPERATION&)
+      {
+        // The OutPort is older one without get_wait() and get_newest().
+        RTC_WARN(("OutPort does not support long-poll. Use get() instead."));
+        m_getTimeout = 0.0;
+        m_getCount = 1;
+        return get(data);
+      }
     catch (...)
       {
         RTC_WARN(("Exception caought from OutPort::get()."));
@@ -220,6 +252,91 @@ namespace RTC
       }
   }
 
+  /*!
+   * @if jp
+   * @brief 新しいデータをまとめて取得する
+   *
+   * 取得した最も古いデータを返し、残りは以降の get() のために保持す
+   * る。
+   *
+   * @else
+   * @brief Get newest data at once
+   *
+   * The oldest data got is returned and the rest are kept for the
+   * following get().
+   *
+   * @endif
+   */
+  DataPortStatus
+  OutPortCorbaCdrConsumer::getNewest(ByteData& data)
+  {
+    ::OpenRTM::CdrDataSeq_var cdr_seq;
+    ::OpenRTM::PortStatus ret(_ptr()->get_newest(m_getCount, m_getTimeout,
+                                                 cdr_seq.out()));
+    if (ret != ::OpenRTM::PORT_OK)
+      {
+        return convertReturn(ret, data);
+      }
+
+    ::OpenRTM::CdrDataSeq& seq(cdr_seq.inout());
+    CORBA::ULong len(seq.length());
+    RTC_DEBUG(("get_newest() successful: %u data", len));
+    if (len == 0)
+      {
+        return convertReturn(::OpenRTM::BUFFER_EMPTY, data);
+      }
+    for (CORBA::ULong i(1); i < len; ++i)
+      {
+        m_pending.emplace_back();
+        copyData(seq[i], m_pending.back());
+      }
+    copyData(seq[0], data);
+    store(data);
+    return DataPortStatus::PORT_OK;
+  }
+
+  /*!
+   * @if jp
+   * @brief CdrData を ByteData にコピーする
+   * @else
+   * @brief Copy CdrData into ByteData
+   * @endif
+   */
+  void OutPortCorbaCdrConsumer::copyData(::OpenRTM::CdrData& cdr,
+                                         ByteData& data)
+  {
+#if defined(ORB_IS_ORBEXPRESS) || defined(ORB_IS_TAO)
+    data.writeData(static_cast<unsigned char*>(cdr.get_buffer()), static_cast<CORBA::ULong>(cdr.length()));
+#elif defined(ORB_IS_RTORB)
+    data.writeData(reinterpret_cast<unsigned char*>(&(cdr[0])), static_cast<CORBA::ULong>(cdr.length()));
+#else
+    data.writeData(static_cast<unsigned char*>(&(cdr[0])), static_cast<CORBA::ULong>(cdr.length()));
+#endif
+  }
+
+  /*!
+   * @if jp
+   * @brief 取得したデータをバッファに書き込む
+   * @else
+   * @brief Write the data got into the buffer
+   * @endif
+   */
+  void OutPortCorbaCdrConsumer::store(ByteData& data)
+  {
+    onReceived(data);
+    onBufferWrite(data);
+
+    if (m_buffer->full())
+      {
+        RTC_INFO(("InPort buffer is full."));
+        onBufferFull(data);
+        onReceiverFull(data);
+      }
+    m_buffer->put(data);
+    m_buffer->advanceWptr();
+    m_buffer->advanceRptr();
+  }
+
   /*!
    * @if jp
    * @brief リターンコード変換 (DataPortStatus -> BufferStatus)
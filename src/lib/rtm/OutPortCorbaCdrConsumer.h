@@ -26,6 +26,8 @@
 #include <rtm/ConnectorListener.h>
 #include <rtm/ConnectorBase.h>
 
+#include <deque>
+
 namespace RTC
 {
   /*!
@@ -98,6 +100,16 @@ namespace RTC
      * 能性がある。したがって、この関数は複数回呼ばれることを想定して記
      * 述されるべきである。
      *
+     * 以下のプロパティで OutPort からのデータ取得方法を指定できる。
+     *
+     * - corba_cdr.get_timeout: 0 より大きい場合、OutPort に未読データ
+     *   がなければ最大この秒数だけ新しいデータを待つ (long-poll)。待っ
+     *   ている間 InPort の read() はブロックする。待ち時間は OutPort
+     *   側の corba_cdr.max_get_timeout で制限される。(デフォルト: 0)
+     * - corba_cdr.get_count: 1 より大きい場合、一度の呼び出しで最大こ
+     *   の個数の新しいデータを取得し、以降の get() は取得済みのデータ
+     *   を返す。(デフォルト: 1)
+     *
      * @param prop 設定情報
      *
      * @else
@@ -111,6 +123,18 @@ namespace RTC
      * connection sequence respectivly.  Therefore, this function
      * should be implemented assuming multiple call.
      *
+     * The following properties specify how data are got from the
+     * OutPort.
+     *
+     * - corba_cdr.get_timeout: If greater than 0 and the OutPort has no
+     *   unread data, new data are waited for up to this seconds
+     *   (long-poll). InPort's read() blocks while waiting. The wait is
+     *   limited by corba_cdr.max_get_timeout of the OutPort side.
+     *   (default: 0)
+     * - corba_cdr.get_count: If greater than 1, up to this number of
+     *   newest data are got at once and the following get() return the
+     *   data already got. (default: 1)
+     *
      * @param prop Configuration information
      *
      * @endif
@@ -276,6 +300,33 @@ namespace RTC
     DataPortStatus convertReturn(::OpenRTM::PortStatus status,
                                               ByteData& data);
 
+    /*!
+     * @if jp
+     * @brief 新しいデータをまとめて取得する
+     * @else
+     * @brief Get newest data at once
+     * @endif
+     */
+    DataPortStatus getNewest(ByteData& data);
+
+    /*!
+     * @if jp
+     * @brief CdrData を ByteData にコピーする
+     * @else
+     * @brief Copy CdrData into ByteData
+     * @endif
+     */
+    static void copyData(::OpenRTM::CdrData& cdr, ByteData& data);
+
+    /*!
+     * @if jp
+     * @brief 取得したデータをバッファに書き込む
+     * @else
+     * @brief Write the data got into the buffer
+     * @endif
+     */
+    void store(ByteData& data);
+
     /*!
      * @if jp
      * @brief ON_BUFFER_WRITE のリスナへ通知する。
@@ -370,6 +421,9 @@ namespace RTC
     CdrBufferBase* m_buffer;
     ConnectorListenersBase* m_listeners;
     ConnectorInfo m_profile;
+    CORBA::Double m_getTimeout{0.0};
+    CORBA::ULong m_getCount{1};
+    std::deque<ByteData> m_pending;
   };
 } // namespace RTC
 
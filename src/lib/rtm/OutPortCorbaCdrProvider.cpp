@@ -54,6 +54,22 @@ namespace RTC
     CORBA_SeqUtil::
       push_back(m_properties,
                 NVUtil::newNV("dataport.corba_cdr.outport_ref", m_objref));
+
+    // the limit is taken from rtc.conf, since the connector profile is
+    // given by the InPort side
+    coil::Properties& config(::RTC::Manager::instance().getConfig());
+    double max_timeout(0.0);
+    if (!coil::stringTo(max_timeout,
+                        config.getProperty("corba_cdr.max_get_timeout",
+                                           "5.0").c_str())
+        || !(max_timeout >= 0.0))
+      {
+        RTC_WARN(("Invalid corba_cdr.max_get_timeout: %s",
+                  config["corba_cdr.max_get_timeout"].c_str()));
+        max_timeout = 5.0;
+      }
+    m_maxGetTimeout = std::chrono::duration_cast<std::chrono::nanoseconds>
+      (std::chrono::duration<double>(max_timeout));
   }
 
   /*!
@@ -98,6 +114,10 @@ namespace RTC
         // never throws exception
         RTC_ERROR(("Unknown exception caught."));
       }
+
+    // the connector wakes up waiting readers before deleting this
+    std::unique_lock<std::mutex> guard(m_callsMutex);
+    m_callsDone.wait(guard, [this] { return m_calls == 0; });
   }
 
   /*!
@@ -160,6 +180,7 @@ namespace RTC
   OutPortCorbaCdrProvider::get(::OpenRTM::CdrData_out data)
   {
     RTC_PARANOID(("OutPortCorbaCdrProvider::get()"));
+    CallGuard call(*this);
     // at least the output "data" area should be allocated
     data = new ::OpenRTM::CdrData();
 
@@ -169,11 +190,97 @@ namespace RTC
         return ::OpenRTM::UNKNOWN_ERROR;
       }
 
-    BufferStatus ret(m_connector->read(m_cdr));
+    ByteData cdr;
+    return copyData(m_connector->read(cdr), cdr, *data.ptr());
+  }
+
+  /*!
+   * @if jp
+   * @brief [CORBA interface] 新しいデータを待ってから取得する
+   * @else
+   * @brief [CORBA interface] Get data after waiting for new data
+   * @endif
+   */
+  ::OpenRTM::PortStatus
+  OutPortCorbaCdrProvider::get_wait(CORBA::Double timeout,
+                                    ::OpenRTM::CdrData_out data)
+  {
+    RTC_PARANOID(("OutPortCorbaCdrProvider::get_wait(%f)", timeout));
+    CallGuard call(*this);
+    data = new ::OpenRTM::CdrData();
+
+    if (m_connector == nullptr)
+      {
+        onSenderError();
+        return ::OpenRTM::UNKNOWN_ERROR;
+      }
+
+    ByteData cdr;
+    return copyData(m_connector->read(cdr, toTimeout(timeout)),
+                    cdr, *data.ptr());
+  }
+
+  /*!
+   * @if jp
+   * @brief [CORBA interface] 新しいデータを最大 count 個取得する
+   * @else
+   * @brief [CORBA interface] Get up to count newest data
+   * @endif
+   */
+  ::OpenRTM::PortStatus
+  OutPortCorbaCdrProvider::get_newest(CORBA::ULong count,
+                                      CORBA::Double timeout,
+                                      ::OpenRTM::CdrDataSeq_out data)
+  {
+    RTC_PARANOID(("OutPortCorbaCdrProvider::get_newest(%u, %f)",
+                  count, timeout));
+    CallGuard call(*this);
+    data = new ::OpenRTM::CdrDataSeq();
+
+    if (m_connector == nullptr)
+      {
+        onSenderError();
+        return ::OpenRTM::UNKNOWN_ERROR;
+      }
+
+    std::vector<ByteData> cdrs;
+    BufferStatus ret(m_connector->readNewest(cdrs, count,
+                                             toTimeout(timeout)));
+    if (ret != BufferStatus::OK || cdrs.empty())
+      {
+        ByteData empty;
+        return convertReturn(ret, empty);
+      }
 
-    if (ret == BufferStatus::OK)
+    ::OpenRTM::CdrDataSeq& seq(*data.ptr());
+    seq.length(static_cast<CORBA::ULong>(cdrs.size()));
+    CORBA::ULong len(0);
+    ::OpenRTM::PortStatus status(::OpenRTM::PORT_OK);
+    for (auto & cdr : cdrs)
       {
-        CORBA::ULong len(static_cast<CORBA::ULong>(m_cdr.getDataLength()));
+        status = copyData(ret, cdr, seq[len]);
+        if (status != ::OpenRTM::PORT_OK) { break; }
+        ++len;
+      }
+    seq.length(len);
+    RTC_PARANOID(("%u data got.", len));
+    return len > 0 ? ::OpenRTM::PORT_OK : status;
+  }
+
+  /*!
+   * @if jp
+   * @brief 読み出したデータを CdrData にコピーする
+   * @else
+   * @brief Copy the data read from the buffer into CdrData
+   * @endif
+   */
+  ::OpenRTM::PortStatus
+  OutPortCorbaCdrProvider::copyData(BufferStatus status, ByteData& cdr,
+                                    ::OpenRTM::CdrData& data)
+  {
+    if (status == BufferStatus::OK)
+      {
+        CORBA::ULong len(static_cast<CORBA::ULong>(cdr.getDataLength()));
         RTC_PARANOID(("converted CDR data size: %d", len));
 
         if (len == static_cast<CORBA::ULong>(0)) {
@@ -181,16 +288,40 @@ namespace RTC
           return ::OpenRTM::BUFFER_EMPTY;
         }
 #ifndef ORB_IS_RTORB
-        data->length(len);
-        m_cdr.readData(static_cast<unsigned char*>(data->get_buffer()), len);
+        data.length(len);
+        cdr.readData(static_cast<unsigned char*>(data.get_buffer()), len);
 #else
-        data->length(len);
-        m_cdr.readData(reinterpret_cast<unsigned char*>(&(*data)[0]),
-                                        static_cast<int>(len));
+        data.length(len);
+        cdr.readData(reinterpret_cast<unsigned char*>(&data[0]),
+                                      static_cast<int>(len));
 #endif  // ORB_IS_RTORB
       }
 
-    return convertReturn(ret, m_cdr);
+    return convertReturn(status, cdr);
+  }
+
+  /*!
+   * @if jp
+   * @brief 秒単位の待ち時間を変換する
+   *
+   * 負の値や非数は待たないことを意味する。corba_cdr.max_get_timeout
+   * より長い値 (無限大を含む) はその値に制限する。
+   *
+   * @else
+   * @brief Convert the waiting time in seconds
+   *
+   * Negative values and NaN mean no waiting. Values longer than
+   * corba_cdr.max_get_timeout, including infinity, are limited to it.
+   *
+   * @endif
+   */
+  std::chrono::nanoseconds
+  OutPortCorbaCdrProvider::toTimeout(CORBA::Double timeout) const
+  {
+    if (!(timeout > 0.0)) { return std::chrono::nanoseconds(0); }
+    std::chrono::duration<double> wait(timeout);
+    if (wait >= m_maxGetTimeout) { return m_maxGetTimeout; }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(wait);
   }
 
   /*!
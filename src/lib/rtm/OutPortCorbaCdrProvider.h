@@ -28,6 +28,11 @@
 #include <rtm/ConnectorListener.h>
 #include <rtm/ConnectorBase.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 namespace RTC
 {
   /*!
@@ -238,6 +243,67 @@ namespace RTC
      */
     ::OpenRTM::PortStatus get(::OpenRTM::CdrData_out data) override;
 
+    /*!
+     * @if jp
+     * @brief [CORBA interface] 新しいデータを待ってから取得する
+     *
+     * 未読のデータがない場合は最大 timeout 秒だけ OutPort への書き込み
+     * を待ち、その後 get() と同様にバッファからデータを取得する。InPort
+     * 側がポーリングせずに新しいデータを受け取るために使用する。
+     * timeout は rtc.conf の corba_cdr.max_get_timeout (デフォルト 5 秒)
+     * で制限される。
+     *
+     * @param timeout 待ち時間 [s]
+     * @param data 取得データ
+     * @return リターンコード
+     *
+     * @else
+     * @brief [CORBA interface] Get data after waiting for new data
+     *
+     * If no unread data exist, this operation waits for writing to the
+     * OutPort up to timeout seconds, and then gets data from the buffer
+     * as get(). It is used by the InPort side to receive new data
+     * without polling. The timeout is limited by
+     * corba_cdr.max_get_timeout of rtc.conf (5 seconds by default).
+     *
+     * @param timeout Waiting time [s]
+     * @param data Data got from the buffer
+     * @return Return code
+     *
+     * @endif
+     */
+    ::OpenRTM::PortStatus get_wait(CORBA::Double timeout,
+                                   ::OpenRTM::CdrData_out data) override;
+
+    /*!
+     * @if jp
+     * @brief [CORBA interface] 新しいデータを最大 count 個取得する
+     *
+     * get_wait() と同様に待った後、未読のデータのうち新しいものから最
+     * 大 count 個を古い順に取得する。それより古い未読のデータは読み飛
+     * ばされる。
+     *
+     * @param count 取得する最大数
+     * @param timeout 待ち時間 [s]
+     * @param data 取得データ
+     * @return リターンコード
+     *
+     * @else
+     * @brief [CORBA interface] Get up to count newest data
+     *
+     * After waiting as get_wait(), up to count newest unread data are
+     * got, oldest first. Older unread data are skipped.
+     *
+     * @param count Maximum number of data
+     * @param timeout Waiting time [s]
+     * @param data Data got from the buffer
+     * @return Return code
+     *
+     * @endif
+     */
+    ::OpenRTM::PortStatus get_newest(CORBA::ULong count,
+                                     CORBA::Double timeout,
+                                     ::OpenRTM::CdrDataSeq_out data) override;
 
   private:
     /*!
@@ -250,6 +316,64 @@ namespace RTC
     ::OpenRTM::PortStatus convertReturn(BufferStatus status,
                                         ByteData& data);
 
+    /*!
+     * @if jp
+     * @brief 読み出したデータを CdrData にコピーする
+     * @else
+     * @brief Copy the data read from the buffer into CdrData
+     * @endif
+     */
+    ::OpenRTM::PortStatus copyData(BufferStatus status, ByteData& cdr,
+                                   ::OpenRTM::CdrData& data);
+
+    /*!
+     * @if jp
+     * @brief 秒単位の待ち時間を変換する
+     * @else
+     * @brief Convert the waiting time in seconds
+     * @endif
+     */
+    std::chrono::nanoseconds toTimeout(CORBA::Double timeout) const;
+
+    /*!
+     * @if jp
+     * @brief 実行中の CORBA オペレーションを数える
+     *
+     * get_wait() などはデータを待つ間コネクタのバッファを参照し続ける。
+     * デストラクタは実行中のオペレーションがなくなるまで待つため、コネ
+     * クタは disconnect() でプロバイダを削除した後にバッファを削除でき
+     * る。
+     *
+     * @else
+     * @brief Count the CORBA operations in progress
+     *
+     * get_wait() and so on keep referring to the buffer of the connector
+     * while waiting for data. The destructor waits until no operation is
+     * in progress, so the connector can delete the buffer after deleting
+     * the provider in disconnect().
+     *
+     * @endif
+     */
+    class CallGuard
+    {
+    public:
+      explicit CallGuard(OutPortCorbaCdrProvider& provider)
+        : m_provider(provider)
+      {
+        std::lock_guard<std::mutex> guard(m_provider.m_callsMutex);
+        ++m_provider.m_calls;
+      }
+      ~CallGuard()
+      {
+        std::lock_guard<std::mutex> guard(m_provider.m_callsMutex);
+        if (--m_provider.m_calls == 0) { m_provider.m_callsDone.notify_all(); }
+      }
+      CallGuard(const CallGuard&) = delete;
+      CallGuard& operator=(const CallGuard&) = delete;
+    private:
+      OutPortCorbaCdrProvider& m_provider;
+    };
+
 
     /*!
      * @if jp
@@ -345,7 +469,11 @@ namespace RTC
     ConnectorListenersBase* m_listeners;
     ConnectorInfo m_profile;
     OutPortConnector* m_connector{nullptr};
-    ByteData m_cdr;
+    // upper limit of the waiting time requested by the InPort side
+    std::chrono::nanoseconds m_maxGetTimeout{std::chrono::seconds(5)};
+    std::mutex m_callsMutex;
+    std::condition_variable m_callsDone;
+    size_t m_calls{0};
   };  // class OutPortCorbaCdrProvider
 } // namespace RTC
 
@@ -107,6 +107,10 @@ namespace RTC
     }
 
     m_buffer->write(*data);
+    {
+      std::lock_guard<std::mutex> guard(m_arrivalMutex);
+    }
+    m_arrival.notify_all();
 
     if (m_sync_readwrite)
     {
@@ -183,6 +187,72 @@ namespace RTC
       return ret;
   }
 
+  /*!
+   * @if jp
+   * @brief 新しいデータを待ってから読み出す
+   * @else
+   * @brief Read data after waiting for new data
+   * @endif
+   */
+  BufferStatus
+  OutPortPullConnector::read(ByteData& data, std::chrono::nanoseconds timeout)
+  {
+    if (m_buffer == nullptr)
+      {
+        return BufferStatus::PRECONDITION_NOT_MET;
+      }
+    if (!m_sync_readwrite) { waitReadable(timeout); }
+    return read(data);
+  }
+
+  /*!
+   * @if jp
+   * @brief 新しいデータを最大 count 個読み出す
+   * @else
+   * @brief Read up to count newest data
+   * @endif
+   */
+  BufferStatus
+  OutPortPullConnector::readNewest(std::vector<ByteData>& data, size_t count,
+                                   std::chrono::nanoseconds timeout)
+  {
+    if (m_buffer == nullptr)
+      {
+        data.clear();
+        return BufferStatus::PRECONDITION_NOT_MET;
+      }
+    if (m_sync_readwrite || count <= 1)
+      {
+        return OutPortConnector::readNewest(data, count, timeout);
+      }
+
+    waitReadable(timeout);
+    size_t readable(m_buffer->readable());
+    if (readable == 0)
+      {
+        // the empty policy of the buffer decides the result
+        return OutPortConnector::readNewest(data, 1,
+                                            std::chrono::nanoseconds::zero());
+      }
+    if (readable > count)
+      {
+        m_buffer->advanceRptr(static_cast<long int>(readable - count));
+        readable = count;
+      }
+
+    data.resize(readable);
+    for (size_t i(0); i < readable; ++i)
+      {
+        BufferStatus ret(m_buffer->read(data[i]));
+        if (ret != BufferStatus::OK)
+          {
+            data.resize(i);
+            return i == 0 ? ret : BufferStatus::OK;
+          }
+      }
+    return BufferStatus::OK;
+  }
+
   /*!
    * @if jp
    * @brief 接続解除関数
@@ -193,7 +263,21 @@ namespace RTC
   DataPortStatus OutPortPullConnector::disconnect()
   {
     RTC_TRACE(("disconnect()"));
-    // delete provider
+    // wake up the readers waiting for new data
+    {
+      std::lock_guard<std::mutex> guard(m_arrivalMutex);
+      m_closing = true;
+    }
+    m_arrival.notify_all();
+    if (m_sync_readwrite)
+      {
+        // release the readers waiting for a write
+        std::lock_guard<std::mutex> guard(m_writecompleted_worker.mutex_);
+        m_writecompleted_worker.completed_ = true;
+        m_writecompleted_worker.cond_.notify_all();
+      }
+
+    // delete provider, which waits for the readers to return
     if (m_provider != nullptr)
       {
         OutPortProviderFactory& cfactory(OutPortProviderFactory::instance());
@@ -212,6 +296,23 @@ namespace RTC
     return DataPortStatus::PORT_OK;
   }
 
+  /*!
+   * @if jp
+   * @brief 未読のデータが書き込まれるまで待つ
+   * @else
+   * @brief Wait until unread data are written
+   * @endif
+   */
+  void OutPortPullConnector::waitReadable(std::chrono::nanoseconds timeout)
+  {
+    if (timeout <= std::chrono::nanoseconds::zero()) { return; }
+    std::unique_lock<std::mutex> guard(m_arrivalMutex);
+    m_arrival.wait_for(guard, timeout, [this]
+      {
+        return m_closing || m_buffer == nullptr || m_buffer->readable() > 0;
+      });
+  }
+
   /*!
    * @if jp
    * @brief Buffer を取得する
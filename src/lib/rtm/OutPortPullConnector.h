@@ -23,6 +23,9 @@
 #include <rtm/OutPortConnector.h>
 #include <rtm/ConnectorListener.h>
 
+#include <condition_variable>
+#include <mutex>
+
 namespace RTC
 {
   class OutPortProvider;
@@ -165,6 +168,34 @@ namespace RTC
 
     BufferStatus read(ByteData &data) override;
 
+    /*!
+     * @if jp
+     * @brief 新しいデータを待ってから読み出す
+     *
+     * バッファに未読のデータが書き込まれるか timeout が経過するまで待
+     * ち、read(ByteData&) で読み出す。sync_readwrite の場合は待たない。
+     *
+     * @else
+     * @brief Read data after waiting for new data
+     *
+     * This operation waits until unread data are written into the
+     * buffer or timeout elapses, and reads by read(ByteData&). It does
+     * not wait if sync_readwrite is enabled.
+     *
+     * @endif
+     */
+    BufferStatus read(ByteData &data, std::chrono::nanoseconds timeout) override;
+
+    /*!
+     * @if jp
+     * @brief 新しいデータを最大 count 個読み出す
+     * @else
+     * @brief Read up to count newest data
+     * @endif
+     */
+    BufferStatus readNewest(std::vector<ByteData>& data, size_t count,
+                            std::chrono::nanoseconds timeout) override;
+
     /*!
      * @if jp
      * @brief 接続解除
@@ -284,7 +315,13 @@ namespace RTC
      */
     CdrBufferBase* m_buffer;
   private:
+      void waitReadable(std::chrono::nanoseconds timeout);
+
       bool m_sync_readwrite;
+      // wakes up the readers waiting for new data
+      std::mutex m_arrivalMutex;
+      std::condition_variable m_arrival;
+      bool m_closing{false};
 
       struct WorkerThreadCtrl
       {
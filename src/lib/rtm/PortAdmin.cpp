@@ -161,6 +161,31 @@ namespace RTC
     return port_profs;
   }
 
+  /*!
+   * @if jp
+   * @brief PorProfile リストの世代番号の取得
+   * @else
+   * @brief Get the generation number of the PortProfileList
+   * @endif
+   */
+  bool PortAdmin::getProfileGeneration(unsigned long& generation) const
+  {
+    std::vector<PortBase*> ports(m_portServants.getObjects());
+    if (ports.size() != m_portRefs.length())
+      {
+        return false;
+      }
+    // the sum of monotonic counters changes whenever one of them changes
+    generation = m_generation;
+    for (auto & port : ports)
+      {
+        // dynamic connector statistics bump the generation when changed
+        port->updateConnectorProperties();
+        generation += port->getProfileGeneration();
+      }
+    return true;
+  }
+
   /*!
    * @if jp
    * @brief Port のオブジェクト参照の取得
@@ -170,15 +195,10 @@ namespace RTC
    */
   PortService_ptr PortAdmin::getPortRef(const char* port_name) const
   {
-    CORBA::Long index;
-    index = CORBA_SeqUtil::find(m_portRefs, find_port_name(port_name));
-    if (index >= 0)
+    auto it = m_portRefIndex.find(port_name);
+    if (it != m_portRefIndex.end())
       {
-#ifdef ORB_IS_ORBEXPRESS
-        return RTC::PortService::_duplicate(m_portRefs[index].in());
-#else
-        return RTC::PortService::_duplicate(m_portRefs[index]);
-#endif
+        return RTC::PortService::_duplicate(it->second.in());
       }
     return RTC::PortService::_nil();
   }
@@ -205,15 +225,18 @@ namespace RTC
   bool PortAdmin::addPort(PortBase& port)
   {
     // Check for duplicate
-    if (CORBA_SeqUtil::find(m_portRefs, find_port_name(port.getName())) != -1)
+    std::string name(port.getName());
+    if (m_portRefIndex.find(name) != m_portRefIndex.end())
       {
         return false;
       }
 
     // Store Port's ref to PortServiceList
     CORBA_SeqUtil::push_back(m_portRefs, port.getPortRef());
+    m_portRefIndex[name] = port.getPortRef();
 
     // Store Port servant
+    ++m_generation;
     return m_portServants.registerObject(&port);
   }
 
@@ -236,16 +259,18 @@ namespace RTC
 #ifdef ORB_IS_RTORB
         delete prof._retn();
 #endif
-        if (CORBA_SeqUtil::find(m_portRefs, find_port_name(name.c_str())) != -1)
+        if (m_portRefIndex.find(name) != m_portRefIndex.end())
           {
             return false;
           }
+        m_portRefIndex[name] = RTC::PortService::_duplicate(port);
       }
     catch (...)
       {
         return false;
       }
     CORBA_SeqUtil::push_back(m_portRefs, RTC::PortService::_duplicate(port));
+    ++m_generation;
     return true;
   }
 
@@ -279,12 +304,19 @@ namespace RTC
         port.disconnect_all();
 
         const char* tmp(port.getProfile().name);
-        CORBA_SeqUtil::erase_if(m_portRefs, find_port_name(tmp));
+        auto it = m_portRefIndex.find(tmp);
+        if (it != m_portRefIndex.end())
+          {
+            CORBA_SeqUtil::erase_if(m_portRefs, find_port(it->second.in()));
+            m_portRefIndex.erase(it);
+          }
 
         PortableServer::ObjectId_var oid = m_pPOA->servant_to_id(&port);
         m_pPOA->deactivate_object(oid);
         port.setPortRef(RTC::PortService::_nil());
 
+        // keep the generation monotonic after the port's counter is gone
+        m_generation += port.getProfileGeneration() + 1;
         return m_portServants.unregisterObject(tmp) != nullptr;
       }
     catch (...)
@@ -298,6 +330,15 @@ namespace RTC
     try
       {
         CORBA_SeqUtil::erase_if(m_portRefs, find_port(port));
+        for (auto it = m_portRefIndex.begin(); it != m_portRefIndex.end(); ++it)
+          {
+            if (port->_is_equivalent(it->second.in()))
+              {
+                m_portRefIndex.erase(it);
+                break;
+              }
+          }
+        ++m_generation;
         return true;
       }
     catch (...)
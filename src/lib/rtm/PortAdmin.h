@@ -26,6 +26,7 @@
 #include <rtm/SystemLogger.h>
 
 #include <string>
+#include <unordered_map>
 
 namespace RTC
 {
@@ -134,6 +135,37 @@ namespace RTC
      */
     PortProfileList getPortProfileList() const;
 
+    /*!
+     * @if jp
+     *
+     * @brief PorProfile リストの世代番号の取得
+     *
+     * Port の追加・削除、および各 Port の PortProfile の変更の度に増加
+     * する番号を取得する。この番号が変化しない限り getPortProfileList()
+     * の結果は変化しない。addPort(PortService_ptr) により登録された外部
+     * の Port は変更を検出できないため、その場合は false を返す。
+     *
+     * @param generation 世代番号
+     * @return 世代番号が有効な場合 true
+     *
+     * @else
+     *
+     * @brief Get the generation number of the PortProfileList
+     *
+     * This operation gets a number which is incremented whenever a
+     * Port is added or removed, or the PortProfile of a Port is
+     * changed. The result of getPortProfileList() does not change as
+     * long as this number is unchanged. Since changes of external
+     * Ports registered by addPort(PortService_ptr) cannot be detected,
+     * false is returned in that case.
+     *
+     * @param generation The generation number
+     * @return true if the generation number is valid
+     *
+     * @endif
+     */
+    bool getProfileGeneration(unsigned long& generation) const;
+
     /*!
      * @if jp
      *
@@ -515,6 +547,24 @@ namespace RTC
      */
     PortServiceList m_portRefs;
 
+    /*!
+     * @if jp
+     * @brief Port の追加・削除の世代番号
+     * @else
+     * @brief Generation number of adding and removing Ports
+     * @endif
+     */
+    unsigned long m_generation{0};
+
+    /*!
+     * @if jp
+     * @brief Port名からオブジェクトリファレンスへの索引
+     * @else
+     * @brief Index from Port names to object references
+     * @endif
+     */
+    std::unordered_map<std::string, PortService_var> m_portRefIndex;
+
     /*!
      * @if jp
      * @brief ロガーストリーム
@@ -548,6 +598,10 @@ namespace RTC
         std::string name(static_cast<const char*>(obj->getProfile().name));
         return m_name == name;
       }
+      const std::string& key() const
+      {
+        return m_name;
+      }
     private:
       std::string m_name;
     };
@@ -23,6 +23,7 @@
 #include <rtm/PortBase.h>
 #include <rtm/PortCallback.h>
 #include <rtm/CORBA_RTCUtil.h>
+#include <rtm/ByteDataCodec.h>
 
 namespace RTC
 {
@@ -99,6 +100,7 @@ namespace RTC
     RTC_TRACE(("get_port_profile()"));
 
     updateConnectors();
+    updateConnectorProperties();
     std::lock_guard<std::mutex> guard(m_profile_mutex);
     PortProfile_var prof;
     prof = new PortProfile(m_profile);
@@ -131,6 +133,7 @@ namespace RTC
     RTC_TRACE(("get_connector_profiles()"));
 
     updateConnectors();
+    updateConnectorProperties();
 
     std::lock_guard<std::mutex> guard(m_profile_mutex);
     ConnectorProfileList_var conn_prof;
@@ -150,6 +153,7 @@ namespace RTC
     RTC_TRACE(("get_connector_profile(%s)", connector_id));
 
     updateConnectors();
+    updateConnectorProperties();
 
     std::lock_guard<std::mutex> guard(m_profile_mutex);
     CORBA::Long index(findConnProfileIndex(connector_id));
@@ -223,10 +227,7 @@ namespace RTC
     RTC_TRACE(("notify_connect()"));
     std::lock_guard<std::mutex> connectors_guard(m_connectorsMutex);
 
-
-
-    Properties prop;
-    NVUtil::copyToProperties(prop, connector_profile.properties);
+    const Properties& prop(getConnectorProperties(connector_profile));
 #ifndef ORB_IS_RTORB
     bool default_value = coil::toBool(m_properties["allow_dup_connection"], "YES", "NO", false);
 #else
@@ -289,6 +290,8 @@ namespace RTC
         RTC_ERROR(("subscribeInterfaces() in notify_connect() failed."));
       }
     onSubscribeInterfaces(getName(), connector_profile, retval[2]);
+    m_connectorProperties.clear();
+    m_connectorPropertiesId.clear();
 
     RTC_PARANOID(("%d connectors are existing",
                   m_profile.connector_profiles.length()));
@@ -306,6 +309,7 @@ namespace RTC
         m_profile.connector_profiles[index] = connector_profile;
         RTC_PARANOID(("Existing connector_id. Updated."));
       }
+    ++m_profileGeneration;
 
     for (int i(0), len(sizeof(retval)/sizeof(ReturnCode_t)); i < len; ++i)
       {
@@ -463,6 +467,7 @@ namespace RTC
         m_profile.connector_profiles._length = len-1;
       }
 #endif  // ORB_IS_RTORB
+    ++m_profileGeneration;
     onDisconnected(getName(), prof, retval);
     return retval;
   }
@@ -512,6 +517,7 @@ namespace RTC
     RTC_TRACE(("setName(%s)", name));
     std::lock_guard<std::mutex> guard(m_profile_mutex);
     m_profile.name = CORBA::string_dup(name);
+    ++m_profileGeneration;
     rtclog.setName(name);
   }
 
@@ -555,6 +561,7 @@ namespace RTC
     RTC_TRACE(("setPortRef()"));
     std::lock_guard<std::mutex> guard(m_profile_mutex);
     m_profile.port_ref = port_ref;
+    ++m_profileGeneration;
   }
 
   /*!
@@ -598,6 +605,7 @@ namespace RTC
 
       m_profile.owner = RTC::RTObject::_duplicate(owner);
       m_profile.name = CORBA::string_dup(portname.c_str());
+      ++m_profileGeneration;
     }
   }
 
@@ -661,7 +669,19 @@ namespace RTC
       {
         RTC::PortService_ptr p;
         p = connector_profile.ports[index];
-        return p->notify_connect(connector_profile);
+        // the step is bounded by the timeout given by the initiator
+        CORBA_RTCUtil::ScopedCallTimeout timeout(
+          CORBA_RTCUtil::get_connect_step_timeout(connector_profile.properties));
+        try
+          {
+            return p->notify_connect(connector_profile);
+          }
+        catch (CORBA::SystemException&)
+          {
+            // reported as an error so that the connection is cleaned up
+            RTC_ERROR(("notify_connect() of the next port failed."));
+            return RTC::RTC_ERROR;
+          }
       }
     return RTC::RTC_OK;
   }
@@ -839,6 +859,7 @@ namespace RTC
       {
         m_profile.connector_profiles[index] = connector_profile;
       }
+    ++m_profileGeneration;
   }
 
   /*!
@@ -856,6 +877,7 @@ namespace RTC
     if (index < 0) return false;
 
     CORBA_SeqUtil::erase(m_profile.connector_profiles, index);
+    ++m_profileGeneration;
     return true;
   }
 
@@ -881,6 +903,7 @@ namespace RTC
     prof.type_name     = CORBA::string_dup(type_name);
     prof.polarity      = pol;
     CORBA_SeqUtil::push_back(m_profile.interfaces, prof);
+    ++m_profileGeneration;
 
     return true;
   }
@@ -901,6 +924,7 @@ namespace RTC
     if (index < 0) return false;
 
     CORBA_SeqUtil::erase(m_profile.interfaces, index);
+    ++m_profileGeneration;
     return true;
   }
 
@@ -952,6 +976,17 @@ namespace RTC
       }
   }
 
+  /*!
+   * @if jp
+   * @brief ConnectorProfile のプロパティを更新する
+   * @else
+   * @brief Update the properties of the ConnectorProfiles
+   * @endif
+   */
+  void PortBase::updateConnectorProperties()
+  {
+  }
+
   /*!
    * @if jp
    * @brief ポートの存在を確認する。
@@ -1005,6 +1040,18 @@ namespace RTC
       return m_directport;
   }
 
+  /*!
+   * @if jp
+   * @brief PortProfile の世代番号を取得する
+   * @else
+   * @brief Get the generation number of the PortProfile
+   * @endif
+   */
+  unsigned long PortBase::getProfileGeneration() const
+  {
+    return m_profileGeneration;
+  }
+
 
   /*!
    * @if jp
@@ -1027,21 +1074,54 @@ namespace RTC
   {
       std::string marshaling_type{ coil::eraseBothEndsBlank(con_prop.getProperty("marshaling_type", "cdr")) };
 
-      Properties prop;
-      NVUtil::copyToProperties(prop, m_profile.properties);
-      coil::vstring enabledSerializerTypes{coil::split(prop["dataport.marshaling_types"], ",", true) };
-
+      unsigned long generation(m_profileGeneration);
+      if (generation != m_portPropertiesGeneration)
+        {
+          m_portProperties.clear();
+          m_portPropertiesGeneration = generation;
+        }
+      const Properties& prop(m_portProperties.update(m_profile.properties));
+      coil::vstring enabledSerializerTypes{coil::split(prop.getProperty("dataport.marshaling_types"), ",", true) };
 
+      // "cdr+lz4": the serializer and all codecs should be available
+      coil::vstring codecs;
+      std::string serializer_type{ ByteDataCodecChain::splitMarshalingType(marshaling_type, codecs) };
 
-      coil::vstring::iterator it = std::find(enabledSerializerTypes.begin(), enabledSerializerTypes.end(), marshaling_type);
+      coil::vstring::iterator it = std::find(enabledSerializerTypes.begin(), enabledSerializerTypes.end(), serializer_type);
       size_t index = std::distance(enabledSerializerTypes.begin(), it);
       if (index == enabledSerializerTypes.size())
       {
           RTC_ERROR(("%s is illegal marshaling type.", marshaling_type.c_str()));
           return false;
       }
+      for (auto const& codec : codecs)
+      {
+          if (!ByteDataCodecFactory::instance().hasFactory(codec))
+          {
+              RTC_ERROR(("%s: codec %s is not available.", marshaling_type.c_str(), codec.c_str()));
+              return false;
+          }
+      }
       return true;
 
   }
 
+  /*!
+   * @if jp
+   * @brief ConnectorProfile::properties を Properties として取得する
+   * @else
+   * @brief Get ConnectorProfile::properties as the properties
+   * @endif
+   */
+  const coil::Properties&
+  PortBase::getConnectorProperties(const ConnectorProfile& cprof)
+  {
+    if (m_connectorPropertiesId != static_cast<const char*>(cprof.connector_id))
+      {
+        m_connectorProperties.clear();
+        m_connectorPropertiesId = static_cast<const char*>(cprof.connector_id);
+      }
+    return m_connectorProperties.update(cprof.properties);
+  }
+
 } // namespace RTC
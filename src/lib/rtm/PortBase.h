@@ -22,6 +22,7 @@
 
 #include <rtm/RTC.h>
 
+#include <atomic>
 #include <mutex>
 #include <rtm/idl/RTCSkel.h>
 #include <rtm/CORBA_SeqUtil.h>
@@ -1273,6 +1274,55 @@ namespace RTC
      * @endif
      */
     virtual DirectPortBase* getDirectPort();
+
+    /*!
+     * @if jp
+     * @brief PortProfile の世代番号を取得する
+     *
+     * PortProfile の名前、インターフェース、コネクタプロファイル、プロ
+     * パティなどが変更される度に増加する番号を返す。PortProfile のキャッ
+     * シュが有効かどうかを判定するために用いる。
+     *
+     * @return PortProfile の世代番号
+     *
+     * @else
+     * @brief Get the generation number of the PortProfile
+     *
+     * This operation returns a number which is incremented whenever
+     * the name, interfaces, connector profiles, properties and so on
+     * of the PortProfile are changed. It is used to check if a cached
+     * PortProfile is still valid.
+     *
+     * @return The generation number of the PortProfile
+     *
+     * @endif
+     */
+    unsigned long getProfileGeneration() const;
+
+    /*!
+     * @if jp
+     *
+     * @brief ConnectorProfile のプロパティを更新する
+     *
+     * ConnectorProfile を返す前、および PortAdmin がプロファイルの世代
+     * 番号を取得する前に呼ばれ、コネクタが持つ統計情報などを
+     * ConnectorProfile のプロパティに反映する。プロパティを変更した場合
+     * は世代番号を進めること。デフォルト実装は何もしない。
+     *
+     * @else
+     *
+     * @brief Update the properties of the ConnectorProfiles
+     *
+     * This is called before returning ConnectorProfiles and before
+     * PortAdmin gets the profile generation, and reflects statistics and
+     * so on held by the connectors in the properties of the
+     * ConnectorProfiles. The generation must be advanced when the
+     * properties are changed. The default implementation does nothing.
+     *
+     * @endif
+     */
+    virtual void updateConnectorProperties();
+
     //============================================================
     // protected operations
     //============================================================
@@ -1878,6 +1928,7 @@ namespace RTC
     {
       CORBA_SeqUtil::push_back(m_profile.properties,
                                NVUtil::newNV(key, value));
+      ++m_profileGeneration;
     }
 
     /*!
@@ -1908,6 +1959,7 @@ namespace RTC
     void appendProperty(const char* key, const char* value)
     {
       NVUtil::appendStringValue(m_profile.properties, key, value);
+      ++m_profileGeneration;
     }
     /*!
      * @if jp
@@ -2079,6 +2131,38 @@ namespace RTC
    * @endif
    */
     bool isExistingMarshalingType(coil::Properties& con_prop);
+
+    /*!
+     * @if jp
+     *
+     * @brief ConnectorProfile::properties を Properties として取得する
+     *
+     * notify_connect() の処理中に同じ接続のプロパティを何度も変換しな
+     * いよう、変換結果を接続IDごとにキャッシュし、NVList に追加された
+     * 要素のみを変換する。m_connectorsMutex をロックした状態で呼び出す
+     * こと。返される参照は次の呼び出しまで有効である。
+     *
+     * @param cprof ConnectorProfile
+     * @return ConnectorProfile::properties を変換した Properties
+     *
+     * @else
+     *
+     * @brief Get ConnectorProfile::properties as the properties
+     *
+     * Not to convert the properties of the same connection many times
+     * in notify_connect(), the converted properties are cached for
+     * each connector ID and only the elements appended to the NVList
+     * are converted. This function must be called with
+     * m_connectorsMutex locked. The returned reference is valid until
+     * the next call.
+     *
+     * @param cprof ConnectorProfile
+     * @return Properties converted from ConnectorProfile::properties
+     *
+     * @endif
+     */
+    const coil::Properties&
+    getConnectorProperties(const ConnectorProfile& cprof);
     /*!
      * @if jp
      * @brief ロガーストリーム
@@ -2096,6 +2180,15 @@ namespace RTC
      */
     PortProfile m_profile;
 
+    /*!
+     * @if jp
+     * @brief PortProfile の世代番号
+     * @else
+     * @brief Generation number of the PortProfile
+     * @endif
+     */
+    std::atomic<unsigned long> m_profileGeneration{0};
+
     /*!
      * @if jp
      * @brief Port の オブジェクト参照
@@ -2114,6 +2207,26 @@ namespace RTC
     mutable std::mutex m_profile_mutex;
     mutable std::mutex m_connectorsMutex;
 
+    /*!
+     * @if jp
+     * @brief 接続処理中の ConnectorProfile::properties のキャッシュ
+     * @else
+     * @brief Cache of ConnectorProfile::properties in connection process
+     * @endif
+     */
+    NVUtil::PropertiesCache m_connectorProperties;
+    std::string m_connectorPropertiesId;
+
+    /*!
+     * @if jp
+     * @brief PortProfile::properties のキャッシュ
+     * @else
+     * @brief Cache of PortProfile::properties
+     * @endif
+     */
+    NVUtil::PropertiesCache m_portProperties;
+    unsigned long m_portPropertiesGeneration{0};
+
     /*!
      * @if jp
      * @brief インスタンス名
@@ -24,6 +24,7 @@
 #include <rtm/PublisherNew.h>
 #include <rtm/InPortConsumer.h>
 #include <rtm/PeriodicTaskFactory.h>
+#include <rtm/PublisherScheduler.h>
 #include <rtm/idl/DataPortSkel.h>
 #include <rtm/ConnectorListener.h>
 
@@ -328,7 +329,7 @@ namespace RTC
     RTC_PARANOID(("Task creation succeeded."));
 
     // setting task function
-    m_task->setTask([this]{ svc(); });
+    PublisherScheduler::instance().setupTask(m_task, prop, [this]{ svc(); });
     m_task->setPeriod(std::chrono::seconds(0));
     m_task->executionMeasure(coil::toBool(prop["measurement.exec_time"],
                                     "enable", "disable", true));
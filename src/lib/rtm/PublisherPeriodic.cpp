@@ -23,6 +23,7 @@
 #include <rtm/InPortConsumer.h>
 #include <rtm/idl/DataPortSkel.h>
 #include <rtm/PeriodicTaskFactory.h>
+#include <rtm/PublisherScheduler.h>
 #include <rtm/SystemLogger.h>
 
 #include <cstdlib>
@@ -454,7 +455,7 @@ namespace RTC
                    prop.getProperty("thread_type", "default").c_str()));
         return false;
       }
-    m_task->setTask([this]{ svc(); });
+    PublisherScheduler::instance().setupTask(m_task, prop, [this]{ svc(); });
     RTC_PARANOID(("Task creation succeeded."));
 
     // Extracting publisher's period time
@@ -0,0 +1,697 @@
+﻿// -*- C++ -*-
+/*!
+ * @file PublisherScheduler.cpp
+ * @brief Priority-aware publisher scheduler class
+ * @date $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/PublisherScheduler.h>
+#include <rtm/PeriodicTaskFactory.h>
+#include <coil/stringutil.h>
+
+#include <algorithm>
+#include <memory>
+
+#if defined(RTM_OS_LINUX)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(RTM_OS_WIN32)
+#include <windows.h>
+#endif
+
+namespace RTC
+{
+  static const char* toString(PublisherPriority priority)
+  {
+    switch (priority)
+      {
+      case PublisherPriority::LOW:  return "low";
+      case PublisherPriority::HIGH: return "high";
+      default:                      return "normal";
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  PublisherScheduler::PublisherScheduler()
+    : rtclog("PublisherScheduler")
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  PublisherScheduler::~PublisherScheduler()
+  {
+    shutdown();
+  }
+
+  /*!
+   * @if jp
+   * @brief 共有ワーカの設定
+   * @else
+   * @brief Configure the shared workers
+   * @endif
+   */
+  void PublisherScheduler::init(const coil::Properties& prop)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    std::string threads(prop.getProperty("threads", "2"));
+    if (!coil::stringTo(m_threads, threads.c_str()) || m_threads == 0)
+      {
+        RTC_ERROR(("invalid publisher_pool.threads: %s", threads.c_str()));
+        m_threads = 2;
+      }
+    std::string reserved(prop.getProperty("reserved_threads", "1"));
+    if (!coil::stringTo(m_reserved, reserved.c_str()))
+      {
+        RTC_ERROR(("invalid publisher_pool.reserved_threads: %s",
+                   reserved.c_str()));
+        m_reserved = 1;
+      }
+    if (m_reserved >= m_threads)
+      {
+        // at least one worker serves all priority classes
+        m_reserved = m_threads - 1;
+      }
+    m_cpu = toCpuMask(prop.getProperty("cpu_affinity"));
+    RTC_DEBUG(("publisher pool: threads %lu, reserved %lu",
+               static_cast<unsigned long>(m_threads),
+               static_cast<unsigned long>(m_reserved)));
+  }
+
+  /*!
+   * @if jp
+   * @brief 共有ワーカを停止する
+   * @else
+   * @brief Stop the shared workers
+   * @endif
+   */
+  void PublisherScheduler::shutdown()
+  {
+    std::vector<std::thread> workers;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_shutdown = true;
+      workers.swap(m_workers);
+      m_cond.notify_all();
+    }
+    for (auto & worker : workers)
+      {
+        worker.join();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief パブリッシャのタスクを設定する
+   * @else
+   * @brief Set up the task of a publisher
+   * @endif
+   */
+  void PublisherScheduler::setupTask(coil::PeriodicTaskBase* task,
+                                     const coil::Properties& prop,
+                                     std::function<void(void)> func)
+  {
+    PublisherPriority priority(PublisherPriority::NORMAL);
+    std::string str(prop.getProperty("publisher.priority", "normal"));
+    if (!toPriority(str, priority))
+      {
+        RTC_ERROR(("invalid publisher.priority: %s", str.c_str()));
+      }
+
+    PublisherPoolTask* pooled(dynamic_cast<PublisherPoolTask*>(task));
+    if (pooled != nullptr)
+      {
+        pooled->setPriority(priority);
+        task->setTask(std::move(func));
+        return;
+      }
+
+    coil::CpuMask cpu(toCpuMask(prop.getProperty("publisher.cpu_affinity")));
+    if (priority == PublisherPriority::NORMAL && cpu.empty())
+      {
+        task->setTask(std::move(func));
+        return;
+      }
+    std::shared_ptr<std::once_flag> once(std::make_shared<std::once_flag>());
+    task->setTask([this, once, priority, cpu, func]
+                  {
+                    std::call_once(*once, [&] { setupThread(priority, cpu); });
+                    func();
+                  });
+  }
+
+  /*!
+   * @if jp
+   * @brief 現在のスレッドに優先度クラスと CPU アフィニティを設定する
+   * @else
+   * @brief Set a priority class and CPU affinity to the current thread
+   * @endif
+   */
+  void PublisherScheduler::setupThread(PublisherPriority priority,
+                                       const coil::CpuMask& cpu)
+  {
+    if (priority != PublisherPriority::NORMAL && !setThreadPriority(priority))
+      {
+        RTC_WARN(("Setting thread priority \"%s\" failed.",
+                  toString(priority)));
+      }
+    if (!cpu.empty() && !coil::setThreadCpuAffinity(cpu))
+      {
+        RTC_ERROR(("setThreadCpuAffinity(): "
+                   "CPU affinity mask setting failed"));
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 文字列を優先度クラスに変換する
+   * @else
+   * @brief Convert a string into a priority class
+   * @endif
+   */
+  bool PublisherScheduler::toPriority(const std::string& str,
+                                      PublisherPriority& priority)
+  {
+    std::string value(coil::normalize(str));
+    if      (value == "low")    { priority = PublisherPriority::LOW;    }
+    else if (value == "normal") { priority = PublisherPriority::NORMAL; }
+    else if (value == "high")   { priority = PublisherPriority::HIGH;   }
+    else                        { return false; }
+    return true;
+  }
+
+  //----------------------------------------------------------------------
+  // private functions
+
+  /*!
+   * @if jp
+   * @brief タスクを有効にする
+   * @else
+   * @brief Activate a task
+   * @endif
+   */
+  void PublisherScheduler::activate(PublisherPoolTask* task)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    task->m_active = true;
+    if (!task->m_suspended && task->m_period.count() > 0 && !task->m_timed)
+      {
+        schedule(task, Clock::now() + task->m_period);
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクを無効にし、実行中であれば終了を待つ
+   * @else
+   * @brief Deactivate a task and wait for the end of its execution
+   * @endif
+   */
+  void PublisherScheduler::finalize(PublisherPoolTask* task)
+  {
+    std::unique_lock<std::mutex> guard(m_mutex);
+    task->m_active = false;
+    task->m_pending = false;
+    cancel(task);
+    m_done.wait(guard, [task] { return !task->m_running; });
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクの周期実行を停止する
+   * @else
+   * @brief Suspend the periodic execution of a task
+   * @endif
+   */
+  void PublisherScheduler::suspend(PublisherPoolTask* task)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    task->m_suspended = true;
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクの周期実行を再開する
+   * @else
+   * @brief Resume the periodic execution of a task
+   * @endif
+   */
+  void PublisherScheduler::resume(PublisherPoolTask* task)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    task->m_suspended = false;
+    if (task->m_active && task->m_period.count() > 0 &&
+        !task->m_timed && !task->m_queued && !task->m_running)
+      {
+        schedule(task, Clock::now());
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクを一度実行させる
+   * @else
+   * @brief Make a task execute once
+   * @endif
+   */
+  void PublisherScheduler::signal(PublisherPoolTask* task)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!task->m_active) { return; }
+    if (task->m_running)
+      {
+        task->m_pending = true;
+        return;
+      }
+    enqueue(task);
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカを起動する (m_mutex を保持して呼ぶ)
+   * @else
+   * @brief Start the workers (called with m_mutex held)
+   * @endif
+   */
+  void PublisherScheduler::start()
+  {
+    if (m_shutdown || !m_workers.empty()) { return; }
+    for (size_t i(0); i < m_threads; ++i)
+      {
+        bool high_only(i < m_reserved && i + 1 < m_threads);
+        m_workers.emplace_back([this, high_only] { run(high_only); });
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカスレッド
+   *
+   * 周期の到来したタスクを実行待ちのキューに移し、優先度の高いキュー
+   * から順に取り出して実行する。reserved が true のワーカは high のキュー
+   * のみを処理する。
+   *
+   * @else
+   * @brief Worker thread
+   *
+   * Tasks whose period has elapsed are moved to the ready queues, and
+   * tasks are taken from the queue of the highest priority first.
+   * Workers with reserved true process only the "high" queue.
+   *
+   * @endif
+   */
+  void PublisherScheduler::run(bool reserved)
+  {
+    setupThread(reserved ? PublisherPriority::HIGH : PublisherPriority::NORMAL,
+                m_cpu);
+
+    std::unique_lock<std::mutex> guard(m_mutex);
+    while (!m_shutdown)
+      {
+        Clock::time_point now(Clock::now());
+        while (!m_timers.empty() && m_timers.begin()->first <= now)
+          {
+            PublisherPoolTask* task(m_timers.begin()->second);
+            m_timers.erase(m_timers.begin());
+            task->m_timed = false;
+            if (task->m_active && !task->m_suspended) { enqueue(task); }
+          }
+
+        PublisherPoolTask* task(next(reserved));
+        if (task == nullptr)
+          {
+            if (m_timers.empty())
+              {
+                m_cond.wait(guard);
+              }
+            else
+              {
+                m_cond.wait_until(guard, m_timers.begin()->first);
+              }
+            continue;
+          }
+
+        task->m_queued = false;
+        task->m_running = true;
+        guard.unlock();
+        Clock::time_point begin(Clock::now());
+        task->execute();
+        guard.lock();
+        task->m_running = false;
+
+        if (task->m_active)
+          {
+            if (task->m_pending)
+              {
+                task->m_pending = false;
+                enqueue(task);
+              }
+            if (!task->m_suspended && task->m_period.count() > 0 &&
+                !task->m_timed)
+              {
+                schedule(task, begin + task->m_period);
+              }
+          }
+        m_done.notify_all();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクを優先度クラスのキューに入れる (m_mutex を保持して呼ぶ)
+   * @else
+   * @brief Put a task into the queue of its priority class (called
+   *        with m_mutex held)
+   * @endif
+   */
+  void PublisherScheduler::enqueue(PublisherPoolTask* task)
+  {
+    if (task->m_queued) { return; }
+    m_ready[static_cast<size_t>(task->m_priority)].push_back(task);
+    task->m_queued = true;
+    start();
+    m_cond.notify_all();
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクの実行時刻を登録する (m_mutex を保持して呼ぶ)
+   * @else
+   * @brief Register the execution time of a task (called with m_mutex
+   *        held)
+   * @endif
+   */
+  void PublisherScheduler::schedule(PublisherPoolTask* task,
+                                    Clock::time_point due)
+  {
+    m_timers.emplace(due, task);
+    task->m_timed = true;
+    start();
+    m_cond.notify_all();
+  }
+
+  /*!
+   * @if jp
+   * @brief タスクをキューから取り除く (m_mutex を保持して呼ぶ)
+   * @else
+   * @brief Remove a task from the queues (called with m_mutex held)
+   * @endif
+   */
+  void PublisherScheduler::cancel(PublisherPoolTask* task)
+  {
+    if (task->m_queued)
+      {
+        std::deque<PublisherPoolTask*>&
+          queue(m_ready[static_cast<size_t>(task->m_priority)]);
+        queue.erase(std::remove(queue.begin(), queue.end(), task), queue.end());
+        task->m_queued = false;
+      }
+    if (task->m_timed)
+      {
+        for (auto it(m_timers.begin()); it != m_timers.end();)
+          {
+            if (it->second == task) { it = m_timers.erase(it); }
+            else                    { ++it; }
+          }
+        task->m_timed = false;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 次に実行するタスクを取り出す (m_mutex を保持して呼ぶ)
+   * @else
+   * @brief Take the task to be executed next (called with m_mutex held)
+   * @endif
+   */
+  PublisherPoolTask* PublisherScheduler::next(bool reserved)
+  {
+    size_t lowest(reserved ? static_cast<size_t>(PublisherPriority::HIGH) :
+                  static_cast<size_t>(PublisherPriority::LOW));
+    for (size_t i(static_cast<size_t>(PublisherPriority::HIGH) + 1);
+         i > lowest; --i)
+      {
+        std::deque<PublisherPoolTask*>& queue(m_ready[i - 1]);
+        if (!queue.empty())
+          {
+            PublisherPoolTask* task(queue.front());
+            queue.pop_front();
+            return task;
+          }
+      }
+    return nullptr;
+  }
+
+  /*!
+   * @if jp
+   * @brief 現在のスレッドの OS 優先度を設定する
+   *
+   * Linux では high を nice -10、low を nice 10 とする。nice 値を下げ
+   * るには CAP_SYS_NICE などの権限が必要である。Windows では
+   * THREAD_PRIORITY_ABOVE_NORMAL と THREAD_PRIORITY_BELOW_NORMAL とす
+   * る。
+   *
+   * @else
+   * @brief Set the OS priority of the current thread
+   *
+   * On Linux "high" is nice -10 and "low" is nice 10. Lowering the nice
+   * value requires privileges such as CAP_SYS_NICE. On Windows they are
+   * THREAD_PRIORITY_ABOVE_NORMAL and THREAD_PRIORITY_BELOW_NORMAL.
+   *
+   * @endif
+   */
+  bool PublisherScheduler::setThreadPriority(PublisherPriority priority)
+  {
+#if defined(RTM_OS_LINUX) && defined(SYS_gettid)
+    int nice(0);
+    if (priority == PublisherPriority::HIGH) { nice = -10; }
+    if (priority == PublisherPriority::LOW)  { nice = 10; }
+    return ::setpriority(PRIO_PROCESS,
+                         static_cast<id_t>(::syscall(SYS_gettid)), nice) == 0;
+#elif defined(RTM_OS_WIN32)
+    int value(THREAD_PRIORITY_NORMAL);
+    if (priority == PublisherPriority::HIGH)
+      {
+        value = THREAD_PRIORITY_ABOVE_NORMAL;
+      }
+    if (priority == PublisherPriority::LOW)
+      {
+        value = THREAD_PRIORITY_BELOW_NORMAL;
+      }
+    return ::SetThreadPriority(::GetCurrentThread(), value) != 0;
+#else
+    return priority == PublisherPriority::NORMAL;
+#endif
+  }
+
+  /*!
+   * @if jp
+   * @brief カンマ区切りの CPU ID を CpuMask に変換する
+   * @else
+   * @brief Convert comma separated CPU IDs into a CpuMask
+   * @endif
+   */
+  coil::CpuMask PublisherScheduler::toCpuMask(const std::string& str)
+  {
+    coil::CpuMask cpu;
+    for (auto const& c : coil::split(str, ",", true))
+      {
+        int num;
+        if (coil::stringTo(num, c.c_str())) { cpu.emplace_back(num); }
+      }
+    return cpu;
+  }
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  PublisherPoolTask::PublisherPoolTask() = default;
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  PublisherPoolTask::~PublisherPoolTask()
+  {
+    finalize();
+  }
+
+  void PublisherPoolTask::activate()
+  {
+    if (m_func == nullptr) { return; }
+    PublisherScheduler::instance().activate(this);
+  }
+
+  void PublisherPoolTask::finalize()
+  {
+    PublisherScheduler::instance().finalize(this);
+  }
+
+  int PublisherPoolTask::suspend()
+  {
+    PublisherScheduler::instance().suspend(this);
+    return 0;
+  }
+
+  int PublisherPoolTask::resume()
+  {
+    PublisherScheduler::instance().resume(this);
+    return 0;
+  }
+
+  void PublisherPoolTask::signal()
+  {
+    PublisherScheduler::instance().signal(this);
+  }
+
+  void PublisherPoolTask::setTask(std::function<void(void)> func)
+  {
+    m_func = std::move(func);
+  }
+
+  void PublisherPoolTask::setPeriod(std::chrono::nanoseconds period)
+  {
+    m_period = period;
+  }
+
+  void PublisherPoolTask::executionMeasure(bool value)
+  {
+    m_execMeasure = value;
+  }
+
+  void PublisherPoolTask::executionMeasureCount(unsigned int n)
+  {
+    m_execCountMax = n;
+  }
+
+  void PublisherPoolTask::periodicMeasure(bool value)
+  {
+    m_periodMeasure = value;
+  }
+
+  void PublisherPoolTask::periodicMeasureCount(unsigned int n)
+  {
+    m_periodCountMax = n;
+  }
+
+  coil::TimeMeasure::Statistics PublisherPoolTask::getExecStat()
+  {
+    std::lock_guard<std::mutex> guard(m_statMutex);
+    return m_execStat;
+  }
+
+  coil::TimeMeasure::Statistics PublisherPoolTask::getPeriodStat()
+  {
+    std::lock_guard<std::mutex> guard(m_statMutex);
+    return m_periodStat;
+  }
+
+  /*!
+   * @if jp
+   * @brief 優先度クラスを設定する
+   * @else
+   * @brief Set the priority class
+   * @endif
+   */
+  void PublisherPoolTask::setPriority(PublisherPriority priority)
+  {
+    m_priority = priority;
+  }
+
+  /*!
+   * @if jp
+   * @brief スレッドを持たないため使用されない
+   * @else
+   * @brief Not used since this task has no thread
+   * @endif
+   */
+  int PublisherPoolTask::svc()
+  {
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief ワーカスレッドでタスク実行関数を実行する
+   * @else
+   * @brief Execute the task function on a worker thread
+   * @endif
+   */
+  void PublisherPoolTask::execute()
+  {
+    if (m_periodMeasure)
+      {
+        m_periodTime.tack();
+        m_periodTime.tick();
+        if (++m_periodCount > m_periodCountMax)
+          {
+            std::lock_guard<std::mutex> guard(m_statMutex);
+            m_periodStat = m_periodTime.getStatistics();
+            m_periodCount = 0;
+          }
+      }
+
+    if (m_execMeasure) { m_execTime.tick(); }
+    m_func();
+    if (m_execMeasure)
+      {
+        m_execTime.tack();
+        if (++m_execCount > m_execCountMax)
+          {
+            std::lock_guard<std::mutex> guard(m_statMutex);
+            m_execStat = m_execTime.getStatistics();
+            m_execCount = 0;
+          }
+      }
+  }
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void PublisherPoolTaskInit()
+  {
+    ::RTC::PeriodicTaskFactory::
+      instance().addFactory("publisher_pool",
+                            ::coil::Creator< ::coil::PeriodicTaskBase,
+                                             ::RTC::PublisherPoolTask>,
+                            ::coil::Destructor< ::coil::PeriodicTaskBase,
+                                                ::RTC::PublisherPoolTask>);
+  }
+}
@@ -0,0 +1,386 @@
+﻿// -*- C++ -*-
+/*!
+ * @file PublisherScheduler.h
+ * @brief Priority-aware publisher scheduler class
+ * @date $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_PUBLISHERSCHEDULER_H
+#define RTC_PUBLISHERSCHEDULER_H
+
+#include <coil/Affinity.h>
+#include <coil/PeriodicTaskBase.h>
+#include <coil/Properties.h>
+#include <coil/Singleton.h>
+#include <rtm/SystemLogger.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief パブリッシャの優先度クラス
+   * @else
+   * @brief Priority class of publishers
+   * @endif
+   */
+  enum class PublisherPriority : uint8_t
+  {
+    LOW,
+    NORMAL,
+    HIGH
+  };
+
+  class PublisherPoolTask;
+
+  /*!
+   * @if jp
+   * @class PublisherScheduler
+   * @brief 優先度に基づくパブリッシャのスケジューラ
+   *
+   * コネクタの publisher.priority (low, normal, high。デフォルト:
+   * normal) に従ってパブリッシャの送信処理をスケジュールする。
+   *
+   * パブリッシャが専用のスレッドを持つ場合は、そのスレッドの OS 優先度
+   * を優先度クラスに合わせ、publisher.cpu_affinity が指定されていれば
+   * CPU アフィニティを設定する。
+   *
+   * thread_type に "publisher_pool" を指定したコネクタは、スレッドを
+   * 持たずに共有のワーカスレッドで送信される。送信要求は優先度クラス毎
+   * のキューに入れられ、常に高い優先度のキューから取り出される (strict
+   * priority)。ワーカのうち manager.publisher_pool.reserved_threads
+   * 個は high のみを処理するため、制御用の接続が大きな画像の送信の後ろ
+   * で待たされることはない。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class PublisherScheduler
+   * @brief Priority-aware scheduler of publishers
+   *
+   * This schedules the sending of publishers according to the
+   * publisher.priority (low, normal or high; default: normal) of the
+   * connectors.
+   *
+   * When a publisher has its own thread, the OS priority of the thread
+   * follows the priority class, and the CPU affinity is set if
+   * publisher.cpu_affinity is specified.
+   *
+   * Connectors with thread_type "publisher_pool" have no thread and are
+   * sent by shared worker threads. Requests are put into a queue per
+   * priority class and always taken from the queue of the highest
+   * priority (strict priority). Since
+   * manager.publisher_pool.reserved_threads of the workers process only
+   * "high", control connections never wait behind large image
+   * transfers.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class PublisherScheduler
+    : public coil::Singleton<PublisherScheduler>
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    PublisherScheduler();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~PublisherScheduler();
+
+    /*!
+     * @if jp
+     *
+     * @brief 共有ワーカの設定
+     *
+     * 以下のプロパティを読む。ワーカは最初の送信要求時に起動される。
+     *
+     * - threads: ワーカスレッド数 (デフォルト: 2)
+     * - reserved_threads: high 専用のワーカ数 (デフォルト: 1)
+     * - cpu_affinity: ワーカの CPU アフィニティ
+     *
+     * @param prop manager.publisher_pool ノード
+     *
+     * @else
+     *
+     * @brief Configure the shared workers
+     *
+     * The following properties are read. The workers are started on the
+     * first request.
+     *
+     * - threads: Number of worker threads (default: 2)
+     * - reserved_threads: Number of workers only for "high" (default: 1)
+     * - cpu_affinity: CPU affinity of the workers
+     *
+     * @param prop manager.publisher_pool node
+     *
+     * @endif
+     */
+    void init(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 共有ワーカを停止する
+     * @else
+     * @brief Stop the shared workers
+     * @endif
+     */
+    void shutdown();
+
+    /*!
+     * @if jp
+     *
+     * @brief パブリッシャのタスクを設定する
+     *
+     * publisher.priority と publisher.cpu_affinity を読み、タスクが
+     * PublisherPoolTask であれば優先度クラスを設定する。それ以外の場合
+     * は、タスクのスレッドで最初に実行される時にスレッドの優先度と CPU
+     * アフィニティを設定するように func を包んで設定する。
+     *
+     * @param task パブリッシャのタスク
+     * @param prop コネクタプロパティ
+     * @param func タスク実行関数
+     *
+     * @else
+     *
+     * @brief Set up the task of a publisher
+     *
+     * publisher.priority and publisher.cpu_affinity are read, and the
+     * priority class is set if the task is a PublisherPoolTask.
+     * Otherwise func is wrapped so that the thread priority and the CPU
+     * affinity are set when it is executed first on the thread of the
+     * task.
+     *
+     * @param task Task of the publisher
+     * @param prop Connector properties
+     * @param func Task execution function
+     *
+     * @endif
+     */
+    void setupTask(coil::PeriodicTaskBase* task, const coil::Properties& prop,
+                   std::function<void(void)> func);
+
+    /*!
+     * @if jp
+     * @brief 現在のスレッドに優先度クラスと CPU アフィニティを設定する
+     * @param priority 優先度クラス
+     * @param cpu CPU アフィニティ (空の場合は設定しない)
+     * @else
+     * @brief Set a priority class and CPU affinity to the current thread
+     * @param priority Priority class
+     * @param cpu CPU affinity (not set if empty)
+     * @endif
+     */
+    void setupThread(PublisherPriority priority, const coil::CpuMask& cpu);
+
+    /*!
+     * @if jp
+     * @brief 文字列を優先度クラスに変換する
+     * @param str "low", "normal" または "high"
+     * @param priority 優先度クラス
+     * @return 変換に成功した場合 true
+     * @else
+     * @brief Convert a string into a priority class
+     * @param str "low", "normal" or "high"
+     * @param priority Priority class
+     * @return true if succeeded
+     * @endif
+     */
+    static bool toPriority(const std::string& str, PublisherPriority& priority);
+
+  private:
+    friend class PublisherPoolTask;
+
+    void activate(PublisherPoolTask* task);
+    void finalize(PublisherPoolTask* task);
+    void suspend(PublisherPoolTask* task);
+    void resume(PublisherPoolTask* task);
+    void signal(PublisherPoolTask* task);
+
+    void start();
+    void run(bool reserved);
+    void enqueue(PublisherPoolTask* task);
+    void schedule(PublisherPoolTask* task, Clock::time_point due);
+    void cancel(PublisherPoolTask* task);
+    PublisherPoolTask* next(bool reserved);
+    static bool setThreadPriority(PublisherPriority priority);
+    static coil::CpuMask toCpuMask(const std::string& str);
+
+    Logger rtclog;
+    size_t m_threads{2};
+    size_t m_reserved{1};
+    coil::CpuMask m_cpu;
+    bool m_shutdown{false};
+    std::vector<std::thread> m_workers;
+    std::deque<PublisherPoolTask*> m_ready[3];
+    std::multimap<Clock::time_point, PublisherPoolTask*> m_timers;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::condition_variable m_done;
+  };
+
+  /*!
+   * @if jp
+   * @class PublisherPoolTask
+   * @brief 共有ワーカで実行されるパブリッシャのタスク
+   *
+   * "publisher_pool" として PeriodicTaskFactory に登録される。スレッ
+   * ドを持たず、signal() や周期の到来で PublisherScheduler のキューに
+   * 入れられる。実行中に signal() された場合は実行後にもう一度キュー
+   * に入れられる。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class PublisherPoolTask
+   * @brief Task of a publisher executed by the shared workers
+   *
+   * This is registered to PeriodicTaskFactory as "publisher_pool". It
+   * has no thread and is put into the queue of PublisherScheduler by
+   * signal() or when the period elapses. If signal() is called during
+   * the execution, it is queued again after the execution.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class PublisherPoolTask : public coil::PeriodicTaskBase
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    PublisherPoolTask();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * 実行中であれば終了を待つ。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * This waits for the end of the execution if it is running.
+     *
+     * @endif
+     */
+    ~PublisherPoolTask() override;
+
+    void activate() override;
+    void finalize() override;
+    int suspend() override;
+    int resume() override;
+    void signal() override;
+    void setTask(std::function<void(void)> func) override;
+    void setPeriod(std::chrono::nanoseconds period) override;
+    void executionMeasure(bool value) override;
+    void executionMeasureCount(unsigned int n) override;
+    void periodicMeasure(bool value) override;
+    void periodicMeasureCount(unsigned int n) override;
+    coil::TimeMeasure::Statistics getExecStat() override;
+    coil::TimeMeasure::Statistics getPeriodStat() override;
+
+    /*!
+     * @if jp
+     * @brief 優先度クラスを設定する
+     * @else
+     * @brief Set the priority class
+     * @endif
+     */
+    void setPriority(PublisherPriority priority);
+
+  protected:
+    int svc() override;
+
+  private:
+    friend class PublisherScheduler;
+
+    void execute();
+
+    std::function<void(void)> m_func;
+    std::chrono::nanoseconds m_period{0};
+    PublisherPriority m_priority{PublisherPriority::NORMAL};
+
+    // guarded by the mutex of PublisherScheduler
+    bool m_active{false};
+    bool m_suspended{false};
+    bool m_queued{false};
+    bool m_timed{false};
+    bool m_running{false};
+    bool m_pending{false};
+
+    bool m_execMeasure{false};
+    unsigned int m_execCount{0};
+    unsigned int m_execCountMax{1000};
+    coil::TimeMeasure m_execTime;
+    bool m_periodMeasure{false};
+    unsigned int m_periodCount{0};
+    unsigned int m_periodCountMax{1000};
+    coil::TimeMeasure m_periodTime;
+    coil::TimeMeasure::Statistics m_execStat{};
+    coil::TimeMeasure::Statistics m_periodStat{};
+    std::mutex m_statMutex;
+  };
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * PublisherPoolTask を "publisher_pool" として PeriodicTaskFactory
+   * に登録する。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * This function registers PublisherPoolTask to PeriodicTaskFactory as
+   * "publisher_pool".
+   *
+   * @endif
+   */
+  void PublisherPoolTaskInit();
+}
+
+#endif  // RTC_PUBLISHERSCHEDULER_H
@@ -669,7 +669,20 @@ namespace RTC
           CORBA::string_dup(m_properties["vendor"].c_str());
         profile->category      =
           CORBA::string_dup(m_properties["category"].c_str());
-        profile->port_profiles = m_portAdmin.getPortProfileList();
+        {
+          // port profiles are copied from all the ports only if changed
+          std::lock_guard<std::mutex> guard(m_portProfilesMutex);
+          unsigned long generation(0);
+          bool cacheable(m_portAdmin.getProfileGeneration(generation));
+          if (!cacheable || !m_portProfilesValid ||
+              generation != m_portProfilesGeneration)
+            {
+              m_portProfiles = m_portAdmin.getPortProfileList();
+              m_portProfilesGeneration = generation;
+              m_portProfilesValid = cacheable;
+            }
+          profile->port_profiles = m_portProfiles;
+        }
 #else  // ORB_IS_RTORB
         profile->instance_name =
           CORBA::string_dup(m_properties["instance_name"].c_str());
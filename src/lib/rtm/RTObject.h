@@ -37,6 +37,7 @@
 #include <rtm/PortConnectListener.h>
 #include <rtm/FsmActionListener.h>
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -5229,6 +5230,25 @@ namespace RTC
      */
     PortAdmin m_portAdmin;
 
+    /*!
+     * @if jp
+     * @brief get_component_profile() 用の PortProfile リストのキャッシュ
+     *
+     * PortAdmin の世代番号が変化した場合のみ再構築される。
+     *
+     * @else
+     * @brief Cache of the PortProfileList for get_component_profile()
+     *
+     * This is rebuilt only when the generation number of the PortAdmin
+     * changes.
+     *
+     * @endif
+     */
+    PortProfileList m_portProfiles;
+    unsigned long m_portProfilesGeneration{0};
+    bool m_portProfilesValid{false};
+    std::mutex m_portProfilesMutex;
+
     /*!
      * @if jp
      * @brief InPortBase* のリスト
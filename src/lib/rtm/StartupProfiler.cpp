@@ -0,0 +1,242 @@
+﻿// -*- C++ -*-
+/*!
+ * @file StartupProfiler.cpp
+ * @brief Manager startup profiler class
+ * @date $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/StartupProfiler.h>
+#include <coil/OS.h>
+
+#include <cstdio>
+#include <fstream>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  StartupProfiler::StartupProfiler()
+    : m_origin(Clock::now()), m_recording(true)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief イベントを記録する
+   * @else
+   * @brief Record an event
+   * @endif
+   */
+  void StartupProfiler::record(const std::string& name,
+                               const std::string& category,
+                               Clock::time_point begin,
+                               Clock::time_point end)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_recording) { return; }
+    m_events.push_back({name, category, begin, end,
+                        threadNumber(std::this_thread::get_id())});
+  }
+
+  /*!
+   * @if jp
+   * @brief 記録を終了する
+   * @else
+   * @brief Stop recording
+   * @endif
+   */
+  void StartupProfiler::finish()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_recording = false;
+  }
+
+  /*!
+   * @if jp
+   * @brief 記録中かどうか
+   * @else
+   * @brief Check if the profiler is recording
+   * @endif
+   */
+  bool StartupProfiler::isRecording()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_recording;
+  }
+
+  /*!
+   * @if jp
+   * @brief 記録されたイベントのリストを取得する
+   * @else
+   * @brief Get the list of recorded events
+   * @endif
+   */
+  std::vector<StartupProfiler::Event> StartupProfiler::getEvents()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_events;
+  }
+
+  /*!
+   * @if jp
+   * @brief イベントを JSON 形式で出力する
+   * @else
+   * @brief Write the events in JSON format
+   * @endif
+   */
+  void StartupProfiler::writeJson(std::ostream& os)
+  {
+    std::vector<Event> events(getEvents());
+    long long total(0);
+    for (auto const& ev : events)
+      {
+        long long end(toMicroseconds(ev.end));
+        if (end > total) { total = end; }
+      }
+
+    os << "{\n";
+    os << "  \"pid\": " << coil::getpid() << ",\n";
+    os << "  \"total_us\": " << total << ",\n";
+    os << "  \"events\": [";
+    for (size_t i(0); i < events.size(); ++i)
+      {
+        const Event& ev(events[i]);
+        long long begin(toMicroseconds(ev.begin));
+        os << (i == 0 ? "\n" : ",\n");
+        os << "    {\"name\": \"" << escape(ev.name) << "\", "
+           << "\"category\": \"" << escape(ev.category) << "\", "
+           << "\"thread\": " << ev.thread << ", "
+           << "\"start_us\": " << begin << ", "
+           << "\"duration_us\": " << (toMicroseconds(ev.end) - begin) << "}";
+      }
+    os << "\n  ]\n}\n";
+  }
+
+  /*!
+   * @if jp
+   * @brief イベントを Chrome trace 形式で出力する
+   * @else
+   * @brief Write the events in Chrome trace format
+   * @endif
+   */
+  void StartupProfiler::writeChromeTrace(std::ostream& os)
+  {
+    std::vector<Event> events(getEvents());
+    coil::pid_t pid(coil::getpid());
+
+    os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    for (size_t i(0); i < events.size(); ++i)
+      {
+        const Event& ev(events[i]);
+        long long begin(toMicroseconds(ev.begin));
+        os << (i == 0 ? "\n" : ",\n");
+        os << "{\"name\": \"" << escape(ev.name) << "\", "
+           << "\"cat\": \"" << escape(ev.category) << "\", "
+           << "\"ph\": \"X\", "
+           << "\"ts\": " << begin << ", "
+           << "\"dur\": " << (toMicroseconds(ev.end) - begin) << ", "
+           << "\"pid\": " << pid << ", "
+           << "\"tid\": " << ev.thread << "}";
+      }
+    os << "\n]}\n";
+  }
+
+  /*!
+   * @if jp
+   * @brief イベントをファイルに出力する
+   * @else
+   * @brief Write the events to a file
+   * @endif
+   */
+  bool StartupProfiler::save(const std::string& file_name,
+                             const std::string& format)
+  {
+    std::ofstream ofs(file_name.c_str());
+    if (!ofs) { return false; }
+
+    if (format == "chrome")
+      {
+        writeChromeTrace(ofs);
+      }
+    else
+      {
+        writeJson(ofs);
+      }
+    return static_cast<bool>(ofs);
+  }
+
+  /*!
+   * @if jp
+   * @brief スレッドIDを記録順の番号に変換する
+   * @else
+   * @brief Convert a thread id into a number in the order of recording
+   * @endif
+   */
+  unsigned int StartupProfiler::threadNumber(std::thread::id id)
+  {
+    for (size_t i(0); i < m_threads.size(); ++i)
+      {
+        if (m_threads[i] == id) { return static_cast<unsigned int>(i); }
+      }
+    m_threads.emplace_back(id);
+    return static_cast<unsigned int>(m_threads.size() - 1);
+  }
+
+  long long StartupProfiler::toMicroseconds(Clock::time_point tp) const
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>
+      (tp - m_origin).count();
+  }
+
+  /*!
+   * @if jp
+   * @brief JSON 文字列用にエスケープする
+   * @else
+   * @brief Escape a string for JSON
+   * @endif
+   */
+  std::string StartupProfiler::escape(const std::string& str)
+  {
+    std::string ret;
+    ret.reserve(str.size());
+    for (auto const& c : str)
+      {
+        switch (c)
+          {
+          case '"':  ret += "\\\""; break;
+          case '\\': ret += "\\\\"; break;
+          case '\n': ret += "\\n";  break;
+          case '\r': ret += "\\r";  break;
+          case '\t': ret += "\\t";  break;
+          default:
+            if (static_cast<unsigned char>(c) < 0x20)
+              {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                ret += buf;
+              }
+            else
+              {
+                ret += c;
+              }
+          }
+      }
+    return ret;
+  }
+} // namespace RTC
@@ -0,0 +1,261 @@
+﻿// -*- C++ -*-
+/*!
+ * @file StartupProfiler.h
+ * @brief Manager startup profiler class
+ * @date $Date: 2026-10-19 10:00:00 $
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_STARTUPPROFILER_H
+#define RTC_STARTUPPROFILER_H
+
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   *
+   * @class StartupProfiler
+   * @brief Manager 起動処理のプロファイラ
+   *
+   * Manager の初期化フェーズ、モジュールのロード、コンポーネント生成な
+   * どの開始・終了時刻を単調増加時計で記録し、JSON または Chrome trace
+   * 形式 (chrome://tracing, Perfetto) で出力する。記録はスレッドセーフ
+   * であり、finish() 以降の記録は無視される。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   *
+   * @class StartupProfiler
+   * @brief Profiler of the Manager startup
+   *
+   * This class records the begin/end time of the Manager initialization
+   * phases, module loading, component creation and so on with a
+   * monotonic clock, and writes them in JSON or Chrome trace format
+   * (chrome://tracing, Perfetto). Recording is thread safe and records
+   * after finish() are ignored.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class StartupProfiler
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /*!
+     * @if jp
+     * @brief 計測イベント
+     * @else
+     * @brief Measured event
+     * @endif
+     */
+    struct Event
+    {
+      std::string name;
+      std::string category;
+      Clock::time_point begin;
+      Clock::time_point end;
+      unsigned int thread;
+    };
+
+    /*!
+     * @if jp
+     *
+     * @class StartupProfiler::Scope
+     * @brief スコープの開始から終了までを一つのイベントとして記録する
+     *
+     * @else
+     *
+     * @class StartupProfiler::Scope
+     * @brief Record a scope as an event from its beginning to its end
+     *
+     * @endif
+     */
+    class Scope
+    {
+    public:
+      Scope(StartupProfiler& profiler, std::string name, std::string category)
+        : m_profiler(profiler), m_name(std::move(name)),
+          m_category(std::move(category)), m_begin(Clock::now())
+      {
+      }
+      ~Scope()
+      {
+        m_profiler.record(m_name, m_category, m_begin, Clock::now());
+      }
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+    private:
+      StartupProfiler& m_profiler;
+      std::string m_name;
+      std::string m_category;
+      Clock::time_point m_begin;
+    };
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     *
+     * 生成時刻を全イベントの時刻の原点とする。
+     *
+     * @else
+     * @brief Constructor
+     *
+     * The construction time is the origin of the time of all events.
+     *
+     * @endif
+     */
+    StartupProfiler();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~StartupProfiler() = default;
+
+    /*!
+     * @if jp
+     *
+     * @brief イベントを記録する
+     *
+     * @param name イベント名
+     * @param category カテゴリ ("phase", "module", "component" など)
+     * @param begin 開始時刻
+     * @param end 終了時刻
+     *
+     * @else
+     *
+     * @brief Record an event
+     *
+     * @param name Event name
+     * @param category Category ("phase", "module", "component", etc.)
+     * @param begin Begin time
+     * @param end End time
+     *
+     * @endif
+     */
+    void record(const std::string& name, const std::string& category,
+                Clock::time_point begin, Clock::time_point end);
+
+    /*!
+     * @if jp
+     * @brief 記録を終了する
+     * @else
+     * @brief Stop recording
+     * @endif
+     */
+    void finish();
+
+    /*!
+     * @if jp
+     * @brief 記録中かどうか
+     * @else
+     * @brief Check if the profiler is recording
+     * @endif
+     */
+    bool isRecording();
+
+    /*!
+     * @if jp
+     * @brief 記録されたイベントのリストを取得する
+     * @else
+     * @brief Get the list of recorded events
+     * @endif
+     */
+    std::vector<Event> getEvents();
+
+    /*!
+     * @if jp
+     *
+     * @brief イベントを JSON 形式で出力する
+     *
+     * 時刻は生成時刻からのマイクロ秒で出力される。
+     *
+     * @param os 出力ストリーム
+     *
+     * @else
+     *
+     * @brief Write the events in JSON format
+     *
+     * Times are written in microseconds from the construction time.
+     *
+     * @param os Output stream
+     *
+     * @endif
+     */
+    void writeJson(std::ostream& os);
+
+    /*!
+     * @if jp
+     *
+     * @brief イベントを Chrome trace 形式で出力する
+     *
+     * @param os 出力ストリーム
+     *
+     * @else
+     *
+     * @brief Write the events in Chrome trace format
+     *
+     * @param os Output stream
+     *
+     * @endif
+     */
+    void writeChromeTrace(std::ostream& os);
+
+    /*!
+     * @if jp
+     *
+     * @brief イベントをファイルに出力する
+     *
+     * @param file_name ファイル名
+     * @param format "json" または "chrome"
+     * @return 成功した場合 true
+     *
+     * @else
+     *
+     * @brief Write the events to a file
+     *
+     * @param file_name File name
+     * @param format "json" or "chrome"
+     * @return true if succeeded
+     *
+     * @endif
+     */
+    bool save(const std::string& file_name, const std::string& format);
+
+  private:
+    unsigned int threadNumber(std::thread::id id);
+    long long toMicroseconds(Clock::time_point tp) const;
+    static std::string escape(const std::string& str);
+
+    Clock::time_point m_origin;
+    bool m_recording;
+    std::vector<Event> m_events;
+    std::vector<std::thread::id> m_threads;
+    std::mutex m_mutex;
+  };
+} // namespace RTC
+
+#endif  // RTC_STARTUPPROFILER_H
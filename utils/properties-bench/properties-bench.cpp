@@ -0,0 +1,273 @@
+﻿// -*- C++ -*-
+/*!
+ * @file properties-bench.cpp
+ * @brief coil::Properties regression check and benchmark
+ * @date $Date$
+ * @author Noriaki Ando <n-ando@aist.go.jp>
+ *
+ * Copyright (C) 2026
+ *     Noriaki Ando
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <coil/Properties.h>
+
+namespace
+{
+  int failures(0);
+
+  std::string names(const coil::Properties& prop)
+  {
+    std::string str;
+    for (auto const& name : prop.propertyNames())
+      {
+        str += name + "=" + prop.getProperty(name) + ";";
+      }
+    return str;
+  }
+
+  std::string dump(const coil::Properties& prop)
+  {
+    std::ostringstream oss;
+    oss << prop;
+    return oss.str();
+  }
+
+  std::string str(bool b) { return b ? "1" : "0"; }
+  std::string str(size_t n) { return std::to_string(n); }
+  std::string str(const std::string& s) { return s; }
+
+  template <typename T>
+  void check(const char* expr, const T& actual, const std::string& expected)
+  {
+    if (str(actual) == expected) { return; }
+    std::cerr << "NG: " << expr << std::endl
+              << "    expected: [" << expected << "]" << std::endl
+              << "    actual:   [" << str(actual) << "]" << std::endl;
+    ++failures;
+  }
+#define CHECK(expr, expected) check(#expr, (expr), (expected))
+
+  /*!
+   * The expected values are the results of coil::Properties before the
+   * children were indexed (the linear search of _findPath(),
+   * _createPath(), _copy() and removeNode()). They cover the key
+   * splitting, the order of the keys, the defaults, copying and
+   * removing nodes.
+   */
+  void checkSemantics()
+  {
+    coil::Properties p;
+    CHECK(p.setProperty("a.b.c", "1"), "");
+    CHECK(p.setProperty("a.b.c", "2"), "1");
+    CHECK(p.getProperty("a.b.c"), "2");
+    CHECK(p.getProperty("a.b"), "");
+    CHECK(p.getProperty("a.x", "dflt"), "dflt");
+    CHECK(p.findNode("a.b") != nullptr, "1");
+    CHECK(p.findNode("a.x") != nullptr, "0");
+    CHECK(p.findNode("") != nullptr, "0");
+
+    // empty and blank path elements are kept as they are
+    CHECK(p.setProperty("a..d", "3"), "");
+    CHECK(p.setProperty(".e", "4"), "");
+    CHECK(p.setProperty("f.", "5"), "");
+    CHECK(p.setProperty(" g . h ", "6"), "");
+    CHECK(names(p), "a.b.c=2;a..d=3;.e=4;f.=5; g . h =6;");
+    CHECK(p.getProperty("g.h"), "");
+    CHECK(p.getProperty(" g . h "), "6");
+
+    CHECK(p.setDefault("a.b.z", "dz"), "dz");
+    CHECK(p.getProperty("a.b.z"), "dz");
+    CHECK(p.getDefault("a.b.z"), "dz");
+    p["n.m"] = "7";
+    CHECK(p.getProperty("n.m"), "7");
+
+    // hasKey() and removeNode() look at the direct children only
+    CHECK(p.hasKey("a") != nullptr, "1");
+    CHECK(p.hasKey("a.b") != nullptr, "0");
+    CHECK(p.createNode("a.b"), "0");
+    CHECK(p.createNode("q.r"), "1");
+    CHECK(std::string(p.getNode("s.t").getName()), "t");
+    CHECK(p.size(), "9");
+    CHECK(names(p),
+          "a.b.c=2;a.b.z=dz;a..d=3;.e=4;f.=5; g . h =6;n.m=7;q.r=;s.t=;");
+
+    coil::Properties* removed(p.removeNode("a"));
+    CHECK(removed != nullptr, "1");
+    if (removed != nullptr)
+      {
+        CHECK(removed->getProperty("b.c"), "2");
+        delete removed;
+      }
+    CHECK(p.removeNode("a") == nullptr, "1");
+    CHECK(p.removeNode("s.t") == nullptr, "1");
+    CHECK(names(p), ".e=4;f.=5; g . h =6;n.m=7;q.r=;s.t=;");
+
+    // copies are deep and keep the order
+    coil::Properties q(p);
+    CHECK(names(q) == names(p), "1");
+    CHECK(dump(q) == dump(p), "1");
+    q.setProperty("n.m", "8");
+    CHECK(p.getProperty("n.m"), "7");
+    coil::Properties w;
+    w.setProperty("x", "1");
+    w = p;
+    CHECK(names(w) == names(p), "1");
+    CHECK(w.getProperty("x", "none"), "none");
+
+    // merging overwrites the values and appends new keys
+    coil::Properties m;
+    m.setProperty("n.m", "9");
+    m.setProperty("k", "1");
+    p << m;
+    CHECK(names(p), ".e=4;f.=5; g . h =6;n.m=9;q.r=;s.t=;k=1;");
+
+    std::istringstream is("a.b: 1\n# comment\nc.d = x\\\n  y\ne\\:f: g\n"
+                          "! bang\nh.i\n");
+    coil::Properties l;
+    l.load(is);
+    CHECK(names(l), "a.b=1;c.d=xy;e:f=g;h.i=;");
+
+    // the insertion order is kept regardless of the index
+    coil::Properties o;
+    std::string expected;
+    for (int i(0); i < 50; ++i)
+      {
+        std::string key("k" + std::to_string((i * 7) % 50) + ".v");
+        o.setProperty(key, std::to_string(i));
+        expected += key + "=" + std::to_string(i) + ";";
+      }
+    CHECK(names(o), expected);
+
+    const char* defs[] = {"x.y", "1", "x.z", "2", ""};
+    coil::Properties d(defs);
+    coil::Properties d2(d);
+    CHECK(names(d2), "x.y=1;x.z=2;");
+    CHECK(d2.getDefault("x.z"), "2");
+    CHECK(dump(d2), "- x\n  - y: 1\n  - z: 2\n");
+
+    coil::Properties root("root", "val");
+    coil::Properties root2(root);
+    CHECK(std::string(root2.getName()), "root");
+    CHECK(std::string(root2.getValue()), "val");
+
+    // a precompiled path finds the same nodes as the key string
+    coil::PropertyPath path("n.m");
+    CHECK(p.getProperty(path), "9");
+    CHECK(p.findNode(path) == p.findNode("n.m"), "1");
+    CHECK(p.getProperty(coil::PropertyPath("n.x"), "none"), "none");
+  }
+
+  template <typename Func>
+  void measure(const char* label, size_t iterations, Func func)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i(0); i < iterations; ++i) { func(); }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << label << ": "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   elapsed).count() / static_cast<long long>(iterations)
+              << " ns" << std::endl;
+  }
+
+  /*!
+   * A tree of 40 entries like the properties of a connector.
+   */
+  void benchmark(size_t iterations)
+  {
+    coil::Properties prop;
+    std::vector<std::string> keys;
+    const char* groups[] = {"dataport", "buffer", "publisher", "consumer",
+                            "provider", "inport", "outport", "serializer"};
+    for (auto group : groups)
+      {
+        for (int i(0); i < 5; ++i)
+          {
+            std::string key(std::string(group) + ".item" + std::to_string(i)
+                            + ".value");
+            prop.setProperty(key, std::to_string(i));
+            keys.emplace_back(key);
+          }
+      }
+    std::vector<coil::PropertyPath> paths;
+    for (auto const& key : keys) { paths.emplace_back(key); }
+
+    size_t hit(0);
+    size_t index(0);
+    measure("getProperty(string)", iterations, [&]()
+      {
+        hit += prop.getProperty(keys[index++ % keys.size()]).size();
+      });
+    measure("getProperty(PropertyPath)", iterations, [&]()
+      {
+        hit += prop.getProperty(paths[index++ % paths.size()]).size();
+      });
+    measure("findNode(string)", iterations, [&]()
+      {
+        hit += prop.findNode(keys[index++ % keys.size()]) != nullptr ? 1 : 0;
+      });
+    measure("copy construction", iterations / 100 + 1, [&]()
+      {
+        coil::Properties copy(prop);
+        hit += copy.size();
+      });
+    measure("setProperty(new key) + removeNode", iterations / 100 + 1, [&]()
+      {
+        coil::Properties copy(prop);
+        copy.setProperty("extra.key", "1");
+        delete copy.removeNode("extra");
+        hit += copy.size();
+      });
+    // keeps the loops from being optimized away
+    if (hit == 0) { std::cout << std::endl; }
+  }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  bool check_only(false);
+  size_t iterations(1000000);
+  for (int i(1); i < argc; ++i)
+    {
+      std::string arg(argv[i]);
+      if (arg == "--check")
+        {
+          check_only = true;
+        }
+      else if (arg.find_first_not_of("0123456789") == std::string::npos)
+        {
+          iterations = std::strtoul(arg.c_str(), nullptr, 10);
+        }
+      else
+        {
+          std::cerr << "usage: " << argv[0] << " [--check] [iterations]"
+                    << std::endl;
+          return 1;
+        }
+    }
+
+  checkSemantics();
+  if (failures != 0)
+    {
+      std::cerr << failures << " checks failed." << std::endl;
+      return 1;
+    }
+  std::cout << "All semantics checks passed." << std::endl;
+  if (check_only || iterations == 0) { return 0; }
+
+  benchmark(iterations);
+  return 0;
+}